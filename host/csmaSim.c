@@ -0,0 +1,384 @@
+/*
+ *  ======== csmaSim.c ========
+ *  Shared-channel simulator for N IEEE 802.15.4 transmitters.
+ *
+ *  Compares blind transmission (what TX_MODE_CHAINED and TX_MODE_BLOCKING
+ *  do) with unslotted CSMA-CA as run by CMD_IEEE_CSMA (TX_MODE_CSMA) on
+ *  one 2.4 GHz O-QPSK channel. Every node has a one-frame queue that is
+ *  refilled with exponentially distributed inter-arrival times, or right
+ *  away if the mean interval is 0 (saturated). Overlapping transmissions
+ *  are all lost; there is no capture effect.
+ *
+ *  Prints one CSV line per mode and node count.
+ *
+ *  Usage: csmaSim [-n maxNodes] [-l psduLength] [-i meanIntervalUs]
+ *                 [-t seconds] [-s seed] [-b minBE] [-B maxBE] [-m maxBackoffs]
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <getopt.h>
+
+/***** Defines *****/
+
+/* 2.4 GHz O-QPSK timing in microseconds */
+#define SYMBOL_US               16
+#define UNIT_BACKOFF_US         (20 * SYMBOL_US)    /* aUnitBackoffPeriod */
+#define CCA_US                  (8 * SYMBOL_US)     /* CCA duration */
+#define TURNAROUND_US           (12 * SYMBOL_US)    /* aTurnaroundTime */
+#define BYTE_US                 (2 * SYMBOL_US)
+#define SHR_PHR_BYTES           6                   /* Preamble, SFD and PHR */
+
+#define MAX_NODES               64
+
+/***** Type declarations *****/
+typedef enum
+{
+    MODE_BLIND,
+    MODE_CSMA
+} Mode;
+
+typedef enum
+{
+    STATE_IDLE,         /* No frame to send */
+    STATE_BACKOFF,      /* Backoff running, CCA starts at eventTime */
+    STATE_CCA,          /* CCA ends at eventTime */
+    STATE_TURNAROUND,   /* RX to TX turnaround ends at eventTime */
+    STATE_TX            /* Transmission ends at eventTime */
+} State;
+
+typedef struct
+{
+    State state;
+    uint64_t eventTime;     /* End of the current state */
+    uint64_t nextArrival;   /* Next frame from the application */
+    bool queued;            /* A frame waits behind the one in progress */
+    uint8_t nb;
+    uint8_t be;
+    uint64_t txStart;
+    bool collided;
+} Node;
+
+typedef struct
+{
+    uint32_t numNodes;
+    uint32_t psduLength;
+    uint32_t meanIntervalUs;    /* 0: saturated */
+    uint64_t simTimeUs;
+    uint32_t seed;
+    uint8_t macMinBE;
+    uint8_t macMaxBE;
+    uint8_t macMaxCSMABackoffs;
+} SimParams;
+
+typedef struct
+{
+    uint64_t numArrivals;
+    uint64_t numOverflows;  /* Frames that arrived while the queue was full */
+    uint64_t numAttempts;   /* Frames put on air */
+    uint64_t numDelivered;
+    uint64_t numChannelAccessFailures;
+    uint64_t totalBackoffs;
+    uint64_t busyUs;        /* Time with at least one transmitter on air */
+} SimResult;
+
+/***** Variable declarations *****/
+static uint32_t rngState;
+
+/***** Function definitions *****/
+
+static uint32_t rngNext(void)
+{
+    /* xorshift32 */
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint64_t nextInterval(const SimParams *params)
+{
+    double u = (rngNext() + 1.0) / 4294967297.0;
+    return (uint64_t)(-log(u) * params->meanIntervalUs);
+}
+
+static uint64_t backoffUs(uint8_t be)
+{
+    return (uint64_t)(rngNext() % (1u << be)) * UNIT_BACKOFF_US;
+}
+
+static bool channelBusy(const Node *nodes, uint32_t numNodes, uint64_t from, uint64_t to)
+{
+    uint32_t i;
+
+    for (i = 0; i < numNodes; i++)
+    {
+        if ((nodes[i].state == STATE_TX) &&
+            (nodes[i].txStart < to) && (nodes[i].eventTime > from))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void startAccess(Node *node, Mode mode, const SimParams *params, uint64_t now)
+{
+    if (mode == MODE_CSMA)
+    {
+        node->nb = 0;
+        node->be = params->macMinBE;
+        node->state = STATE_BACKOFF;
+        node->eventTime = now + backoffUs(node->be);
+    }
+    else
+    {
+        node->state = STATE_TURNAROUND;
+        node->eventTime = now + TURNAROUND_US;
+    }
+}
+
+static void frameDone(Node *node, Mode mode, const SimParams *params,
+                      SimResult *result, uint64_t now)
+{
+    if (params->meanIntervalUs == 0)
+    {
+        /* Saturated: the next frame is always ready */
+        result->numArrivals++;
+        startAccess(node, mode, params, now);
+    }
+    else if (node->queued)
+    {
+        node->queued = false;
+        startAccess(node, mode, params, now);
+    }
+    else
+    {
+        node->state = STATE_IDLE;
+    }
+}
+
+static void simulate(Mode mode, const SimParams *params, SimResult *result)
+{
+    Node nodes[MAX_NODES];
+    uint64_t airtimeUs = (uint64_t)(SHR_PHR_BYTES + params->psduLength) * BYTE_US;
+    uint64_t busyUntil = 0;
+    uint32_t i;
+
+    memset(result, 0, sizeof(*result));
+    memset(nodes, 0, sizeof(nodes));
+    rngState = params->seed ? params->seed : 1;
+
+    for (i = 0; i < params->numNodes; i++)
+    {
+        if (params->meanIntervalUs == 0)
+        {
+            result->numArrivals++;
+            startAccess(&nodes[i], mode, params, rngNext() % UNIT_BACKOFF_US);
+        }
+        else
+        {
+            nodes[i].state = STATE_IDLE;
+            nodes[i].nextArrival = nextInterval(params);
+        }
+    }
+
+    while (1)
+    {
+        /* Earliest pending event, transmissions ending first on a tie */
+        Node *node = NULL;
+        uint64_t now = UINT64_MAX;
+        bool isArrival = false;
+
+        for (i = 0; i < params->numNodes; i++)
+        {
+            Node *n = &nodes[i];
+            if ((n->state != STATE_IDLE) &&
+                ((n->eventTime < now) || ((n->eventTime == now) && (n->state == STATE_TX))))
+            {
+                node = n;
+                now = n->eventTime;
+                isArrival = false;
+            }
+            if ((params->meanIntervalUs != 0) && (n->nextArrival < now))
+            {
+                node = n;
+                now = n->nextArrival;
+                isArrival = true;
+            }
+        }
+
+        if ((node == NULL) || (now >= params->simTimeUs))
+        {
+            break;
+        }
+
+        if (isArrival)
+        {
+            result->numArrivals++;
+            node->nextArrival = now + nextInterval(params);
+            if (node->state == STATE_IDLE)
+            {
+                startAccess(node, mode, params, now);
+            }
+            else if (!node->queued)
+            {
+                node->queued = true;
+            }
+            else
+            {
+                result->numOverflows++;
+            }
+            continue;
+        }
+
+        switch (node->state)
+        {
+            case STATE_BACKOFF:
+                node->state = STATE_CCA;
+                node->eventTime = now + CCA_US;
+                break;
+
+            case STATE_CCA:
+                if (!channelBusy(nodes, params->numNodes, now - CCA_US, now))
+                {
+                    node->state = STATE_TURNAROUND;
+                    node->eventTime = now + TURNAROUND_US;
+                }
+                else if (node->nb >= params->macMaxCSMABackoffs)
+                {
+                    result->totalBackoffs += node->nb;
+                    result->numChannelAccessFailures++;
+                    frameDone(node, mode, params, result, now);
+                }
+                else
+                {
+                    node->nb++;
+                    if (node->be < params->macMaxBE)
+                    {
+                        node->be++;
+                    }
+                    node->state = STATE_BACKOFF;
+                    node->eventTime = now + backoffUs(node->be);
+                }
+                break;
+
+            case STATE_TURNAROUND:
+                result->numAttempts++;
+                if (mode == MODE_CSMA)
+                {
+                    result->totalBackoffs += node->nb;
+                }
+                node->collided = false;
+                for (i = 0; i < params->numNodes; i++)
+                {
+                    if ((&nodes[i] != node) && (nodes[i].state == STATE_TX))
+                    {
+                        nodes[i].collided = true;
+                        node->collided = true;
+                    }
+                }
+                node->state = STATE_TX;
+                node->txStart = now;
+                node->eventTime = now + airtimeUs;
+
+                if (node->eventTime > busyUntil)
+                {
+                    result->busyUs += node->eventTime - ((busyUntil > now) ? busyUntil : now);
+                    busyUntil = node->eventTime;
+                }
+                break;
+
+            case STATE_TX:
+                if (!node->collided)
+                {
+                    result->numDelivered++;
+                }
+                frameDone(node, mode, params, result, now);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (busyUntil > params->simTimeUs)
+    {
+        result->busyUs -= busyUntil - params->simTimeUs;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SimParams params;
+    uint32_t maxNodes = 16;
+    double seconds = 10.0;
+    int opt;
+
+    params.psduLength = 32;         /* PAYLOAD_LENGTH plus FCS */
+    params.meanIntervalUs = 0;
+    params.seed = 1;
+    params.macMinBE = 3;
+    params.macMaxBE = 5;
+    params.macMaxCSMABackoffs = 4;
+
+    while ((opt = getopt(argc, argv, "n:l:i:t:s:b:B:m:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': maxNodes = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'l': params.psduLength = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': params.meanIntervalUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 's': params.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'b': params.macMinBE = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'B': params.macMaxBE = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'm': params.macMaxCSMABackoffs = (uint8_t)strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "usage: %s [-n maxNodes] [-l psduLength] [-i meanIntervalUs] "
+                                "[-t seconds] [-s seed] [-b minBE] [-B maxBE] [-m maxBackoffs]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+
+    if ((maxNodes == 0) || (maxNodes > MAX_NODES) ||
+        (params.psduLength < 5) || (params.psduLength > 127) ||
+        (params.macMinBE > params.macMaxBE) || (params.macMaxBE > 8))
+    {
+        fprintf(stderr, "%s: parameter out of range\n", argv[0]);
+        return 1;
+    }
+    params.simTimeUs = (uint64_t)(seconds * 1e6);
+
+    printf("mode,nodes,offered_fps,attempted_fps,delivered_fps,delivery_ratio,"
+           "channel_utilization,avg_backoffs,channel_access_failures\n");
+
+    Mode mode;
+    for (mode = MODE_BLIND; mode <= MODE_CSMA; mode++)
+    {
+        for (params.numNodes = 1; params.numNodes <= maxNodes; params.numNodes++)
+        {
+            SimResult result;
+            simulate(mode, &params, &result);
+
+            printf("%s,%u,%.1f,%.1f,%.1f,%.4f,%.4f,%.3f,%llu\n",
+                   (mode == MODE_CSMA) ? "csma" : "blind",
+                   params.numNodes,
+                   result.numArrivals / seconds,
+                   result.numAttempts / seconds,
+                   result.numDelivered / seconds,
+                   result.numArrivals ? (double)result.numDelivered / result.numArrivals : 0.0,
+                   (double)result.busyUs / params.simTimeUs,
+                   result.numAttempts ? (double)result.totalBackoffs / result.numAttempts : 0.0,
+                   (unsigned long long)result.numChannelAccessFailures);
+        }
+    }
+
+    return 0;
+}
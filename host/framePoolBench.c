@@ -0,0 +1,322 @@
+/*
+ *  ======== framePoolBench.c ========
+ *  Host check and benchmark of the frame pool (framePool.c in the CCS
+ *  project).
+ *
+ *  Checks construction limits, allocation until the pool is empty, the
+ *  LIFO order of free and alloc, the statistics and the high-watermark,
+ *  then lets threads allocate, write, check and free slots at the same
+ *  time to catch a slot handed out twice. Finally times alloc/free pairs,
+ *  from one thread and from all of them at once, and prints ns per pair
+ *  as CSV.
+ *
+ *  Usage: framePoolBench [-s slots] [-t threads] [-n millions]
+ */
+
+/***** Includes *****/
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "framePool.h"
+
+/***** Defines *****/
+#define CHECK_SLOTS             8
+#define MAX_THREADS             16
+#define STRESS_PAIRS            200000
+
+/***** Type declarations *****/
+typedef struct
+{
+    FramePool_Handle pool;
+    uint8_t id;
+    uint32_t numPairs;
+    uint32_t numCorrupt;        /* Slots found written by another thread */
+    uint32_t numEmpty;          /* Allocations that found the pool empty */
+    double ns;
+} Worker;
+
+/***** Variable declarations *****/
+static pthread_barrier_t startBarrier;
+
+/***** Function definitions *****/
+
+static double nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define CHECK(cond, what)                                   \
+    do                                                      \
+    {                                                       \
+        if (!(cond))                                        \
+        {                                                   \
+            printf("framePool: %s\n", what);                \
+            return false;                                   \
+        }                                                   \
+    } while (0)
+
+static bool checkSingle(void)
+{
+    static FramePool_Slot slots[CHECK_SLOTS];
+    FramePool_Slot *taken[CHECK_SLOTS];
+    FramePool_Object pool;
+    FramePool_Stats stats;
+    uint16_t i, j;
+
+    CHECK(FramePool_construct(&pool, slots, 0) == NULL, "0 slots accepted");
+    CHECK(FramePool_construct(&pool, slots, FRAME_POOL_MAX_SLOTS + 1) == NULL, "too many slots accepted");
+    CHECK(FramePool_construct(&pool, slots, CHECK_SLOTS) == &pool, "construct failed");
+
+    /* Every slot once, then nothing */
+    for (i = 0; i < CHECK_SLOTS; i++)
+    {
+        taken[i] = FramePool_alloc(&pool);
+        CHECK(taken[i] != NULL, "pool empty too early");
+        CHECK((taken[i] >= slots) && (taken[i] < &slots[CHECK_SLOTS]), "slot outside the storage");
+        CHECK(taken[i]->length == 0, "length not cleared");
+        for (j = 0; j < i; j++)
+        {
+            CHECK(taken[j] != taken[i], "slot handed out twice");
+        }
+        taken[i]->length = FRAME_POOL_PSDU_SIZE;
+        memset(taken[i]->psdu, i, FRAME_POOL_PSDU_SIZE);
+    }
+    CHECK(FramePool_alloc(&pool) == NULL, "alloc on an empty pool");
+    CHECK(FramePool_alloc(&pool) == NULL, "alloc on an empty pool");
+
+    FramePool_getStats(&pool, &stats);
+    CHECK(stats.numSlots == CHECK_SLOTS, "numSlots");
+    CHECK(stats.numUsed == CHECK_SLOTS, "numUsed when full");
+    CHECK(stats.maxUsed == CHECK_SLOTS, "maxUsed when full");
+    CHECK(stats.numAllocs == CHECK_SLOTS, "numAllocs");
+    CHECK(stats.numFailures == 2, "numFailures");
+
+    /* The PSDUs were not overwritten by the free list */
+    for (i = 0; i < CHECK_SLOTS; i++)
+    {
+        for (j = 0; j < FRAME_POOL_PSDU_SIZE; j++)
+        {
+            CHECK(taken[i]->psdu[j] == i, "PSDU overwritten");
+        }
+    }
+
+    /* Freed slots come back last in, first out */
+    FramePool_free(&pool, taken[2]);
+    FramePool_free(&pool, taken[5]);
+    FramePool_free(&pool, taken[0]);
+    FramePool_getStats(&pool, &stats);
+    CHECK(stats.numUsed == CHECK_SLOTS - 3, "numUsed after free");
+    CHECK(stats.maxUsed == CHECK_SLOTS, "maxUsed dropped on free");
+    CHECK(FramePool_alloc(&pool) == taken[0], "free/alloc order");
+    CHECK(FramePool_alloc(&pool) == taken[5], "free/alloc order");
+    CHECK(FramePool_alloc(&pool) == taken[2], "free/alloc order");
+    CHECK(FramePool_alloc(&pool) == NULL, "alloc on an empty pool");
+
+    /* Watermark restarts from what is used now and climbs again */
+    for (i = 0; i < CHECK_SLOTS; i++)
+    {
+        FramePool_free(&pool, taken[i]);
+    }
+    FramePool_getStats(&pool, &stats);
+    CHECK(stats.numUsed == 0, "numUsed when empty");
+    CHECK(stats.maxUsed == CHECK_SLOTS, "maxUsed before reset");
+    FramePool_resetWatermark(&pool);
+    FramePool_getStats(&pool, &stats);
+    CHECK(stats.maxUsed == 0, "maxUsed after reset");
+    taken[0] = FramePool_alloc(&pool);
+    taken[1] = FramePool_alloc(&pool);
+    FramePool_free(&pool, taken[0]);
+    FramePool_getStats(&pool, &stats);
+    CHECK((stats.numUsed == 1) && (stats.maxUsed == 2), "watermark after reset");
+    FramePool_free(&pool, taken[1]);
+
+    /* Emptied and refilled, the pool still has every slot exactly once */
+    for (i = 0; i < CHECK_SLOTS; i++)
+    {
+        taken[i] = FramePool_alloc(&pool);
+        CHECK(taken[i] != NULL, "slot lost");
+    }
+    CHECK(FramePool_alloc(&pool) == NULL, "slot duplicated");
+
+    return true;
+}
+
+/* Marks the slot as its own, gives other threads a chance to take it as
+ * well, then checks that nobody did */
+static void *stressThread(void *arg)
+{
+    Worker *w = arg;
+    uint32_t i;
+
+    pthread_barrier_wait(&startBarrier);
+    for (i = 0; i < w->numPairs; i++)
+    {
+        FramePool_Slot *slot = FramePool_alloc(w->pool);
+        if (slot == NULL)
+        {
+            w->numEmpty++;
+            continue;
+        }
+        memset(slot->psdu, w->id, 16);
+        sched_yield();
+        uint8_t k;
+        for (k = 0; k < 16; k++)
+        {
+            if (slot->psdu[k] != w->id)
+            {
+                w->numCorrupt++;
+                break;
+            }
+        }
+        FramePool_free(w->pool, slot);
+    }
+
+    return NULL;
+}
+
+static bool checkThreads(uint16_t numSlots, uint8_t numThreads)
+{
+    FramePool_Slot *slots = calloc(numSlots, sizeof(FramePool_Slot));
+    Worker workers[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    FramePool_Object pool;
+    FramePool_Stats stats;
+    uint32_t numAllocs = 0;
+    uint32_t numEmpty = 0;
+    uint8_t i;
+
+    FramePool_construct(&pool, slots, numSlots);
+    pthread_barrier_init(&startBarrier, NULL, numThreads);
+    for (i = 0; i < numThreads; i++)
+    {
+        workers[i] = (Worker){ .pool = &pool, .id = (uint8_t)(i + 1), .numPairs = STRESS_PAIRS };
+        pthread_create(&threads[i], NULL, stressThread, &workers[i]);
+    }
+    for (i = 0; i < numThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+        CHECK(workers[i].numCorrupt == 0, "slot in use by two threads");
+        numAllocs += STRESS_PAIRS - workers[i].numEmpty;
+        numEmpty += workers[i].numEmpty;
+    }
+    pthread_barrier_destroy(&startBarrier);
+
+    FramePool_getStats(&pool, &stats);
+    CHECK(stats.numUsed == 0, "numUsed after the threads");
+    CHECK(stats.numAllocs == numAllocs, "numAllocs after the threads");
+    CHECK(stats.numFailures == numEmpty, "numFailures after the threads");
+    CHECK(stats.maxUsed <= numSlots, "maxUsed above the slot count");
+    CHECK(stats.maxUsed <= numThreads, "maxUsed above the thread count");
+
+    /* Every slot still there exactly once */
+    uint16_t n = 0;
+    while (FramePool_alloc(&pool) != NULL)
+    {
+        n++;
+    }
+    CHECK(n == numSlots, "slots lost or duplicated by the threads");
+
+    free(slots);
+    return true;
+}
+
+static void *benchThread(void *arg)
+{
+    Worker *w = arg;
+    uint32_t i;
+
+    pthread_barrier_wait(&startBarrier);
+    double start = nowNs();
+    for (i = 0; i < w->numPairs; i++)
+    {
+        FramePool_Slot *slot = FramePool_alloc(w->pool);
+        if (slot != NULL)
+        {
+            slot->length = (uint8_t)i;
+            FramePool_free(w->pool, slot);
+        }
+    }
+    w->ns = nowNs() - start;
+
+    return NULL;
+}
+
+/* ns per alloc/free pair, the average over the threads */
+static double bench(uint16_t numSlots, uint8_t numThreads, uint32_t numPairs)
+{
+    FramePool_Slot *slots = calloc(numSlots, sizeof(FramePool_Slot));
+    Worker workers[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    FramePool_Object pool;
+    double ns = 0;
+    uint8_t i;
+
+    FramePool_construct(&pool, slots, numSlots);
+    pthread_barrier_init(&startBarrier, NULL, numThreads);
+    for (i = 0; i < numThreads; i++)
+    {
+        workers[i] = (Worker){ .pool = &pool, .numPairs = numPairs };
+        pthread_create(&threads[i], NULL, benchThread, &workers[i]);
+    }
+    for (i = 0; i < numThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+        ns += workers[i].ns / numPairs;
+    }
+    pthread_barrier_destroy(&startBarrier);
+    free(slots);
+
+    return ns / numThreads;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t numSlots = 8;
+    uint32_t numThreads = 4;
+    uint32_t millions = 20;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:t:n:")) != -1)
+    {
+        switch (opt)
+        {
+            case 's': numSlots = (uint32_t)atoi(optarg); break;
+            case 't': numThreads = (uint32_t)atoi(optarg); break;
+            case 'n': millions = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-s slots] [-t threads] [-n millions]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((numSlots == 0) || (numSlots > FRAME_POOL_MAX_SLOTS) || (numThreads == 0) ||
+        (numThreads > MAX_THREADS) || (millions == 0))
+    {
+        fprintf(stderr, "%s: parameter out of range\n", argv[0]);
+        return 1;
+    }
+
+    if (!checkSingle() || !checkThreads((uint16_t)numSlots, (uint8_t)numThreads))
+    {
+        return 1;
+    }
+
+    uint32_t numPairs = millions * 1000000;
+    printf("threads,slots,pairs,ns_per_pair\n");
+    printf("1,%u,%u,%.3f\n", numSlots, numPairs, bench((uint16_t)numSlots, 1, numPairs));
+    if (numThreads > 1)
+    {
+        printf("%u,%u,%u,%.3f\n", numThreads, numSlots, numPairs / numThreads,
+               bench((uint16_t)numSlots, (uint8_t)numThreads, numPairs / numThreads));
+    }
+
+    return 0;
+}
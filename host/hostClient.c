@@ -0,0 +1,689 @@
+/*
+ *  ======== hostClient.c ========
+ *  Host side of the UART job protocol (hostProtocol.h in the CCS project),
+ *  for the firmware built with TX_MODE_HOST.
+ *
+ *  Checks the link with a ping, then sends the job the given number of
+ *  times, each either a generator spec or the frames of a list file (one
+ *  frame per line in hex, MAC header included, without FCS; of a line with
+ *  commas only the last field, so the tx lines of rfSim -t can be used). Reports are read as they stream in; per job one CSV line
+ *  gives frames sent and failed, reports received and lost, the device's
+ *  time from the first frame on air to the end of the last, the resulting
+ *  frames per second and the wall clock time of the whole exchange.
+ *
+ *  With -w the jobs also send back every frame they sent, as PCAPNG
+ *  blocks that are appended to the given file as they come; each job is a
+ *  section of its own.
+ *
+ *  With -t the radio trace is drained after every job and its records are
+ *  appended to the given file, for traceDecode.
+ *
+ *  Usage: hostClient [-B baud] [-c channel] [-p dBm] [-n count]
+ *                    [-i intervalUs] [-g pattern] [-l length] [-f frameFile]
+ *                    [-r repeat] [-o reportFile] [-w pcapngFile]
+ *                    [-t traceFile] device
+ */
+
+/***** Includes *****/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#include "hostProtocol.h"
+#include "payloadGen.h"
+
+/***** Defines *****/
+#define RESPONSE_TIMEOUT_MS     2000    /* Per message, beyond the job's own duration */
+#define RAT_TICKS_PER_US        4
+#define TRACE_RECORD_SIZE       20      /* RADIO_TRACE_RECORD_SIZE */
+
+/***** Type declarations *****/
+typedef struct
+{
+    uint8_t type;
+    uint16_t length;
+    uint8_t payload[HOST_PROTOCOL_MAX_PAYLOAD];
+} Message;
+
+typedef struct
+{
+    uint32_t numReports;
+    uint32_t numEntries;
+    uint32_t numSent;
+    uint32_t numErrors;
+    uint32_t numMissed;
+    uint32_t numOutOfOrder;         /* Reports not starting where the last one ended */
+} JobCount;
+
+/***** Variable declarations *****/
+static int fd = -1;
+static uint8_t rxBuf[4096];
+static size_t rxHead;
+static size_t rxTail;
+static uint64_t rxBytes;
+static uint64_t txBytes;
+static uint32_t numSkipped;
+static uint32_t numCrcErrors;
+
+static uint8_t frames[HOST_PROTOCOL_MAX_FRAMES][HOST_PROTOCOL_MAX_LENGTH];
+static uint8_t frameLengths[HOST_PROTOCOL_MAX_FRAMES];
+static uint8_t numFrames;
+
+static FILE *captureFile;
+static FILE *traceFile;
+static uint32_t numTraceBytes;
+
+/***** Function definitions *****/
+
+static double wallNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static speed_t baudConstant(unsigned long baud)
+{
+    switch (baud)
+    {
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        case 3000000: return B3000000;
+        default:      return B0;
+    }
+}
+
+static bool openDevice(const char *path, unsigned long baud)
+{
+    struct termios tio;
+    speed_t speed = baudConstant(baud);
+
+    if (speed == B0)
+    {
+        fprintf(stderr, "hostClient: unsupported baud rate %lu\n", baud);
+        return false;
+    }
+
+    fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        perror(path);
+        return false;
+    }
+
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    return true;
+}
+
+static bool sendMessage(uint8_t type, const uint8_t *payload, uint16_t length)
+{
+    uint8_t buf[HOST_PROTOCOL_MAX_MESSAGE];
+    uint32_t size = HostProtocol_encode(buf, type, payload, length);
+    uint32_t done = 0;
+
+    while (done < size)
+    {
+        ssize_t n = write(fd, &buf[done], size - done);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("hostClient: write");
+            return false;
+        }
+        done += (uint32_t)n;
+    }
+    txBytes += size;
+
+    return true;
+}
+
+/* Makes at least count bytes available; false on timeout or error */
+static bool fill(size_t count, int timeoutMs)
+{
+    if (rxHead > 0)
+    {
+        memmove(rxBuf, &rxBuf[rxHead], rxTail - rxHead);
+        rxTail -= rxHead;
+        rxHead = 0;
+    }
+
+    while (rxTail < count)
+    {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+        if (poll(&pfd, 1, timeoutMs) <= 0)
+        {
+            return false;
+        }
+        ssize_t n = read(fd, &rxBuf[rxTail], sizeof(rxBuf) - rxTail);
+        if (n <= 0)
+        {
+            if ((n < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            return false;
+        }
+        rxTail += (size_t)n;
+        rxBytes += (uint64_t)n;
+    }
+
+    return true;
+}
+
+/* Reads the next message with a good CRC; false on timeout */
+static bool receiveMessage(Message *msg, int timeoutMs)
+{
+    while (1)
+    {
+        if (!fill(HOST_PROTOCOL_HDR_LENGTH, timeoutMs))
+        {
+            return false;
+        }
+        if (!HostProtocol_parseHeader(&rxBuf[rxHead], &msg->type, &msg->length))
+        {
+            rxHead++;
+            numSkipped++;
+            continue;
+        }
+
+        size_t size = HOST_PROTOCOL_HDR_LENGTH + msg->length + HOST_PROTOCOL_CRC_LENGTH;
+        if (!fill(size, timeoutMs))
+        {
+            return false;
+        }
+
+        const uint8_t *p = &rxBuf[rxHead];
+        uint16_t crc = HostProtocol_crc16(0xFFFF, &p[1], HOST_PROTOCOL_HDR_LENGTH - 1 + msg->length);
+        const uint8_t *crcBytes = &p[HOST_PROTOCOL_HDR_LENGTH + msg->length];
+        if (crc != (uint16_t)(crcBytes[0] | (crcBytes[1] << 8)))
+        {
+            /* Not a message after all, or a damaged one: resync behind the sync */
+            rxHead++;
+            numCrcErrors++;
+            continue;
+        }
+
+        memcpy(msg->payload, &p[HOST_PROTOCOL_HDR_LENGTH], msg->length);
+        rxHead += size;
+        return true;
+    }
+}
+
+static int hexValue(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static bool readFrames(const char *path)
+{
+    char line[2 * HOST_PROTOCOL_MAX_LENGTH + 64];
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        uint8_t length = 0;
+        int high = -1;
+        char *c = strrchr(line, ',');
+
+        for (c = (c != NULL) ? c + 1 : line; (*c != '\0') && (*c != '#'); c++)
+        {
+            int value = hexValue(*c);
+            if (value < 0)
+            {
+                continue;
+            }
+            if (high < 0)
+            {
+                high = value;
+                continue;
+            }
+            if (length == HOST_PROTOCOL_MAX_LENGTH)
+            {
+                fprintf(stderr, "%s: frame longer than %d bytes\n", path, HOST_PROTOCOL_MAX_LENGTH);
+                fclose(file);
+                return false;
+            }
+            frames[numFrames][length++] = (uint8_t)((high << 4) | value);
+            high = -1;
+        }
+        if (length == 0)
+        {
+            continue;
+        }
+        if (numFrames == HOST_PROTOCOL_MAX_FRAMES)
+        {
+            fprintf(stderr, "%s: more than %d frames\n", path, HOST_PROTOCOL_MAX_FRAMES);
+            fclose(file);
+            return false;
+        }
+        frameLengths[numFrames++] = length;
+    }
+
+    fclose(file);
+    if (numFrames == 0)
+    {
+        fprintf(stderr, "%s: no frames\n", path);
+        return false;
+    }
+    return true;
+}
+
+static bool ping(void)
+{
+    Message msg;
+
+    if (!sendMessage(HOST_MSG_PING, NULL, 0))
+    {
+        return false;
+    }
+    while (receiveMessage(&msg, RESPONSE_TIMEOUT_MS))
+    {
+        if ((msg.type == HOST_MSG_PONG) && (msg.length == 3))
+        {
+            fprintf(stderr, "hostClient: protocol version %u, %u frames of up to %u bytes per list\n",
+                    msg.payload[0], msg.payload[1], msg.payload[2]);
+            if (msg.payload[0] != HOST_PROTOCOL_VERSION)
+            {
+                fprintf(stderr, "hostClient: version %d expected\n", HOST_PROTOCOL_VERSION);
+                return false;
+            }
+            return true;
+        }
+    }
+
+    fprintf(stderr, "hostClient: no answer to ping\n");
+    return false;
+}
+
+static bool runJob(const HostProtocol_Job *job, FILE *reportFile, JobCount *count,
+                   HostProtocol_JobDone *done)
+{
+    uint8_t payload[HOST_PROTOCOL_JOB_LENGTH];
+    uint32_t nextIndex = 0;
+    bool acked = false;
+    uint8_t i;
+    Message msg;
+
+    memset(count, 0, sizeof(*count));
+
+    HostProtocol_encodeJob(payload, job);
+    if (!sendMessage(HOST_MSG_JOB, payload, sizeof(payload)))
+    {
+        return false;
+    }
+    for (i = 0; (job->source == HOST_JOB_SOURCE_LIST) && (i < job->numFrames); i++)
+    {
+        if (!sendMessage(HOST_MSG_FRAME, frames[i], frameLengths[i]))
+        {
+            return false;
+        }
+    }
+
+    /* A timed job may take long between reports */
+    int timeoutMs = RESPONSE_TIMEOUT_MS +
+                    (int)((uint64_t)job->interval * HOST_PROTOCOL_REPORT_BATCH / 1000);
+
+    while (receiveMessage(&msg, timeoutMs))
+    {
+        switch (msg.type)
+        {
+            case HOST_MSG_JOB_ACK:
+                if ((msg.length != 3) || (msg.payload[2] != HOST_JOB_STATUS_ACCEPTED))
+                {
+                    fprintf(stderr, "hostClient: job %u refused, status %u\n", job->jobId,
+                            (msg.length == 3) ? msg.payload[2] : 0xFF);
+                    return false;
+                }
+                acked = true;
+                break;
+
+            case HOST_MSG_REPORT:
+            {
+                HostProtocol_ReportEntry entries[HOST_PROTOCOL_REPORT_BATCH];
+                uint32_t firstIndex;
+                uint16_t jobId;
+                int numEntries = HostProtocol_decodeReport(msg.payload, msg.length, &jobId,
+                                                           &firstIndex, entries);
+                int k;
+
+                if ((numEntries < 0) || (jobId != job->jobId))
+                {
+                    break;
+                }
+                count->numReports++;
+                if (firstIndex != nextIndex)
+                {
+                    count->numOutOfOrder++;
+                }
+                nextIndex = firstIndex + (uint32_t)numEntries;
+
+                for (k = 0; k < numEntries; k++)
+                {
+                    count->numEntries++;
+                    switch (entries[k].status)
+                    {
+                        case HOST_FRAME_SENT:   count->numSent++; break;
+                        case HOST_FRAME_MISSED: count->numMissed++; break;
+                        default:                count->numErrors++; break;
+                    }
+                    if (reportFile != NULL)
+                    {
+                        fprintf(reportFile, "%u,%u,%u,%.3f\n", jobId, firstIndex + (uint32_t)k,
+                                entries[k].status, entries[k].timeStamp / (double)RAT_TICKS_PER_US);
+                    }
+                }
+                break;
+            }
+
+            case HOST_MSG_JOB_DONE:
+                if (msg.length != HOST_PROTOCOL_JOB_DONE_LENGTH)
+                {
+                    break;
+                }
+                HostProtocol_decodeJobDone(msg.payload, done);
+                if (done->jobId == job->jobId)
+                {
+                    return acked;
+                }
+                break;
+
+            case HOST_MSG_CAPTURE:
+                if ((captureFile != NULL) &&
+                    (fwrite(msg.payload, 1, msg.length, captureFile) != msg.length))
+                {
+                    perror("hostClient: capture");
+                    return false;
+                }
+                break;
+
+            case HOST_MSG_ERROR:
+                fprintf(stderr, "hostClient: error %u on message type 0x%02x\n",
+                        msg.payload[0], (msg.length > 1) ? msg.payload[1] : 0);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    fprintf(stderr, "hostClient: job %u timed out\n", job->jobId);
+    return false;
+}
+
+/* Appends the unread trace records to traceFile */
+static bool drainTrace(HostProtocol_TraceDone *done)
+{
+    uint32_t numBytes = 0;
+    Message msg;
+
+    if (!sendMessage(HOST_MSG_TRACE, NULL, 0))
+    {
+        return false;
+    }
+    while (receiveMessage(&msg, RESPONSE_TIMEOUT_MS))
+    {
+        switch (msg.type)
+        {
+            case HOST_MSG_TRACE_DATA:
+                if (fwrite(msg.payload, 1, msg.length, traceFile) != msg.length)
+                {
+                    perror("hostClient: trace");
+                    return false;
+                }
+                numBytes += msg.length;
+                break;
+
+            case HOST_MSG_TRACE_DONE:
+                if (msg.length != HOST_PROTOCOL_TRACE_DONE_LENGTH)
+                {
+                    break;
+                }
+                HostProtocol_decodeTraceDone(msg.payload, done);
+                if (numBytes != done->numSent * TRACE_RECORD_SIZE)
+                {
+                    fprintf(stderr, "hostClient: %u trace records sent, %u bytes received\n",
+                            done->numSent, numBytes);
+                }
+                numTraceBytes += numBytes;
+                return true;
+
+            case HOST_MSG_ERROR:
+                fprintf(stderr, "hostClient: error %u on message type 0x%02x\n",
+                        msg.payload[0], (msg.length > 1) ? msg.payload[1] : 0);
+                return false;
+
+            default:
+                break;
+        }
+    }
+
+    fprintf(stderr, "hostClient: trace timed out\n");
+    return false;
+}
+
+static int findPattern(const char *name)
+{
+    int i;
+
+    for (i = 0; i < PAYLOAD_GEN_COUNT; i++)
+    {
+        if (strcmp(name, PayloadGen_getName((PayloadGen_Pattern)i)) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 1000000;
+    const char *framePath = NULL;
+    const char *reportPath = NULL;
+    const char *capturePath = NULL;
+    const char *tracePath = NULL;
+    const char *pattern = "prbs9";
+    uint32_t repeat = 1;
+    FILE *reportFile = NULL;
+    HostProtocol_TraceDone traceDone = { 0 };
+    HostProtocol_Job job;
+    int opt;
+
+    memset(&job, 0, sizeof(job));
+    job.channel = 11;
+    job.count = 100;
+    job.length = 30;
+
+    while ((opt = getopt(argc, argv, "B:c:p:n:i:g:l:f:r:o:w:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'B': baud = strtoul(optarg, NULL, 0); break;
+            case 'c': job.channel = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'p': job.txPower = (int8_t)strtol(optarg, NULL, 0); break;
+            case 'n': job.count = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': job.interval = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'g': pattern = optarg; break;
+            case 'l': job.length = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'f': framePath = optarg; break;
+            case 'r': repeat = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o': reportPath = optarg; break;
+            case 'w': capturePath = optarg; break;
+            case 't': tracePath = optarg; break;
+            default:
+                optind = argc + 1;
+                break;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        fprintf(stderr, "usage: %s [-B baud] [-c channel] [-p dBm] [-n count] [-i intervalUs] "
+                        "[-g pattern] [-l length] [-f frameFile] [-r repeat] [-o reportFile] "
+                        "[-w pcapngFile] [-t traceFile] device\n",
+                argv[0]);
+        return 1;
+    }
+
+    /* An interval makes a timed job, none a burst */
+    job.mode = (job.interval != 0) ? HOST_JOB_MODE_TIMED : HOST_JOB_MODE_BURST;
+    if (framePath != NULL)
+    {
+        if (!readFrames(framePath))
+        {
+            return 1;
+        }
+        job.source = HOST_JOB_SOURCE_LIST;
+        job.numFrames = numFrames;
+    }
+    else
+    {
+        int source = findPattern(pattern);
+        if (source < 0)
+        {
+            fprintf(stderr, "%s: unknown pattern %s\n", argv[0], pattern);
+            return 1;
+        }
+        job.source = (uint8_t)source;
+    }
+
+    if (reportPath != NULL)
+    {
+        reportFile = fopen(reportPath, "w");
+        if (reportFile == NULL)
+        {
+            perror(reportPath);
+            return 1;
+        }
+        fprintf(reportFile, "job,frame,status,timeUs\n");
+    }
+
+    if (capturePath != NULL)
+    {
+        captureFile = fopen(capturePath, "wb");
+        if (captureFile == NULL)
+        {
+            perror(capturePath);
+            return 1;
+        }
+        job.flags |= HOST_JOB_FLAG_CAPTURE;
+    }
+
+    if (tracePath != NULL)
+    {
+        traceFile = fopen(tracePath, "wb");
+        if (traceFile == NULL)
+        {
+            perror(tracePath);
+            return 1;
+        }
+    }
+
+    if (!openDevice(argv[optind], baud) || !ping())
+    {
+        return 1;
+    }
+
+    printf("job,sent,errors,missed,reports,reportsLost,outOfOrder,deviceUs,framesPerS,wallS,"
+           "linkBytesIn,linkBytesOut\n");
+
+    uint32_t r;
+    for (r = 0; r < repeat; r++)
+    {
+        HostProtocol_JobDone done;
+        JobCount count;
+        uint64_t rxStart = rxBytes;
+        uint64_t txStart = txBytes;
+        double start = wallNow();
+
+        job.jobId = (uint16_t)(r + 1);
+        if (!runJob(&job, reportFile, &count, &done))
+        {
+            return 1;
+        }
+        double wall = wallNow() - start;
+
+        /* Not part of the job's wall time */
+        if ((traceFile != NULL) && !drainTrace(&traceDone))
+        {
+            return 1;
+        }
+
+        /* Over the device's own time base, which the host link does not
+         * stretch */
+        double framesPerS = ((done.elapsed > 0) && (done.numSent > 0)) ? done.numSent * 1e6 / done.elapsed
+                                                                       : 0.0;
+        printf("%u,%u,%u,%u,%u,%u,%u,%u,%.1f,%.3f,%llu,%llu\n", done.jobId, done.numSent,
+               done.numErrors - count.numMissed, count.numMissed, count.numReports,
+               done.numReportsLost, count.numOutOfOrder, done.elapsed, framesPerS, wall,
+               (unsigned long long)(rxBytes - rxStart), (unsigned long long)(txBytes - txStart));
+        fflush(stdout);
+    }
+
+    if ((numSkipped > 0) || (numCrcErrors > 0))
+    {
+        fprintf(stderr, "hostClient: %u bytes skipped, %u CRC errors\n", numSkipped, numCrcErrors);
+    }
+    if (reportFile != NULL)
+    {
+        fclose(reportFile);
+    }
+    if (captureFile != NULL)
+    {
+        fclose(captureFile);
+    }
+    if (traceFile != NULL)
+    {
+        fprintf(stderr, "hostClient: %u trace records written, %u of %u overwritten before they were read\n",
+                numTraceBytes / TRACE_RECORD_SIZE, traceDone.numLost, traceDone.numRecords);
+        fclose(traceFile);
+    }
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ *  ======== macFrameCheck.c ========
+ *  Host check of the MAC frame builder (macFrame.c in the CCS project).
+ *
+ *  Writes data frames with short and extended addresses, beacons and MAC
+ *  commands with MacFrame_writeHeader(), from the constant templates and
+ *  from MacFrame_initTemplate(), and compares them byte for byte with
+ *  frames written out by hand from IEEE 802.15.4-2006 section 7.2. Then
+ *  checks the header lengths, MacFrame_build() up to the largest frame
+ *  and the air times of MAC_FRAME_AIR_US() the benchmarks and the TX
+ *  schedules are computed from.
+ *
+ *  Usage: macFrameCheck
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "macFrame.h"
+
+/***** Defines *****/
+/* The addresses of rfPacketTx.c and RF_cmdIeeeRx_ieee154 */
+#define PAN_ID                  0x0000
+#define SHORT_ADDR              0xABBA
+#define PEER_ADDR               0x0001
+#define EXT_ADDR                0x00124B0001020304ULL
+#define PEER_EXT_ADDR           0x00124B00A0B0C0D0ULL
+#define SEQ                     0x5C
+
+/***** Type declarations *****/
+typedef struct
+{
+    const char *name;
+    MacFrame_Template tmpl;     /* Constant initializer */
+    MacFrame_Params params;     /* The same header for MacFrame_initTemplate() */
+    uint8_t hdrLen;
+    uint8_t hdr[MAC_FRAME_MAX_HDR_LENGTH];
+} HeaderCase;
+
+/***** Variable declarations *****/
+static const HeaderCase headerCases[] =
+{
+    {
+        "data short broadcast",
+        MAC_FRAME_TEMPLATE_DATA_SHORT(PAN_ID, MAC_BROADCAST_ADDR, SHORT_ADDR, 0),
+        { .frameType = MAC_FRAME_TYPE_DATA, .panIdCompression = true,
+          .dstAddrMode = MAC_ADDR_MODE_SHORT, .dstPanId = PAN_ID, .dstShortAddr = MAC_BROADCAST_ADDR,
+          .srcAddrMode = MAC_ADDR_MODE_SHORT, .srcShortAddr = SHORT_ADDR },
+        9, { 0x41, 0x88, SEQ, 0x00, 0x00, 0xFF, 0xFF, 0xBA, 0xAB }
+    },
+    {
+        "data short ack request",
+        MAC_FRAME_TEMPLATE_DATA_SHORT(PAN_ID, PEER_ADDR, SHORT_ADDR, 1),
+        { .frameType = MAC_FRAME_TYPE_DATA, .ackRequest = true, .panIdCompression = true,
+          .dstAddrMode = MAC_ADDR_MODE_SHORT, .dstPanId = PAN_ID, .dstShortAddr = PEER_ADDR,
+          .srcAddrMode = MAC_ADDR_MODE_SHORT, .srcShortAddr = SHORT_ADDR },
+        9, { 0x61, 0x88, SEQ, 0x00, 0x00, 0x01, 0x00, 0xBA, 0xAB }
+    },
+    {
+        "data extended",
+        MAC_FRAME_TEMPLATE_DATA_EXT(0x1234, PEER_EXT_ADDR, EXT_ADDR, 0),
+        { .frameType = MAC_FRAME_TYPE_DATA, .panIdCompression = true,
+          .dstAddrMode = MAC_ADDR_MODE_EXT, .dstPanId = 0x1234, .dstExtAddr = PEER_EXT_ADDR,
+          .srcAddrMode = MAC_ADDR_MODE_EXT, .srcExtAddr = EXT_ADDR },
+        21, { 0x41, 0xCC, SEQ, 0x34, 0x12,
+              0xD0, 0xC0, 0xB0, 0xA0, 0x00, 0x4B, 0x12, 0x00,
+              0x04, 0x03, 0x02, 0x01, 0x00, 0x4B, 0x12, 0x00 }
+    },
+    {
+        "beacon short",
+        MAC_FRAME_TEMPLATE_BEACON_SHORT(0x1234, SHORT_ADDR),
+        { .frameType = MAC_FRAME_TYPE_BEACON,
+          .srcAddrMode = MAC_ADDR_MODE_SHORT, .srcPanId = 0x1234, .srcShortAddr = SHORT_ADDR },
+        7, { 0x00, 0x80, SEQ, 0x34, 0x12, 0xBA, 0xAB }
+    },
+    {
+        "beacon extended",
+        MAC_FRAME_TEMPLATE_BEACON_EXT(0x1234, EXT_ADDR),
+        { .frameType = MAC_FRAME_TYPE_BEACON,
+          .srcAddrMode = MAC_ADDR_MODE_EXT, .srcPanId = 0x1234, .srcExtAddr = EXT_ADDR },
+        13, { 0x00, 0xC0, SEQ, 0x34, 0x12, 0x04, 0x03, 0x02, 0x01, 0x00, 0x4B, 0x12, 0x00 }
+    },
+    {
+        "command short",
+        MAC_FRAME_TEMPLATE_COMMAND_SHORT(PAN_ID, PEER_ADDR, SHORT_ADDR, 1),
+        { .frameType = MAC_FRAME_TYPE_COMMAND, .ackRequest = true, .panIdCompression = true,
+          .dstAddrMode = MAC_ADDR_MODE_SHORT, .dstPanId = PAN_ID, .dstShortAddr = PEER_ADDR,
+          .srcAddrMode = MAC_ADDR_MODE_SHORT, .srcShortAddr = SHORT_ADDR },
+        9, { 0x63, 0x88, SEQ, 0x00, 0x00, 0x01, 0x00, 0xBA, 0xAB }
+    },
+};
+
+/* Frame length without FCS and its time on air: 6 bytes of preamble, SFD
+ * and PHR, the frame and 2 bytes of FCS at 32 us per byte */
+static const struct
+{
+    uint8_t length;
+    uint32_t us;
+} airCases[] =
+{
+    { 3,   352 },                   /* ACK */
+    { 9,   544 },                   /* Empty data frame, short addresses */
+    { 30,  1216 },                  /* PAYLOAD_LENGTH of rfPacketTx.c */
+    { MAC_FRAME_MAX_LENGTH, 4256 }, /* aMaxPHYPacketSize */
+};
+
+/***** Function definitions *****/
+
+static void printBytes(const char *what, const uint8_t *buf, uint8_t length)
+{
+    uint8_t i;
+
+    printf("  %-8s", what);
+    for (i = 0; i < length; i++)
+    {
+        printf(" %02X", buf[i]);
+    }
+    printf("\n");
+}
+
+static bool checkHeader(const char *name, const char *how, const MacFrame_Template *tmpl,
+                        const HeaderCase *c)
+{
+    uint8_t buf[MAC_FRAME_MAX_HDR_LENGTH + 1];
+
+    memset(buf, 0xEE, sizeof(buf));
+    uint8_t *payload = MacFrame_writeHeader(tmpl, SEQ, buf);
+
+    if ((tmpl->hdrLen != c->hdrLen) || (payload != buf + c->hdrLen) ||
+        (memcmp(buf, c->hdr, c->hdrLen) != 0) || (buf[c->hdrLen] != 0xEE))
+    {
+        printf("macFrame: %s from %s: hdrLen %u, expected %u\n", name, how, tmpl->hdrLen, c->hdrLen);
+        printBytes("written", buf, (uint8_t)(tmpl->hdrLen + 1));
+        printBytes("expected", c->hdr, c->hdrLen);
+        return false;
+    }
+    if ((MacFrame_getSeq(buf) != SEQ) || (MacFrame_getType(buf) != c->params.frameType))
+    {
+        printf("macFrame: %s from %s: sequence number or frame type\n", name, how);
+        return false;
+    }
+
+    return true;
+}
+
+static bool checkHeaders(void)
+{
+    MacFrame_Template tmpl;
+    bool ok = true;
+    size_t i;
+
+    for (i = 0; i < sizeof(headerCases) / sizeof(headerCases[0]); i++)
+    {
+        const HeaderCase *c = &headerCases[i];
+
+        ok &= checkHeader(c->name, "template", &c->tmpl, c);
+
+        memset(&tmpl, 0, sizeof(tmpl));
+        if (!MacFrame_initTemplate(&tmpl, &c->params))
+        {
+            printf("macFrame: %s: MacFrame_initTemplate() failed\n", c->name);
+            ok = false;
+            continue;
+        }
+        ok &= checkHeader(c->name, "params", &tmpl, c);
+    }
+
+    /* Reserved addressing mode */
+    MacFrame_Params params = { .dstAddrMode = 1, .srcAddrMode = MAC_ADDR_MODE_SHORT };
+    if (MacFrame_initTemplate(&tmpl, &params))
+    {
+        printf("macFrame: reserved addressing mode accepted\n");
+        ok = false;
+    }
+
+    return ok;
+}
+
+static bool checkBuild(void)
+{
+    static const MacFrame_Template tmpl =
+        MAC_FRAME_TEMPLATE_DATA_SHORT(PAN_ID, MAC_BROADCAST_ADDR, SHORT_ADDR, 0);
+    uint8_t payload[MAC_FRAME_MAX_LENGTH];
+    uint8_t buf[MAC_FRAME_MAX_LENGTH];
+    uint8_t maxPayload = MAC_FRAME_MAX_LENGTH - 9;
+    uint8_t i;
+
+    for (i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = i;
+    }
+
+    if ((MacFrame_build(&tmpl, SEQ, payload, maxPayload, buf) != MAC_FRAME_MAX_LENGTH) ||
+        (memcmp(buf, headerCases[0].hdr, 9) != 0) || (memcmp(buf + 9, payload, maxPayload) != 0))
+    {
+        printf("macFrame: largest frame not built\n");
+        return false;
+    }
+    if (MacFrame_build(&tmpl, SEQ, payload, maxPayload + 1, buf) != 0)
+    {
+        printf("macFrame: frame over %u bytes built\n", MAC_FRAME_MAX_LENGTH);
+        return false;
+    }
+    if (MacFrame_build(&tmpl, SEQ, payload, 0, buf) != 9)
+    {
+        printf("macFrame: header only frame\n");
+        return false;
+    }
+
+    return true;
+}
+
+static bool checkAirTime(void)
+{
+    bool ok = true;
+    size_t i;
+
+    for (i = 0; i < sizeof(airCases) / sizeof(airCases[0]); i++)
+    {
+        uint32_t us = MAC_FRAME_AIR_US(airCases[i].length);
+        if (us != airCases[i].us)
+        {
+            printf("macFrame: %u byte frame on air %u us, expected %u\n",
+                   airCases[i].length, us, airCases[i].us);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = checkHeaders();
+    ok &= checkBuild();
+    ok &= checkAirTime();
+
+    printf("macFrame: %s\n", ok ? "ok" : "FAILED");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+ *  ======== payloadBench.c ========
+ *  Host check and benchmark of the payload generator (payloadGen.c in the
+ *  CCS project).
+ *
+ *  Checks every pattern against a bit by bit reference, including that a
+ *  sequence split over frames of random length is the same as one long
+ *  fill and that the PRBS periods are 511 and 32767 bits, then times each
+ *  pattern filling frames of the given length and prints ns per byte,
+ *  next to the bit by bit reference for the PRBS.
+ *
+ *  Usage: payloadBench [-l frameLength] [-m megabytes]
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "payloadGen.h"
+
+/***** Defines *****/
+#define MAX_LENGTH              125     /* Largest MAC payload */
+#define CHECK_BYTES             8192
+
+/***** Function definitions *****/
+
+/* One bit per step, the way the polynomials are written down */
+static void referenceFill(PayloadGen_Pattern pattern, uint32_t *reg, uint8_t *buf, uint32_t length)
+{
+    uint32_t i;
+    uint8_t k;
+
+    for (i = 0; i < length; i++)
+    {
+        uint8_t out = 0;
+        for (k = 0; k < 8; k++)
+        {
+            uint32_t bit;
+            if (pattern == PAYLOAD_GEN_PRBS9)
+            {
+                bit = ((*reg >> 0) ^ (*reg >> 4)) & 1;      /* x^9 + x^5 + 1 */
+                *reg = (*reg >> 1) | (bit << 8);
+            }
+            else
+            {
+                bit = ((*reg >> 0) ^ (*reg >> 1)) & 1;      /* x^15 + x^14 + 1 */
+                *reg = (*reg >> 1) | (bit << 14);
+            }
+            out |= (uint8_t)(bit << k);
+        }
+        buf[i] = out;
+    }
+}
+
+static double nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static bool check(PayloadGen_Pattern pattern)
+{
+    static uint8_t whole[CHECK_BYTES];
+    static uint8_t split[CHECK_BYTES];
+    static uint8_t reference[CHECK_BYTES];
+    PayloadGen_Object gen;
+    uint32_t i;
+
+    /* One long fill */
+    PayloadGen_init(&gen, pattern, 0x5A);
+    PayloadGen_fill(&gen, whole, CHECK_BYTES);
+
+    /* The same sequence in frames of 1 to MAX_LENGTH bytes */
+    PayloadGen_init(&gen, pattern, 0x5A);
+    srand(1);
+    for (i = 0; i < CHECK_BYTES; )
+    {
+        uint32_t length = 1 + (uint32_t)rand() % MAX_LENGTH;
+        if (length > CHECK_BYTES - i)
+        {
+            length = CHECK_BYTES - i;
+        }
+        PayloadGen_fill(&gen, &split[i], length);
+        i += length;
+    }
+    if (memcmp(whole, split, CHECK_BYTES) != 0)
+    {
+        printf("%s: split fill differs\n", PayloadGen_getName(pattern));
+        return false;
+    }
+
+    /* Against the reference */
+    switch (pattern)
+    {
+        case PAYLOAD_GEN_FIXED:
+            memset(reference, 0x5A, CHECK_BYTES);
+            break;
+        case PAYLOAD_GEN_COUNTER:
+            for (i = 0; i < CHECK_BYTES; i++)
+            {
+                reference[i] = (uint8_t)(0x5A + i);
+            }
+            break;
+        default:
+        {
+            uint32_t reg = 0x5A;
+            referenceFill(pattern, &reg, reference, CHECK_BYTES);
+            break;
+        }
+    }
+    if (memcmp(whole, reference, CHECK_BYTES) != 0)
+    {
+        printf("%s: differs from the reference\n", PayloadGen_getName(pattern));
+        return false;
+    }
+
+    /* PRBS period: the sequence repeats after 2^n - 1 bits and not before.
+     * 8 x period bits are a whole number of bytes. */
+    if ((pattern == PAYLOAD_GEN_PRBS9) || (pattern == PAYLOAD_GEN_PRBS15))
+    {
+        uint32_t period = (pattern == PAYLOAD_GEN_PRBS9) ? 511 : 32767;
+        uint32_t periodBytes = period;     /* 8 periods in bytes */
+        uint8_t *seq = malloc(2 * periodBytes);
+        PayloadGen_init(&gen, pattern, 1);
+        PayloadGen_fill(&gen, seq, 2 * periodBytes);
+        bool repeats = (memcmp(seq, &seq[periodBytes], periodBytes) == 0);
+        uint32_t ones = 0;
+        for (i = 0; i < periodBytes; i++)
+        {
+            ones += (uint32_t)__builtin_popcount(seq[i]);
+        }
+        free(seq);
+        /* A maximal length sequence has 2^(n-1) ones per period */
+        if (!repeats || (ones != 8 * ((period + 1) / 2)))
+        {
+            printf("%s: not a maximal length sequence\n", PayloadGen_getName(pattern));
+            return false;
+        }
+    }
+
+    /* A checker in the same state finds no errors, one flipped bit is one */
+    PayloadGen_Object checker;
+    PayloadGen_init(&checker, pattern, 0x5A);
+    whole[100] ^= 0x10;
+    uint32_t numErrors = PayloadGen_check(&checker, whole, CHECK_BYTES);
+    if (numErrors != 1)
+    {
+        printf("%s: check found %u bit errors instead of 1\n", PayloadGen_getName(pattern), numErrors);
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t length = 30;
+    uint32_t megabytes = 64;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:m:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'l': length = (uint32_t)atoi(optarg); break;
+            case 'm': megabytes = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-l frameLength] [-m megabytes]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((length == 0) || (length > MAX_LENGTH) || (megabytes == 0))
+    {
+        fprintf(stderr, "%s: parameter out of range\n", argv[0]);
+        return 1;
+    }
+
+    PayloadGen_Pattern pattern;
+    bool ok = true;
+    for (pattern = PAYLOAD_GEN_FIXED; pattern < PAYLOAD_GEN_COUNT; pattern++)
+    {
+        ok = check(pattern) && ok;
+    }
+    if (!ok)
+    {
+        return 1;
+    }
+
+    uint64_t numFrames = ((uint64_t)megabytes << 20) / length;
+    static uint8_t buf[MAX_LENGTH];
+    volatile uint8_t sink = 0;
+
+    printf("pattern,frame_bytes,ns_per_byte,reference_ns_per_byte\n");
+    for (pattern = PAYLOAD_GEN_FIXED; pattern < PAYLOAD_GEN_COUNT; pattern++)
+    {
+        PayloadGen_Object gen;
+        uint64_t i;
+
+        PayloadGen_init(&gen, pattern, 0);
+        double start = nowNs();
+        for (i = 0; i < numFrames; i++)
+        {
+            PayloadGen_fill(&gen, buf, length);
+            sink ^= buf[i % length];
+        }
+        double ns = (nowNs() - start) / ((double)numFrames * length);
+
+        printf("%s,%u,%.3f,", PayloadGen_getName(pattern), length, ns);
+        if ((pattern == PAYLOAD_GEN_PRBS9) || (pattern == PAYLOAD_GEN_PRBS15))
+        {
+            uint32_t reg = 1;
+            start = nowNs();
+            for (i = 0; i < numFrames; i++)
+            {
+                referenceFill(pattern, &reg, buf, length);
+                sink ^= buf[i % length];
+            }
+            printf("%.3f\n", (nowNs() - start) / ((double)numFrames * length));
+        }
+        else
+        {
+            printf("\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/bin/sh
+#
+#  Builds the firmware for the host simulation.
+#
+#  Usage: build.sh [output] [extra compiler flags]
+#  e.g.   build.sh rfSim-ack -DTX_MODE=4
+#
+set -e
+
+SIM=$(cd "$(dirname "$0")" && pwd)
+FW="$SIM/../../rfPacketTx_CC1352P_2_LAUNCHXL_tirtos_ccs"
+OUT=${1:-rfSim}
+[ $# -gt 0 ] && shift
+
+FW_SRCS=$(ls "$FW"/*.c | grep -v '/main_tirtos\.c$')
+
+${CC:-cc} -std=c11 -D_DEFAULT_SOURCE -O2 -g -Wall \
+    -DDeviceFamily_CC13X2_CC26X2 \
+    -I"$SIM" -I"$SIM/include" -I"$FW" -I"$FW/syscfg" \
+    "$@" \
+    -o "$OUT" \
+    "$SIM"/*.c $FW_SRCS "$FW/syscfg/ti_radio_config.c" "$FW/syscfg/ti_drivers_config.c"
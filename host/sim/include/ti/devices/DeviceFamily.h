@@ -0,0 +1,11 @@
+/*
+ *  ======== DeviceFamily.h ========
+ *  Host stand-in: every device family maps to the CC13x2/CC26x2 headers.
+ */
+#ifndef ti_devices_DeviceFamily__include
+#define ti_devices_DeviceFamily__include
+
+#define DeviceFamily_DIRECTORY          cc13x2_cc26x2
+#define DeviceFamily_constructPath(x)   <ti/devices/cc13x2_cc26x2/x>
+
+#endif /* ti_devices_DeviceFamily__include */
@@ -0,0 +1,18 @@
+/*
+ *  ======== aon_rtc.h ========
+ *  Host stand-in: the RTC runs from the start of the simulation and is
+ *  read off the simulated time (simPower.c).
+ */
+#ifndef __AON_RTC_H__
+#define __AON_RTC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern void AONRTCEnable(void);
+extern bool AONRTCActive(void);
+
+/* Seconds in the upper 16 bits, 1/65536 seconds in the lower */
+extern uint32_t AONRTCCurrentCompareValueGet(void);
+
+#endif /* __AON_RTC_H__ */
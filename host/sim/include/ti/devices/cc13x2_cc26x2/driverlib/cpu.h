@@ -0,0 +1,15 @@
+/*
+ *  ======== cpu.h ========
+ *  Host stand-in: busy waits take no simulated time.
+ */
+#ifndef __CPU_H__
+#define __CPU_H__
+
+#include <stdint.h>
+
+static inline void CPUdelay(uint32_t ui32Count)
+{
+    (void)ui32Count;
+}
+
+#endif /* __CPU_H__ */
@@ -0,0 +1,47 @@
+/*
+ *  ======== ioc.h ========
+ *  Host stand-in: IO identifiers and the UART port IDs.
+ */
+#ifndef __IOC_H__
+#define __IOC_H__
+
+#define IOID_0      0x00000000
+#define IOID_1      0x00000001
+#define IOID_2      0x00000002
+#define IOID_3      0x00000003
+#define IOID_4      0x00000004
+#define IOID_5      0x00000005
+#define IOID_6      0x00000006
+#define IOID_7      0x00000007
+#define IOID_8      0x00000008
+#define IOID_9      0x00000009
+#define IOID_10     0x0000000A
+#define IOID_11     0x0000000B
+#define IOID_12     0x0000000C
+#define IOID_13     0x0000000D
+#define IOID_14     0x0000000E
+#define IOID_15     0x0000000F
+#define IOID_16     0x00000010
+#define IOID_17     0x00000011
+#define IOID_18     0x00000012
+#define IOID_19     0x00000013
+#define IOID_20     0x00000014
+#define IOID_21     0x00000015
+#define IOID_22     0x00000016
+#define IOID_23     0x00000017
+#define IOID_24     0x00000018
+#define IOID_25     0x00000019
+#define IOID_26     0x0000001A
+#define IOID_27     0x0000001B
+#define IOID_28     0x0000001C
+#define IOID_29     0x0000001D
+#define IOID_30     0x0000001E
+#define IOID_31     0x0000001F
+#define IOID_UNUSED 0xFFFFFFFF
+
+#define IOC_PORT_MCU_UART0_RX   0x0000000F
+#define IOC_PORT_MCU_UART0_TX   0x00000010
+#define IOC_PORT_MCU_UART0_CTS  0x00000011
+#define IOC_PORT_MCU_UART0_RTS  0x00000012
+
+#endif /* __IOC_H__ */
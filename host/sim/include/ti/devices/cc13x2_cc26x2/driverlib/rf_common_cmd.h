@@ -0,0 +1,103 @@
+/*
+ *  ======== rf_common_cmd.h ========
+ *  Host stand-in for the common RF core commands. Field names follow the
+ *  device headers; the layout is not bit-exact.
+ */
+#ifndef __COMMON_CMD_H
+#define __COMMON_CMD_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+
+#define CMD_NOP                     0x0801
+#define CMD_RADIO_SETUP             0x0802
+#define CMD_FS                      0x0803
+#define CMD_FS_OFF                  0x0804
+#define CMD_RADIO_SETUP_PA          CMD_RADIO_SETUP
+#define CMD_BLE5_RADIO_SETUP        0x1820
+#define CMD_PROP_RADIO_DIV_SETUP    0x3807
+#define CMD_SET_TX_POWER            0x0010
+#define CMD_SET_TX20_POWER          0x0014
+
+/* Header shared by all radio operation commands */
+#define RFC_RADIO_OP_HEADER     \
+    uint16_t commandNo;         \
+    uint16_t status;            \
+    uint8_t *pNextOp;           \
+    ratmr_t startTime;          \
+    rfc_trig_t startTrigger;    \
+    rfc_cond_t condition;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+} rfc_radioOp_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint8_t mode;
+    uint8_t loDivider;
+    struct
+    {
+        uint16_t frontEndMode:3;
+        uint16_t biasMode:1;
+        uint16_t analogCfgMode:6;
+        uint16_t bNoFsPowerUp:1;
+    } config;
+    uint16_t txPower;
+    uint32_t *pRegOverride;
+} rfc_CMD_RADIO_SETUP_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint8_t mode;
+    uint8_t loDivider;
+    struct
+    {
+        uint16_t frontEndMode:3;
+        uint16_t biasMode:1;
+        uint16_t analogCfgMode:6;
+        uint16_t bNoFsPowerUp:1;
+    } config;
+    uint16_t txPower;
+    uint32_t *pRegOverride;
+    uint32_t *pRegOverrideTxStd;
+    uint32_t *pRegOverrideTx20;
+} rfc_CMD_RADIO_SETUP_PA_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint16_t modulation;
+    uint16_t symbolRate;
+    uint8_t rxBw;
+    uint8_t preamConf;
+    uint16_t formatConf;
+    uint16_t config;
+    uint16_t txPower;
+    uint32_t *pRegOverride;
+    uint16_t centerFreq;
+    uint16_t intFreq;
+    uint8_t loDivider;
+} rfc_CMD_PROP_RADIO_DIV_SETUP_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint16_t frequency;
+    uint16_t fractFreq;
+    struct
+    {
+        uint8_t bTxMode:1;
+        uint8_t refFreq:6;
+    } synthConf;
+    uint8_t __dummy0;
+    uint8_t __dummy1;
+    uint8_t __dummy2;
+    uint16_t __dummy3;
+} rfc_CMD_FS_t;
+
+#endif /* __COMMON_CMD_H */
@@ -0,0 +1,53 @@
+/*
+ *  ======== rf_data_entry.h ========
+ *  Host stand-in for the RF core data entry structures.
+ */
+#ifndef __DATA_ENTRY_H
+#define __DATA_ENTRY_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+
+typedef struct
+{
+    uint8_t *pNextEntry;
+    uint8_t status;
+    struct
+    {
+        uint8_t type:2;
+        uint8_t lenSz:2;
+        uint8_t irqIntv:4;
+    } config;
+    uint16_t length;
+} rfc_dataEntry_t;
+
+typedef struct
+{
+    uint8_t *pNextEntry;
+    uint8_t status;
+    struct
+    {
+        uint8_t type:2;
+        uint8_t lenSz:2;
+        uint8_t irqIntv:4;
+    } config;
+    uint16_t length;
+    uint8_t data;
+} rfc_dataEntryGeneral_t;
+
+typedef struct
+{
+    uint8_t *pNextEntry;
+    uint8_t status;
+    struct
+    {
+        uint8_t type:2;
+        uint8_t lenSz:2;
+        uint8_t irqIntv:4;
+    } config;
+    uint16_t length;
+    uint8_t *pData;
+} rfc_dataEntryPointer_t;
+
+#endif /* __DATA_ENTRY_H */
@@ -0,0 +1,164 @@
+/*
+ *  ======== rf_ieee_cmd.h ========
+ *  Host stand-in for the IEEE 802.15.4 radio commands. Field names follow
+ *  the device headers; the layout is not bit-exact.
+ */
+#ifndef __IEEE_CMD_H
+#define __IEEE_CMD_H
+
+#include <stdint.h>
+
+#include "rf_mailbox.h"
+#include "rf_common_cmd.h"
+#include "rf_ieee_mailbox.h"
+
+#define CMD_IEEE_RX             0x2801
+#define CMD_IEEE_ED_SCAN        0x2802
+#define CMD_IEEE_TX             0x2C01
+#define CMD_IEEE_CSMA           0x2C02
+#define CMD_IEEE_RX_ACK         0x2C03
+#define CMD_IEEE_ABORT_BG       0x2C04
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    struct
+    {
+        uint8_t bIncludePhyHdr:1;
+        uint8_t bIncludeCrc:1;
+        uint8_t :1;
+        uint8_t payloadLenMsb:5;
+    } txOpt;
+    uint8_t payloadLen;
+    uint8_t *pPayload;
+    ratmr_t timeStamp;
+} rfc_CMD_IEEE_TX_t;
+
+typedef struct
+{
+    uint8_t nTxAck;
+    uint8_t nBeacon;
+    uint8_t nTxData;
+    uint8_t nTxAck2;
+    uint8_t nRxNok;
+    uint8_t nRxIgnored;
+    uint8_t nRxBufFull;
+    int8_t lastRssi;
+    int8_t maxRssi;
+    uint8_t __dummy0;
+    ratmr_t beaconTimeStamp;
+    uint8_t nRxBeacon;
+    uint8_t nRxData;
+    uint8_t nRxAck;
+    uint8_t nRxMacCmd;
+    uint8_t nRxReserved;
+} rfc_ieeeRxOutput_t;
+
+/* Appended to received frames with rxConfig.bAppendCorrCrc */
+typedef struct
+{
+    struct
+    {
+        uint8_t corr:6;
+        uint8_t bIgnore:1;
+        uint8_t bCrcErr:1;
+    } status;
+} rfc_ieeeRxCorrCrc_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint8_t channel;
+    struct
+    {
+        uint8_t bAutoFlushCrc:1;
+        uint8_t bAutoFlushIgn:1;
+        uint8_t bIncludePhyHdr:1;
+        uint8_t bIncludeCrc:1;
+        uint8_t bAppendRssi:1;
+        uint8_t bAppendCorrCrc:1;
+        uint8_t bAppendSrcInd:1;
+        uint8_t bAppendTimestamp:1;
+    } rxConfig;
+    dataQueue_t *pRxQ;
+    rfc_ieeeRxOutput_t *pOutput;
+    struct
+    {
+        uint16_t frameFiltEn:1;
+        uint16_t frameFiltStop:1;
+        uint16_t autoAckEn:1;
+        uint16_t slottedAckEn:1;
+        uint16_t autoPendEn:1;
+        uint16_t defaultPend:1;
+        uint16_t bPendDataReqOnly:1;
+        uint16_t bPanCoord:1;
+        uint16_t maxFrameVersion:2;
+        uint16_t fcfReservedMask:3;
+        uint16_t modifyFtFilter:2;
+        uint16_t bStrictLenFilter:1;
+    } frameFiltOpt;
+    struct
+    {
+        uint8_t bAcceptFt0Beacon:1;
+        uint8_t bAcceptFt1Data:1;
+        uint8_t bAcceptFt2Ack:1;
+        uint8_t bAcceptFt3MacCmd:1;
+        uint8_t bAcceptFt4Reserved:1;
+        uint8_t bAcceptFt5Reserved:1;
+        uint8_t bAcceptFt6Reserved:1;
+        uint8_t bAcceptFt7Reserved:1;
+    } frameTypes;
+    struct
+    {
+        uint8_t ccaEnEnergy:1;
+        uint8_t ccaEnCorr:1;
+        uint8_t ccaEnSync:1;
+        uint8_t ccaCorrOp:1;
+        uint8_t ccaSyncOp:1;
+        uint8_t ccaCorrThr:2;
+    } ccaOpt;
+    int8_t ccaRssiThr;
+    uint8_t __dummy0;
+    uint8_t numExtEntries;
+    uint8_t numShortEntries;
+    uint32_t *pExtEntryList;
+    uint32_t *pShortEntryList;
+    uint64_t localExtAddr;
+    uint16_t localShortAddr;
+    uint16_t localPanID;
+    uint16_t __dummy1;
+    uint8_t __dummy2;
+    rfc_trig_t endTrigger;
+    ratmr_t endTime;
+} rfc_CMD_IEEE_RX_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint16_t randomState;
+    uint8_t macMaxBE;
+    uint8_t macMaxCSMABackoffs;
+    struct
+    {
+        uint8_t initCW:5;
+        uint8_t bSlotted:1;
+        uint8_t rxOffMode:2;
+    } csmaConfig;
+    uint8_t NB;
+    uint8_t BE;
+    uint8_t remainingPeriods;
+    int8_t lastRssi;
+    rfc_trig_t endTrigger;
+    ratmr_t lastTimeStamp;
+    ratmr_t endTime;
+} rfc_CMD_IEEE_CSMA_t;
+
+typedef struct
+{
+    RFC_RADIO_OP_HEADER
+    uint8_t seqNo;
+    rfc_trig_t endTrigger;
+    ratmr_t endTime;
+} rfc_CMD_IEEE_RX_ACK_t;
+
+#endif /* __IEEE_CMD_H */
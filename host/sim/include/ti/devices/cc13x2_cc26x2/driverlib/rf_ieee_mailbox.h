@@ -0,0 +1,26 @@
+/*
+ *  ======== rf_ieee_mailbox.h ========
+ *  Host stand-in for the IEEE 802.15.4 command status codes.
+ */
+#ifndef __IEEE_MAILBOX_H
+#define __IEEE_MAILBOX_H
+
+/* Operation finished normally */
+#define IEEE_DONE_OK            0x2400
+#define IEEE_DONE_BUSY          0x2401
+#define IEEE_DONE_STOPPED       0x2402
+#define IEEE_DONE_ACK           0x2403
+#define IEEE_DONE_ACKPEND       0x2404
+#define IEEE_DONE_TIMEOUT       0x2405
+#define IEEE_DONE_BGEND         0x2406
+#define IEEE_DONE_ABORT         0x2407
+
+/* Operation finished with error */
+#define IEEE_ERROR_PAR          0x2800
+#define IEEE_ERROR_NO_SETUP     0x2801
+#define IEEE_ERROR_NO_FS        0x2802
+#define IEEE_ERROR_SYNTH_PROG   0x2803
+#define IEEE_ERROR_RXOVF        0x2804
+#define IEEE_ERROR_TXUNF        0x2805
+
+#endif /* __IEEE_MAILBOX_H */
@@ -0,0 +1,107 @@
+/*
+ *  ======== rf_mailbox.h ========
+ *  Host stand-in for the RF core mailbox definitions: command status
+ *  codes, triggers, conditions and data queue entries.
+ */
+#ifndef __MAILBOX_H
+#define __MAILBOX_H
+
+#include <stdint.h>
+
+/* Radio timer (RAT) time, 4 MHz */
+typedef uint32_t ratmr_t;
+
+/* Radio operation status: operation not finished */
+#define IDLE                    0x0000
+#define PENDING                 0x0001
+#define ACTIVE                  0x0002
+#define SKIPPED                 0x0003
+
+/* Radio operation status: operation finished normally */
+#define DONE_OK                 0x0400
+#define DONE_COUNTDOWN          0x0401
+#define DONE_RXERR              0x0402
+#define DONE_TIMEOUT            0x0403
+#define DONE_STOPPED            0x0404
+#define DONE_ABORT              0x0405
+#define DONE_FAILED             0x0406
+
+/* Radio operation status: operation did not finish */
+#define ERROR_PAST_START        0x0800
+#define ERROR_START_TRIG        0x0801
+#define ERROR_CONDITION         0x0802
+#define ERROR_PAR               0x0803
+#define ERROR_POINTER           0x0804
+#define ERROR_CMDID             0x0805
+#define ERROR_WRONG_BG          0x0806
+#define ERROR_NO_SETUP          0x0807
+#define ERROR_NO_FS             0x0808
+#define ERROR_SYNTH_PROG        0x0809
+#define ERROR_TXUNF             0x080A
+#define ERROR_RXOVF             0x080B
+#define ERROR_NO_RX             0x080C
+#define ERROR_PENDING           0x080D
+
+/* Trigger types */
+#define TRIG_NOW                0
+#define TRIG_NEVER              1
+#define TRIG_ABSTIME            2
+#define TRIG_REL_SUBMIT         3
+#define TRIG_REL_START          4
+#define TRIG_REL_PREVSTART      5
+#define TRIG_REL_FIRSTSTART     6
+#define TRIG_REL_PREVEND        7
+#define TRIG_REL_EVT1           8
+#define TRIG_REL_EVT2           9
+#define TRIG_EXTERNAL           10
+#define TRIG_PAST_BM            0x80
+
+/* Conditions for running the next command */
+#define COND_ALWAYS             0
+#define COND_NEVER              1
+#define COND_STOP_ON_FALSE      2
+#define COND_STOP_ON_TRUE       3
+#define COND_SKIP_ON_FALSE      4
+#define COND_SKIP_ON_TRUE       5
+
+/* Register overrides, as used by the SysConfig override lists */
+#define HW_REG_OVERRIDE(addr, val)          ((((uintptr_t)(addr)) & 0xFFFC) | ((uint32_t)(val) << 16))
+#define ADI_REG_OVERRIDE(adiNo, addr, val)  (2 | ((uint32_t)(val) << 16) | \
+                                             (((addr) & 0x3F) << 24) | (((adiNo) ? 1u : 0) << 31))
+#define TX_STD_POWER_OVERRIDE(txPower)      ((uint32_t)0x000C | ((uint32_t)(txPower) << 16))
+#define TX20_POWER_OVERRIDE(txPower)        0x0000002D, ((uint32_t)(txPower))
+
+/* Data entry status */
+#define DATA_ENTRY_PENDING      0
+#define DATA_ENTRY_ACTIVE       1
+#define DATA_ENTRY_BUSY         2
+#define DATA_ENTRY_FINISHED     3
+#define DATA_ENTRY_UNFINISHED   4
+
+/* Data entry types */
+#define DATA_ENTRY_TYPE_GEN     0
+#define DATA_ENTRY_TYPE_MULTI   1
+#define DATA_ENTRY_TYPE_PTR     2
+#define DATA_ENTRY_TYPE_PARTIAL 3
+
+typedef struct
+{
+    uint8_t triggerType:4;
+    uint8_t bEnaCmd:1;
+    uint8_t triggerNo:2;
+    uint8_t pastTrig:1;
+} rfc_trig_t;
+
+typedef struct
+{
+    uint8_t rule:4;
+    uint8_t nSkip:4;
+} rfc_cond_t;
+
+typedef struct
+{
+    uint8_t *pCurrEntry;
+    uint8_t *pLastEntry;
+} dataQueue_t;
+
+#endif /* __MAILBOX_H */
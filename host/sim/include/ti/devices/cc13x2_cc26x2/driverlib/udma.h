@@ -0,0 +1,12 @@
+/*
+ *  ======== udma.h ========
+ *  Host stand-in: channel numbers only.
+ */
+#ifndef __UDMA_H__
+#define __UDMA_H__
+
+#define UDMA_CHAN_UART0_RX      1
+#define UDMA_CHAN_UART0_TX      2
+#define UDMA_ALT_SELECT         0x00000020
+
+#endif /* __UDMA_H__ */
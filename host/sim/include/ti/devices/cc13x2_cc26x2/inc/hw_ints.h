@@ -0,0 +1,11 @@
+/*
+ *  ======== hw_ints.h ========
+ *  Host stand-in: interrupt numbers used by ti_drivers_config.c.
+ */
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+#define INT_UART0_COMB          21
+#define INT_DMA_ERR             36
+
+#endif /* __HW_INTS_H__ */
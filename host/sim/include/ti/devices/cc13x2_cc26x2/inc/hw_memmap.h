@@ -0,0 +1,11 @@
+/*
+ *  ======== hw_memmap.h ========
+ *  Host stand-in: peripheral base addresses used by ti_drivers_config.c.
+ */
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+#define UART0_BASE              0x40001000
+#define UDMA0_BASE              0x40020000
+
+#endif /* __HW_MEMMAP_H__ */
@@ -0,0 +1,10 @@
+/*
+ *  ======== rf_patch_cpe_ieee_802_15_4.h ========
+ *  Host stand-in: the simulated radio needs no CPE patch.
+ */
+#ifndef _RF_PATCH_CPE_IEEE_802_15_4_H
+#define _RF_PATCH_CPE_IEEE_802_15_4_H
+
+extern void rf_patch_cpe_ieee_802_15_4(void);
+
+#endif /* _RF_PATCH_CPE_IEEE_802_15_4_H */
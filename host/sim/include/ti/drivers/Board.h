@@ -0,0 +1,10 @@
+/*
+ *  ======== Board.h ========
+ *  Host stand-in.
+ */
+#ifndef ti_drivers_Board__include
+#define ti_drivers_Board__include
+
+extern void Board_init(void);
+
+#endif /* ti_drivers_Board__include */
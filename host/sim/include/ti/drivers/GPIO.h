@@ -0,0 +1,20 @@
+/*
+ *  ======== GPIO.h ========
+ *  Host stand-in: types for the GPIO tables in ti_drivers_config.c.
+ */
+#ifndef ti_drivers_GPIO__include
+#define ti_drivers_GPIO__include
+
+#include <stdint.h>
+
+typedef uint32_t GPIO_PinConfig;
+typedef void (*GPIO_CallbackFxn)(uint_least8_t index);
+
+#define GPIO_CFG_OUT_STD        0x00000000
+#define GPIO_CFG_OUT_STR_LOW    0x00000000
+#define GPIO_CFG_OUT_STR_MED    0x00010000
+#define GPIO_CFG_OUT_STR_HIGH   0x00020000
+#define GPIO_CFG_OUT_LOW        0x00000000
+#define GPIO_CFG_OUT_HIGH       0x00080000
+
+#endif /* ti_drivers_GPIO__include */
@@ -0,0 +1,80 @@
+/*
+ *  ======== PIN.h ========
+ *  Host stand-in for the TI PIN driver.
+ *
+ *  The implementation in host/sim/simPin.c keeps the level of every IO in
+ *  memory. Inputs are driven by the simulation (SimPin_setInput()), which
+ *  also raises the configured edge interrupts.
+ */
+#ifndef ti_drivers_PIN__include
+#define ti_drivers_PIN__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint32_t PIN_Config;
+typedef uint32_t PIN_Id;
+typedef uint32_t PIN_Status;
+
+typedef struct PIN_State_s PIN_State;
+typedef PIN_State *PIN_Handle;
+
+typedef void (*PIN_IntCb)(PIN_Handle handle, PIN_Id pinId);
+
+struct PIN_State_s
+{
+    PIN_IntCb pCbFunc;
+    uint64_t bmPort;
+    uintptr_t userArg;
+};
+
+#define PIN_ID(x)               ((x) & 0xFF)
+#define PIN_TERMINATE           0xFE
+#define PIN_UNASSIGNED          0xFF
+
+/* Input configuration */
+#define PIN_INPUT_EN            (0 << 29)
+#define PIN_INPUT_DIS           (1 << 29)
+#define PIN_HYSTERESIS          (1 << 30)
+#define PIN_NOPULL              (0 << 13)
+#define PIN_PULLUP              (1 << 13)
+#define PIN_PULLDOWN            (2 << 13)
+#define PIN_BM_INPUT_MODE       ((1 << 29) | (1 << 30) | (3 << 13))
+
+/* Output configuration */
+#define PIN_GPIO_OUTPUT_DIS     (0 << 23)
+#define PIN_GPIO_OUTPUT_EN      (1 << 23)
+#define PIN_GPIO_LOW            (0 << 22)
+#define PIN_GPIO_HIGH           (1 << 22)
+#define PIN_PUSHPULL            (0 << 25)
+#define PIN_OPENDRAIN           (2 << 25)
+#define PIN_OPENSOURCE          (3 << 25)
+#define PIN_SLEWCTRL            (1 << 12)
+#define PIN_DRVSTR_MIN          (0 << 8)
+#define PIN_DRVSTR_MED          (4 << 8)
+#define PIN_DRVSTR_MAX          (8 << 8)
+
+/* Interrupt configuration */
+#define PIN_IRQ_DIS             (0 << 16)
+#define PIN_IRQ_NEGEDGE         (5 << 16)
+#define PIN_IRQ_POSEDGE         (6 << 16)
+#define PIN_IRQ_BOTHEDGES       (7 << 16)
+#define PIN_BM_IRQ              (7 << 16)
+
+#define PIN_SUCCESS             0
+#define PIN_ALREADY_ALLOCATED   1
+#define PIN_NO_ACCESS           2
+#define PIN_UNSUPPORTED         3
+
+extern PIN_Status PIN_init(const PIN_Config aPinCfg[]);
+extern PIN_Handle PIN_open(PIN_State *state, const PIN_Config pinList[]);
+extern void PIN_close(PIN_Handle handle);
+extern PIN_Status PIN_registerIntCb(PIN_Handle handle, PIN_IntCb callbackFxn);
+extern PIN_Status PIN_setConfig(PIN_Handle handle, PIN_Config bmMask, PIN_Config pinCfg);
+extern PIN_Status PIN_setInterrupt(PIN_Handle handle, PIN_Config pinCfg);
+extern PIN_Status PIN_clrPendInterrupt(PIN_Handle handle, PIN_Id pinId);
+extern uint_fast8_t PIN_getInputValue(PIN_Id pinId);
+extern PIN_Status PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint_fast8_t val);
+extern uint_fast8_t PIN_getOutputValue(PIN_Id pinId);
+
+#endif /* ti_drivers_PIN__include */
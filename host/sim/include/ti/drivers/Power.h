@@ -0,0 +1,35 @@
+/*
+ *  ======== Power.h ========
+ *  Host stand-in: notifications and dependencies. The simulation enters
+ *  standby itself whenever the firmware waits with the radio off
+ *  (simPower.c).
+ */
+#ifndef ti_drivers_Power__include
+#define ti_drivers_Power__include
+
+#include <stdint.h>
+
+#define Power_SOK                   (0)
+#define Power_EFAIL                 (-1)
+
+#define Power_NOTIFYDONE            (0)
+#define Power_NOTIFYERROR           (-1)
+
+typedef int_fast16_t (*Power_NotifyFxn)(uint_fast16_t eventType, uintptr_t eventArg, uintptr_t clientArg);
+
+typedef struct Power_NotifyObj_s
+{
+    struct Power_NotifyObj_s *next;
+    uint_fast16_t eventTypes;
+    Power_NotifyFxn notifyFxn;
+    uintptr_t clientArg;
+} Power_NotifyObj;
+
+extern int_fast16_t Power_init(void);
+extern int_fast16_t Power_registerNotify(Power_NotifyObj *pNotifyObj, uint_fast16_t eventTypes,
+                                         Power_NotifyFxn notifyFxn, uintptr_t clientArg);
+extern void Power_unregisterNotify(Power_NotifyObj *pNotifyObj);
+extern int_fast16_t Power_setDependency(uint_fast16_t resourceId);
+extern int_fast16_t Power_releaseDependency(uint_fast16_t resourceId);
+
+#endif /* ti_drivers_Power__include */
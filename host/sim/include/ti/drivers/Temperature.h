@@ -0,0 +1,8 @@
+/*
+ *  ======== Temperature.h ========
+ *  Host stand-in: the simulation has no temperature sensor.
+ */
+#ifndef ti_drivers_Temperature__include
+#define ti_drivers_Temperature__include
+
+#endif /* ti_drivers_Temperature__include */
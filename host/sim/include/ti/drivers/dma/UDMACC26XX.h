@@ -0,0 +1,48 @@
+/*
+ *  ======== UDMACC26XX.h ========
+ *  Host stand-in: configuration types for ti_drivers_config.c. The
+ *  simulated UART moves its data without a DMA model.
+ */
+#ifndef ti_drivers_dma_UDMACC26XX__include
+#define ti_drivers_dma_UDMACC26XX__include
+
+#include <stdint.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26X2.h>
+#include <ti/devices/cc13x2_cc26x2/driverlib/udma.h>
+#include <ti/devices/cc13x2_cc26x2/inc/hw_ints.h>
+
+typedef struct
+{
+    volatile void *pvSrcEndAddr;
+    volatile void *pvDstEndAddr;
+    volatile uint32_t ui32Control;
+    volatile uint32_t ui32Spare;
+} tDMAControlTable;
+
+/* One control table entry per channel; the table placement is left to the
+ * host linker */
+#define ALLOCATE_CONTROL_TABLE_ENTRY(ENTRY_NAME, CHANNEL_INDEX) \
+    static volatile tDMAControlTable ENTRY_NAME
+
+typedef struct
+{
+    uint32_t dummy[4];
+} UDMACC26XX_Object;
+
+typedef struct
+{
+    uint32_t baseAddr;
+    uint32_t powerMngrId;
+    uint8_t intNum;
+    uint8_t intPriority;
+} UDMACC26XX_HWAttrs;
+
+typedef struct
+{
+    void *object;
+    const void *hwAttrs;
+} UDMACC26XX_Config;
+
+#endif /* ti_drivers_dma_UDMACC26XX__include */
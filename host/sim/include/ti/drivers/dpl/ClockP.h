@@ -0,0 +1,48 @@
+/*
+ *  ======== ClockP.h ========
+ *  Host stand-in for the DPL clock module. Clocks run on the simulated
+ *  time of host/sim/simKernel.c.
+ */
+#ifndef ti_dpl_ClockP__include
+#define ti_dpl_ClockP__include
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Storage for a clock object, large enough for the simulated one */
+typedef union ClockP_Struct
+{
+    uint64_t dummy[12];
+} ClockP_Struct;
+
+typedef void *ClockP_Handle;
+typedef void (*ClockP_Fxn)(uintptr_t arg);
+
+typedef struct
+{
+    bool startFlag;
+    uint32_t period;
+    uintptr_t arg;
+} ClockP_Params;
+
+typedef enum
+{
+    ClockP_OK = 0,
+    ClockP_FAILURE = -1
+} ClockP_Status;
+
+extern void ClockP_Params_init(ClockP_Params *params);
+extern ClockP_Handle ClockP_construct(ClockP_Struct *clockP, ClockP_Fxn clockFxn,
+                                      uint32_t timeout, ClockP_Params *params);
+extern void ClockP_destruct(ClockP_Struct *clockP);
+extern void ClockP_start(ClockP_Handle handle);
+extern void ClockP_stop(ClockP_Handle handle);
+extern void ClockP_setTimeout(ClockP_Handle handle, uint32_t timeout);
+extern bool ClockP_isActive(ClockP_Handle handle);
+extern uint32_t ClockP_getSystemTicks(void);
+extern uint32_t ClockP_getSystemTickPeriod(void);
+extern void ClockP_usleep(uint32_t usec);
+extern void ClockP_sleep(uint32_t sec);
+
+#endif /* ti_dpl_ClockP__include */
@@ -0,0 +1,16 @@
+/*
+ *  ======== HwiP.h ========
+ *  Host stand-in for the DPL interrupt module. Simulated interrupts only
+ *  run while the application waits, so disabling them is a no-op.
+ */
+#ifndef ti_dpl_HwiP__include
+#define ti_dpl_HwiP__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern uintptr_t HwiP_disable(void);
+extern void HwiP_restore(uintptr_t key);
+extern bool HwiP_inISR(void);
+
+#endif /* ti_dpl_HwiP__include */
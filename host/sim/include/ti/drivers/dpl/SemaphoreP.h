@@ -0,0 +1,47 @@
+/*
+ *  ======== SemaphoreP.h ========
+ *  Host stand-in for the DPL semaphore module. A pend that cannot be
+ *  satisfied runs the simulation until it can.
+ */
+#ifndef ti_dpl_SemaphoreP__include
+#define ti_dpl_SemaphoreP__include
+
+#include <stdint.h>
+
+typedef union SemaphoreP_Struct
+{
+    uint64_t dummy[8];
+} SemaphoreP_Struct;
+
+typedef void *SemaphoreP_Handle;
+
+#define SemaphoreP_WAIT_FOREVER     ~(0)
+#define SemaphoreP_NO_WAIT          (0)
+
+typedef enum
+{
+    SemaphoreP_OK = 0,
+    SemaphoreP_TIMEOUT = -1
+} SemaphoreP_Status;
+
+typedef enum
+{
+    SemaphoreP_Mode_COUNTING = 0x0,
+    SemaphoreP_Mode_BINARY = 0x1
+} SemaphoreP_Mode;
+
+typedef struct
+{
+    SemaphoreP_Mode mode;
+    void (*callback)(void);
+} SemaphoreP_Params;
+
+extern void SemaphoreP_Params_init(SemaphoreP_Params *params);
+extern SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle, unsigned int count,
+                                              SemaphoreP_Params *params);
+extern SemaphoreP_Handle SemaphoreP_constructBinary(SemaphoreP_Struct *handle, unsigned int count);
+extern void SemaphoreP_destruct(SemaphoreP_Struct *semP);
+extern SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout);
+extern void SemaphoreP_post(SemaphoreP_Handle handle);
+
+#endif /* ti_dpl_SemaphoreP__include */
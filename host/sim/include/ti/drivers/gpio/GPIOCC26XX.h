@@ -0,0 +1,23 @@
+/*
+ *  ======== GPIOCC26XX.h ========
+ *  Host stand-in: types for the GPIO tables in ti_drivers_config.c.
+ */
+#ifndef ti_drivers_GPIOCC26XX__include
+#define ti_drivers_GPIOCC26XX__include
+
+#include <stdint.h>
+
+#include <ti/drivers/GPIO.h>
+
+#define GPIOCC26XX_DIO_07   0x0007
+
+typedef struct
+{
+    GPIO_PinConfig *pinConfigs;
+    GPIO_CallbackFxn *callbacks;
+    uint8_t numberOfPinConfigs;
+    uint8_t numberOfCallbacks;
+    uint32_t intPriority;
+} GPIOCC26XX_Config;
+
+#endif /* ti_drivers_GPIOCC26XX__include */
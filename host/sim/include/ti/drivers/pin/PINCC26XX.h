@@ -0,0 +1,29 @@
+/*
+ *  ======== PINCC26XX.h ========
+ *  Host stand-in for the CC26XX PIN driver extensions.
+ */
+#ifndef ti_drivers_PINCC26XX__include
+#define ti_drivers_PINCC26XX__include
+
+#include <stdint.h>
+
+#include <ti/drivers/PIN.h>
+
+typedef struct
+{
+    int8_t intPriority;
+    int8_t swiPriority;
+} PINCC26XX_HWAttrs;
+
+/* IO multiplexer settings used by the antenna switch */
+#define PINCC26XX_MUX_GPIO          (-1)
+#define PINCC26XX_MUX_RFC_GPO0      0x2F
+#define PINCC26XX_MUX_RFC_GPO1      0x30
+#define PINCC26XX_MUX_RFC_GPO2      0x31
+#define PINCC26XX_MUX_RFC_GPO3      0x32
+
+extern PIN_Status PINCC26XX_setMux(PIN_Handle handle, PIN_Id pinId, int32_t muxId);
+extern int32_t PINCC26XX_getMux(PIN_Id pinId);
+extern PIN_Status PINCC26XX_setOutputValue(PIN_Id pinId, uint_fast8_t val);
+
+#endif /* ti_drivers_PINCC26XX__include */
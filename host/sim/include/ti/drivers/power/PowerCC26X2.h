@@ -0,0 +1,34 @@
+/*
+ *  ======== PowerCC26X2.h ========
+ *  Host stand-in: configuration type and peripheral IDs for
+ *  ti_drivers_config.c and the notification events.
+ */
+#ifndef ti_drivers_power_PowerCC26X2__include
+#define ti_drivers_power_PowerCC26X2__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Power_registerNotify() events, as in PowerCC26XX.h */
+#define PowerCC26XX_ENTERING_STANDBY    0x1
+#define PowerCC26XX_ENTERING_SHUTDOWN   0x2
+#define PowerCC26XX_AWAKE_STANDBY       0x4
+#define PowerCC26XX_AWAKE_STANDBY_LATE  0x8
+
+/* Resource IDs */
+#define PowerCC26XX_PERIPH_UART0        0x00000005
+#define PowerCC26XX_PERIPH_UDMA         0x00000008
+#define PowerCC26XX_XOSC_HF             0x00000018
+
+typedef struct
+{
+    bool enablePolicy;
+    void (*policyInitFxn)(void);
+    void (*policyFxn)(void);
+    bool (*calibrateFxn)(unsigned int);
+    bool calibrateRCOSC_LF;
+    bool calibrateRCOSC_HF;
+    void (*enableTCXOFxn)(bool);
+} PowerCC26X2_Config;
+
+#endif /* ti_drivers_power_PowerCC26X2__include */
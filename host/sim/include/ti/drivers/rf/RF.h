@@ -0,0 +1,256 @@
+/*
+ *  ======== RF.h ========
+ *  Host stand-in for the TI RF driver.
+ *
+ *  Declares the part of the RF driver API the firmware uses. The
+ *  implementation in host/sim/simRf.c runs radio operations against a
+ *  virtual radio timer instead of the RF core.
+ */
+#ifndef ti_drivers_rf__include
+#define ti_drivers_rf__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/rf_common_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_mailbox.h)
+
+typedef rfc_radioOp_t RF_Op;
+
+typedef union
+{
+    rfc_radioOp_t commonOp;
+    rfc_CMD_RADIO_SETUP_t common;
+    rfc_CMD_RADIO_SETUP_PA_t common_pa;
+    rfc_CMD_PROP_RADIO_DIV_SETUP_t prop_div;
+} RF_RadioSetup;
+
+typedef uint64_t RF_EventMask;
+typedef int16_t RF_CmdHandle;
+
+typedef struct RF_Object_s RF_Object;
+typedef RF_Object *RF_Handle;
+
+typedef enum
+{
+    RF_StatBusyError,
+    RF_StatRadioInactiveError,
+    RF_StatCmdDoneError,
+    RF_StatInvalidParamsError,
+    RF_StatCmdEnded,
+    RF_StatError = 0x80,
+    RF_StatCmdDoneSuccess,
+    RF_StatCmdSch,
+    RF_StatSuccess
+} RF_Stat;
+
+typedef enum
+{
+    RF_PriorityHighest = 2,
+    RF_PriorityHigh = 1,
+    RF_PriorityNormal = 0
+} RF_Priority;
+
+typedef enum
+{
+    RF_StartNotSpecified = 0,
+    RF_StartAbs = 1
+} RF_StartType;
+
+typedef enum
+{
+    RF_EndNotSpecified = 0,
+    RF_EndAbs = 1,
+    RF_EndRel = 2,
+    RF_EndInfinit = 3
+} RF_EndType;
+
+#define RF_AllowDelayNone   0
+#define RF_AllowDelayAny    UINT32_MAX
+
+typedef struct
+{
+    uint32_t startTime;
+    RF_StartType startType;
+    uint32_t allowDelay;
+    uint32_t endTime;
+    RF_EndType endType;
+    uint32_t duration;
+    uint32_t activityInfo;
+} RF_ScheduleCmdParams;
+
+typedef void (*RF_Callback)(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+typedef void (*RF_ClientCallback)(RF_Handle h, uint32_t event, void *arg);
+
+typedef struct
+{
+    uint32_t nInactivityTimeout;
+    uint32_t nPowerUpDuration;
+    void *pPowerCb;
+    void *pErrCb;
+    uint16_t nPowerUpDurationMargin;
+    uint16_t nPhySwitchingDurationMargin;
+    RF_ClientCallback pClientEventCb;
+    uint32_t nClientEventMask;
+    uint16_t nID;
+} RF_Params;
+
+typedef struct
+{
+    uint8_t rfMode;
+    void (*cpePatchFxn)(void);
+    void (*mcePatchFxn)(void);
+    void (*rfePatchFxn)(void);
+} RF_Mode;
+
+#define RF_MODE_AUTO        0
+
+struct RF_Object_s
+{
+    RF_Mode *pRfMode;
+    RF_RadioSetup *pRadioSetup;
+    RF_Params params;
+};
+
+/* Global driver events, see RFCC26XX_HWAttrsV2.globalCallback */
+typedef uint32_t RF_GlobalEvent;
+#define RF_GlobalEventRadioSetup        (1u << 0)
+#define RF_GlobalEventRadioPowerDown    (1u << 1)
+#define RF_GlobalEventInit              (1u << 2)
+#define RF_GlobalEventCmdStart          (1u << 3)
+#define RF_GlobalEventCmdStop           (1u << 4)
+#define RF_GlobalEventCoexControl       (1u << 5)
+
+typedef void (*RF_GlobalCallback)(RF_Handle h, RF_GlobalEvent event, void *arg);
+
+typedef struct
+{
+    uint8_t hwiPriority;
+    uint8_t swiPriority;
+    bool xoscHfAlwaysNeeded;
+    RF_GlobalCallback globalCallback;
+    RF_GlobalEvent globalEventMask;
+} RFCC26XX_HWAttrsV2;
+
+#define RF_LODIVIDER_MASK               0x7F
+
+/* TX power tables */
+typedef enum
+{
+    RF_TxPowerTable_DefaultPA = 0,
+    RF_TxPowerTable_HighPA = 1
+} RF_TxPowerTable_PAType;
+
+typedef struct
+{
+    uint32_t rawValue:22;
+    uint32_t __dummy:9;
+    uint32_t paType:1;
+} RF_TxPowerTable_Value;
+
+typedef struct
+{
+    int8_t power;
+    RF_TxPowerTable_Value value;
+} __attribute__((packed)) RF_TxPowerTable_Entry;
+
+#define RF_TxPowerTable_MIN_DBM         -128
+#define RF_TxPowerTable_MAX_DBM         126
+#define RF_TxPowerTable_INVALID_DBM     127
+#define RF_TxPowerTable_INVALID_VALUE   0x3fffff
+
+#define RF_TxPowerTable_DEFAULT_PA_ENTRY(bias, gain, boost, coefficient) \
+    { .rawValue = ((bias) << 0) | ((gain) << 6) | ((boost) << 8) | ((coefficient) << 9), \
+      .paType = RF_TxPowerTable_DefaultPA }
+
+#define RF_TxPowerTable_HIGH_PA_ENTRY(bias, ibboost, boost, coefficient, ldoTrim) \
+    { .rawValue = ((bias) << 0) | ((ibboost) << 6) | ((boost) << 8) | ((coefficient) << 9) | ((ldoTrim) << 16), \
+      .paType = RF_TxPowerTable_HighPA }
+
+#define RF_TxPowerTable_TERMINATION_ENTRY \
+    { .power = RF_TxPowerTable_INVALID_DBM, .value = { .rawValue = RF_TxPowerTable_INVALID_VALUE } }
+
+/* Command events */
+#define RF_EventCmdDone                 (1ull << 0)
+#define RF_EventLastCmdDone             (1ull << 1)
+#define RF_EventFGCmdDone               (1ull << 2)
+#define RF_EventLastFGCmdDone           (1ull << 3)
+#define RF_EventTxDone                  (1ull << 4)
+#define RF_EventTXAck                   (1ull << 5)
+#define RF_EventTxCtrl                  (1ull << 6)
+#define RF_EventTxCtrlAck               (1ull << 7)
+#define RF_EventTxCtrlAckAck            (1ull << 8)
+#define RF_EventTxRetrans               (1ull << 9)
+#define RF_EventTxEntryDone             (1ull << 10)
+#define RF_EventTxBufferChange          (1ull << 11)
+#define RF_EventPaChanged               (1ull << 14)
+#define RF_EventRxOk                    (1ull << 16)
+#define RF_EventRxNOk                   (1ull << 17)
+#define RF_EventRxIgnored               (1ull << 18)
+#define RF_EventRxEmpty                 (1ull << 19)
+#define RF_EventRxCtrl                  (1ull << 20)
+#define RF_EventRxCtrlAck               (1ull << 21)
+#define RF_EventRxBufFull               (1ull << 22)
+#define RF_EventRxEntryDone             (1ull << 23)
+#define RF_EventDataWritten             (1ull << 24)
+#define RF_EventNDataWritten            (1ull << 25)
+#define RF_EventRxAborted               (1ull << 26)
+#define RF_EventRxCollisionDetected     (1ull << 27)
+#define RF_EventModulesUnlocked         (1ull << 29)
+#define RF_EventInternalError           (1ull << 31)
+#define RF_EventMdmSoft                 (1ull << 32)
+#define RF_EventCmdCancelled            (1ull << 58)
+#define RF_EventCmdAborted              (1ull << 59)
+#define RF_EventCmdStopped              (1ull << 60)
+#define RF_EventRatCh                   (1ull << 61)
+#define RF_EventPowerUp                 (1ull << 62)
+#define RF_EventError                   (1ull << 63)
+#define RF_EventCmdPreempted            (1ull << 57)
+
+/* RF_cancelCmd() modes */
+#define RF_ABORT_GRACEFULLY             (1 << 0)
+#define RF_ABORT_PREEMPTION             (1 << 2)
+
+/* Special command handles */
+#define RF_CMDHANDLE_FLUSH_ALL          (-1)
+#define RF_ALLOC_ERROR                  (-2)
+#define RF_SCHEDULE_CMD_ERROR           (-3)
+#define RF_ERROR_RAT_PROG               (-4)
+#define RF_ERROR_INVALID_RFMODE         (-5)
+#define RF_ERROR_CMDFS_SYNTH_PROG       (-6)
+
+/* RF_control() commands */
+#define RF_CTRL_SET_INACTIVITY_TIMEOUT          0
+#define RF_CTRL_UPDATE_SETUP_CMD                1
+#define RF_CTRL_SET_POWERUP_DURATION_MARGIN     2
+
+/* The radio timer runs at 4 MHz */
+#define RF_RAT_TICKS_PER_US             4
+#define RF_convertUsToRatTicks(microseconds)    ((microseconds) * RF_RAT_TICKS_PER_US)
+#define RF_convertMsToRatTicks(milliseconds)    ((milliseconds) * 1000 * RF_RAT_TICKS_PER_US)
+#define RF_convertRatTicksToUs(ticks)           ((ticks) / RF_RAT_TICKS_PER_US)
+
+extern void RF_Params_init(RF_Params *params);
+extern void RF_ScheduleCmdParams_init(RF_ScheduleCmdParams *pSchParams);
+extern RF_Handle RF_open(RF_Object *pObj, RF_Mode *pRfMode, RF_RadioSetup *pRadioSetup, RF_Params *params);
+extern void RF_close(RF_Handle h);
+extern uint32_t RF_getCurrentTime(void);
+extern RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op *pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent);
+extern RF_CmdHandle RF_scheduleCmd(RF_Handle h, RF_Op *pOp, RF_ScheduleCmdParams *pSchParams,
+                                   RF_Callback pCb, RF_EventMask bmEvent);
+extern RF_EventMask RF_pendCmd(RF_Handle h, RF_CmdHandle ch, RF_EventMask bmEvent);
+extern RF_EventMask RF_runCmd(RF_Handle h, RF_Op *pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent);
+extern RF_EventMask RF_runScheduleCmd(RF_Handle h, RF_Op *pOp, RF_ScheduleCmdParams *pSchParams,
+                                      RF_Callback pCb, RF_EventMask bmEvent);
+extern RF_Stat RF_cancelCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode);
+extern RF_Stat RF_flushCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode);
+extern void RF_yield(RF_Handle h);
+extern RF_Stat RF_control(RF_Handle h, int8_t ctrl, void *args);
+extern RF_Op *RF_getCmdOp(RF_Handle h, RF_CmdHandle cmdHnd);
+extern RF_TxPowerTable_Value RF_getTxPower(RF_Handle h);
+extern RF_Stat RF_setTxPower(RF_Handle h, RF_TxPowerTable_Value value);
+extern int8_t RF_TxPowerTable_findPowerLevel(RF_TxPowerTable_Entry table[], RF_TxPowerTable_Value value);
+extern RF_TxPowerTable_Value RF_TxPowerTable_findValue(RF_TxPowerTable_Entry table[], int8_t powerLevel);
+
+#endif /* ti_drivers_rf__include */
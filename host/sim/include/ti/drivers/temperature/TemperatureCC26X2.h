@@ -0,0 +1,15 @@
+/*
+ *  ======== TemperatureCC26X2.h ========
+ *  Host stand-in: configuration type for ti_drivers_config.c.
+ */
+#ifndef ti_drivers_temperature_TemperatureCC26X2__include
+#define ti_drivers_temperature_TemperatureCC26X2__include
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t intPriority;
+} TemperatureCC26X2_Config;
+
+#endif /* ti_drivers_temperature_TemperatureCC26X2__include */
@@ -0,0 +1,57 @@
+/*
+ *  ======== UART2CC26X2.h ========
+ *  Host stand-in: object and hardware attribute types for
+ *  ti_drivers_config.c.
+ */
+#ifndef ti_drivers_uart2_UART2CC26X2__include
+#define ti_drivers_uart2_UART2CC26X2__include
+
+#include <stdint.h>
+
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/UART2.h>
+#include <ti/drivers/dma/UDMACC26XX.h>
+#include <ti/devices/cc13x2_cc26x2/driverlib/ioc.h>
+
+typedef enum
+{
+    UART2CC26X2_FIFO_THRESHOLD_1_8,
+    UART2CC26X2_FIFO_THRESHOLD_2_8,
+    UART2CC26X2_FIFO_THRESHOLD_4_8,
+    UART2CC26X2_FIFO_THRESHOLD_6_8,
+    UART2CC26X2_FIFO_THRESHOLD_7_8
+} UART2CC26X2_FifoThreshold;
+
+typedef struct
+{
+    uint32_t dummy[32];
+} UART2CC26X2_Object;
+
+typedef struct
+{
+    uint32_t baseAddr;
+    int intNum;
+    uint8_t intPriority;
+    uint8_t rxPin;
+    uint8_t txPin;
+    uint8_t ctsPin;
+    uint8_t rtsPin;
+    uint32_t flowControl;
+    uint32_t powerId;
+    unsigned char *rxBufPtr;
+    size_t rxBufSize;
+    unsigned char *txBufPtr;
+    size_t txBufSize;
+    uint8_t txPinMux;
+    uint8_t rxPinMux;
+    uint8_t ctsPinMux;
+    uint8_t rtsPinMux;
+    volatile tDMAControlTable *dmaTxTableEntryPri;
+    volatile tDMAControlTable *dmaRxTableEntryPri;
+    uint32_t rxChannelMask;
+    uint32_t txChannelMask;
+    UART2CC26X2_FifoThreshold txIntFifoThr;
+    UART2CC26X2_FifoThreshold rxIntFifoThr;
+} UART2CC26X2_HWAttrs;
+
+#endif /* ti_drivers_uart2_UART2CC26X2__include */
@@ -0,0 +1,20 @@
+/*
+ *  ======== Hwi.h ========
+ *  Host stand-in for the SYS/BIOS interrupt module, stack inspection only.
+ */
+#ifndef ti_sysbios_hal_Hwi__include
+#define ti_sysbios_hal_Hwi__include
+
+#include <xdc/std.h>
+
+typedef struct
+{
+    SizeT hwiStackPeak;
+    SizeT hwiStackSize;
+    Ptr hwiStackBase;
+} Hwi_StackInfo;
+
+/* Returns TRUE if the stack overflowed */
+extern Bool Hwi_getStackInfo(Hwi_StackInfo *stkInfo, Bool computeStackDepth);
+
+#endif /* ti_sysbios_hal_Hwi__include */
@@ -0,0 +1,43 @@
+/*
+ *  ======== Task.h ========
+ *  Host stand-in for the SYS/BIOS task module, inspection only.
+ */
+#ifndef ti_sysbios_knl_Task__include
+#define ti_sysbios_knl_Task__include
+
+#include <xdc/std.h>
+
+typedef struct Task_Object Task_Object;
+typedef Task_Object *Task_Handle;
+
+typedef enum
+{
+    Task_Mode_RUNNING,
+    Task_Mode_READY,
+    Task_Mode_BLOCKED,
+    Task_Mode_TERMINATED,
+    Task_Mode_INACTIVE
+} Task_Mode;
+
+typedef struct
+{
+    Int priority;
+    Ptr stack;
+    SizeT stackSize;
+    Ptr stackHeap;
+    Ptr env;
+    Task_Mode mode;
+    Ptr sp;
+    SizeT used;
+} Task_Stat;
+
+extern Task_Handle Task_self(void);
+extern Void Task_stat(Task_Handle handle, Task_Stat *statbuf);
+
+/* Static instances by index, created and constructed ones as a list */
+extern Int Task_Object_count(void);
+extern Task_Handle Task_Object_get(Task_Object *array, Int i);
+extern Task_Handle Task_Object_first(void);
+extern Task_Handle Task_Object_next(Task_Handle handle);
+
+#endif /* ti_sysbios_knl_Task__include */
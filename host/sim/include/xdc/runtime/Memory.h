@@ -0,0 +1,22 @@
+/*
+ *  ======== Memory.h ========
+ *  Host stand-in for the XDCtools memory module, statistics only.
+ */
+#ifndef xdc_runtime_Memory__include
+#define xdc_runtime_Memory__include
+
+#include <xdc/std.h>
+
+typedef void *IHeap_Handle;
+
+typedef struct
+{
+    SizeT totalSize;
+    SizeT totalFreeSize;
+    SizeT largestFreeSize;
+} Memory_Stats;
+
+/* NULL for the default heap */
+extern Void Memory_getStats(IHeap_Handle heap, Memory_Stats *stats);
+
+#endif /* xdc_runtime_Memory__include */
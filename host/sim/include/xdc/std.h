@@ -0,0 +1,22 @@
+/*
+ *  ======== std.h ========
+ *  Host stand-in for the XDCtools base types the kernel APIs use.
+ */
+#ifndef xdc_std__include
+#define xdc_std__include
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef bool Bool;
+typedef int Int;
+typedef unsigned int UInt;
+typedef size_t SizeT;
+typedef void *Ptr;
+typedef void Void;
+
+#define TRUE    true
+#define FALSE   false
+
+#endif /* xdc_std__include */
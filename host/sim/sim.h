@@ -0,0 +1,303 @@
+/*
+ *  ======== sim.h ========
+ *  Host simulation of the LaunchPad: virtual time, radio and pins.
+ *
+ *  The firmware runs unchanged in one host thread on top of the stand-in
+ *  SDK headers in include/. Simulated time only advances while the
+ *  firmware waits: RF_pendCmd(), SemaphoreP_pend(), usleep() and sleep()
+ *  run the event queue until the wait is over, and every RF, clock and pin
+ *  callback runs from there, as if an SWI or HWI had preempted the waiting
+ *  task. Code between two waits takes no simulated time, so the same
+ *  inputs always give the same timeline.
+ *
+ *  Time is kept in radio timer (RAT) ticks, 4 per microsecond, and
+ *  RF_getCurrentTime() returns its lower 32 bits. The run ends when the
+ *  firmware waits and no event is left, unless an input hook brings one
+ *  in from outside.
+ */
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ti/drivers/PIN.h>
+
+#define SIM_TICKS_PER_US            4
+#define SIM_US(us)                  ((uint64_t)(us) * SIM_TICKS_PER_US)
+#define SIM_MS(ms)                  ((uint64_t)(ms) * 1000 * SIM_TICKS_PER_US)
+
+/***** Kernel *****/
+
+typedef void (*Sim_EventFxn)(void *arg);
+
+typedef struct Sim_Event_s
+{
+    struct Sim_Event_s *next;
+    uint64_t time;
+    Sim_EventFxn fxn;
+    void *arg;
+    bool active;
+} Sim_Event;
+
+/*
+ *  ======== Sim_now ========
+ *  Current simulated time in RAT ticks.
+ */
+extern uint64_t Sim_now(void);
+
+/*
+ *  ======== Sim_schedule ========
+ *  Runs fxn(arg) at the given time. Events at the same time run in the
+ *  order they were scheduled. A scheduled event is moved, not duplicated.
+ */
+extern void Sim_schedule(Sim_Event *event, uint64_t time, Sim_EventFxn fxn, void *arg);
+
+/*
+ *  ======== Sim_cancel ========
+ */
+extern void Sim_cancel(Sim_Event *event);
+
+/*
+ *  ======== Sim_waitUntil ========
+ *  Runs events until done(arg) returns true. Ends the simulation if there
+ *  is no event left to run.
+ */
+extern void Sim_waitUntil(bool (*done)(void *arg), void *arg);
+
+/*
+ *  ======== Sim_sleep ========
+ *  Lets the given number of ticks pass, running the events in between.
+ */
+extern void Sim_sleep(uint64_t ticks);
+
+/*
+ *  ======== Sim_setIdleHook ========
+ *  fxn is called whenever the firmware waits, before time advances, like
+ *  a lowest priority task on the target.
+ */
+extern void Sim_setIdleHook(void (*fxn)(void));
+
+/*
+ *  ======== Sim_setInputHook ========
+ *  fxn is called whenever the firmware waits, to turn outside input into
+ *  events. block is false while events are queued; with an empty queue
+ *  fxn is called with block set and should wait for input. Returning
+ *  false then ends the simulation.
+ */
+extern void Sim_setInputHook(bool (*fxn)(bool block));
+
+/*
+ *  ======== Sim_setEndHook ========
+ *  fxn is called once when the simulation ends, before the process exits.
+ */
+extern void Sim_setEndHook(void (*fxn)(void));
+
+/*
+ *  ======== Sim_end ========
+ *  Calls the end hook and exits with status 0.
+ */
+extern void Sim_end(void) __attribute__((noreturn));
+
+/*
+ *  ======== Sim_random ========
+ *  Deterministic pseudo random numbers for the models.
+ */
+extern void Sim_seed(uint32_t seed);
+extern uint32_t Sim_random(void);
+
+/***** Kernel *****/
+
+/* What the kernel's memory inspection reports, as configured for the
+ * target: the idle task of the kernel project, the firmware thread of
+ * main_tirtos.c, the C stack and the heap of the linker command file.
+ * The firmware runs on the host's stack, so stack use is not modelled
+ * and every stack reports nothing used; nothing is allocated either. */
+#define SIM_KERNEL_IDLE_STACK_SIZE  512
+#define SIM_KERNEL_MAIN_STACK_SIZE  2096
+#define SIM_KERNEL_ISR_STACK_SIZE   1024
+#ifdef STATIC_ALLOCATION
+#define SIM_KERNEL_HEAP_SIZE        0x400
+#else
+#define SIM_KERNEL_HEAP_SIZE        0x4000
+#endif
+
+/***** Power *****/
+
+/* Shortest wait the standby policy sleeps through, like the
+ * PowerCC26XX_TOTALTIMESTANDBY check of PowerCC26XX_standbyPolicy() */
+#ifndef SIM_STANDBY_MIN_US
+#define SIM_STANDBY_MIN_US          1000
+#endif
+
+/* HF crystal start-up, part of SIM_RF_POWER_UP_US. The crystal is off in
+ * standby unless a Power_setDependency() holds it, so a dependency set
+ * ahead of a power-up takes the time it has been running off it. */
+#ifndef SIM_XOSC_HF_US
+#define SIM_XOSC_HF_US              400
+#endif
+
+typedef struct
+{
+    uint32_t numStandby;        /* Times the device entered standby */
+    uint64_t standbyTicks;      /* Time spent in standby */
+} SimPower_Stats;
+
+/*
+ *  ======== SimPower_idle ========
+ *  Called by the kernel before time jumps ahead to until. Enters standby,
+ *  with its notifications, if the radio is off and the gap is long enough.
+ */
+extern void SimPower_idle(uint64_t until);
+
+/*
+ *  ======== SimPower_wake ========
+ *  Called by the kernel after the jump. Leaves standby if it was entered.
+ */
+extern void SimPower_wake(void);
+
+/*
+ *  ======== SimPower_getXoscTicks ========
+ *  How long a Power_setDependency() has held the HF crystal on since it
+ *  last started, 0 if nothing holds it.
+ */
+extern uint64_t SimPower_getXoscTicks(void);
+
+extern void SimPower_getStats(SimPower_Stats *stats);
+
+/***** Radio *****/
+
+/* Model timing in microseconds. Rough figures for the CC1352P, meant to
+ * compare TX strategies rather than to predict absolute numbers. */
+#ifndef SIM_RF_POWER_UP_US
+#define SIM_RF_POWER_UP_US          1000    /* XOSC start, RF core boot and radio setup */
+#endif
+#ifndef SIM_RF_SETUP_US
+#define SIM_RF_SETUP_US             150     /* Radio setup alone, e.g. after a PA change */
+#endif
+#ifndef SIM_RF_FS_US
+#define SIM_RF_FS_US                150     /* CMD_FS */
+#endif
+#ifndef SIM_RF_DISPATCH_US
+#define SIM_RF_DISPATCH_US          80      /* RF_postCmd() to the first command of a chain starting */
+#endif
+#ifndef SIM_RF_DONE_US
+#define SIM_RF_DONE_US              40      /* Last command done to the callback and RF_pendCmd() */
+#endif
+#ifndef SIM_RF_TX_STARTUP_US
+#define SIM_RF_TX_STARTUP_US        192     /* CMD_IEEE_TX start to preamble, aTurnaroundTime */
+#endif
+#define SIM_RF_SYMBOL_US            16      /* 250 kbps O-QPSK */
+#define SIM_RF_BYTE_US              32
+#define SIM_RF_SHR_PHR_BYTES        6       /* Preamble, SFD and PHR */
+#define SIM_RF_ACK_BYTES            5       /* FCF, sequence number and FCS */
+#define SIM_RF_SIFS_US              (12 * SIM_RF_SYMBOL_US)
+#define SIM_RF_LIFS_US              (40 * SIM_RF_SYMBOL_US)
+
+/* RF_scheduleCmd() arbitration between clients: the priority is taken from
+ * the low 16 bits of activityInfo, the activity from the high 16, the way
+ * DMM lays them out. RF_postCmd() always posts at RF_PriorityNormal. */
+#define SIM_RF_PRIORITY(activityInfo)   ((uint16_t)((activityInfo) & 0xFFFF))
+
+/*
+ *  A peer can send data frames to a CMD_IEEE_RX with a receive queue. It
+ *  starts with the first such command and sends peerCount broadcast data
+ *  frames of peerLength bytes (FCS excluded), sequence numbers counting
+ *  up, peerGapUs apart, or as close as the standard allows (SIFS/LIFS) if
+ *  that is 0. A frame reaches the queue only if the radio listened from
+ *  its start to its end, not tied up by a foreground command. Some get
+ *  lost on the way and some arrive with a CRC error; the RSSI is drawn
+ *  within 10 dB of peerRssi.
+ */
+typedef struct
+{
+    uint8_t  ackPercent;        /* Chance that CMD_IEEE_RX_ACK sees an ACK */
+    uint8_t  ccaBusyPercent;    /* Chance that one CCA finds the channel busy */
+    uint8_t  peerLength;        /* 0 for no peer */
+    uint32_t peerCount;
+    uint32_t peerGapUs;
+    uint8_t  peerLossPercent;
+    uint8_t  peerCrcPercent;
+    int8_t   peerRssi;
+} SimRf_Params;
+
+typedef struct
+{
+    uint32_t numOpens;          /* RF_open() calls */
+    uint32_t numPowerUps;
+    uint32_t numSetups;         /* Radio setups, including the ones of power-ups */
+    uint32_t numFs;             /* CMD_FS, including the ones replayed on power-up */
+    uint32_t numPaSwitches;
+    uint32_t numCmds;           /* Radio operations started */
+    uint32_t numTx;             /* Frames sent */
+    uint32_t numTxErrors;       /* CMD_IEEE_TX that ended with an error */
+    uint32_t numCsma;
+    uint32_t numCsmaBusy;       /* Channel access failures */
+    uint32_t numBackoffs;
+    uint32_t numRxAck;
+    uint32_t numAcks;           /* ACKs received */
+    uint32_t numCancels;
+    uint32_t numPreemptions;    /* Background RX aborted for a higher priority client */
+    uint32_t numPeerFrames;     /* Frames the peer sent */
+    uint32_t numPeerLost;       /* Lost on the way */
+    uint32_t numPeerDeaf;       /* Sent while the radio was not listening */
+    uint32_t numPeerBufFull;    /* Heard, but no free entry */
+    uint32_t numPeerReceived;   /* Written to the receive queue, CRC errors included */
+    uint64_t txBytes;           /* PSDU bytes sent, FCS included */
+    uint64_t airTicks;          /* Time frames were on air, SHR included */
+    uint64_t onTicks;           /* Time the radio was powered */
+} SimRf_Stats;
+
+/*
+ *  ======== SimRf_TxHook ========
+ *  Called for every frame as it starts on air, with the frequency in MHz
+ *  of the last CMD_FS. psdu excludes the FCS the radio appends.
+ */
+typedef void (*SimRf_TxHook)(const uint8_t *psdu, uint8_t length, uint32_t timeStamp,
+                             uint16_t frequency);
+
+extern void SimRf_Params_init(SimRf_Params *params);
+extern void SimRf_configure(const SimRf_Params *params);
+extern void SimRf_setTxHook(SimRf_TxHook hook);
+extern void SimRf_getStats(SimRf_Stats *stats);
+
+/*
+ *  ======== SimRf_isOn ========
+ *  True while the radio is powered.
+ */
+extern bool SimRf_isOn(void);
+
+/***** UART *****/
+
+/*
+ *  ======== SimUart_open ========
+ *  Backs the UART2 driver with a pseudo terminal and returns the path of
+ *  its terminal side, or NULL on failure. Bytes written by whoever opens
+ *  it arrive at the firmware at the UART's baud rate; the firmware's
+ *  writes go to it as they are made. The simulation ends when the other
+ *  side closes it after having written to it.
+ */
+extern const char *SimUart_open(void);
+
+/***** Pins *****/
+
+/*
+ *  ======== SimPin_setInput ========
+ *  Drives an input pin and raises its edge interrupt if one is enabled.
+ */
+extern void SimPin_setInput(PIN_Id pinId, uint_fast8_t value);
+
+/*
+ *  ======== SimPin_press ========
+ *  Pulls an active low button pin low at the given time and releases it
+ *  holdTicks later.
+ */
+extern void SimPin_press(PIN_Id pinId, uint64_t time, uint64_t holdTicks);
+
+/*
+ *  ======== SimPin_getMux ========
+ *  Returns the IO multiplexer setting, PINCC26XX_MUX_GPIO by default.
+ */
+extern int32_t SimPin_getMux(PIN_Id pinId);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,87 @@
+/*
+ *  ======== simBios.c ========
+ *  Kernel task, interrupt and heap inspection.
+ *
+ *  Reports the tasks, stacks and heap the target has (sim.h), for the
+ *  firmware's high-water marks. Nothing here runs tasks; the firmware
+ *  thread is the host's main thread.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Memory.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "sim.h"
+
+/***** Type declarations *****/
+struct Task_Object
+{
+    Int priority;
+    SizeT stackSize;
+};
+
+/***** Variable declarations *****/
+
+/* The idle task is static, the firmware thread is created by main() */
+static Task_Object staticTasks[] = { { 0, SIM_KERNEL_IDLE_STACK_SIZE } };
+static Task_Object mainTask = { 1, SIM_KERNEL_MAIN_STACK_SIZE };
+
+/***** Function definitions *****/
+
+Task_Handle Task_self(void)
+{
+    return &mainTask;
+}
+
+Void Task_stat(Task_Handle handle, Task_Stat *statbuf)
+{
+    memset(statbuf, 0, sizeof(*statbuf));
+    statbuf->priority = handle->priority;
+    statbuf->stackSize = handle->stackSize;
+    statbuf->mode = (handle == &mainTask) ? Task_Mode_RUNNING : Task_Mode_READY;
+}
+
+Int Task_Object_count(void)
+{
+    return sizeof(staticTasks) / sizeof(staticTasks[0]);
+}
+
+Task_Handle Task_Object_get(Task_Object *array, Int i)
+{
+    return (array != NULL) ? &array[i] : &staticTasks[i];
+}
+
+Task_Handle Task_Object_first(void)
+{
+    return &mainTask;
+}
+
+Task_Handle Task_Object_next(Task_Handle handle)
+{
+    (void)handle;
+    return NULL;
+}
+
+Bool Hwi_getStackInfo(Hwi_StackInfo *stkInfo, Bool computeStackDepth)
+{
+    (void)computeStackDepth;
+
+    stkInfo->hwiStackPeak = 0;
+    stkInfo->hwiStackSize = SIM_KERNEL_ISR_STACK_SIZE;
+    stkInfo->hwiStackBase = NULL;
+    return FALSE;
+}
+
+Void Memory_getStats(IHeap_Handle heap, Memory_Stats *stats)
+{
+    (void)heap;
+
+    stats->totalSize = SIM_KERNEL_HEAP_SIZE;
+    stats->totalFreeSize = SIM_KERNEL_HEAP_SIZE;
+    stats->largestFreeSize = SIM_KERNEL_HEAP_SIZE;
+}
@@ -0,0 +1,31 @@
+/*
+ *  ======== simBoard.c ========
+ *  Remaining symbols ti_drivers_config.c and the RF mode need.
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ti/drivers/Power.h>
+
+/***** Function definitions *****/
+
+int_fast16_t Power_init(void)
+{
+    return 0;
+}
+
+void PowerCC26XX_standbyPolicy(void)
+{
+}
+
+bool PowerCC26XX_calibrate(unsigned int arg)
+{
+    (void)arg;
+    return false;
+}
+
+void rf_patch_cpe_ieee_802_15_4(void)
+{
+}
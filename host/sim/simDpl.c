@@ -0,0 +1,244 @@
+/*
+ *  ======== simDpl.c ========
+ *  DPL clock, semaphore and interrupt modules on simulated time.
+ *
+ *  usleep() and sleep() are replaced as well, so the firmware's POSIX
+ *  sleeps advance simulated time instead of blocking the host.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <unistd.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+#include "sim.h"
+
+/***** Defines *****/
+#define CLOCK_TICK_US           10      /* ClockP tick period, as in the TI-RTOS kernel config */
+
+/***** Type declarations *****/
+typedef struct
+{
+    Sim_Event event;
+    ClockP_Fxn fxn;
+    uintptr_t arg;
+    uint32_t timeout;
+    uint32_t period;
+} Clock;
+
+typedef struct
+{
+    unsigned int count;
+    SemaphoreP_Mode mode;
+    bool timedOut;
+    Sim_Event timeout;
+} Semaphore;
+
+_Static_assert(sizeof(Clock) <= sizeof(ClockP_Struct), "ClockP_Struct too small");
+_Static_assert(sizeof(Semaphore) <= sizeof(SemaphoreP_Struct), "SemaphoreP_Struct too small");
+
+/***** Prototypes *****/
+static void clockEvent(void *arg);
+
+/***** Function definitions *****/
+
+static void clockEvent(void *arg)
+{
+    Clock *clock = arg;
+
+    if (clock->period != 0)
+    {
+        Sim_schedule(&clock->event, Sim_now() + SIM_US((uint64_t)clock->period * CLOCK_TICK_US),
+                     clockEvent, clock);
+    }
+    clock->fxn(clock->arg);
+}
+
+void ClockP_Params_init(ClockP_Params *params)
+{
+    params->startFlag = false;
+    params->period = 0;
+    params->arg = 0;
+}
+
+ClockP_Handle ClockP_construct(ClockP_Struct *clockP, ClockP_Fxn clockFxn,
+                               uint32_t timeout, ClockP_Params *params)
+{
+    Clock *clock = (Clock *)clockP;
+    ClockP_Params defaults;
+
+    if (params == NULL)
+    {
+        ClockP_Params_init(&defaults);
+        params = &defaults;
+    }
+
+    clock->event.active = false;
+    clock->fxn = clockFxn;
+    clock->arg = params->arg;
+    clock->timeout = timeout;
+    clock->period = params->period;
+
+    if (params->startFlag)
+    {
+        ClockP_start(clock);
+    }
+    return clock;
+}
+
+void ClockP_destruct(ClockP_Struct *clockP)
+{
+    ClockP_stop((ClockP_Handle)clockP);
+}
+
+void ClockP_start(ClockP_Handle handle)
+{
+    Clock *clock = handle;
+    Sim_schedule(&clock->event, Sim_now() + SIM_US((uint64_t)clock->timeout * CLOCK_TICK_US),
+                 clockEvent, clock);
+}
+
+void ClockP_stop(ClockP_Handle handle)
+{
+    Sim_cancel(&((Clock *)handle)->event);
+}
+
+void ClockP_setTimeout(ClockP_Handle handle, uint32_t timeout)
+{
+    ((Clock *)handle)->timeout = timeout;
+}
+
+bool ClockP_isActive(ClockP_Handle handle)
+{
+    return ((Clock *)handle)->event.active;
+}
+
+uint32_t ClockP_getSystemTicks(void)
+{
+    return (uint32_t)(Sim_now() / SIM_US(CLOCK_TICK_US));
+}
+
+uint32_t ClockP_getSystemTickPeriod(void)
+{
+    return CLOCK_TICK_US;
+}
+
+void ClockP_usleep(uint32_t usec)
+{
+    Sim_sleep(SIM_US(usec));
+}
+
+void ClockP_sleep(uint32_t sec)
+{
+    Sim_sleep(SIM_MS((uint64_t)sec * 1000));
+}
+
+int usleep(useconds_t usec)
+{
+    Sim_sleep(SIM_US(usec));
+    return 0;
+}
+
+unsigned int sleep(unsigned int seconds)
+{
+    Sim_sleep(SIM_MS((uint64_t)seconds * 1000));
+    return 0;
+}
+
+void SemaphoreP_Params_init(SemaphoreP_Params *params)
+{
+    params->mode = SemaphoreP_Mode_COUNTING;
+    params->callback = NULL;
+}
+
+SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle, unsigned int count,
+                                       SemaphoreP_Params *params)
+{
+    Semaphore *sem = (Semaphore *)handle;
+
+    sem->mode = (params != NULL) ? params->mode : SemaphoreP_Mode_COUNTING;
+    sem->count = ((sem->mode == SemaphoreP_Mode_BINARY) && (count > 1)) ? 1 : count;
+    sem->timedOut = false;
+    sem->timeout.active = false;
+
+    return sem;
+}
+
+SemaphoreP_Handle SemaphoreP_constructBinary(SemaphoreP_Struct *handle, unsigned int count)
+{
+    SemaphoreP_Params params;
+
+    SemaphoreP_Params_init(&params);
+    params.mode = SemaphoreP_Mode_BINARY;
+
+    return SemaphoreP_construct(handle, count, &params);
+}
+
+void SemaphoreP_destruct(SemaphoreP_Struct *semP)
+{
+    Sim_cancel(&((Semaphore *)semP)->timeout);
+}
+
+static bool canTake(void *arg)
+{
+    Semaphore *sem = arg;
+    return (sem->count > 0) || sem->timedOut;
+}
+
+static void semTimeout(void *arg)
+{
+    ((Semaphore *)arg)->timedOut = true;
+}
+
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    Semaphore *sem = handle;
+
+    if ((sem->count == 0) && (timeout != SemaphoreP_NO_WAIT))
+    {
+        sem->timedOut = false;
+        if (timeout != (uint32_t)SemaphoreP_WAIT_FOREVER)
+        {
+            Sim_schedule(&sem->timeout, Sim_now() + SIM_US((uint64_t)timeout * CLOCK_TICK_US),
+                         semTimeout, sem);
+        }
+        Sim_waitUntil(canTake, sem);
+        Sim_cancel(&sem->timeout);
+    }
+
+    if (sem->count == 0)
+    {
+        return SemaphoreP_TIMEOUT;
+    }
+
+    sem->count--;
+    return SemaphoreP_OK;
+}
+
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    Semaphore *sem = handle;
+
+    if ((sem->mode == SemaphoreP_Mode_COUNTING) || (sem->count == 0))
+    {
+        sem->count++;
+    }
+}
+
+uintptr_t HwiP_disable(void)
+{
+    return 0;
+}
+
+void HwiP_restore(uintptr_t key)
+{
+    (void)key;
+}
+
+bool HwiP_inISR(void)
+{
+    return false;
+}
@@ -0,0 +1,157 @@
+/*
+ *  ======== simKernel.c ========
+ *  Event queue and simulated time.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "sim.h"
+
+/***** Prototypes *****/
+static void wakeUp(void *arg);
+static bool isSet(void *arg);
+
+/***** Variable declarations *****/
+static uint64_t now;
+static Sim_Event *queue;
+static void (*endHook)(void);
+static void (*idleHook)(void);
+static bool (*inputHook)(bool block);
+static uint32_t rngState = 1;
+
+/***** Function definitions *****/
+
+static void wakeUp(void *arg)
+{
+    *(bool *)arg = true;
+}
+
+static bool isSet(void *arg)
+{
+    return *(bool *)arg;
+}
+
+uint64_t Sim_now(void)
+{
+    return now;
+}
+
+void Sim_schedule(Sim_Event *event, uint64_t time, Sim_EventFxn fxn, void *arg)
+{
+    Sim_cancel(event);
+
+    event->time = (time < now) ? now : time;
+    event->fxn = fxn;
+    event->arg = arg;
+    event->active = true;
+
+    /* Sorted by time, after all events with the same time */
+    Sim_Event **p = &queue;
+    while ((*p != NULL) && ((*p)->time <= event->time))
+    {
+        p = &(*p)->next;
+    }
+    event->next = *p;
+    *p = event;
+}
+
+void Sim_cancel(Sim_Event *event)
+{
+    if (!event->active)
+    {
+        return;
+    }
+
+    Sim_Event **p = &queue;
+    while (*p != event)
+    {
+        p = &(*p)->next;
+    }
+    *p = event->next;
+    event->active = false;
+}
+
+void Sim_waitUntil(bool (*done)(void *arg), void *arg)
+{
+    while (!done(arg))
+    {
+        if (idleHook != NULL)
+        {
+            idleHook();
+        }
+
+        Sim_Event *event = queue;
+        if (inputHook != NULL)
+        {
+            if (!inputHook(event == NULL))
+            {
+                Sim_end();
+            }
+            event = queue;
+        }
+        if (event == NULL)
+        {
+            /* Nothing can happen any more */
+            Sim_end();
+        }
+
+        queue = event->next;
+        event->active = false;
+        if (event->time > now)
+        {
+            SimPower_idle(event->time);
+            now = event->time;
+            SimPower_wake();
+        }
+        event->fxn(event->arg);
+    }
+}
+
+void Sim_sleep(uint64_t ticks)
+{
+    Sim_Event event = { .active = false };
+    bool woken = false;
+
+    Sim_schedule(&event, now + ticks, wakeUp, &woken);
+    Sim_waitUntil(isSet, &woken);
+}
+
+void Sim_setIdleHook(void (*fxn)(void))
+{
+    idleHook = fxn;
+}
+
+void Sim_setInputHook(bool (*fxn)(bool block))
+{
+    inputHook = fxn;
+}
+
+void Sim_setEndHook(void (*fxn)(void))
+{
+    endHook = fxn;
+}
+
+void Sim_end(void)
+{
+    if (endHook != NULL)
+    {
+        endHook();
+    }
+    exit(0);
+}
+
+void Sim_seed(uint32_t seed)
+{
+    rngState = (seed != 0) ? seed : 1;
+}
+
+uint32_t Sim_random(void)
+{
+    /* xorshift32 */
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
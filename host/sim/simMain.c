@@ -0,0 +1,355 @@
+/*
+ *  ======== simMain.c ========
+ *  Runs the firmware's mainThread() against the simulated board.
+ *
+ *  Button presses come from a script of L (left, BUTTON_0) and R (right,
+ *  BUTTON_1) characters, one press per interval. When the firmware waits
+ *  for a button that will never be pressed, the simulation ends and prints
+ *  what the radio did.
+ *
+ *  With -p every frame sent is written to a PCAPNG file (pcapng.h), the
+ *  blocks batched in memory and written out a buffer at a time.
+ *
+ *  With -u the UART is a pseudo terminal, linked to the given path, for a
+ *  host program to talk to; the run then also waits for it.
+ *
+ *  With -x a peer sends frames to the receiver (sim.h): length, then
+ *  optionally count, gap in us, loss and CRC error percentages and RSSI,
+ *  comma separated.
+ *
+ *  Usage: rfSim [-b buttons] [-i intervalMs] [-a ackPercent]
+ *               [-c ccaBusyPercent] [-s seed] [-t] [-r traceFile]
+ *               [-w wallSeconds] [-u uartLink] [-p pcapngFile]
+ *               [-x length[,count[,gapUs[,lossPercent[,crcPercent[,rssi]]]]]]
+ */
+
+/***** Includes *****/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <unistd.h>
+
+#include <ti/drivers/Board.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26X2.h>
+
+#include "ti_drivers_config.h"
+#include "ti_radio_config.h"
+#include "bootTime.h"
+#include "pcapng.h"
+#include "radioTrace.h"
+#include "sim.h"
+
+/***** Defines *****/
+#define PRESS_HOLD_MS           50
+#define CAPTURE_BUFFER_SIZE     65536
+
+/***** Variable declarations *****/
+static FILE *traceFile;
+static bool traceFrames;
+
+static FILE *captureFile;
+static uint8_t captureBuffer[CAPTURE_BUFFER_SIZE];
+static uint32_t captureLength;
+static Pcapng_Clock captureClock;
+static uint32_t numInterfaces;
+static uint8_t captureChannel;          /* Setting of the last interface */
+static int8_t captureTxPower;
+
+/***** Prototypes *****/
+extern void *mainThread(void *arg0);
+
+/***** Function definitions *****/
+
+static void flushCapture(void)
+{
+    if (fwrite(captureBuffer, 1, captureLength, captureFile) != captureLength)
+    {
+        perror("rfSim: capture");
+        exit(1);
+    }
+    captureLength = 0;
+}
+
+static void captureTx(const uint8_t *psdu, uint8_t length, uint32_t timeStamp, uint16_t frequency)
+{
+    uint8_t channel = (uint8_t)(11 + (frequency - 2405) / 5);
+    int8_t txPower = RF_TxPowerTable_findPowerLevel(txPowerTable_2400_pa5_20, RF_getTxPower(NULL));
+
+    if (captureLength + PCAPNG_IDB_MAX_LENGTH + PCAPNG_EPB_MAX_LENGTH > sizeof(captureBuffer))
+    {
+        flushCapture();
+    }
+
+    /* A new interface for every new setting */
+    if ((numInterfaces == 0) || (channel != captureChannel) || (txPower != captureTxPower))
+    {
+        captureLength += Pcapng_writeInterface(&captureBuffer[captureLength], channel, txPower);
+        captureChannel = channel;
+        captureTxPower = txPower;
+        numInterfaces++;
+    }
+    captureLength += Pcapng_writeFrame(&captureBuffer[captureLength], numInterfaces - 1,
+                                       Pcapng_toNs(&captureClock, timeStamp), channel, psdu, length);
+}
+
+static void traceTx(const uint8_t *psdu, uint8_t length, uint32_t timeStamp, uint16_t frequency)
+{
+    uint8_t i;
+
+    if (captureFile != NULL)
+    {
+        captureTx(psdu, length, timeStamp, frequency);
+    }
+    if (!traceFrames)
+    {
+        return;
+    }
+
+    printf("tx,%.3f,%u,%u,", timeStamp / (double)SIM_TICKS_PER_US / 1000.0, frequency, length);
+    for (i = 0; i < length; i++)
+    {
+        printf("%02x", psdu[i]);
+    }
+    printf("\n");
+}
+
+/* Drains the radio trace ring to the file whenever the firmware waits */
+static void drainTrace(void)
+{
+    uint8_t buf[16 * RADIO_TRACE_RECORD_SIZE];
+    uint32_t numRecords;
+
+    while ((numRecords = RadioTrace_read(buf, 16)) > 0)
+    {
+        fwrite(buf, RADIO_TRACE_RECORD_SIZE, numRecords, traceFile);
+    }
+}
+
+/* -x length[,count[,gapUs[,lossPercent[,crcPercent[,rssi]]]]] */
+static bool parsePeer(const char *arg, SimRf_Params *params)
+{
+    long values[6] = { 0, 1000, 0, 0, 0, -60 };
+    char *end = (char *)arg;
+    int i;
+
+    for (i = 0; i < 6; i++)
+    {
+        values[i] = strtol(end, &end, 0);
+        if (*end != ',')
+        {
+            break;
+        }
+        end++;
+    }
+    if ((*end != '\0') || (values[0] < 9) || (values[0] > 125) || (values[1] < 0) ||
+        (values[2] < 0) || (values[3] < 0) || (values[3] > 100) || (values[4] < 0) ||
+        (values[4] > 100) || (values[5] < -127) || (values[5] > 0))
+    {
+        return false;
+    }
+
+    params->peerLength = (uint8_t)values[0];
+    params->peerCount = (uint32_t)values[1];
+    params->peerGapUs = (uint32_t)values[2];
+    params->peerLossPercent = (uint8_t)values[3];
+    params->peerCrcPercent = (uint8_t)values[4];
+    params->peerRssi = (int8_t)values[5];
+    return true;
+}
+
+static void report(void)
+{
+    SimRf_Stats stats;
+    SimRf_getStats(&stats);
+    SimPower_Stats powerStats;
+    SimPower_getStats(&powerStats);
+
+    double seconds = Sim_now() / (double)SIM_US(1000000);
+
+    printf("simulated time       %.6f s\n", seconds);
+    printf("radio on             %.6f s (%.2f %%)\n",
+           stats.onTicks / (double)SIM_US(1000000),
+           (seconds > 0) ? 100.0 * stats.onTicks / Sim_now() : 0.0);
+    printf("standby              %.6f s (%.2f %%, %u times)\n",
+           powerStats.standbyTicks / (double)SIM_US(1000000),
+           (seconds > 0) ? 100.0 * powerStats.standbyTicks / Sim_now() : 0.0, powerStats.numStandby);
+    printf("power-ups            %u\n", stats.numPowerUps);
+    printf("radio setups         %u\n", stats.numSetups);
+    printf("synthesizer (CMD_FS) %u\n", stats.numFs);
+    printf("PA switches          %u\n", stats.numPaSwitches);
+    printf("radio operations     %u\n", stats.numCmds);
+    printf("frames sent          %u (%llu bytes, %.6f s on air)\n", stats.numTx,
+           (unsigned long long)stats.txBytes, stats.airTicks / (double)SIM_US(1000000));
+    printf("TX errors            %u\n", stats.numTxErrors);
+    printf("CSMA-CA              %u (%u backoffs, %u channel access failures)\n",
+           stats.numCsma, stats.numBackoffs, stats.numCsmaBusy);
+    printf("ACK waits            %u (%u acknowledged)\n", stats.numRxAck, stats.numAcks);
+    printf("cancelled commands   %u\n", stats.numCancels);
+    printf("preempted commands   %u\n", stats.numPreemptions);
+    if (stats.numPeerFrames > 0)
+    {
+        printf("peer frames          %u (%u received, %u lost, %u not listening, %u buffer full)\n",
+               stats.numPeerFrames, stats.numPeerReceived, stats.numPeerLost, stats.numPeerDeaf,
+               stats.numPeerBufFull);
+    }
+
+    if (captureFile != NULL)
+    {
+        flushCapture();
+        fclose(captureFile);
+    }
+    if (traceFile != NULL)
+    {
+        RadioTrace_Stats traceStats;
+
+        drainTrace();
+        fclose(traceFile);
+        RadioTrace_getStats(&traceStats);
+        printf("trace records        %u (%u lost)\n", traceStats.numRead, traceStats.numLost);
+    }
+    fflush(stdout);
+}
+
+static void watchdog(int sig)
+{
+    static const char msg[] = "rfSim: wall clock limit reached, the firmware is stuck "
+                              "(error trap or busy wait)\n";
+    (void)sig;
+    if (write(STDERR_FILENO, msg, sizeof(msg) - 1) < 0)
+    {
+        /* Nothing left to do */
+    }
+    _exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *buttons = "RRRRR";
+    uint32_t intervalMs = 1000;
+    uint32_t wallSeconds = 10;
+    bool wallSet = false;
+    const char *uartLink = NULL;
+    uint32_t seed = 1;
+    SimRf_Params rfParams;
+    int opt;
+
+    SimRf_Params_init(&rfParams);
+
+    while ((opt = getopt(argc, argv, "b:i:a:c:s:tr:w:u:p:x:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b': buttons = optarg; break;
+            case 'i': intervalMs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': rfParams.ackPercent = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'c': rfParams.ccaBusyPercent = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': traceFrames = true; break;
+            case 'r':
+                traceFile = fopen(optarg, "wb");
+                if (traceFile == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'w': wallSeconds = (uint32_t)strtoul(optarg, NULL, 0); wallSet = true; break;
+            case 'u': uartLink = optarg; break;
+            case 'p':
+                captureFile = fopen(optarg, "wb");
+                if (captureFile == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+                Pcapng_Clock_init(&captureClock);
+                captureLength = Pcapng_writeSectionHeader(captureBuffer);
+                break;
+            case 'x':
+                if (!parsePeer(optarg, &rfParams))
+                {
+                    fprintf(stderr, "%s: bad peer %s\n", argv[0], optarg);
+                    return 1;
+                }
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-b buttons] [-i intervalMs] [-a ackPercent] "
+                                "[-c ccaBusyPercent] [-s seed] [-t] [-r traceFile] [-w wallSeconds] "
+                                "[-u uartLink] [-p pcapngFile] "
+                                "[-x length[,count[,gapUs[,lossPercent[,crcPercent[,rssi]]]]]]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+
+    if ((rfParams.ackPercent > 100) || (rfParams.ccaBusyPercent > 100) ||
+        (intervalMs <= PRESS_HOLD_MS) || (strspn(buttons, "LR") != strlen(buttons)))
+    {
+        fprintf(stderr, "%s: parameter out of range\n", argv[0]);
+        return 1;
+    }
+
+    Sim_seed(seed);
+    SimRf_configure(&rfParams);
+    if (traceFrames || (captureFile != NULL))
+    {
+        SimRf_setTxHook(traceTx);
+    }
+    if (traceFile != NULL)
+    {
+        Sim_setIdleHook(drainTrace);
+    }
+    Sim_setEndHook(report);
+
+    if (uartLink != NULL)
+    {
+        const char *path = SimUart_open();
+        if (path == NULL)
+        {
+            perror("rfSim: pseudo terminal");
+            return 1;
+        }
+        unlink(uartLink);
+        if (symlink(path, uartLink) != 0)
+        {
+            perror(uartLink);
+            return 1;
+        }
+        fprintf(stderr, "rfSim: UART on %s (%s)\n", uartLink, path);
+
+        /* The host takes its time; waiting for it is not being stuck */
+        if (!wallSet)
+        {
+            wallSeconds = 0;
+        }
+    }
+
+    size_t i;
+    for (i = 0; buttons[i] != '\0'; i++)
+    {
+        PIN_Id pin = (buttons[i] == 'L') ? CONFIG_PIN_BUTTON_0 : CONFIG_PIN_BUTTON_1;
+        SimPin_press(pin, SIM_MS((uint64_t)intervalMs * (i + 1)), SIM_MS(PRESS_HOLD_MS));
+    }
+
+    if (wallSeconds != 0)
+    {
+        signal(SIGALRM, watchdog);
+        alarm(wallSeconds);
+    }
+
+    /* As main() of main_tirtos.c does */
+    BootTime_init();
+    Board_init();
+    BootTime_mark(BOOT_TIME_BOARD);
+#ifdef FAST_BOOT
+    Power_setDependency(PowerCC26XX_XOSC_HF);
+    BootTime_mark(BOOT_TIME_XOSC);
+#endif
+    BootTime_mark(BOOT_TIME_BIOS);
+    mainThread(NULL);
+
+    Sim_end();
+}
@@ -0,0 +1,274 @@
+/*
+ *  ======== simPin.c ========
+ *  PIN driver model.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+
+#include "sim.h"
+
+/***** Defines *****/
+#define NUM_IOS                 32
+
+/***** Type declarations *****/
+typedef struct
+{
+    PIN_Handle owner;
+    PIN_Config config;
+    uint8_t output;             /* Level driven by the output driver */
+    uint8_t input;              /* Level driven from outside */
+    int32_t mux;
+} Io;
+
+typedef struct
+{
+    Sim_Event event;
+    PIN_Id pinId;
+    uint64_t holdTicks;
+    bool pressed;
+} Press;
+
+/***** Prototypes *****/
+static void configure(PIN_Id pinId, PIN_Config config);
+static void pressEvent(void *arg);
+
+/***** Variable declarations *****/
+static Io ios[NUM_IOS];
+static bool initialized;
+
+/***** Function definitions *****/
+
+static void init(void)
+{
+    uint32_t i;
+
+    if (initialized)
+    {
+        return;
+    }
+    initialized = true;
+
+    for (i = 0; i < NUM_IOS; i++)
+    {
+        ios[i].config = PIN_INPUT_DIS;
+        ios[i].mux = PINCC26XX_MUX_GPIO;
+        ios[i].input = 1;
+    }
+}
+
+static void configure(PIN_Id pinId, PIN_Config config)
+{
+    Io *io = &ios[pinId];
+
+    io->config = config;
+    if (config & PIN_GPIO_OUTPUT_EN)
+    {
+        io->output = (config & PIN_GPIO_HIGH) ? 1 : 0;
+    }
+    if ((config & PIN_BM_INPUT_MODE & (3 << 13)) == PIN_PULLDOWN)
+    {
+        io->input = 0;
+    }
+    else if ((config & PIN_BM_INPUT_MODE & (3 << 13)) == PIN_PULLUP)
+    {
+        io->input = 1;
+    }
+}
+
+PIN_Status PIN_init(const PIN_Config aPinCfg[])
+{
+    uint32_t i;
+
+    init();
+    for (i = 0; PIN_ID(aPinCfg[i]) != PIN_TERMINATE; i++)
+    {
+        if (PIN_ID(aPinCfg[i]) < NUM_IOS)
+        {
+            configure(PIN_ID(aPinCfg[i]), aPinCfg[i]);
+        }
+    }
+    return PIN_SUCCESS;
+}
+
+PIN_Handle PIN_open(PIN_State *state, const PIN_Config pinList[])
+{
+    uint32_t i;
+
+    init();
+
+    /* All or nothing, as on the target */
+    for (i = 0; PIN_ID(pinList[i]) != PIN_TERMINATE; i++)
+    {
+        PIN_Id pinId = PIN_ID(pinList[i]);
+        if ((pinId >= NUM_IOS) || (ios[pinId].owner != NULL))
+        {
+            return NULL;
+        }
+    }
+
+    state->pCbFunc = NULL;
+    state->bmPort = 0;
+    state->userArg = 0;
+
+    for (i = 0; PIN_ID(pinList[i]) != PIN_TERMINATE; i++)
+    {
+        PIN_Id pinId = PIN_ID(pinList[i]);
+        ios[pinId].owner = state;
+        state->bmPort |= 1ull << pinId;
+        configure(pinId, pinList[i]);
+    }
+
+    return state;
+}
+
+void PIN_close(PIN_Handle handle)
+{
+    uint32_t i;
+
+    for (i = 0; i < NUM_IOS; i++)
+    {
+        if (ios[i].owner == handle)
+        {
+            ios[i].owner = NULL;
+            ios[i].mux = PINCC26XX_MUX_GPIO;
+        }
+    }
+    handle->bmPort = 0;
+}
+
+PIN_Status PIN_registerIntCb(PIN_Handle handle, PIN_IntCb callbackFxn)
+{
+    handle->pCbFunc = callbackFxn;
+    return PIN_SUCCESS;
+}
+
+PIN_Status PIN_setConfig(PIN_Handle handle, PIN_Config bmMask, PIN_Config pinCfg)
+{
+    PIN_Id pinId = PIN_ID(pinCfg);
+
+    if ((pinId >= NUM_IOS) || (ios[pinId].owner != handle))
+    {
+        return PIN_NO_ACCESS;
+    }
+
+    PIN_Config config = (ios[pinId].config & ~bmMask) | (pinCfg & bmMask);
+    configure(pinId, config);
+
+    return PIN_SUCCESS;
+}
+
+PIN_Status PIN_setInterrupt(PIN_Handle handle, PIN_Config pinCfg)
+{
+    return PIN_setConfig(handle, PIN_BM_IRQ, pinCfg);
+}
+
+PIN_Status PIN_clrPendInterrupt(PIN_Handle handle, PIN_Id pinId)
+{
+    (void)handle;
+    (void)pinId;
+    return PIN_SUCCESS;
+}
+
+uint_fast8_t PIN_getInputValue(PIN_Id pinId)
+{
+    const Io *io = &ios[PIN_ID(pinId)];
+    return (io->config & PIN_GPIO_OUTPUT_EN) ? io->output : io->input;
+}
+
+PIN_Status PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint_fast8_t val)
+{
+    if ((PIN_ID(pinId) >= NUM_IOS) || (ios[PIN_ID(pinId)].owner != handle))
+    {
+        return PIN_NO_ACCESS;
+    }
+
+    ios[PIN_ID(pinId)].output = val ? 1 : 0;
+    return PIN_SUCCESS;
+}
+
+uint_fast8_t PIN_getOutputValue(PIN_Id pinId)
+{
+    return ios[PIN_ID(pinId)].output;
+}
+
+PIN_Status PINCC26XX_setMux(PIN_Handle handle, PIN_Id pinId, int32_t muxId)
+{
+    if ((PIN_ID(pinId) >= NUM_IOS) || (ios[PIN_ID(pinId)].owner != handle))
+    {
+        return PIN_NO_ACCESS;
+    }
+
+    ios[PIN_ID(pinId)].mux = muxId;
+    return PIN_SUCCESS;
+}
+
+int32_t PINCC26XX_getMux(PIN_Id pinId)
+{
+    return ios[PIN_ID(pinId)].mux;
+}
+
+PIN_Status PINCC26XX_setOutputValue(PIN_Id pinId, uint_fast8_t val)
+{
+    ios[PIN_ID(pinId)].output = val ? 1 : 0;
+    return PIN_SUCCESS;
+}
+
+int32_t SimPin_getMux(PIN_Id pinId)
+{
+    return PINCC26XX_getMux(pinId);
+}
+
+void SimPin_setInput(PIN_Id pinId, uint_fast8_t value)
+{
+    Io *io = &ios[PIN_ID(pinId)];
+    uint8_t old = io->input;
+
+    init();
+    io->input = value ? 1 : 0;
+
+    if ((io->owner == NULL) || (io->owner->pCbFunc == NULL) ||
+        (io->config & PIN_GPIO_OUTPUT_EN) || (old == io->input))
+    {
+        return;
+    }
+
+    PIN_Config irq = io->config & PIN_BM_IRQ;
+    bool rising = (io->input == 1);
+    if ((irq == PIN_IRQ_BOTHEDGES) ||
+        ((irq == PIN_IRQ_POSEDGE) && rising) ||
+        ((irq == PIN_IRQ_NEGEDGE) && !rising))
+    {
+        io->owner->pCbFunc(io->owner, PIN_ID(pinId));
+    }
+}
+
+static void pressEvent(void *arg)
+{
+    Press *press = arg;
+
+    if (!press->pressed)
+    {
+        press->pressed = true;
+        SimPin_setInput(press->pinId, 0);
+        Sim_schedule(&press->event, Sim_now() + press->holdTicks, pressEvent, press);
+    }
+    else
+    {
+        SimPin_setInput(press->pinId, 1);
+        free(press);
+    }
+}
+
+void SimPin_press(PIN_Id pinId, uint64_t time, uint64_t holdTicks)
+{
+    Press *press = calloc(1, sizeof(*press));
+
+    press->pinId = PIN_ID(pinId);
+    press->holdTicks = holdTicks;
+    Sim_schedule(&press->event, time, pressEvent, press);
+}
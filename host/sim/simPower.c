@@ -0,0 +1,147 @@
+/*
+ *  ======== simPower.c ========
+ *  Power driver notifications, the standby model and the RTC.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26X2.h>
+#include <ti/devices/cc13x2_cc26x2/driverlib/aon_rtc.h>
+
+#include "sim.h"
+
+/***** Prototypes *****/
+static void notify(uint_fast16_t eventType);
+
+/***** Variable declarations *****/
+static Power_NotifyObj *notifyList;
+static bool inStandby;
+static uint64_t standbyStart;
+static SimPower_Stats stats;
+
+static uint16_t xoscDependencies;
+static uint64_t xoscStart;
+static bool rtcEnabled;
+
+/***** Function definitions *****/
+
+static void notify(uint_fast16_t eventType)
+{
+    Power_NotifyObj *obj;
+
+    for (obj = notifyList; obj != NULL; obj = obj->next)
+    {
+        if (obj->eventTypes & eventType)
+        {
+            obj->notifyFxn(eventType, 0, obj->clientArg);
+        }
+    }
+}
+
+int_fast16_t Power_registerNotify(Power_NotifyObj *pNotifyObj, uint_fast16_t eventTypes,
+                                  Power_NotifyFxn notifyFxn, uintptr_t clientArg)
+{
+    if ((pNotifyObj == NULL) || (notifyFxn == NULL))
+    {
+        return Power_EFAIL;
+    }
+
+    pNotifyObj->eventTypes = eventTypes;
+    pNotifyObj->notifyFxn = notifyFxn;
+    pNotifyObj->clientArg = clientArg;
+    pNotifyObj->next = notifyList;
+    notifyList = pNotifyObj;
+
+    return Power_SOK;
+}
+
+void Power_unregisterNotify(Power_NotifyObj *pNotifyObj)
+{
+    Power_NotifyObj **p = &notifyList;
+
+    while (*p != NULL)
+    {
+        if (*p == pNotifyObj)
+        {
+            *p = pNotifyObj->next;
+            return;
+        }
+        p = &(*p)->next;
+    }
+}
+
+int_fast16_t Power_setDependency(uint_fast16_t resourceId)
+{
+    if ((resourceId == PowerCC26XX_XOSC_HF) && (xoscDependencies++ == 0))
+    {
+        xoscStart = Sim_now();
+    }
+
+    return Power_SOK;
+}
+
+int_fast16_t Power_releaseDependency(uint_fast16_t resourceId)
+{
+    if ((resourceId == PowerCC26XX_XOSC_HF) && (xoscDependencies > 0))
+    {
+        xoscDependencies--;
+    }
+
+    return Power_SOK;
+}
+
+void AONRTCEnable(void)
+{
+    rtcEnabled = true;
+}
+
+bool AONRTCActive(void)
+{
+    return rtcEnabled;
+}
+
+uint32_t AONRTCCurrentCompareValueGet(void)
+{
+    return (uint32_t)(Sim_now() * 65536 / SIM_US(1000000));
+}
+
+void SimPower_idle(uint64_t until)
+{
+    /* The RF driver holds a standby constraint while the radio is on */
+    if (SimRf_isOn() || (until - Sim_now() < SIM_US(SIM_STANDBY_MIN_US)))
+    {
+        return;
+    }
+
+    inStandby = true;
+    standbyStart = Sim_now();
+    stats.numStandby++;
+    notify(PowerCC26XX_ENTERING_STANDBY);
+}
+
+void SimPower_wake(void)
+{
+    if (!inStandby)
+    {
+        return;
+    }
+
+    inStandby = false;
+    stats.standbyTicks += Sim_now() - standbyStart;
+
+    /* The crystal was off and starts over */
+    xoscStart = Sim_now();
+    notify(PowerCC26XX_AWAKE_STANDBY);
+}
+
+uint64_t SimPower_getXoscTicks(void)
+{
+    return (xoscDependencies == 0) ? 0 : Sim_now() - xoscStart;
+}
+
+void SimPower_getStats(SimPower_Stats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,1295 @@
+/*
+ *  ======== simRf.c ========
+ *  RF driver model.
+ *
+ *  Commands are queued per driver handle as on the target and run one
+ *  chain at a time, following pNextOp, the start triggers and the
+ *  condition rules. CMD_IEEE_RX runs as a background command; CMD_IEEE_TX,
+ *  CMD_IEEE_CSMA and CMD_IEEE_RX_ACK posted while it runs start right away
+ *  as a foreground chain on top of it.
+ *
+ *  The radio powers up when the first chain starts and stays on until
+ *  RF_yield() is called with nothing left to run. Power-up replays the
+ *  last CMD_FS, like the driver does. Switching between the default and
+ *  the high PA needs a new radio setup, after which the synthesizer must
+ *  be programmed again.
+ *
+ *  With several clients, a chain posted with RF_scheduleCmd() at a higher
+ *  priority (activityInfo, sim.h) than a CMD_IEEE_RX of another client
+ *  preempts it: the RX is aborted with RF_EventCmdPreempted and the new
+ *  chain starts in its place. Chains of the same client keep running
+ *  foreground on top of their background RX.
+ *
+ *  Frames of the peer (sim.h) are written to the receive queue of the
+ *  running CMD_IEEE_RX as the radio core does: length, frame and the
+ *  fields rxConfig asks for, then the entry is finished and the next one
+ *  becomes current. The timestamp is the start of the preamble, like the
+ *  one of CMD_IEEE_TX here.
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include <ti/drivers/rf/RF.h>
+#include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+#include "sim.h"
+
+/***** Defines *****/
+#define MAX_CMDS                    64      /* Command handles kept for RF_pendCmd() */
+#define MAX_QUEUED                  8       /* Unfinished commands per client, as on the target */
+
+#define UNIT_BACKOFF_US             (20 * SIM_RF_SYMBOL_US)
+#define CCA_US                      (8 * SIM_RF_SYMBOL_US)
+#define ACK_TURNAROUND_US           (12 * SIM_RF_SYMBOL_US)
+
+#define PEER_START_US               1000    /* First CMD_IEEE_RX to the peer's first frame */
+#define PEER_ADDR                   0x0001
+#define PEER_HDR_LENGTH             9       /* FCF, sequence number, PAN ID, both short addresses */
+#define MAX_SIFS_LENGTH             18      /* aMaxSIFSFrameSize */
+
+#define TERMINATION_EVENTS          (RF_EventLastCmdDone | RF_EventLastFGCmdDone | \
+                                     RF_EventCmdCancelled | RF_EventCmdAborted | RF_EventCmdStopped | \
+                                     RF_EventCmdPreempted)
+
+#define NEVER                       UINT64_MAX
+#define PAST                        (UINT64_MAX - 1)    /* Absolute start time missed */
+
+/***** Type declarations *****/
+typedef struct
+{
+    RF_Handle client;
+    RF_CmdHandle handle;
+    RF_Op *pOp;                 /* First command of the chain */
+    RF_Callback pCb;
+    RF_EventMask bmEvent;
+    RF_EventMask events;        /* All events so far */
+    RF_EventMask returned;      /* Events already returned by RF_pendCmd() */
+    bool queued;
+    bool running;
+    bool done;
+    bool foreground;
+    uint16_t priority;          /* RF_Priority from activityInfo, normal for RF_postCmd() */
+    uint64_t submitTime;
+
+    /* Chain state */
+    RF_Op *op;                  /* Current command */
+    bool opResult;
+    uint16_t opStatus;
+    uint64_t firstStart;
+    uint64_t prevStart;
+    uint64_t prevEnd;
+    RF_EventMask doneEvents;    /* Events of the last command, reported after SIM_RF_DONE_US */
+    Sim_Event event;
+} Cmd;
+
+/***** Prototypes *****/
+static Cmd *findCmd(RF_CmdHandle ch);
+static uint64_t triggerTime(const Cmd *cmd, rfc_trig_t trig, ratmr_t time, uint64_t start);
+static void dispatch(void);
+static void powerUp(RF_Handle h);
+static void wakeUpFor(Cmd *cmd);
+static void wakeUpEvent(void *arg);
+static void powerDown(void);
+static void startChain(Cmd *cmd, bool foreground);
+static void scheduleOp(Cmd *cmd);
+static void beginOp(void *arg);
+static void endOp(void *arg);
+static void finishChain(Cmd *cmd, RF_EventMask events, bool delayed);
+static void doneEvent(void *arg);
+static void stopChain(Cmd *cmd, bool graceful);
+static bool preempts(const Cmd *cmd);
+static RF_CmdHandle post(RF_Handle h, RF_Op *pOp, uint16_t priority, RF_Callback pCb,
+                         RF_EventMask bmEvent);
+static void notify(Cmd *cmd, RF_EventMask events);
+static bool isDone(void *arg);
+static bool hasNewEvents(void *arg);
+static bool isListening(void);
+static void peerFrameStart(void *arg);
+static void peerFrameEnd(void *arg);
+static void receiveFrame(const uint8_t *psdu, uint8_t length, bool crcError, int8_t rssi,
+                         uint32_t timeStamp);
+
+/***** Variable declarations *****/
+extern const RFCC26XX_HWAttrsV2 RFCC26XX_hwAttrs;
+
+static SimRf_Params simParams = { .ackPercent = 100, .ccaBusyPercent = 0 };
+static SimRf_TxHook txHook;
+static SimRf_Stats stats;
+
+static Cmd cmds[MAX_CMDS];
+static uint32_t nextCmd;
+static RF_CmdHandle nextHandle;
+static Cmd *queue[MAX_CMDS];
+static uint32_t numQueued;
+static Cmd *mainCmd;            /* Chain running in the foreground or background slot */
+static Cmd *fgCmd;              /* Foreground chain on top of a background RX */
+
+static bool initialized;
+static bool radioOn;
+static bool setupPending;
+static bool fsProgrammed;
+static uint16_t fsFrequency;    /* MHz, kept across power-downs like the driver does */
+static bool yieldPending;
+static uint64_t readyTime;
+static uint64_t powerUpTime;
+static Sim_Event wakeUpEventObj;  /* Deferred power-up for an absolute start */
+static RF_Handle currentClient;
+static RF_TxPowerTable_Value txPower;
+
+static RF_EventMask pendMask;
+
+/* The peer's frame on air */
+static bool peerStarted;
+static Sim_Event peerEvent;
+static uint8_t peerSeq;
+static bool peerHeard;
+static uint64_t peerFrameTime;
+
+
+/***** Function definitions *****/
+
+void SimRf_Params_init(SimRf_Params *params)
+{
+    params->ackPercent = 100;
+    params->ccaBusyPercent = 0;
+    params->peerLength = 0;
+    params->peerCount = 0;
+    params->peerGapUs = 0;
+    params->peerLossPercent = 0;
+    params->peerCrcPercent = 0;
+    params->peerRssi = -60;
+}
+
+void SimRf_configure(const SimRf_Params *params)
+{
+    simParams = *params;
+}
+
+void SimRf_setTxHook(SimRf_TxHook hook)
+{
+    txHook = hook;
+}
+
+bool SimRf_isOn(void)
+{
+    return radioOn;
+}
+
+void SimRf_getStats(SimRf_Stats *pStats)
+{
+    *pStats = stats;
+    if (radioOn)
+    {
+        pStats->onTicks += Sim_now() - powerUpTime;
+    }
+}
+
+static Cmd *findCmd(RF_CmdHandle ch)
+{
+    uint32_t i;
+
+    for (i = 0; i < MAX_CMDS; i++)
+    {
+        if ((cmds[i].client != NULL) && (cmds[i].handle == ch))
+        {
+            return &cmds[i];
+        }
+    }
+    return NULL;
+}
+
+static uint64_t triggerTime(const Cmd *cmd, rfc_trig_t trig, ratmr_t time, uint64_t start)
+{
+    uint64_t now = Sim_now();
+
+    switch (trig.triggerType)
+    {
+        case TRIG_NOW:
+            return now;
+
+        case TRIG_NEVER:
+            return NEVER;
+
+        case TRIG_ABSTIME:
+        {
+            /* RAT time wraps every ~18 minutes: the closest match wins */
+            int32_t delta = (int32_t)(time - (uint32_t)now);
+            if (delta >= 0)
+            {
+                return now + (uint32_t)delta;
+            }
+            return trig.pastTrig ? now : PAST;
+        }
+
+        case TRIG_REL_SUBMIT:
+            return cmd->submitTime + time;
+
+        case TRIG_REL_START:
+            return start + time;
+
+        case TRIG_REL_PREVSTART:
+            return cmd->prevStart + time;
+
+        case TRIG_REL_FIRSTSTART:
+            return cmd->firstStart + time;
+
+        case TRIG_REL_PREVEND:
+            return cmd->prevEnd + time;
+
+        default:
+            return now;
+    }
+}
+
+static void powerUp(RF_Handle h)
+{
+    uint64_t now = Sim_now();
+
+    if (!radioOn)
+    {
+        radioOn = true;
+        powerUpTime = now;
+        stats.numPowerUps++;
+        stats.numSetups++;
+        readyTime = now + SIM_US(SIM_RF_POWER_UP_US);
+        setupPending = false;
+
+        /* The crystal may already be running */
+        uint64_t xoscTicks = SimPower_getXoscTicks();
+        readyTime -= (xoscTicks < SIM_US(SIM_XOSC_HF_US)) ? xoscTicks : SIM_US(SIM_XOSC_HF_US);
+
+        if (fsProgrammed)
+        {
+            stats.numFs++;
+            readyTime += SIM_US(SIM_RF_FS_US);
+        }
+    }
+    else if (setupPending)
+    {
+        setupPending = false;
+        stats.numSetups++;
+        readyTime = ((readyTime > now) ? readyTime : now) + SIM_US(SIM_RF_SETUP_US);
+    }
+    else
+    {
+        return;
+    }
+
+    currentClient = h;
+    if ((RFCC26XX_hwAttrs.globalCallback != NULL) &&
+        (RFCC26XX_hwAttrs.globalEventMask & RF_GlobalEventRadioSetup))
+    {
+        RFCC26XX_hwAttrs.globalCallback(h, RF_GlobalEventRadioSetup, h->pRadioSetup);
+    }
+}
+
+/* Like the driver, power up for a chain with an absolute start only just
+ * in time for it, so the device can sleep until then */
+static void wakeUpFor(Cmd *cmd)
+{
+    RF_Op *op = cmd->pOp;
+    uint64_t now = Sim_now();
+
+    if (!radioOn && (op->startTrigger.triggerType == TRIG_ABSTIME))
+    {
+        uint64_t start = triggerTime(cmd, op->startTrigger, op->startTime, now);
+        uint64_t powerUpTicks = SIM_US(SIM_RF_POWER_UP_US + (fsProgrammed ? SIM_RF_FS_US : 0));
+
+        if ((start != PAST) && (start > now + powerUpTicks))
+        {
+            Sim_schedule(&wakeUpEventObj, start - powerUpTicks, wakeUpEvent, cmd->client);
+            return;
+        }
+    }
+
+    powerUp(cmd->client);
+}
+
+static void wakeUpEvent(void *arg)
+{
+    powerUp(arg);
+}
+
+static void powerDown(void)
+{
+    if (!radioOn)
+    {
+        return;
+    }
+
+    radioOn = false;
+    yieldPending = false;
+    stats.onTicks += Sim_now() - powerUpTime;
+
+    if ((RFCC26XX_hwAttrs.globalCallback != NULL) &&
+        (RFCC26XX_hwAttrs.globalEventMask & RF_GlobalEventRadioPowerDown))
+    {
+        RFCC26XX_hwAttrs.globalCallback(currentClient, RF_GlobalEventRadioPowerDown, NULL);
+    }
+}
+
+static bool isForegroundOp(uint16_t commandNo)
+{
+    return (commandNo == CMD_IEEE_TX) || (commandNo == CMD_IEEE_CSMA) ||
+           (commandNo == CMD_IEEE_RX_ACK);
+}
+
+static void dispatch(void)
+{
+    while (numQueued > 0)
+    {
+        Cmd *cmd = queue[0];
+        bool foreground;
+
+        if (mainCmd == NULL)
+        {
+            foreground = false;
+        }
+        else if (preempts(cmd))
+        {
+            /* Aborting the RX dispatches again, which starts cmd */
+            Cmd *preempted = mainCmd;
+            stats.numPreemptions++;
+            preempted->op->status = IEEE_DONE_ABORT;
+            finishChain(preempted, RF_EventCmdPreempted | RF_EventCmdAborted, false);
+            continue;
+        }
+        else if ((fgCmd == NULL) && (mainCmd->op->commandNo == CMD_IEEE_RX) &&
+                 (mainCmd->op->status == ACTIVE) && isForegroundOp(cmd->pOp->commandNo))
+        {
+            foreground = true;
+        }
+        else
+        {
+            return;
+        }
+
+        numQueued--;
+        memmove(&queue[0], &queue[1], numQueued * sizeof(queue[0]));
+        startChain(cmd, foreground);
+    }
+
+    if ((mainCmd == NULL) && yieldPending)
+    {
+        powerDown();
+    }
+}
+
+/* Higher priority than the background RX of another client, which has
+ * nothing in the foreground */
+static bool preempts(const Cmd *cmd)
+{
+    return (mainCmd != NULL) && (fgCmd == NULL) && (mainCmd->client != cmd->client) &&
+           (mainCmd->op->commandNo == CMD_IEEE_RX) && (cmd->priority > mainCmd->priority);
+}
+
+static void startChain(Cmd *cmd, bool foreground)
+{
+    cmd->queued = false;
+    cmd->running = true;
+    cmd->foreground = foreground;
+    cmd->op = cmd->pOp;
+    cmd->firstStart = NEVER;
+
+    if (foreground)
+    {
+        fgCmd = cmd;
+    }
+    else
+    {
+        mainCmd = cmd;
+        wakeUpFor(cmd);
+    }
+
+    scheduleOp(cmd);
+}
+
+static void scheduleOp(Cmd *cmd)
+{
+    RF_Op *op = cmd->op;
+    uint64_t start = triggerTime(cmd, op->startTrigger, op->startTime, Sim_now());
+
+    op->status = PENDING;
+
+    if (start == PAST)
+    {
+        /* Absolute start time in the past without pastTrig */
+        cmd->opStatus = ERROR_PAST_START;
+        cmd->opResult = false;
+        Sim_schedule(&cmd->event, Sim_now(), endOp, cmd);
+        return;
+    }
+    if (start == NEVER)
+    {
+        /* Waits for RF_cancelCmd() */
+        return;
+    }
+    if (start < readyTime)
+    {
+        start = readyTime;
+    }
+    if ((cmd->firstStart == NEVER) && (start < Sim_now() + SIM_US(SIM_RF_DISPATCH_US)))
+    {
+        /* Driver and radio core overhead before a chain can start */
+        start = Sim_now() + SIM_US(SIM_RF_DISPATCH_US);
+    }
+
+    Sim_schedule(&cmd->event, start, beginOp, cmd);
+}
+
+static uint64_t runTx(Cmd *cmd, rfc_CMD_IEEE_TX_t *tx, uint64_t now)
+{
+    if (!fsProgrammed)
+    {
+        cmd->opStatus = IEEE_ERROR_NO_FS;
+        cmd->opResult = false;
+        stats.numTxErrors++;
+        return now;
+    }
+
+    uint32_t psduLength = tx->payloadLen + (tx->txOpt.bIncludeCrc ? 0 : 2);
+    uint64_t air = SIM_US((uint64_t)(SIM_RF_SHR_PHR_BYTES + psduLength) * SIM_RF_BYTE_US);
+
+    tx->timeStamp = (ratmr_t)(now + SIM_US(SIM_RF_TX_STARTUP_US));
+    if (txHook != NULL)
+    {
+        txHook(tx->pPayload, tx->payloadLen, tx->timeStamp, fsFrequency);
+    }
+
+    stats.numTx++;
+    stats.txBytes += psduLength;
+    stats.airTicks += air;
+    cmd->opStatus = IEEE_DONE_OK;
+    cmd->opResult = true;
+
+    return now + SIM_US(SIM_RF_TX_STARTUP_US) + air;
+}
+
+static uint64_t runCsma(Cmd *cmd, rfc_CMD_IEEE_CSMA_t *csma, uint64_t now)
+{
+    uint64_t t = now;
+
+    stats.numCsma++;
+
+    /* The outcome of every CCA is drawn up front, so the whole procedure is
+     * one event */
+    while (1)
+    {
+        t += SIM_US((uint64_t)(Sim_random() % (1u << csma->BE)) * UNIT_BACKOFF_US);
+        t += SIM_US(CCA_US);
+
+        if ((Sim_random() % 100) >= simParams.ccaBusyPercent)
+        {
+            csma->lastRssi = -100;
+            cmd->opStatus = IEEE_DONE_OK;
+            cmd->opResult = true;
+            break;
+        }
+
+        csma->lastRssi = -50;
+        if (csma->NB >= csma->macMaxCSMABackoffs)
+        {
+            stats.numCsmaBusy++;
+            cmd->opStatus = IEEE_DONE_BUSY;
+            cmd->opResult = false;
+            break;
+        }
+
+        csma->NB++;
+        stats.numBackoffs++;
+        if (csma->BE < csma->macMaxBE)
+        {
+            csma->BE++;
+        }
+    }
+
+    csma->lastTimeStamp = (ratmr_t)t;
+
+    return t;
+}
+
+static uint64_t runRxAck(Cmd *cmd, rfc_CMD_IEEE_RX_ACK_t *rxAck, uint64_t now)
+{
+    uint64_t end = triggerTime(cmd, rxAck->endTrigger, rxAck->endTime, now);
+    if (end == PAST)
+    {
+        end = now;
+    }
+
+    stats.numRxAck++;
+
+    if ((Sim_random() % 100) < simParams.ackPercent)
+    {
+        uint64_t ackTime = now + SIM_US(ACK_TURNAROUND_US +
+                                        (SIM_RF_SHR_PHR_BYTES + SIM_RF_ACK_BYTES) * SIM_RF_BYTE_US);
+        if (ackTime <= end)
+        {
+            stats.numAcks++;
+            cmd->opStatus = IEEE_DONE_ACK;
+            cmd->opResult = true;
+            return ackTime;
+        }
+    }
+
+    cmd->opStatus = IEEE_DONE_TIMEOUT;
+    cmd->opResult = false;
+
+    return end;
+}
+
+/* Listening: a CMD_IEEE_RX with a queue is active on a programmed
+ * synthesizer and no foreground command has the radio */
+static bool isListening(void)
+{
+    return (mainCmd != NULL) && (mainCmd->op->commandNo == CMD_IEEE_RX) &&
+           (mainCmd->op->status == ACTIVE) && (fgCmd == NULL) && fsProgrammed &&
+           (((rfc_CMD_IEEE_RX_t *)mainCmd->op)->pRxQ != NULL);
+}
+
+static void peerFrameStart(void *arg)
+{
+    peerFrameTime = Sim_now();
+    peerHeard = isListening();
+
+    uint64_t air = SIM_US((uint64_t)(SIM_RF_SHR_PHR_BYTES + simParams.peerLength + 2) * SIM_RF_BYTE_US);
+    Sim_schedule(&peerEvent, peerFrameTime + air, peerFrameEnd, NULL);
+}
+
+static void peerFrameEnd(void *arg)
+{
+    uint8_t psdu[125];
+    uint8_t i;
+
+    /* Broadcast data frame, PAN ID compression, short addresses */
+    psdu[0] = 0x41;
+    psdu[1] = 0x88;
+    psdu[2] = peerSeq;
+    psdu[3] = 0x00;
+    psdu[4] = 0x00;
+    psdu[5] = 0xFF;
+    psdu[6] = 0xFF;
+    psdu[7] = PEER_ADDR & 0xFF;
+    psdu[8] = PEER_ADDR >> 8;
+    for (i = PEER_HDR_LENGTH; i < simParams.peerLength; i++)
+    {
+        psdu[i] = (uint8_t)(peerSeq + i);
+    }
+
+    stats.numPeerFrames++;
+    if ((Sim_random() % 100) < simParams.peerLossPercent)
+    {
+        stats.numPeerLost++;
+    }
+    else if (!peerHeard || !isListening())
+    {
+        stats.numPeerDeaf++;
+    }
+    else
+    {
+        bool crcError = (Sim_random() % 100) < simParams.peerCrcPercent;
+        int8_t rssi = (int8_t)(simParams.peerRssi - 10 + (int32_t)(Sim_random() % 21));
+        receiveFrame(psdu, simParams.peerLength, crcError, rssi, (uint32_t)peerFrameTime);
+    }
+    peerSeq++;
+
+    if (stats.numPeerFrames < simParams.peerCount)
+    {
+        uint32_t gapUs = simParams.peerGapUs;
+        if (gapUs == 0)
+        {
+            gapUs = (simParams.peerLength + 2 > MAX_SIFS_LENGTH) ? SIM_RF_LIFS_US : SIM_RF_SIFS_US;
+        }
+        Sim_schedule(&peerEvent, Sim_now() + SIM_US(gapUs), peerFrameStart, NULL);
+    }
+}
+
+static void receiveFrame(const uint8_t *psdu, uint8_t length, bool crcError, int8_t rssi,
+                         uint32_t timeStamp)
+{
+    Cmd *cmd = mainCmd;
+    rfc_CMD_IEEE_RX_t *rx = (rfc_CMD_IEEE_RX_t *)cmd->op;
+    rfc_ieeeRxOutput_t *output = rx->pOutput;
+    rfc_dataEntryGeneral_t *entry = (rfc_dataEntryGeneral_t *)rx->pRxQ->pCurrEntry;
+
+    if (output != NULL)
+    {
+        if (crcError)
+        {
+            output->nRxNok++;
+        }
+        else
+        {
+            output->nRxData++;
+        }
+        output->lastRssi = rssi;
+        if (rssi > output->maxRssi)
+        {
+            output->maxRssi = rssi;
+        }
+    }
+    if (crcError && rx->rxConfig.bAutoFlushCrc)
+    {
+        notify(cmd, RF_EventRxNOk);
+        return;
+    }
+
+    uint32_t lenSz = (entry != NULL) ? entry->config.lenSz : 0;
+    uint32_t size = length + (rx->rxConfig.bIncludeCrc ? 2 : 0) + (rx->rxConfig.bAppendRssi ? 1 : 0) +
+                    (rx->rxConfig.bAppendCorrCrc ? 1 : 0) + (rx->rxConfig.bAppendSrcInd ? 1 : 0) +
+                    (rx->rxConfig.bAppendTimestamp ? 4 : 0);
+    if ((entry == NULL) || (entry->status != DATA_ENTRY_PENDING) || (entry->length < lenSz + size))
+    {
+        stats.numPeerBufFull++;
+        if (output != NULL)
+        {
+            output->nRxBufFull++;
+        }
+        notify(cmd, RF_EventRxBufFull);
+        return;
+    }
+
+    uint8_t *p = &entry->data;
+    if (lenSz > 0)
+    {
+        *p++ = (uint8_t)size;
+    }
+    if (lenSz > 1)
+    {
+        *p++ = (uint8_t)(size >> 8);
+    }
+    memcpy(p, psdu, length);
+    p += length;
+    if (rx->rxConfig.bIncludeCrc)
+    {
+        /* Not a real CRC; nobody checks it */
+        *p++ = crcError ? 0xFF : 0x00;
+        *p++ = 0x00;
+    }
+    if (rx->rxConfig.bAppendRssi)
+    {
+        *p++ = (uint8_t)rssi;
+    }
+    if (rx->rxConfig.bAppendCorrCrc)
+    {
+        /* Best correlation, bCrcErr in the top bit */
+        *p++ = 0x3F | (crcError ? 0x80 : 0x00);
+    }
+    if (rx->rxConfig.bAppendSrcInd)
+    {
+        *p++ = 0;
+    }
+    if (rx->rxConfig.bAppendTimestamp)
+    {
+        p[0] = (uint8_t)timeStamp;
+        p[1] = (uint8_t)(timeStamp >> 8);
+        p[2] = (uint8_t)(timeStamp >> 16);
+        p[3] = (uint8_t)(timeStamp >> 24);
+    }
+
+    /* The last entry of a linear queue ends it */
+    entry->status = DATA_ENTRY_FINISHED;
+    rx->pRxQ->pCurrEntry = ((uint8_t *)entry == rx->pRxQ->pLastEntry) ? NULL : entry->pNextEntry;
+    stats.numPeerReceived++;
+
+    notify(cmd, RF_EventRxEntryDone | (crcError ? RF_EventRxNOk : RF_EventRxOk));
+}
+
+static void beginOp(void *arg)
+{
+    Cmd *cmd = arg;
+    RF_Op *op = cmd->op;
+    uint64_t now = Sim_now();
+    uint64_t end = now;
+
+    op->status = ACTIVE;
+    stats.numCmds++;
+    if (cmd->firstStart == NEVER)
+    {
+        cmd->firstStart = now;
+    }
+    cmd->prevStart = now;
+    cmd->opStatus = DONE_OK;
+    cmd->opResult = true;
+
+    switch (op->commandNo)
+    {
+        case CMD_RADIO_SETUP:
+            end = now + SIM_US(SIM_RF_SETUP_US);
+            stats.numSetups++;
+            fsProgrammed = false;
+            break;
+
+        case CMD_FS:
+            end = now + SIM_US(SIM_RF_FS_US);
+            stats.numFs++;
+            fsProgrammed = true;
+            fsFrequency = ((rfc_CMD_FS_t *)op)->frequency;
+            break;
+
+        case CMD_IEEE_TX:
+            end = runTx(cmd, (rfc_CMD_IEEE_TX_t *)op, now);
+            break;
+
+        case CMD_IEEE_CSMA:
+            end = cmd->foreground ? runCsma(cmd, (rfc_CMD_IEEE_CSMA_t *)op, now) : now;
+            if (!cmd->foreground)
+            {
+                cmd->opStatus = ERROR_NO_RX;
+                cmd->opResult = false;
+            }
+            break;
+
+        case CMD_IEEE_RX_ACK:
+            end = cmd->foreground ? runRxAck(cmd, (rfc_CMD_IEEE_RX_ACK_t *)op, now) : now;
+            if (!cmd->foreground)
+            {
+                cmd->opStatus = ERROR_NO_RX;
+                cmd->opResult = false;
+            }
+            break;
+
+        case CMD_IEEE_RX:
+        {
+            rfc_CMD_IEEE_RX_t *rx = (rfc_CMD_IEEE_RX_t *)op;
+            end = triggerTime(cmd, rx->endTrigger, rx->endTime, now);
+            if (end == PAST)
+            {
+                end = now;
+            }
+            cmd->opStatus = IEEE_DONE_OK;
+            if ((rx->pRxQ != NULL) && (simParams.peerCount > 0) && !peerStarted)
+            {
+                peerStarted = true;
+                Sim_schedule(&peerEvent, now + SIM_US(PEER_START_US), peerFrameStart, NULL);
+            }
+            /* Foreground commands may have been waiting for this one */
+            dispatch();
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if (end != NEVER)
+    {
+        Sim_schedule(&cmd->event, end, endOp, cmd);
+    }
+}
+
+static void endOp(void *arg)
+{
+    Cmd *cmd = arg;
+    RF_Op *op = cmd->op;
+    RF_EventMask events = cmd->foreground ? RF_EventFGCmdDone : RF_EventCmdDone;
+    RF_Op *next = (RF_Op *)op->pNextOp;
+    bool result = cmd->opResult;
+
+    op->status = cmd->opStatus;
+    cmd->prevEnd = Sim_now();
+
+    if ((op->commandNo == CMD_IEEE_TX) && (op->status == IEEE_DONE_OK))
+    {
+        events |= RF_EventTxDone;
+    }
+
+    if (op->status & 0x0800)
+    {
+        /* Errors end the chain */
+        next = NULL;
+    }
+    else
+    {
+        switch (op->condition.rule)
+        {
+            case COND_ALWAYS:
+                break;
+
+            case COND_NEVER:
+                next = NULL;
+                break;
+
+            case COND_STOP_ON_FALSE:
+                next = result ? next : NULL;
+                break;
+
+            case COND_STOP_ON_TRUE:
+                next = result ? NULL : next;
+                break;
+
+            case COND_SKIP_ON_FALSE:
+            case COND_SKIP_ON_TRUE:
+                if (result == (op->condition.rule == COND_SKIP_ON_TRUE))
+                {
+                    /* nSkip 0 repeats this command, 1 is the next one */
+                    uint8_t i;
+                    next = op;
+                    for (i = 0; (i < op->condition.nSkip) && (next != NULL); i++)
+                    {
+                        next = (RF_Op *)next->pNextOp;
+                    }
+                }
+                break;
+
+            default:
+                next = NULL;
+                break;
+        }
+    }
+
+    if (next == NULL)
+    {
+        finishChain(cmd, events, true);
+        return;
+    }
+
+    notify(cmd, events);
+    cmd->op = next;
+    scheduleOp(cmd);
+}
+
+/* The radio is free for the next queued command right away. A chain that
+ * ran to its end is reported to the client SIM_RF_DONE_US later. */
+static void finishChain(Cmd *cmd, RF_EventMask events, bool delayed)
+{
+    Sim_cancel(&cmd->event);
+
+    cmd->running = false;
+
+    if (cmd == fgCmd)
+    {
+        fgCmd = NULL;
+        events |= RF_EventLastFGCmdDone;
+    }
+    else
+    {
+        mainCmd = NULL;
+        events |= RF_EventLastCmdDone;
+        Sim_cancel(&wakeUpEventObj);
+
+        /* A foreground chain cannot outlive its background command */
+        if (fgCmd != NULL)
+        {
+            Cmd *fg = fgCmd;
+            fg->op->status = IEEE_DONE_BGEND;
+            finishChain(fg, RF_EventFGCmdDone, false);
+        }
+    }
+
+    if (delayed)
+    {
+        cmd->doneEvents = events;
+        Sim_schedule(&cmd->event, Sim_now() + SIM_US(SIM_RF_DONE_US), doneEvent, cmd);
+    }
+    else
+    {
+        cmd->done = true;
+        notify(cmd, events);
+    }
+    dispatch();
+}
+
+static void doneEvent(void *arg)
+{
+    Cmd *cmd = arg;
+    cmd->done = true;
+    notify(cmd, cmd->doneEvents);
+}
+
+static void stopChain(Cmd *cmd, bool graceful)
+{
+    RF_Op *op = cmd->op;
+    bool ieee = ((op->commandNo & 0xF000) == 0x2000);
+
+    stats.numCancels++;
+
+    if (op->status == ACTIVE)
+    {
+        if (graceful)
+        {
+            op->status = ieee ? IEEE_DONE_STOPPED : DONE_STOPPED;
+        }
+        else
+        {
+            op->status = ieee ? IEEE_DONE_ABORT : DONE_ABORT;
+        }
+    }
+    else if (op->status == PENDING)
+    {
+        /* Never started */
+        op->status = IDLE;
+    }
+
+    finishChain(cmd, graceful ? RF_EventCmdStopped : RF_EventCmdAborted, false);
+}
+
+static void notify(Cmd *cmd, RF_EventMask events)
+{
+    cmd->events |= events;
+
+    RF_EventMask callbackEvents = events & (cmd->bmEvent | TERMINATION_EVENTS);
+    if ((cmd->pCb != NULL) && (callbackEvents != 0))
+    {
+        cmd->pCb(cmd->client, cmd->handle, callbackEvents);
+    }
+}
+
+static bool isDone(void *arg)
+{
+    return ((Cmd *)arg)->done;
+}
+
+static bool hasNewEvents(void *arg)
+{
+    Cmd *cmd = arg;
+    return cmd->done || ((cmd->events & ~cmd->returned & pendMask) != 0);
+}
+
+void RF_Params_init(RF_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->nInactivityTimeout = UINT32_MAX;
+}
+
+void RF_ScheduleCmdParams_init(RF_ScheduleCmdParams *pSchParams)
+{
+    memset(pSchParams, 0, sizeof(*pSchParams));
+    pSchParams->allowDelay = RF_AllowDelayAny;
+}
+
+RF_Handle RF_open(RF_Object *pObj, RF_Mode *pRfMode, RF_RadioSetup *pRadioSetup, RF_Params *params)
+{
+    pObj->pRfMode = pRfMode;
+    pObj->pRadioSetup = pRadioSetup;
+    if (params != NULL)
+    {
+        pObj->params = *params;
+    }
+    else
+    {
+        RF_Params_init(&pObj->params);
+    }
+
+    stats.numOpens++;
+
+    if (!initialized)
+    {
+        initialized = true;
+        if ((RFCC26XX_hwAttrs.globalCallback != NULL) &&
+            (RFCC26XX_hwAttrs.globalEventMask & RF_GlobalEventInit))
+        {
+            RFCC26XX_hwAttrs.globalCallback(pObj, RF_GlobalEventInit, NULL);
+        }
+    }
+
+    /* The setup command carries the initial TX power */
+    txPower.rawValue = pRadioSetup->common.txPower;
+    txPower.paType = RF_TxPowerTable_DefaultPA;
+    currentClient = pObj;
+
+    return pObj;
+}
+
+void RF_close(RF_Handle h)
+{
+    RF_flushCmd(h, RF_CMDHANDLE_FLUSH_ALL, 0);
+    powerDown();
+    fsProgrammed = false;
+}
+
+uint32_t RF_getCurrentTime(void)
+{
+    return (uint32_t)Sim_now();
+}
+
+static RF_CmdHandle post(RF_Handle h, RF_Op *pOp, uint16_t priority, RF_Callback pCb,
+                         RF_EventMask bmEvent)
+{
+    uint32_t i;
+    uint32_t numPending = 0;
+
+    for (i = 0; i < MAX_CMDS; i++)
+    {
+        if ((cmds[i].client == h) && !cmds[i].done)
+        {
+            numPending++;
+        }
+    }
+    if (numPending >= MAX_QUEUED)
+    {
+        return RF_ALLOC_ERROR;
+    }
+
+    /* Reuse the oldest finished entry */
+    Cmd *cmd = NULL;
+    for (i = 0; i < MAX_CMDS; i++)
+    {
+        Cmd *c = &cmds[(nextCmd + i) % MAX_CMDS];
+        if ((c->client == NULL) || c->done)
+        {
+            cmd = c;
+            nextCmd = (nextCmd + i + 1) % MAX_CMDS;
+            break;
+        }
+    }
+    if (cmd == NULL)
+    {
+        return RF_ALLOC_ERROR;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->client = h;
+    cmd->handle = nextHandle;
+    nextHandle = (nextHandle == INT16_MAX) ? 0 : (nextHandle + 1);
+    cmd->pOp = pOp;
+    cmd->pCb = pCb;
+    cmd->bmEvent = bmEvent;
+    cmd->priority = priority;
+    cmd->queued = true;
+    cmd->submitTime = Sim_now();
+    yieldPending = false;
+
+    queue[numQueued++] = cmd;
+    dispatch();
+
+    return cmd->handle;
+}
+
+/* Like the multi-mode driver, ePri is not used */
+RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op *pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent)
+{
+    (void)ePri;
+    return post(h, pOp, RF_PriorityNormal, pCb, bmEvent);
+}
+
+RF_CmdHandle RF_scheduleCmd(RF_Handle h, RF_Op *pOp, RF_ScheduleCmdParams *pSchParams,
+                            RF_Callback pCb, RF_EventMask bmEvent)
+{
+    /* The driver refuses a command it cannot start within allowDelay of an
+     * absolute start time. Only a start already missed is modelled. */
+    if ((pSchParams != NULL) && (pSchParams->startType == RF_StartAbs) &&
+        (pSchParams->allowDelay != RF_AllowDelayAny) &&
+        ((int32_t)(RF_getCurrentTime() - pSchParams->startTime) > (int32_t)pSchParams->allowDelay))
+    {
+        return RF_ALLOC_ERROR;
+    }
+
+    /* Nor one that can not start before its absolute end time */
+    if ((pSchParams != NULL) && (pSchParams->endType == RF_EndAbs) &&
+        ((int32_t)(pSchParams->endTime - (RF_getCurrentTime() + SIM_US(SIM_RF_DISPATCH_US))) < 0))
+    {
+        return RF_ALLOC_ERROR;
+    }
+
+    return post(h, pOp, (pSchParams != NULL) ? SIM_RF_PRIORITY(pSchParams->activityInfo) : RF_PriorityNormal,
+                pCb, bmEvent);
+}
+
+RF_EventMask RF_pendCmd(RF_Handle h, RF_CmdHandle ch, RF_EventMask bmEvent)
+{
+    Cmd *cmd = findCmd(ch);
+
+    (void)h;
+
+    if (cmd == NULL)
+    {
+        return 0;
+    }
+
+    pendMask = bmEvent | TERMINATION_EVENTS;
+    Sim_waitUntil(hasNewEvents, cmd);
+
+    RF_EventMask events = cmd->events & ~cmd->returned & (bmEvent | TERMINATION_EVENTS);
+    cmd->returned |= events;
+
+    return events;
+}
+
+RF_EventMask RF_runCmd(RF_Handle h, RF_Op *pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent)
+{
+    RF_CmdHandle ch = RF_postCmd(h, pOp, ePri, pCb, bmEvent);
+    if (ch < 0)
+    {
+        return RF_EventCmdCancelled;
+    }
+
+    Cmd *cmd = findCmd(ch);
+    Sim_waitUntil(isDone, cmd);
+
+    return cmd->events & TERMINATION_EVENTS;
+}
+
+RF_EventMask RF_runScheduleCmd(RF_Handle h, RF_Op *pOp, RF_ScheduleCmdParams *pSchParams,
+                               RF_Callback pCb, RF_EventMask bmEvent)
+{
+    RF_CmdHandle ch = RF_scheduleCmd(h, pOp, pSchParams, pCb, bmEvent);
+    if (ch < 0)
+    {
+        return RF_EventCmdCancelled;
+    }
+
+    Cmd *cmd = findCmd(ch);
+    Sim_waitUntil(isDone, cmd);
+
+    return cmd->events & TERMINATION_EVENTS;
+}
+
+RF_Stat RF_cancelCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode)
+{
+    Cmd *cmd = findCmd(ch);
+    uint32_t i;
+
+    (void)h;
+
+    /* Also a chain that ended but is not reported yet */
+    if ((cmd == NULL) || cmd->done || (!cmd->running && !cmd->queued))
+    {
+        return RF_StatCmdDoneError;
+    }
+
+    if (cmd->queued)
+    {
+        for (i = 0; i < numQueued; i++)
+        {
+            if (queue[i] == cmd)
+            {
+                numQueued--;
+                memmove(&queue[i], &queue[i + 1], (numQueued - i) * sizeof(queue[0]));
+                break;
+            }
+        }
+        cmd->queued = false;
+        cmd->done = true;
+        stats.numCancels++;
+        notify(cmd, RF_EventCmdCancelled);
+        return RF_StatSuccess;
+    }
+
+    stopChain(cmd, (mode & RF_ABORT_GRACEFULLY) != 0);
+
+    return RF_StatSuccess;
+}
+
+RF_Stat RF_flushCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode)
+{
+    int32_t i;
+
+    /* Queued commands first, newest first, so nothing starts in between */
+    for (i = (int32_t)numQueued - 1; i >= 0; i--)
+    {
+        Cmd *cmd = queue[i];
+        if ((cmd->client == h) && ((ch == RF_CMDHANDLE_FLUSH_ALL) || (cmd->handle >= ch)))
+        {
+            RF_cancelCmd(h, cmd->handle, mode);
+        }
+    }
+
+    if ((fgCmd != NULL) && (fgCmd->client == h) &&
+        ((ch == RF_CMDHANDLE_FLUSH_ALL) || (fgCmd->handle >= ch)))
+    {
+        RF_cancelCmd(h, fgCmd->handle, mode);
+    }
+    if ((mainCmd != NULL) && (mainCmd->client == h) &&
+        ((ch == RF_CMDHANDLE_FLUSH_ALL) || (mainCmd->handle >= ch)))
+    {
+        RF_cancelCmd(h, mainCmd->handle, mode);
+    }
+
+    return RF_StatSuccess;
+}
+
+void RF_yield(RF_Handle h)
+{
+    (void)h;
+
+    if ((mainCmd == NULL) && (numQueued == 0))
+    {
+        powerDown();
+    }
+    else
+    {
+        yieldPending = true;
+    }
+}
+
+RF_Stat RF_control(RF_Handle h, int8_t ctrl, void *args)
+{
+    (void)h;
+    (void)ctrl;
+    (void)args;
+    return RF_StatSuccess;
+}
+
+RF_Op *RF_getCmdOp(RF_Handle h, RF_CmdHandle cmdHnd)
+{
+    Cmd *cmd = findCmd(cmdHnd);
+
+    (void)h;
+
+    return (cmd != NULL) ? cmd->pOp : NULL;
+}
+
+RF_TxPowerTable_Value RF_getTxPower(RF_Handle h)
+{
+    (void)h;
+    return txPower;
+}
+
+RF_Stat RF_setTxPower(RF_Handle h, RF_TxPowerTable_Value value)
+{
+    (void)h;
+
+    if (value.paType != txPower.paType)
+    {
+        /* Other PA, other overrides: the next chain runs a radio setup */
+        stats.numPaSwitches++;
+        setupPending = true;
+        fsProgrammed = false;
+    }
+    txPower = value;
+
+    return RF_StatSuccess;
+}
+
+int8_t RF_TxPowerTable_findPowerLevel(RF_TxPowerTable_Entry table[], RF_TxPowerTable_Value value)
+{
+    uint32_t i;
+
+    for (i = 0; table[i].power != RF_TxPowerTable_INVALID_DBM; i++)
+    {
+        if ((table[i].value.rawValue == value.rawValue) &&
+            (table[i].value.paType == value.paType))
+        {
+            return table[i].power;
+        }
+    }
+    return RF_TxPowerTable_INVALID_DBM;
+}
+
+RF_TxPowerTable_Value RF_TxPowerTable_findValue(RF_TxPowerTable_Entry table[], int8_t powerLevel)
+{
+    RF_TxPowerTable_Value invalid = { .rawValue = RF_TxPowerTable_INVALID_VALUE };
+    uint32_t i;
+
+    for (i = 0; table[i].power != RF_TxPowerTable_INVALID_DBM; i++)
+    {
+        if (table[i].power == powerLevel)
+        {
+            return table[i].value;
+        }
+    }
+
+    /* The extremes select the first and the last entry */
+    if ((i > 0) && (powerLevel == RF_TxPowerTable_MIN_DBM))
+    {
+        return table[0].value;
+    }
+    if ((i > 0) && (powerLevel == RF_TxPowerTable_MAX_DBM))
+    {
+        return table[i - 1].value;
+    }
+    return invalid;
+}
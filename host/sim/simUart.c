@@ -0,0 +1,294 @@
+/*
+ *  ======== simUart.c ========
+ *  UART2 driver on a pseudo terminal.
+ *
+ *  Bytes are read from the terminal whenever the firmware waits and handed
+ *  to UART2_read() one byte time (10 bits) apart in simulated time, so
+ *  the firmware sees the link at its baud rate. Writes go to the terminal
+ *  at once; their callback runs when the last byte would have left the
+ *  UART. Until SimUart_open() is called the UART can not be opened, as on
+ *  a board without one.
+ */
+
+/***** Includes *****/
+#define _XOPEN_SOURCE 600               /* posix_openpt() */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <ti/drivers/UART2.h>
+
+#include "sim.h"
+
+/***** Defines *****/
+#define RX_BUFFER_SIZE          4096    /* A power of two */
+#define RX_BUFFER_MASK          (RX_BUFFER_SIZE - 1)
+#define BITS_PER_BYTE           10      /* 8N1 */
+
+/***** Type declarations *****/
+typedef struct
+{
+    UART2_Params params;
+    uint64_t byteTicks;
+
+    /* Bytes from the terminal, each with the time it reaches the firmware */
+    uint8_t rxData[RX_BUFFER_SIZE];
+    uint64_t rxTime[RX_BUFFER_SIZE];
+    uint32_t rxHead;                    /* Next byte UART2_read() takes */
+    uint32_t rxReady;                   /* Bytes before this one have arrived */
+    uint32_t rxTail;                    /* Next free entry */
+    Sim_Event rxEvent;
+
+    const void *txBuf;
+    size_t txCount;
+    bool txBusy;
+    Sim_Event txEvent;
+} Uart;
+
+/***** Prototypes *****/
+static void rxArrive(void *arg);
+static void txDone(void *arg);
+static bool input(bool block);
+static bool rxAvailable(void *arg);
+static bool txIdle(void *arg);
+
+/***** Variable declarations *****/
+extern const UART2_Config UART2_config[];
+extern const uint_least8_t UART2_count;
+
+static int masterFd = -1;
+static int slaveFd = -1;                /* Held open until the other side writes */
+static Uart uart;
+static bool isOpen;
+
+/***** Function definitions *****/
+
+static void rxArrive(void *arg)
+{
+    while ((uart.rxReady != uart.rxTail) && (uart.rxTime[uart.rxReady & RX_BUFFER_MASK] <= Sim_now()))
+    {
+        uart.rxReady++;
+    }
+    if (uart.rxReady != uart.rxTail)
+    {
+        Sim_schedule(&uart.rxEvent, uart.rxTime[uart.rxReady & RX_BUFFER_MASK], rxArrive, NULL);
+    }
+}
+
+static void txDone(void *arg)
+{
+    const void *buf = uart.txBuf;
+    size_t count = uart.txCount;
+
+    uart.txBusy = false;
+    if (uart.params.writeMode == UART2_Mode_CALLBACK)
+    {
+        uart.params.writeCallback((UART2_Handle)&UART2_config[0], (void *)buf, count,
+                                  uart.params.userArg, UART2_STATUS_SUCCESS);
+    }
+}
+
+/* Takes what the terminal has into the receive buffer */
+static bool input(bool block)
+{
+    struct pollfd pfd = { .fd = masterFd, .events = POLLIN };
+    uint32_t space = RX_BUFFER_SIZE - (uart.rxTail - uart.rxHead);
+
+    if (space == 0)
+    {
+        return true;
+    }
+    if (poll(&pfd, 1, block ? -1 : 0) <= 0)
+    {
+        return true;
+    }
+    if (!(pfd.revents & POLLIN))
+    {
+        /* Hung up; only the other side can have done that */
+        return (slaveFd >= 0);
+    }
+
+    uint8_t buf[RX_BUFFER_SIZE];
+    ssize_t n = read(masterFd, buf, space);
+    if (n <= 0)
+    {
+        return (n < 0) && (errno == EAGAIN);
+    }
+    if (slaveFd >= 0)
+    {
+        /* The other side is there; from now on its close ends the run */
+        close(slaveFd);
+        slaveFd = -1;
+    }
+
+    /* Bytes queue behind the ones not yet arrived */
+    uint64_t time = Sim_now();
+    if (uart.rxReady != uart.rxTail)
+    {
+        time = uart.rxTime[(uart.rxTail - 1) & RX_BUFFER_MASK];
+    }
+    ssize_t i;
+    for (i = 0; i < n; i++)
+    {
+        time += uart.byteTicks;
+        uart.rxData[uart.rxTail & RX_BUFFER_MASK] = buf[i];
+        uart.rxTime[uart.rxTail & RX_BUFFER_MASK] = time;
+        uart.rxTail++;
+    }
+    if (!uart.rxEvent.active)
+    {
+        Sim_schedule(&uart.rxEvent, uart.rxTime[uart.rxReady & RX_BUFFER_MASK], rxArrive, NULL);
+    }
+
+    return true;
+}
+
+static bool rxAvailable(void *arg)
+{
+    return (uart.rxReady - uart.rxHead) >= *(size_t *)arg;
+}
+
+static bool txIdle(void *arg)
+{
+    return !uart.txBusy;
+}
+
+const char *SimUart_open(void)
+{
+    struct termios tio;
+
+    masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((masterFd < 0) || (grantpt(masterFd) != 0) || (unlockpt(masterFd) != 0))
+    {
+        return NULL;
+    }
+
+    const char *path = ptsname(masterFd);
+    slaveFd = open(path, O_RDWR | O_NOCTTY);
+    if (slaveFd < 0)
+    {
+        return NULL;
+    }
+
+    /* No echo or line editing, whatever the other side sets */
+    tcgetattr(slaveFd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slaveFd, TCSANOW, &tio);
+
+    Sim_setInputHook(input);
+
+    return path;
+}
+
+void UART2_Params_init(UART2_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->readMode = UART2_Mode_BLOCKING;
+    params->writeMode = UART2_Mode_BLOCKING;
+    params->readReturnMode = UART2_ReadReturnMode_PARTIAL;
+    params->baudRate = 115200;
+}
+
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params *params)
+{
+    UART2_Params defaults;
+
+    if ((masterFd < 0) || isOpen || (index >= UART2_count) || (index != 0))
+    {
+        return NULL;
+    }
+    if (params == NULL)
+    {
+        UART2_Params_init(&defaults);
+        params = &defaults;
+    }
+    if ((params->readMode != UART2_Mode_BLOCKING) || (params->baudRate == 0) ||
+        ((params->writeMode == UART2_Mode_CALLBACK) && (params->writeCallback == NULL)))
+    {
+        /* Only what the firmware uses is modelled */
+        return NULL;
+    }
+
+    memset(&uart, 0, sizeof(uart));
+    uart.params = *params;
+    uart.byteTicks = (SIM_US(1000000) * BITS_PER_BYTE + params->baudRate - 1) / params->baudRate;
+    isOpen = true;
+
+    return (UART2_Handle)&UART2_config[index];
+}
+
+void UART2_close(UART2_Handle handle)
+{
+    Sim_cancel(&uart.rxEvent);
+    Sim_cancel(&uart.txEvent);
+    isOpen = false;
+}
+
+int_fast16_t UART2_read(UART2_Handle handle, void *buffer, size_t size, size_t *bytesRead)
+{
+    size_t wanted = (uart.params.readReturnMode == UART2_ReadReturnMode_FULL) ? size : 1;
+    size_t n = 0;
+
+    if (size > 0)
+    {
+        Sim_waitUntil(rxAvailable, &wanted);
+    }
+    while ((n < size) && (uart.rxHead != uart.rxReady))
+    {
+        ((uint8_t *)buffer)[n++] = uart.rxData[uart.rxHead & RX_BUFFER_MASK];
+        uart.rxHead++;
+    }
+
+    if (bytesRead != NULL)
+    {
+        *bytesRead = n;
+    }
+    return UART2_STATUS_SUCCESS;
+}
+
+int_fast16_t UART2_write(UART2_Handle handle, const void *buffer, size_t size, size_t *bytesWritten)
+{
+    const uint8_t *p = buffer;
+    size_t left = size;
+
+    if (uart.txBusy)
+    {
+        return UART2_STATUS_EINUSE;
+    }
+
+    while (left > 0)
+    {
+        ssize_t n = write(masterFd, p, left);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            /* Nobody listening; the bytes are lost on the wire */
+            break;
+        }
+        p += n;
+        left -= (size_t)n;
+    }
+
+    uart.txBuf = buffer;
+    uart.txCount = size;
+    uart.txBusy = true;
+    Sim_schedule(&uart.txEvent, Sim_now() + uart.byteTicks * size, txDone, NULL);
+
+    if (bytesWritten != NULL)
+    {
+        *bytesWritten = size;
+    }
+    if (uart.params.writeMode == UART2_Mode_BLOCKING)
+    {
+        Sim_waitUntil(txIdle, NULL);
+    }
+    return UART2_STATUS_SUCCESS;
+}
@@ -0,0 +1,428 @@
+/*
+ *  ======== traceDecode.c ========
+ *  Decoder for the radio command trace (radioTrace.h in the CCS project).
+ *
+ *  Reads the binary records as drained from the trace ring, from a file or
+ *  stdin, and prints per command type the number of records and errors and
+ *  latency histograms with power of two buckets in microseconds:
+ *  post to start (handed to the RF driver until on air), start to end (on
+ *  air until reported done) and post to end. Gaps in the record sequence
+ *  numbers are reported as lost records.
+ *
+ *  Memory records (memWatch.h) are not commands: the latest of every
+ *  region is printed after the histograms as its peak and size in bytes,
+ *  and with -d as a comment line where it was logged.
+ *
+ *  Usage: traceDecode [-d] [-c] [file]
+ *    -d  print every record as CSV instead
+ *    -c  print the histograms as CSV
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+/***** Defines *****/
+#define RECORD_SIZE             20      /* RADIO_TRACE_RECORD_SIZE */
+#define FLAG_START              0x01    /* RADIO_TRACE_FLAG_START */
+#define FLAG_MEMORY             0x02    /* RADIO_TRACE_FLAG_MEMORY */
+#define RAT_TICKS_PER_US        4
+
+#define MAX_COMMANDS            16
+#define NUM_BUCKETS             24      /* Up to 2^23 us, about 8 s */
+#define MAX_REGIONS             16
+
+/***** Type declarations *****/
+typedef enum
+{
+    METRIC_POST_TO_START,
+    METRIC_START_TO_END,
+    METRIC_POST_TO_END,
+    NUM_METRICS
+} Metric;
+
+typedef struct
+{
+    uint16_t commandNo;
+    uint16_t status;
+    uint32_t postTime;
+    uint32_t startTime;
+    uint32_t endTime;
+    int8_t   txPower;
+    uint8_t  channel;
+    uint8_t  seq;
+    uint8_t  flags;
+} Record;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t buckets[NUM_BUCKETS];
+} Histogram;
+
+typedef struct
+{
+    uint16_t region;        /* MEM_WATCH_REGION() */
+    uint32_t size;
+    uint32_t peak;
+} Region;
+
+typedef struct
+{
+    uint16_t commandNo;
+    uint32_t numRecords;
+    uint32_t numErrors;
+    Histogram hist[NUM_METRICS];
+} CommandStats;
+
+/***** Variable declarations *****/
+static const char *const metricNames[NUM_METRICS] = { "post_to_start", "start_to_end", "post_to_end" };
+
+static CommandStats commands[MAX_COMMANDS];
+static uint32_t numCommands;
+
+static Region regions[MAX_REGIONS];
+static uint32_t numRegions;
+
+/***** Function definitions *****/
+
+static const char *commandName(uint16_t commandNo)
+{
+    switch (commandNo)
+    {
+        case 0x0802: return "CMD_RADIO_SETUP";
+        case 0x0803: return "CMD_FS";
+        case 0x2801: return "CMD_IEEE_RX";
+        case 0x2C01: return "CMD_IEEE_TX";
+        case 0x2C02: return "CMD_IEEE_CSMA";
+        case 0x2C03: return "CMD_IEEE_RX_ACK";
+        default:     return "?";
+    }
+}
+
+static const char *regionName(uint16_t region, char *buf, size_t size)
+{
+    switch (region >> 8)
+    {
+        case 1:  snprintf(buf, size, "task%u", region & 0xFF); break;
+        case 2:  snprintf(buf, size, "isr"); break;
+        case 3:  snprintf(buf, size, "heap"); break;
+        default: snprintf(buf, size, "0x%04x", region); break;
+    }
+    return buf;
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void decode(const uint8_t *p, Record *record)
+{
+    /* Little endian, in the order of RadioTrace_Record */
+    record->commandNo = (uint16_t)(p[0] | (p[1] << 8));
+    record->status = (uint16_t)(p[2] | (p[3] << 8));
+    record->postTime = get32(&p[4]);
+    record->startTime = get32(&p[8]);
+    record->endTime = get32(&p[12]);
+    record->txPower = (int8_t)p[16];
+    record->channel = p[17];
+    record->seq = p[18];
+    record->flags = p[19];
+}
+
+static CommandStats *findCommand(uint16_t commandNo)
+{
+    uint32_t i;
+
+    for (i = 0; i < numCommands; i++)
+    {
+        if (commands[i].commandNo == commandNo)
+        {
+            return &commands[i];
+        }
+    }
+    if (numCommands == MAX_COMMANDS)
+    {
+        return NULL;
+    }
+
+    CommandStats *command = &commands[numCommands++];
+    memset(command, 0, sizeof(*command));
+    command->commandNo = commandNo;
+    return command;
+}
+
+static void addRegion(const Record *record)
+{
+    uint32_t i = 0;
+
+    while ((i < numRegions) && (regions[i].region != record->status))
+    {
+        i++;
+    }
+    if (i == numRegions)
+    {
+        if (numRegions == MAX_REGIONS)
+        {
+            return;
+        }
+        numRegions++;
+    }
+
+    regions[i].region = record->status;
+    regions[i].size = record->postTime;
+    regions[i].peak = record->startTime;
+}
+
+static void printRegions(bool csv)
+{
+    uint32_t i;
+    char name[16];
+
+    if (numRegions == 0)
+    {
+        return;
+    }
+    printf(csv ? "region,size,peak\n" : "memory high-water marks:\n");
+    for (i = 0; i < numRegions; i++)
+    {
+        const Region *r = &regions[i];
+        if (csv)
+        {
+            printf("%s,%u,%u\n", regionName(r->region, name, sizeof(name)), r->size, r->peak);
+        }
+        else
+        {
+            printf("  %-6s %6u of %6u bytes (%u %%)\n", regionName(r->region, name, sizeof(name)),
+                   r->peak, r->size, (r->size == 0) ? 0 : (uint32_t)((uint64_t)r->peak * 100 / r->size));
+        }
+    }
+}
+
+static void addSample(Histogram *hist, uint32_t ticks)
+{
+    uint32_t us = ticks / RAT_TICKS_PER_US;
+    uint32_t bucket = 0;
+
+    /* Bucket 0 is 0 us, bucket n is 2^(n-1) to 2^n - 1 us */
+    while ((bucket < NUM_BUCKETS - 1) && ((us >> bucket) != 0))
+    {
+        bucket++;
+    }
+    hist->buckets[bucket]++;
+
+    if ((hist->count == 0) || (us < hist->minUs))
+    {
+        hist->minUs = us;
+    }
+    if (us > hist->maxUs)
+    {
+        hist->maxUs = us;
+    }
+    hist->totalUs += us;
+    hist->count++;
+}
+
+static uint32_t bucketLow(uint32_t bucket)
+{
+    return (bucket == 0) ? 0 : (1u << (bucket - 1));
+}
+
+static uint32_t bucketHigh(uint32_t bucket)
+{
+    return (bucket == 0) ? 0 : ((1u << bucket) - 1);
+}
+
+static void printHistograms(bool csv)
+{
+    uint32_t i;
+    Metric metric;
+
+    if (csv)
+    {
+        printf("command,metric,low_us,high_us,count\n");
+    }
+
+    for (i = 0; i < numCommands; i++)
+    {
+        const CommandStats *command = &commands[i];
+
+        if (!csv)
+        {
+            printf("%s (0x%04x): %u records, %u errors\n", commandName(command->commandNo),
+                   command->commandNo, command->numRecords, command->numErrors);
+        }
+
+        for (metric = METRIC_POST_TO_START; metric < NUM_METRICS; metric++)
+        {
+            const Histogram *hist = &command->hist[metric];
+            uint32_t bucket;
+            uint32_t maxCount = 0;
+
+            if (hist->count == 0)
+            {
+                continue;
+            }
+            for (bucket = 0; bucket < NUM_BUCKETS; bucket++)
+            {
+                if (hist->buckets[bucket] > maxCount)
+                {
+                    maxCount = hist->buckets[bucket];
+                }
+            }
+
+            if (!csv)
+            {
+                printf("  %s: min %u us, avg %llu us, max %u us\n", metricNames[metric],
+                       hist->minUs, (unsigned long long)(hist->totalUs / hist->count), hist->maxUs);
+            }
+            for (bucket = 0; bucket < NUM_BUCKETS; bucket++)
+            {
+                uint32_t count = hist->buckets[bucket];
+                if (count == 0)
+                {
+                    continue;
+                }
+                if (csv)
+                {
+                    printf("%s,%s,%u,%u,%u\n", commandName(command->commandNo), metricNames[metric],
+                           bucketLow(bucket), bucketHigh(bucket), count);
+                }
+                else
+                {
+                    printf("    %7u - %7u us %8u ", bucketLow(bucket), bucketHigh(bucket), count);
+                    uint32_t width = (count * 40 + maxCount - 1) / maxCount;
+                    while (width-- > 0)
+                    {
+                        putchar('#');
+                    }
+                    putchar('\n');
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool dump = false;
+    bool csv = false;
+    FILE *in = stdin;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "dc")) != -1)
+    {
+        switch (opt)
+        {
+            case 'd': dump = true; break;
+            case 'c': csv = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-d] [-c] [file]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind < argc)
+    {
+        in = fopen(argv[optind], "rb");
+        if (in == NULL)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    if (dump)
+    {
+        printf("seq,command,status,tx_dbm,channel,post_us,start_us,end_us\n");
+    }
+
+    uint8_t buf[RECORD_SIZE];
+    uint32_t numRecords = 0;
+    uint32_t numLost = 0;
+    uint8_t nextSeq = 0;
+
+    while (fread(buf, RECORD_SIZE, 1, in) == 1)
+    {
+        Record record;
+        decode(buf, &record);
+
+        /* Gaps can only be told modulo 256 */
+        if ((numRecords > 0) && (record.seq != nextSeq))
+        {
+            numLost += (uint8_t)(record.seq - nextSeq);
+        }
+        nextSeq = (uint8_t)(record.seq + 1);
+        numRecords++;
+
+        if (record.flags & FLAG_MEMORY)
+        {
+            if (dump)
+            {
+                char name[16];
+                printf("# %u,memory,%s,%u of %u bytes,%.2f\n", record.seq,
+                       regionName(record.status, name, sizeof(name)), record.startTime, record.postTime,
+                       record.endTime / (double)RAT_TICKS_PER_US);
+            }
+            addRegion(&record);
+            continue;
+        }
+
+        if (dump)
+        {
+            printf("%u,%s,0x%04x,%d,%u,%.2f,", record.seq, commandName(record.commandNo),
+                   record.status, record.txPower, record.channel,
+                   record.postTime / (double)RAT_TICKS_PER_US);
+            if (record.flags & FLAG_START)
+            {
+                printf("%.2f", record.startTime / (double)RAT_TICKS_PER_US);
+            }
+            printf(",%.2f\n", record.endTime / (double)RAT_TICKS_PER_US);
+            continue;
+        }
+
+        CommandStats *command = findCommand(record.commandNo);
+        if (command == NULL)
+        {
+            continue;
+        }
+
+        command->numRecords++;
+        if (record.status & 0x0800)    /* ERROR_* and IEEE_ERROR_* */
+        {
+            command->numErrors++;
+        }
+        /* RAT differences wrap like the 32 bit timer does */
+        if (record.flags & FLAG_START)
+        {
+            addSample(&command->hist[METRIC_POST_TO_START], record.startTime - record.postTime);
+            addSample(&command->hist[METRIC_START_TO_END], record.endTime - record.startTime);
+        }
+        addSample(&command->hist[METRIC_POST_TO_END], record.endTime - record.postTime);
+    }
+
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+
+    if (!dump)
+    {
+        if (!csv)
+        {
+            printf("%u records, %u lost\n", numRecords, numLost);
+        }
+        printHistograms(csv);
+        printRegions(csv);
+    }
+
+    return 0;
+}
@@ -9,27 +9,183 @@ CMD_SRCS += \
 ../cc13x2_cc26x2_tirtos.cmd 
 
 C_SRCS += \
+../ackTx.c \
+../antennaSwitch.c \
+../bootTime.c \
+../buttons.c \
+../channelHop.c \
+../csmaTx.c \
+../energyMeter.c \
+../framePool.c \
+../hostJobs.c \
+../hostLink.c \
+../hostProtocol.c \
+../macFrame.c \
 ../main_tirtos.c \
-../rfPacketTx.c 
+../memWatch.c \
+../payloadGen.c \
+../pcapng.c \
+../powerTable.c \
+../radioSession.c \
+../radioTrace.c \
+../rfPacketTx.c \
+../rxMonitor.c \
+../sharedRadio.c \
+../txBench.c \
+../txBurst.c \
+../txPipe.c \
+../txQueue.c \
+../txSweep.c \
+../txTimed.c 
 
 C_DEPS += \
+./ackTx.d \
+./antennaSwitch.d \
+./bootTime.d \
+./buttons.d \
+./channelHop.d \
+./csmaTx.d \
+./energyMeter.d \
+./framePool.d \
+./hostJobs.d \
+./hostLink.d \
+./hostProtocol.d \
+./macFrame.d \
 ./main_tirtos.d \
-./rfPacketTx.d 
+./memWatch.d \
+./payloadGen.d \
+./pcapng.d \
+./powerTable.d \
+./radioSession.d \
+./radioTrace.d \
+./rfPacketTx.d \
+./rxMonitor.d \
+./sharedRadio.d \
+./txBench.d \
+./txBurst.d \
+./txPipe.d \
+./txQueue.d \
+./txSweep.d \
+./txTimed.d 
 
 OBJS += \
+./ackTx.obj \
+./antennaSwitch.obj \
+./bootTime.obj \
+./buttons.obj \
+./channelHop.obj \
+./csmaTx.obj \
+./energyMeter.obj \
+./framePool.obj \
+./hostJobs.obj \
+./hostLink.obj \
+./hostProtocol.obj \
+./macFrame.obj \
 ./main_tirtos.obj \
-./rfPacketTx.obj 
+./memWatch.obj \
+./payloadGen.obj \
+./pcapng.obj \
+./powerTable.obj \
+./radioSession.obj \
+./radioTrace.obj \
+./rfPacketTx.obj \
+./rxMonitor.obj \
+./sharedRadio.obj \
+./txBench.obj \
+./txBurst.obj \
+./txPipe.obj \
+./txQueue.obj \
+./txSweep.obj \
+./txTimed.obj 
 
 OBJS__QUOTED += \
+"ackTx.obj" \
+"antennaSwitch.obj" \
+"bootTime.obj" \
+"buttons.obj" \
+"channelHop.obj" \
+"csmaTx.obj" \
+"energyMeter.obj" \
+"framePool.obj" \
+"hostJobs.obj" \
+"hostLink.obj" \
+"hostProtocol.obj" \
+"macFrame.obj" \
 "main_tirtos.obj" \
-"rfPacketTx.obj" 
+"memWatch.obj" \
+"payloadGen.obj" \
+"pcapng.obj" \
+"powerTable.obj" \
+"radioSession.obj" \
+"radioTrace.obj" \
+"rfPacketTx.obj" \
+"rxMonitor.obj" \
+"sharedRadio.obj" \
+"txBench.obj" \
+"txBurst.obj" \
+"txPipe.obj" \
+"txQueue.obj" \
+"txSweep.obj" \
+"txTimed.obj" 
 
 C_DEPS__QUOTED += \
+"ackTx.d" \
+"antennaSwitch.d" \
+"bootTime.d" \
+"buttons.d" \
+"channelHop.d" \
+"csmaTx.d" \
+"energyMeter.d" \
+"framePool.d" \
+"hostJobs.d" \
+"hostLink.d" \
+"hostProtocol.d" \
+"macFrame.d" \
 "main_tirtos.d" \
-"rfPacketTx.d" 
+"memWatch.d" \
+"payloadGen.d" \
+"pcapng.d" \
+"powerTable.d" \
+"radioSession.d" \
+"radioTrace.d" \
+"rfPacketTx.d" \
+"rxMonitor.d" \
+"sharedRadio.d" \
+"txBench.d" \
+"txBurst.d" \
+"txPipe.d" \
+"txQueue.d" \
+"txSweep.d" \
+"txTimed.d" 
 
 C_SRCS__QUOTED += \
+"../ackTx.c" \
+"../antennaSwitch.c" \
+"../bootTime.c" \
+"../buttons.c" \
+"../channelHop.c" \
+"../csmaTx.c" \
+"../energyMeter.c" \
+"../framePool.c" \
+"../hostJobs.c" \
+"../hostLink.c" \
+"../hostProtocol.c" \
+"../macFrame.c" \
 "../main_tirtos.c" \
-"../rfPacketTx.c" 
+"../memWatch.c" \
+"../payloadGen.c" \
+"../pcapng.c" \
+"../powerTable.c" \
+"../radioSession.c" \
+"../radioTrace.c" \
+"../rfPacketTx.c" \
+"../rxMonitor.c" \
+"../sharedRadio.c" \
+"../txBench.c" \
+"../txBurst.c" \
+"../txPipe.c" \
+"../txQueue.c" \
+"../txSweep.c" \
+"../txTimed.c" 
 
 
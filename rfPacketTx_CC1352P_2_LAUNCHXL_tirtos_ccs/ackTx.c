@@ -0,0 +1,205 @@
+/*
+ *  ======== ackTx.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include "ackTx.h"
+#include "macFrame.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_ieee_mailbox.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+#define MAX_ATTEMPTS    (ACK_TX_MAX_FRAME_RETRIES + 1)
+
+/***** Prototypes *****/
+static void chainDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+/***** Variable declarations *****/
+static RF_Handle rfHandle;
+static RF_CmdHandle rxCmdHandle = RF_ALLOC_ERROR;
+static uint32_t rxPostTime;
+
+static rfc_CMD_IEEE_RX_t rxCmd;
+static rfc_CMD_IEEE_TX_t txCmd[MAX_ATTEMPTS];
+static rfc_CMD_IEEE_RX_ACK_t rxAckCmd[MAX_ATTEMPTS];
+static uint8_t numAttempts;
+
+/* RAT time the foreground chain finished, taken in the RF callback */
+static volatile uint32_t chainDoneTime;
+
+static AckTx_Stats stats;
+
+/***** Function definitions *****/
+
+static void chainDoneCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    if (e & RF_EventLastFGCmdDone)
+    {
+        chainDoneTime = RF_getCurrentTime();
+    }
+}
+
+void AckTx_Params_init(AckTx_Params *params)
+{
+    params->macMaxFrameRetries = 3;
+    params->ackWaitUs = ACK_TX_WAIT_US;
+}
+
+RF_Stat AckTx_open(RF_Handle handle, const AckTx_Params *params)
+{
+    if (params->macMaxFrameRetries > ACK_TX_MAX_FRAME_RETRIES)
+    {
+        return RF_StatInvalidParamsError;
+    }
+
+    rfHandle = handle;
+    numAttempts = params->macMaxFrameRetries + 1;
+    memset(&stats, 0, sizeof(stats));
+    stats.minAckLatency = UINT32_MAX;
+
+    /* Background receiver: ACK frames are accepted while CMD_IEEE_RX_ACK
+     * runs, every other frame is filtered out */
+    rxCmd = RF_cmdIeeeRx_ieee154;
+    rxCmd.pRxQ = NULL;
+    rxCmd.pOutput = NULL;
+    rxCmd.frameFiltOpt.frameFiltEn = 1;
+    rxCmd.frameFiltOpt.frameFiltStop = 1;
+    rxCmd.frameFiltOpt.autoAckEn = 0;
+    memset(&rxCmd.frameTypes, 0, sizeof(rxCmd.frameTypes));
+    rxCmd.endTrigger.triggerType = TRIG_NEVER;
+
+    uint8_t i;
+    for (i = 0; i < numAttempts; i++)
+    {
+        txCmd[i] = RF_cmdIeeeTx_ieee154;
+        txCmd[i].startTrigger.triggerType = TRIG_NOW;
+        txCmd[i].condition.rule = COND_STOP_ON_FALSE;
+        txCmd[i].pNextOp = (uint8_t *)&rxAckCmd[i];
+
+        rxAckCmd[i] = RF_cmdIeeeRxAck_ieee154;
+        rxAckCmd[i].startTrigger.triggerType = TRIG_NOW;
+        rxAckCmd[i].endTrigger.triggerType = TRIG_REL_START;
+        rxAckCmd[i].endTime = RF_convertUsToRatTicks(params->ackWaitUs);
+        rxAckCmd[i].condition.rule = COND_STOP_ON_TRUE;
+        rxAckCmd[i].pNextOp = (uint8_t *)&txCmd[i + 1];
+    }
+    rxAckCmd[numAttempts - 1].condition.rule = COND_NEVER;
+    rxAckCmd[numAttempts - 1].pNextOp = NULL;
+
+    rxPostTime = RF_getCurrentTime();
+    rxCmdHandle = RF_postCmd(rfHandle, (RF_Op*)&rxCmd, RF_PriorityNormal, NULL, 0);
+
+    return (rxCmdHandle >= 0) ? RF_StatSuccess : RF_StatError;
+}
+
+RF_EventMask AckTx_send(uint8_t *frame, uint8_t frameLen, AckTx_Result *result)
+{
+    uint8_t seq = MacFrame_getSeq(frame);
+    uint8_t i;
+
+    for (i = 0; i < numAttempts; i++)
+    {
+        txCmd[i].status = IDLE;
+        txCmd[i].pPayload = frame;
+        txCmd[i].payloadLen = frameLen;
+        rxAckCmd[i].status = IDLE;
+        rxAckCmd[i].seqNo = seq;
+    }
+
+    uint32_t postTime = RF_getCurrentTime();
+    RF_CmdHandle fgCmdHandle = RF_postCmd(rfHandle, (RF_Op*)&txCmd[0], RF_PriorityNormal,
+                                          chainDoneCallback, RF_EventLastFGCmdDone);
+    if (fgCmdHandle < 0)
+    {
+        /* Queue full or the radio not available: nothing was sent */
+        if (result != NULL)
+        {
+            memset(result, 0, sizeof(*result));
+        }
+        return RF_EventError;
+    }
+    RF_EventMask terminationReason = RF_pendCmd(rfHandle, fgCmdHandle,
+                                                RF_EventLastFGCmdDone | RF_EventLastCmdDone);
+
+    /* Attempts that were started; the chain stops after the first ACK */
+    uint8_t attempts = 0;
+    while ((attempts < numAttempts) && (((volatile RF_Op*)&txCmd[attempts])->status != IDLE))
+    {
+        uint16_t status = ((volatile RF_Op*)&txCmd[attempts])->status;
+        RadioTrace_add((RF_Op*)&txCmd[attempts], postTime,
+                       (status == IEEE_DONE_OK) ? txCmd[attempts].timeStamp : RADIO_TRACE_NO_TIME,
+                       chainDoneTime);
+        RadioSession_addAirTime(&txCmd[attempts]);
+        if (((volatile RF_Op*)&rxAckCmd[attempts])->status != IDLE)
+        {
+            RadioTrace_add((RF_Op*)&rxAckCmd[attempts], postTime, RADIO_TRACE_NO_TIME, chainDoneTime);
+        }
+        attempts++;
+    }
+
+    uint16_t txStatus = (attempts > 0) ? ((volatile RF_Op*)&txCmd[attempts - 1])->status : IDLE;
+    uint16_t ackStatus = (attempts > 0) ? ((volatile RF_Op*)&rxAckCmd[attempts - 1])->status : IDLE;
+    bool acked = (ackStatus == IEEE_DONE_ACK) || (ackStatus == IEEE_DONE_ACKPEND);
+    uint32_t ackLatency = 0;
+
+    stats.numFrames++;
+    stats.numAttempts += attempts;
+    if (acked)
+    {
+        ackLatency = chainDoneTime - txCmd[attempts - 1].timeStamp;
+
+        stats.numAcked++;
+        stats.histAttempts[attempts - 1]++;
+        stats.totalAckLatency += ackLatency;
+        if (ackLatency < stats.minAckLatency)
+        {
+            stats.minAckLatency = ackLatency;
+        }
+        if (ackLatency > stats.maxAckLatency)
+        {
+            stats.maxAckLatency = ackLatency;
+        }
+    }
+    else
+    {
+        stats.numNoAck++;
+    }
+
+    if (result != NULL)
+    {
+        result->acked = acked;
+        result->framePending = (ackStatus == IEEE_DONE_ACKPEND);
+        result->numAttempts = attempts;
+        result->txStatus = txStatus;
+        result->timeStamp = txCmd[0].timeStamp;
+        result->ackLatency = ackLatency;
+    }
+
+    return terminationReason;
+}
+
+void AckTx_close(void)
+{
+    if (rxCmdHandle >= 0)
+    {
+        RF_cancelCmd(rfHandle, rxCmdHandle, RF_ABORT_GRACEFULLY);
+        RF_pendCmd(rfHandle, rxCmdHandle, RF_EventLastCmdDone);
+        RadioTrace_add((RF_Op*)&rxCmd, rxPostTime, RADIO_TRACE_NO_TIME, RF_getCurrentTime());
+        rxCmdHandle = RF_ALLOC_ERROR;
+    }
+}
+
+void AckTx_getStats(AckTx_Stats *pStats)
+{
+    *pStats = stats;
+}
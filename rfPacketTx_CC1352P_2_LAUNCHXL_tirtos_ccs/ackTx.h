@@ -0,0 +1,97 @@
+/*
+ *  ======== ackTx.h ========
+ *  Acknowledged unicast with retransmission on the radio core.
+ *
+ *  A frame is sent as one chain of CMD_IEEE_TX -> CMD_IEEE_RX_ACK pairs,
+ *  one pair per attempt:
+ *
+ *      TX[0] -> RX_ACK[0] -> TX[1] -> RX_ACK[1] -> ... -> RX_ACK[n]
+ *
+ *  RX_ACK ends with result TRUE when the ACK with the right sequence
+ *  number arrives (COND_STOP_ON_TRUE ends the chain) and FALSE when the
+ *  ACK wait time ran out, which starts the next TX. The MCU is only
+ *  interrupted once per frame, whatever the number of attempts.
+ *
+ *  CMD_IEEE_RX_ACK is a foreground command, so AckTx_open() starts
+ *  RF_cmdIeeeRx_ieee154 as the background receiver. The frame must have
+ *  the ACK request bit set and a unicast destination address.
+ */
+#ifndef ACKTX_H_
+#define ACKTX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Upper bound for macMaxFrameRetries, sizes the command chain */
+#ifndef ACK_TX_MAX_FRAME_RETRIES
+#define ACK_TX_MAX_FRAME_RETRIES    7
+#endif
+
+/* macAckWaitDuration for 2.4 GHz O-QPSK: 54 symbols of 16 us */
+#define ACK_TX_WAIT_US              864
+
+typedef struct
+{
+    uint8_t  macMaxFrameRetries;    /* Retransmissions after the first attempt */
+    uint16_t ackWaitUs;             /* Time to wait for the ACK after each TX */
+} AckTx_Params;
+
+typedef struct
+{
+    bool     acked;             /* ACK received */
+    bool     framePending;      /* ACK had the frame pending bit set */
+    uint8_t  numAttempts;       /* Transmissions, 1 + retries */
+    uint16_t txStatus;          /* Status of the last CMD_IEEE_TX */
+    uint32_t timeStamp;         /* RAT time the first attempt started on air */
+    uint32_t ackLatency;        /* RAT ticks from the start of the acknowledged attempt to the ACK */
+} AckTx_Result;
+
+typedef struct
+{
+    uint32_t numFrames;
+    uint32_t numAcked;
+    uint32_t numNoAck;          /* Frames that ran out of retries */
+    uint32_t numAttempts;
+    uint32_t histAttempts[ACK_TX_MAX_FRAME_RETRIES + 1];   /* Acked frames by attempts - 1 */
+    uint32_t minAckLatency;
+    uint32_t maxAckLatency;
+    uint32_t totalAckLatency;
+} AckTx_Stats;
+
+/*
+ *  ======== AckTx_Params_init ========
+ *  macMaxFrameRetries 3 (the IEEE 802.15.4 default) and ACK_TX_WAIT_US.
+ */
+extern void AckTx_Params_init(AckTx_Params *params);
+
+/*
+ *  ======== AckTx_open ========
+ *  Builds the command chain and starts the background receiver. The
+ *  synthesizer must already be programmed.
+ */
+extern RF_Stat AckTx_open(RF_Handle rfHandle, const AckTx_Params *params);
+
+/*
+ *  ======== AckTx_send ========
+ *  Sends one frame and blocks until it is acknowledged or the retries
+ *  are used up. result may be NULL. Returns the RF driver termination
+ *  reason of the foreground chain, or RF_EventError with result cleared
+ *  if the chain could not be posted.
+ */
+extern RF_EventMask AckTx_send(uint8_t *frame, uint8_t frameLen, AckTx_Result *result);
+
+/*
+ *  ======== AckTx_close ========
+ *  Stops the background receiver.
+ */
+extern void AckTx_close(void);
+
+/*
+ *  ======== AckTx_getStats ========
+ */
+extern void AckTx_getStats(AckTx_Stats *stats);
+
+#endif /* ACKTX_H_ */
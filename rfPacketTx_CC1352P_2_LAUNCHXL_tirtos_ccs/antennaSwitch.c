@@ -0,0 +1,173 @@
+/*
+ *  ======== antennaSwitch.c ========
+ *  Antenna switch of the CC1352P-2 LaunchPad, replacing the weak
+ *  rfDriverCallbackAntennaSwitching() in ti_drivers_config.c.
+ *
+ *  Every path is set up front, the default and the high PA path of each
+ *  band, so a PA switch only applies the other entry, and a radio setup
+ *  that keeps the path, such as one replayed for another client, leaves
+ *  the pins alone.
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+
+/* Board Header files */
+#include "ti_drivers_config.h"
+
+/***** Defines *****/
+#define ANTENNA_NUM_PINS        3
+
+/***** Type declarations *****/
+typedef enum
+{
+    ANTENNA_PATH_OFF,
+    ANTENNA_PATH_SUB1GHZ,
+    ANTENNA_PATH_SUB1GHZ_HIGH_PA,
+    ANTENNA_PATH_24GHZ,
+    ANTENNA_PATH_24GHZ_HIGH_PA,
+    ANTENNA_PATH_COUNT
+} AntennaPath;
+
+/* IO multiplexer settings of the pins, and the level of those left as GPIO */
+typedef struct
+{
+    int32_t mux[ANTENNA_NUM_PINS];
+    uint8_t value[ANTENNA_NUM_PINS];
+} AntennaPathConfig;
+
+/***** Prototypes *****/
+static void setAntennaPath(AntennaPath path);
+
+/***** Variable declarations *****/
+static PIN_Handle antennaPins;
+static PIN_State antennaState;
+
+static PIN_Config antennaPinTable[] = {
+    CONFIG_RF_24GHZ   | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MAX,  /* Path disabled */
+    CONFIG_RF_HIGH_PA | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MAX,  /* Path disabled */
+    CONFIG_RF_SUB1GHZ | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MAX,  /* Path disabled */
+    PIN_TERMINATE
+};
+
+static const PIN_Id antennaPinIds[ANTENNA_NUM_PINS] = {
+    CONFIG_RF_24GHZ,
+    CONFIG_RF_HIGH_PA,
+    CONFIG_RF_SUB1GHZ
+};
+
+/*
+ * Truth table:
+ *
+ * Path        DIO28 DIO29 DIO30
+ * =========== ===== ===== =====
+ * Off         0     0     0
+ * Sub-1 GHz   0     0     1
+ * 2.4 GHz     1     0     0
+ * 20 dBm TX   0     1     0
+ *
+ * Note: RFC_GPO3 is a work-around because the RFC_GPO1 (PA enable signal)
+ *       is sometimes not de-asserted on CC1352 Rev A.
+ */
+static const AntennaPathConfig antennaPathConfigs[ANTENNA_PATH_COUNT] = {
+    /* Off */
+    { { PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO }, { 0, 0, 0 } },
+    /* RF core active --> Sub-1 GHz */
+    { { PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO }, { 0, 0, 1 } },
+    /* PA enable --> HIGH PA, LNA enable --> Sub-1 GHz */
+    { { PINCC26XX_MUX_GPIO, PINCC26XX_MUX_RFC_GPO3, PINCC26XX_MUX_RFC_GPO0 }, { 0, 0, 0 } },
+    /* RF core active --> 2.4 GHz */
+    { { PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO, PINCC26XX_MUX_GPIO }, { 1, 0, 0 } },
+    /* PA enable --> HIGH PA, LNA enable --> 2.4 GHz */
+    { { PINCC26XX_MUX_RFC_GPO0, PINCC26XX_MUX_RFC_GPO3, PINCC26XX_MUX_GPIO }, { 0, 0, 0 } },
+};
+
+static AntennaPath antennaPath = ANTENNA_PATH_OFF;
+
+/***** Function definitions *****/
+
+static void setAntennaPath(AntennaPath path)
+{
+    const AntennaPathConfig *config = &antennaPathConfigs[path];
+    uint8_t i;
+
+    /* Switch off all paths */
+    for (i = 0; i < ANTENNA_NUM_PINS; i++)
+    {
+        PINCC26XX_setOutputValue(antennaPinIds[i], 0);
+    }
+
+    for (i = 0; i < ANTENNA_NUM_PINS; i++)
+    {
+        PINCC26XX_setMux(antennaPins, antennaPinIds[i], config->mux[i]);
+        if (config->value[i])
+        {
+            PINCC26XX_setOutputValue(antennaPinIds[i], 1);
+        }
+    }
+
+    antennaPath = path;
+}
+
+/*
+ *  ======== rfDriverCallbackAntennaSwitching ========
+ *  Replaces the weak one in ti_drivers_config.c. Picks the path from the
+ *  band of the setup command and the PA of the current TX power.
+ */
+void rfDriverCallbackAntennaSwitching(RF_Handle client, RF_GlobalEvent events, void *arg)
+{
+    /* Protect against repeated RF_init */
+    static bool initialized = false;
+
+    if (!initialized && (events & RF_GlobalEventInit))
+    {
+        initialized = true;
+        antennaPins = PIN_open(&antennaState, antennaPinTable);
+    }
+    else if (events & RF_GlobalEventRadioSetup)
+    {
+        RF_TxPowerTable_PAType paType = (RF_TxPowerTable_PAType)RF_getTxPower(client).paType;
+        RF_RadioSetup *setupCommand = (RF_RadioSetup*)arg;
+        uint8_t loDivider = 0;
+
+        switch (setupCommand->common.commandNo)
+        {
+            case CMD_RADIO_SETUP:
+            case CMD_BLE5_RADIO_SETUP:
+                loDivider = RF_LODIVIDER_MASK & setupCommand->common.loDivider;
+                break;
+            case CMD_PROP_RADIO_DIV_SETUP:
+                loDivider = RF_LODIVIDER_MASK & setupCommand->prop_div.loDivider;
+                break;
+            default:
+                break;
+        }
+
+        /* A divided LO is the Sub-1 GHz front-end */
+        AntennaPath path;
+        if (loDivider != 0)
+        {
+            path = (paType == RF_TxPowerTable_HighPA) ? ANTENNA_PATH_SUB1GHZ_HIGH_PA : ANTENNA_PATH_SUB1GHZ;
+        }
+        else
+        {
+            path = (paType == RF_TxPowerTable_HighPA) ? ANTENNA_PATH_24GHZ_HIGH_PA : ANTENNA_PATH_24GHZ;
+        }
+
+        if (path != antennaPath)
+        {
+            setAntennaPath(path);
+        }
+    }
+    else if (events & RF_GlobalEventRadioPowerDown)
+    {
+        /* Switch off all paths and reset the IO multiplexer to GPIO functionality */
+        setAntennaPath(ANTENNA_PATH_OFF);
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ *  ======== bootTime.c ========
+ */
+
+/***** Includes *****/
+#include <stdio.h>
+
+#include "bootTime.h"
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Driverlib Header files */
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/aon_rtc.h)
+
+/***** Prototypes *****/
+static uint32_t now(void);
+
+/***** Variable declarations *****/
+static const char *const phaseNames[BOOT_TIME_NUM_PHASES] =
+{
+    "main", "board", "xosc", "bios", "thread", "radio", "init", "ready", "air", "done"
+};
+
+/* RTC counts since BootTime_init(), 16.16 seconds, are offset + raw */
+static uint32_t offset;
+static uint32_t lastRaw;
+
+static BootTime_Report report;
+
+/***** Function definitions *****/
+
+/* Microseconds since BootTime_init() */
+static uint32_t now(void)
+{
+    uint32_t raw = AONRTCCurrentCompareValueGet();
+
+    /* The RTC was restarted, go on from the last time seen */
+    if (raw < lastRaw)
+    {
+        offset += lastRaw;
+    }
+    lastRaw = raw;
+
+    return (uint32_t)(((uint64_t)(offset + raw) * 1000000) >> 16);
+}
+
+void BootTime_init(void)
+{
+    uint8_t i;
+
+    if (!AONRTCActive())
+    {
+        AONRTCEnable();
+    }
+    lastRaw = AONRTCCurrentCompareValueGet();
+    offset = 0 - lastRaw;
+
+    for (i = 0; i < BOOT_TIME_NUM_PHASES; i++)
+    {
+        report.us[i] = BOOT_TIME_NOT_MARKED;
+    }
+    report.us[BOOT_TIME_MAIN] = 0;
+}
+
+void BootTime_mark(BootTime_Phase phase)
+{
+    uint32_t us = now();
+
+    if (report.us[phase] == BOOT_TIME_NOT_MARKED)
+    {
+        report.us[phase] = us;
+    }
+}
+
+bool BootTime_markOnAir(uint32_t ratTimeStamp)
+{
+    if (report.us[BOOT_TIME_ON_AIR] != BOOT_TIME_NOT_MARKED)
+    {
+        return false;
+    }
+
+    /* Both clocks read back to back, the RAT one taken back to the frame */
+    uint32_t ratNow = RF_getCurrentTime();
+    uint32_t us = now();
+    uint32_t sinceOnAir = RF_convertRatTicksToUs(ratNow - ratTimeStamp);
+
+    report.us[BOOT_TIME_ON_AIR] = (sinceOnAir < us) ? us - sinceOnAir : 0;
+    report.us[BOOT_TIME_DONE] = us;
+
+    return true;
+}
+
+void BootTime_getReport(BootTime_Report *pReport)
+{
+    *pReport = report;
+}
+
+int BootTime_formatReport(const BootTime_Report *r, char *buf, size_t size)
+{
+    int n = snprintf(buf, size, "# boot");
+    uint32_t last = 0;
+    bool first = true;
+    size_t used;
+    uint8_t i;
+
+    for (i = BOOT_TIME_MAIN + 1; i < BOOT_TIME_NUM_PHASES; i++)
+    {
+        if (r->us[i] == BOOT_TIME_NOT_MARKED)
+        {
+            continue;
+        }
+        used = ((size_t)n < size) ? (size_t)n : size;
+        n += snprintf(buf + used, size - used, "%s%s %lu (%lu)", first ? " " : ", ", phaseNames[i],
+                      (unsigned long)r->us[i], (unsigned long)((r->us[i] > last) ? r->us[i] - last : 0));
+        last = r->us[i];
+        first = false;
+    }
+    used = ((size_t)n < size) ? (size_t)n : size;
+    n += snprintf(buf + used, size - used, " us\n");
+
+    return n;
+}
@@ -0,0 +1,80 @@
+/*
+ *  ======== bootTime.h ========
+ *  Boot to first frame on air, phase by phase.
+ *
+ *  main() calls BootTime_init() first and every phase after it is stamped
+ *  with BootTime_mark() as it ends, in microseconds since then. ROM boot
+ *  and the C runtime startup before main() are not seen.
+ *
+ *  The clock is the always-on RTC, 15.26 us per count, which is started
+ *  here if nothing has started it yet. The kernel restarts it from zero
+ *  in BIOS_start(); a stamp found before the one before is taken to be
+ *  after such a restart and continues from there, so the part of
+ *  BIOS_start() until the restart is not counted (some tens of us).
+ *
+ *  The first frame is stamped with its RAT timeStamp, taken across to the
+ *  RTC through the current time of both.
+ */
+#ifndef BOOTTIME_H_
+#define BOOTTIME_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+    BOOT_TIME_MAIN,             /* main() entered, time 0 */
+    BOOT_TIME_BOARD,            /* Board_initGeneral() done */
+    BOOT_TIME_XOSC,             /* HF crystal asked for, FAST_BOOT only */
+    BOOT_TIME_BIOS,             /* Thread created, BIOS_start() called */
+    BOOT_TIME_THREAD,           /* mainThread() entered */
+    BOOT_TIME_RADIO,            /* Radio opened, its first command posted with FAST_BOOT */
+    BOOT_TIME_INIT,             /* Pins, buttons and the send path set up */
+    BOOT_TIME_READY,            /* Radio set up and tuned for the first frame */
+    BOOT_TIME_ON_AIR,           /* First frame started on air */
+    BOOT_TIME_DONE,             /* First frame reported done, without FAST_BOOT its press */
+    BOOT_TIME_NUM_PHASES
+} BootTime_Phase;
+
+#define BOOT_TIME_NOT_MARKED    UINT32_MAX
+
+typedef struct
+{
+    uint32_t us[BOOT_TIME_NUM_PHASES];  /* Since main(), BOOT_TIME_NOT_MARKED if not reached */
+} BootTime_Report;
+
+/*
+ *  ======== BootTime_init ========
+ *  Starts the clock; everything is timed from here.
+ */
+extern void BootTime_init(void);
+
+/*
+ *  ======== BootTime_mark ========
+ *  Stamps the end of a phase now. Only the first stamp of a phase counts.
+ */
+extern void BootTime_mark(BootTime_Phase phase);
+
+/*
+ *  ======== BootTime_markOnAir ========
+ *  Stamps BOOT_TIME_ON_AIR with the RAT time the first frame started on
+ *  air and BOOT_TIME_DONE now. Returns true the first time, false once
+ *  the first frame has been stamped.
+ */
+extern bool BootTime_markOnAir(uint32_t ratTimeStamp);
+
+/*
+ *  ======== BootTime_getReport ========
+ */
+extern void BootTime_getReport(BootTime_Report *report);
+
+/*
+ *  ======== BootTime_formatReport ========
+ *  Writes one line with the time every phase that was reached ended and,
+ *  in brackets, how long it took, in us. Returns the length like
+ *  snprintf().
+ */
+extern int BootTime_formatReport(const BootTime_Report *report, char *buf, size_t size);
+
+#endif /* BOOTTIME_H_ */
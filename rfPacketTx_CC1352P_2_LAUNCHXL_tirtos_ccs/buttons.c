@@ -0,0 +1,158 @@
+/*
+ *  ======== buttons.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+
+#include "buttons.h"
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+/* Board Header files */
+#include "ti_drivers_config.h"
+
+/***** Prototypes *****/
+static void buttonCallback(PIN_Handle handle, PIN_Id pinId);
+static void debounceCallback(uintptr_t arg);
+
+/***** Variable declarations *****/
+static PIN_Handle buttonPinHandle;
+static PIN_State buttonPinState;
+
+/*
+ * Application button pin configuration table:
+ *   - Buttons are active low and interrupt on the press edge.
+ */
+static PIN_Config buttonPinTable[] = {
+    CONFIG_PIN_BUTTON_0  | PIN_INPUT_EN | PIN_PULLUP | PIN_HYSTERESIS | PIN_IRQ_NEGEDGE,
+    CONFIG_PIN_BUTTON_1  | PIN_INPUT_EN | PIN_PULLUP | PIN_HYSTERESIS | PIN_IRQ_NEGEDGE,
+    PIN_TERMINATE
+};
+
+static const PIN_Id buttonPins[BUTTONS_COUNT] = {
+    CONFIG_PIN_BUTTON_0,
+    CONFIG_PIN_BUTTON_1
+};
+
+static ClockP_Struct debounceClockStruct[BUTTONS_COUNT];
+static ClockP_Handle debounceClock[BUTTONS_COUNT];
+static volatile bool locked[BUTTONS_COUNT];
+
+/* Event ring: head is only written by the pin callback, tail only by
+ * Buttons_waitEvent() */
+static Buttons_Event events[BUTTONS_QUEUE_DEPTH];
+static volatile uint32_t head;
+static volatile uint32_t tail;
+static SemaphoreP_Struct eventSemStruct;
+static SemaphoreP_Handle eventSem;
+
+static Buttons_Stats stats;
+
+/***** Function definitions *****/
+
+static void buttonCallback(PIN_Handle handle, PIN_Id pinId)
+{
+    uint32_t now = RF_getCurrentTime();
+    uint8_t button = (pinId == CONFIG_PIN_BUTTON_0) ? BUTTONS_LEFT : BUTTONS_RIGHT;
+
+    if (locked[button])
+    {
+        /* Bounce of a press that was already reported */
+        return;
+    }
+    locked[button] = true;
+    ClockP_start(debounceClock[button]);
+
+    if (head - tail >= BUTTONS_QUEUE_DEPTH)
+    {
+        stats.numDropped++;
+        return;
+    }
+
+    Buttons_Event *event = &events[head % BUTTONS_QUEUE_DEPTH];
+    event->button = button;
+    event->pressTime = now;
+    head++;
+    stats.numEvents++;
+
+    SemaphoreP_post(eventSem);
+}
+
+static void debounceCallback(uintptr_t arg)
+{
+    uint8_t button = (uint8_t)arg;
+
+    if (PIN_getInputValue(buttonPins[button]) == 0)
+    {
+        /* Still pressed, check again later */
+        ClockP_start(debounceClock[button]);
+    }
+    else
+    {
+        locked[button] = false;
+    }
+}
+
+bool Buttons_open(void)
+{
+    uint8_t i;
+
+    eventSem = SemaphoreP_construct(&eventSemStruct, 0, NULL);
+
+    for (i = 0; i < BUTTONS_COUNT; i++)
+    {
+        ClockP_Params clockParams;
+        ClockP_Params_init(&clockParams);
+        clockParams.arg = i;
+
+        debounceClock[i] = ClockP_construct(&debounceClockStruct[i], debounceCallback,
+                                            BUTTONS_DEBOUNCE_US / ClockP_getSystemTickPeriod(),
+                                            &clockParams);
+    }
+
+    stats.minPressToAir = UINT32_MAX;
+
+    buttonPinHandle = PIN_open(&buttonPinState, buttonPinTable);
+    if (buttonPinHandle == NULL)
+    {
+        return false;
+    }
+
+    PIN_registerIntCb(buttonPinHandle, buttonCallback);
+
+    return true;
+}
+
+void Buttons_waitEvent(Buttons_Event *event)
+{
+    SemaphoreP_pend(eventSem, SemaphoreP_WAIT_FOREVER);
+
+    *event = events[tail % BUTTONS_QUEUE_DEPTH];
+    tail++;
+}
+
+void Buttons_recordOnAir(const Buttons_Event *event, uint32_t airTime)
+{
+    uint32_t latency = airTime - event->pressTime;
+
+    stats.lastPressToAir = latency;
+    if (latency < stats.minPressToAir)
+    {
+        stats.minPressToAir = latency;
+    }
+    if (latency > stats.maxPressToAir)
+    {
+        stats.maxPressToAir = latency;
+    }
+    stats.numLatencies++;
+}
+
+void Buttons_getStats(Buttons_Stats *pStats)
+{
+    *pStats = stats;
+}
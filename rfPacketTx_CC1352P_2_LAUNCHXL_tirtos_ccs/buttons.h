@@ -0,0 +1,72 @@
+/*
+ *  ======== buttons.h ========
+ *  Interrupt driven LaunchPad buttons.
+ *
+ *  Both buttons interrupt on the falling edge. The first edge of a press is
+ *  queued as an event right away, timestamped with RF_getCurrentTime(), and
+ *  further edges are ignored until a debounce clock sees the button
+ *  released. The consuming thread blocks on a semaphore while no event is
+ *  pending, so the device can go to standby instead of polling the pins.
+ */
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BUTTONS_LEFT            0   /* CONFIG_PIN_BUTTON_0 */
+#define BUTTONS_RIGHT           1   /* CONFIG_PIN_BUTTON_1 */
+#define BUTTONS_COUNT           2
+
+/* Time a button must stay released before it can trigger again */
+#ifndef BUTTONS_DEBOUNCE_US
+#define BUTTONS_DEBOUNCE_US     10000
+#endif
+
+/* Number of presses that can be pending before new ones are dropped */
+#ifndef BUTTONS_QUEUE_DEPTH
+#define BUTTONS_QUEUE_DEPTH     4
+#endif
+
+typedef struct
+{
+    uint8_t button;         /* BUTTONS_LEFT or BUTTONS_RIGHT */
+    uint32_t pressTime;     /* RAT time of the first edge */
+} Buttons_Event;
+
+typedef struct
+{
+    uint32_t numEvents;
+    uint32_t numDropped;        /* Presses lost because the queue was full */
+    uint32_t numLatencies;      /* Presses with a recorded press-to-air time */
+    uint32_t lastPressToAir;    /* In RAT ticks */
+    uint32_t minPressToAir;
+    uint32_t maxPressToAir;
+} Buttons_Stats;
+
+/*
+ *  ======== Buttons_open ========
+ *  Opens the button pins and enables their interrupts. Returns false if
+ *  the pins could not be allocated.
+ */
+extern bool Buttons_open(void);
+
+/*
+ *  ======== Buttons_waitEvent ========
+ *  Blocks until a debounced button press is available.
+ */
+extern void Buttons_waitEvent(Buttons_Event *event);
+
+/*
+ *  ======== Buttons_recordOnAir ========
+ *  Records the press-to-air latency of event, given the RAT timestamp of
+ *  the first frame that was sent in response to it.
+ */
+extern void Buttons_recordOnAir(const Buttons_Event *event, uint32_t airTime);
+
+/*
+ *  ======== Buttons_getStats ========
+ */
+extern void Buttons_getStats(Buttons_Stats *stats);
+
+#endif /* BUTTONS_H_ */
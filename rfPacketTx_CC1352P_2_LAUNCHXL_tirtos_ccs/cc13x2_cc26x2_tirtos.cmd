@@ -32,7 +32,11 @@
 
 --stack_size=1024   /* C stack is also used for ISR stack */
 
+#ifdef STATIC_ALLOCATION
+HEAPSIZE = 0x400;   /* Nothing of the application is on the heap, see main_tirtos.c */
+#else
 HEAPSIZE = 0x4000;  /* Size of heap buffer used by HeapMem */
+#endif
 
 /* Retain interrupt vector table variable                                    */
 --retain=g_pfnVectors
@@ -112,6 +116,9 @@ SECTIONS
     .sysmem         :   > SRAM
     .stack          :   > SRAM (HIGH)
     .nonretenvar    :   > SRAM
+    /* Frame buffer pool slots, see FRAME_POOL_SECTION in framePool.h. They
+     * can go to GPRAM instead if the cache is disabled in the CCFG. */
+    .frameBuffers   :   > SRAM, type = NOINIT
     /* Heap buffer used by HeapMem */
     .priheap   : {
         __primary_heap_start__ = .;
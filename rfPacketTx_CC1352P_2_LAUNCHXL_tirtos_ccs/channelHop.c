@@ -0,0 +1,136 @@
+/*
+ *  ======== channelHop.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include "channelHop.h"
+#include "macFrame.h"
+#include "radioSession.h"
+
+/***** Prototypes *****/
+static void addGap(uint32_t gap, uint32_t *num, uint32_t *min, uint32_t *max, uint32_t *total);
+
+/***** Variable declarations *****/
+
+/* Neighbours in the sequence are at least 4 channels (20 MHz) apart */
+static const uint8_t defaultSequence[] =
+{
+    11, 15, 19, 23, 12, 16, 20, 24, 13, 17, 21, 25, 14, 18, 22, 26
+};
+
+static ChannelHop_Params hopParams;
+static uint8_t position;            /* Sequence entry of the current channel */
+static uint8_t framesOnChannel;     /* Frames already assigned to it */
+
+static ChannelHop_Stats stats;
+
+/***** Function definitions *****/
+
+static void addGap(uint32_t gap, uint32_t *num, uint32_t *min, uint32_t *max, uint32_t *total)
+{
+    if (gap < *min)
+    {
+        *min = gap;
+    }
+    if (gap > *max)
+    {
+        *max = gap;
+    }
+    *total += gap;
+    (*num)++;
+}
+
+void ChannelHop_Params_init(ChannelHop_Params *params)
+{
+    params->sequence = defaultSequence;
+    params->sequenceLength = sizeof(defaultSequence);
+    params->framesPerHop = 1;
+}
+
+bool ChannelHop_init(const ChannelHop_Params *params)
+{
+    uint8_t i;
+
+    if ((params->sequence == NULL) || (params->sequenceLength == 0) ||
+        (params->sequenceLength > CHANNEL_HOP_MAX_SEQUENCE) || (params->framesPerHop == 0))
+    {
+        return false;
+    }
+    for (i = 0; i < params->sequenceLength; i++)
+    {
+        if (RadioSession_getFsCmd(params->sequence[i]) == NULL)
+        {
+            return false;
+        }
+    }
+
+    hopParams = *params;
+    position = 0;
+    framesOnChannel = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.minHopGap = UINT32_MAX;
+    stats.minStayGap = UINT32_MAX;
+
+    return true;
+}
+
+void ChannelHop_assign(TxBurst_Object *burst)
+{
+    uint8_t i;
+
+    for (i = 0; i < burst->numFrames; i++)
+    {
+        if (framesOnChannel == hopParams.framesPerHop)
+        {
+            position = (position + 1) % hopParams.sequenceLength;
+            framesOnChannel = 0;
+        }
+        TxBurst_setFrameChannel(burst, i, hopParams.sequence[position]);
+        framesOnChannel++;
+    }
+
+    if (burst->numFrames > 0)
+    {
+        RadioSession_setChannel(burst->channel[0]);
+    }
+}
+
+void ChannelHop_update(TxBurst_Object *burst)
+{
+    uint8_t i;
+
+    RadioSession_setTunedChannel(TxBurst_getTunedChannel(burst));
+
+    for (i = 1; i < burst->numFrames; i++)
+    {
+        if ((TxBurst_getFrameStatus(burst, i - 1) != IEEE_DONE_OK) ||
+            (TxBurst_getFrameStatus(burst, i) != IEEE_DONE_OK))
+        {
+            break;
+        }
+
+        /* From the end of the frame before on air to the start of this one */
+        uint32_t prevEnd = TxBurst_getFrameTimeStamp(burst, i - 1) +
+                           RF_convertUsToRatTicks(MAC_FRAME_AIR_US(burst->cmd[i - 1].payloadLen));
+        uint32_t gap = TxBurst_getFrameTimeStamp(burst, i) - prevEnd;
+
+        if (TxBurst_isHop(burst, i))
+        {
+            stats.lastHopGap = gap;
+            addGap(gap, &stats.numHops, &stats.minHopGap, &stats.maxHopGap, &stats.totalHopGap);
+        }
+        else
+        {
+            addGap(gap, &stats.numStays, &stats.minStayGap, &stats.maxStayGap, &stats.totalStayGap);
+        }
+    }
+}
+
+void ChannelHop_getStats(ChannelHop_Stats *pStats)
+{
+    *pStats = stats;
+}
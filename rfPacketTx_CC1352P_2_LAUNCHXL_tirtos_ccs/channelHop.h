@@ -0,0 +1,80 @@
+/*
+ *  ======== channelHop.h ========
+ *  Channel hopping for chained bursts.
+ *
+ *  Walks a hop sequence of IEEE 802.15.4 channels and assigns them to the
+ *  frames of a TxBurst, changing channel every framesPerHop frames, so the
+ *  burst retunes between frames inside one command chain. After the burst
+ *  the synthesizer position is handed back to the radio session and the
+ *  retune cost is measured from the frame timestamps: the gap between the
+ *  end of a frame on air and the start of the next one, for frames that
+ *  hopped and, as the baseline, for frames that stayed on their channel.
+ *  The difference is the time the CMD_FS in between took.
+ */
+#ifndef CHANNELHOP_H_
+#define CHANNELHOP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "txBurst.h"
+
+/* Longest hop sequence */
+#define CHANNEL_HOP_MAX_SEQUENCE    16
+
+typedef struct
+{
+    const uint8_t *sequence;    /* Channels 11-26 in hop order */
+    uint8_t sequenceLength;     /* Up to CHANNEL_HOP_MAX_SEQUENCE */
+    uint8_t framesPerHop;       /* Frames sent on a channel before the next hop */
+} ChannelHop_Params;
+
+typedef struct
+{
+    uint32_t numHops;           /* Retunes inside bursts that succeeded */
+    uint32_t numStays;          /* Frame to frame gaps on the same channel */
+    uint32_t lastHopGap;        /* RAT ticks, end of a frame on air to the next on another channel */
+    uint32_t minHopGap;
+    uint32_t maxHopGap;
+    uint32_t totalHopGap;
+    uint32_t minStayGap;        /* RAT ticks, the same for frames on the same channel */
+    uint32_t maxStayGap;
+    uint32_t totalStayGap;
+} ChannelHop_Stats;
+
+/*
+ *  ======== ChannelHop_Params_init ========
+ *  All 16 channels, spread so consecutive hops are at least 20 MHz apart,
+ *  and a hop before every frame.
+ */
+extern void ChannelHop_Params_init(ChannelHop_Params *params);
+
+/*
+ *  ======== ChannelHop_init ========
+ *  Starts the sequence from its first channel and clears the statistics.
+ *  The sequence is not copied. Returns false if a parameter is out of range.
+ */
+extern bool ChannelHop_init(const ChannelHop_Params *params);
+
+/*
+ *  ======== ChannelHop_assign ========
+ *  Gives every frame of the burst its channel from the sequence and
+ *  selects the channel of the first frame in the radio session, so
+ *  RadioSession_beginTx() tunes to it. Call after the frames are added
+ *  and before RadioSession_beginTx().
+ */
+extern void ChannelHop_assign(TxBurst_Object *burst);
+
+/*
+ *  ======== ChannelHop_update ========
+ *  Call after TxBurst_send(): tells the radio session where the burst left
+ *  the synthesizer and adds the gaps of the burst to the statistics.
+ */
+extern void ChannelHop_update(TxBurst_Object *burst);
+
+/*
+ *  ======== ChannelHop_getStats ========
+ */
+extern void ChannelHop_getStats(ChannelHop_Stats *stats);
+
+#endif /* CHANNELHOP_H_ */
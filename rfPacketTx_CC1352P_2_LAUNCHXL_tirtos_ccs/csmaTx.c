@@ -0,0 +1,168 @@
+/*
+ *  ======== csmaTx.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include "csmaTx.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Variable declarations *****/
+static RF_Handle rfHandle;
+static RF_CmdHandle rxCmdHandle = RF_ALLOC_ERROR;
+static uint32_t rxPostTime;
+
+static rfc_CMD_IEEE_RX_t rxCmd;
+static rfc_CMD_IEEE_CSMA_t csmaCmd;
+static rfc_CMD_IEEE_TX_t txCmd;
+static uint8_t macMinBE;
+
+static CsmaTx_Stats stats;
+
+/***** Function definitions *****/
+
+void CsmaTx_Params_init(CsmaTx_Params *params)
+{
+    params->macMinBE = 3;
+    params->macMaxBE = 5;
+    params->macMaxCSMABackoffs = 4;
+    params->ccaRssiThr = -75;
+    params->randomSeed = 0;
+}
+
+RF_Stat CsmaTx_open(RF_Handle handle, const CsmaTx_Params *params)
+{
+    rfHandle = handle;
+    memset(&stats, 0, sizeof(stats));
+
+    /* Background receiver: only there for CCA, so every frame is filtered
+     * out and nothing needs a receive queue */
+    rxCmd = RF_cmdIeeeRx_ieee154;
+    rxCmd.pRxQ = NULL;
+    rxCmd.pOutput = NULL;
+    rxCmd.frameFiltOpt.frameFiltEn = 1;
+    rxCmd.frameFiltOpt.frameFiltStop = 1;
+    rxCmd.frameFiltOpt.autoAckEn = 0;
+    memset(&rxCmd.frameTypes, 0, sizeof(rxCmd.frameTypes));
+    rxCmd.ccaOpt.ccaEnEnergy = 1;
+    rxCmd.ccaOpt.ccaEnCorr = 1;
+    rxCmd.ccaOpt.ccaEnSync = 1;
+    rxCmd.ccaOpt.ccaCorrOp = 1;
+    rxCmd.ccaOpt.ccaSyncOp = 0;
+    rxCmd.ccaOpt.ccaCorrThr = 3;
+    rxCmd.ccaRssiThr = params->ccaRssiThr;
+    rxCmd.endTrigger.triggerType = TRIG_NEVER;
+
+    /* CSMA-CA, followed by the TX if the channel was found clear */
+    csmaCmd = RF_cmdIeeeCsma_ieee154;
+    csmaCmd.randomState = (params->randomSeed != 0) ? params->randomSeed
+                                                    : (uint16_t)RF_getCurrentTime();
+    csmaCmd.macMaxBE = params->macMaxBE;
+    csmaCmd.macMaxCSMABackoffs = params->macMaxCSMABackoffs;
+    csmaCmd.csmaConfig.initCW = 1;
+    csmaCmd.csmaConfig.bSlotted = 0;
+    csmaCmd.csmaConfig.rxOffMode = 0;
+    csmaCmd.remainingPeriods = 0;
+    csmaCmd.endTrigger.triggerType = TRIG_NEVER;
+    csmaCmd.startTrigger.triggerType = TRIG_NOW;
+    csmaCmd.condition.rule = COND_STOP_ON_FALSE;
+    csmaCmd.pNextOp = (uint8_t *)&txCmd;
+    macMinBE = params->macMinBE;
+
+    txCmd = RF_cmdIeeeTx_ieee154;
+    txCmd.startTrigger.triggerType = TRIG_NOW;
+    txCmd.condition.rule = COND_NEVER;
+    txCmd.pNextOp = NULL;
+
+    rxPostTime = RF_getCurrentTime();
+    rxCmdHandle = RF_postCmd(rfHandle, (RF_Op*)&rxCmd, RF_PriorityNormal, NULL, 0);
+
+    return (rxCmdHandle >= 0) ? RF_StatSuccess : RF_StatError;
+}
+
+RF_EventMask CsmaTx_send(uint8_t *frame, uint8_t frameLen, CsmaTx_Result *result)
+{
+    csmaCmd.status = IDLE;
+    csmaCmd.NB = 0;
+    csmaCmd.BE = macMinBE;
+    txCmd.status = IDLE;
+    txCmd.pPayload = frame;
+    txCmd.payloadLen = frameLen;
+
+    uint32_t postTime = RF_getCurrentTime();
+    RF_CmdHandle fgCmdHandle = RF_postCmd(rfHandle, (RF_Op*)&csmaCmd, RF_PriorityNormal, NULL, 0);
+    if (fgCmdHandle < 0)
+    {
+        /* Queue full or the radio not available: nothing was sent */
+        if (result != NULL)
+        {
+            memset(result, 0, sizeof(*result));
+        }
+        return RF_EventError;
+    }
+    RF_EventMask terminationReason = RF_pendCmd(rfHandle, fgCmdHandle,
+                                                RF_EventLastFGCmdDone | RF_EventLastCmdDone);
+    uint32_t endTime = RF_getCurrentTime();
+
+    uint16_t csmaStatus = ((volatile RF_Op*)&csmaCmd)->status;
+    uint16_t txStatus = ((volatile RF_Op*)&txCmd)->status;
+
+    RadioTrace_add((RF_Op*)&csmaCmd, postTime, RADIO_TRACE_NO_TIME, endTime);
+    if (txStatus != IDLE)
+    {
+        RadioTrace_add((RF_Op*)&txCmd, postTime,
+                       (txStatus == IEEE_DONE_OK) ? txCmd.timeStamp : RADIO_TRACE_NO_TIME, endTime);
+        RadioSession_addAirTime(&txCmd);
+    }
+
+    stats.numFrames++;
+    stats.totalBackoffs += csmaCmd.NB;
+    if (csmaCmd.NB > stats.maxBackoffs)
+    {
+        stats.maxBackoffs = csmaCmd.NB;
+    }
+    if (csmaStatus == IEEE_DONE_BUSY)
+    {
+        stats.numChannelAccessFailures++;
+    }
+    if (txStatus == IEEE_DONE_OK)
+    {
+        stats.numSent++;
+    }
+
+    if (result != NULL)
+    {
+        result->csmaStatus = csmaStatus;
+        result->txStatus = txStatus;
+        result->numBackoffs = csmaCmd.NB;
+        result->lastRssi = csmaCmd.lastRssi;
+        result->timeStamp = txCmd.timeStamp;
+    }
+
+    return terminationReason;
+}
+
+void CsmaTx_close(void)
+{
+    if (rxCmdHandle >= 0)
+    {
+        RF_cancelCmd(rfHandle, rxCmdHandle, RF_ABORT_GRACEFULLY);
+        RF_pendCmd(rfHandle, rxCmdHandle, RF_EventLastCmdDone);
+        RadioTrace_add((RF_Op*)&rxCmd, rxPostTime, RADIO_TRACE_NO_TIME, RF_getCurrentTime());
+        rxCmdHandle = RF_ALLOC_ERROR;
+    }
+}
+
+void CsmaTx_getStats(CsmaTx_Stats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,82 @@
+/*
+ *  ======== csmaTx.h ========
+ *  Unslotted CSMA-CA transmission on the radio core.
+ *
+ *  Every frame is sent as the chain CMD_IEEE_CSMA -> CMD_IEEE_TX. The TX
+ *  only runs if CSMA-CA found the channel clear (condition
+ *  COND_STOP_ON_FALSE), so backoff, CCA and transmission all happen
+ *  without the MCU. CCA needs the receiver, so CsmaTx_open() starts
+ *  RF_cmdIeeeRx_ieee154 as the background command and the CSMA chains run
+ *  as foreground commands on top of it.
+ */
+#ifndef CSMATX_H_
+#define CSMATX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+typedef struct
+{
+    uint8_t macMinBE;           /* Initial backoff exponent */
+    uint8_t macMaxBE;           /* Maximum backoff exponent */
+    uint8_t macMaxCSMABackoffs; /* Backoffs before channel access failure */
+    int8_t  ccaRssiThr;         /* Energy detect threshold in dBm */
+    uint16_t randomSeed;        /* Initial state of the backoff generator */
+} CsmaTx_Params;
+
+typedef struct
+{
+    uint16_t csmaStatus;        /* IEEE_DONE_OK if the channel was clear, IEEE_DONE_BUSY if not */
+    uint16_t txStatus;          /* CMD_IEEE_TX status, IDLE if the frame was not sent */
+    uint8_t  numBackoffs;       /* Backoffs CSMA-CA needed (NB) */
+    int8_t   lastRssi;          /* RSSI of the last CCA */
+    uint32_t timeStamp;         /* RAT time the frame started on air */
+} CsmaTx_Result;
+
+typedef struct
+{
+    uint32_t numFrames;
+    uint32_t numSent;
+    uint32_t numChannelAccessFailures;
+    uint32_t totalBackoffs;
+    uint8_t  maxBackoffs;
+} CsmaTx_Stats;
+
+/*
+ *  ======== CsmaTx_Params_init ========
+ *  macMinBE 3, macMaxBE 5, macMaxCSMABackoffs 4 (the IEEE 802.15.4
+ *  defaults) and a CCA threshold of -75 dBm.
+ */
+extern void CsmaTx_Params_init(CsmaTx_Params *params);
+
+/*
+ *  ======== CsmaTx_open ========
+ *  Starts the background receiver used for CCA. The synthesizer must
+ *  already be programmed.
+ */
+extern RF_Stat CsmaTx_open(RF_Handle rfHandle, const CsmaTx_Params *params);
+
+/*
+ *  ======== CsmaTx_send ========
+ *  Sends one frame with CSMA-CA and blocks until it is sent or channel
+ *  access failed. result may be NULL. Returns the RF driver termination
+ *  reason of the foreground chain, or RF_EventError with result cleared
+ *  if the chain could not be posted.
+ */
+extern RF_EventMask CsmaTx_send(uint8_t *frame, uint8_t frameLen, CsmaTx_Result *result);
+
+/*
+ *  ======== CsmaTx_close ========
+ *  Stops the background receiver.
+ */
+extern void CsmaTx_close(void);
+
+/*
+ *  ======== CsmaTx_getStats ========
+ */
+extern void CsmaTx_getStats(CsmaTx_Stats *stats);
+
+#endif /* CSMATX_H_ */
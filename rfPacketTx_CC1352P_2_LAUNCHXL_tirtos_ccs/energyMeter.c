@@ -0,0 +1,208 @@
+/*
+ *  ======== energyMeter.c ========
+ */
+
+/***** Includes *****/
+#include <stdio.h>
+#include <string.h>
+
+#include "energyMeter.h"
+#include "macFrame.h"
+#include "radioSession.h"
+
+/* TI Drivers */
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26X2.h>
+#include <ti/drivers/rf/RF.h>
+
+/***** Type declarations *****/
+typedef struct
+{
+    int8_t   txPower;           /* dBm */
+    uint32_t current;           /* nA */
+} TxCurrentPoint;
+
+/***** Prototypes *****/
+static int_fast16_t standbyNotify(uint_fast16_t eventType, uintptr_t eventArg, uintptr_t clientArg);
+
+/***** Variable declarations *****/
+extern const RFCC26XX_HWAttrsV2 RFCC26XX_hwAttrs;
+
+/* Typical 2.4 GHz TX currents, default PA up to 5 dBm, high PA above;
+ * linear in between */
+static const TxCurrentPoint txCurrents[] =
+{
+    { -20,  4200000 },
+    {   0,  7100000 },
+    {   5,  9600000 },
+    {   6, 20000000 },
+    {  10, 28000000 },
+    {  14, 40000000 },
+    {  20, 85000000 },
+};
+
+static Power_NotifyObj standbyNotifyObj;
+
+/* Free running totals, updated from the notifications and the RF driver
+ * callback; a window takes their difference */
+static volatile uint32_t standbyTicks;
+static volatile uint32_t standbyStart;
+static volatile uint32_t numWakeUps;
+static volatile uint32_t radioTicks;
+static volatile uint32_t radioStart;
+static volatile uint32_t numPowerUps;
+static volatile bool radioOn;
+
+/* Window */
+static uint32_t startTime;
+static uint32_t startStandbyTicks;
+static uint32_t startNumWakeUps;
+static uint32_t startRadioTicks;
+static uint32_t startNumPowerUps;
+static uint32_t numFrames;
+static uint32_t airTicks;
+static uint64_t txChargeExtra;  /* nA x RAT ticks above ENERGY_RADIO_NA while on air */
+
+/***** Function definitions *****/
+
+static int_fast16_t standbyNotify(uint_fast16_t eventType, uintptr_t eventArg, uintptr_t clientArg)
+{
+    uint32_t now = RF_getCurrentTime();
+
+    if (eventType == PowerCC26XX_ENTERING_STANDBY)
+    {
+        standbyStart = now;
+    }
+    else
+    {
+        standbyTicks += now - standbyStart;
+        numWakeUps++;
+    }
+
+    return Power_NOTIFYDONE;
+}
+
+/*
+ *  ======== rfDriverCallback ========
+ *  Replaces the weak one in ti_drivers_config.c. RF_GlobalEventRadioSetup
+ *  also comes for the setup after a PA switch, with the radio already on.
+ *  The radio session times power-ups from the same events.
+ */
+void rfDriverCallback(RF_Handle client, RF_GlobalEvent events, void *arg)
+{
+    uint32_t now = RF_getCurrentTime();
+
+    if ((events & RF_GlobalEventRadioSetup) && !radioOn)
+    {
+        radioOn = true;
+        radioStart = now;
+        numPowerUps++;
+    }
+    else if ((events & RF_GlobalEventRadioPowerDown) && radioOn)
+    {
+        radioOn = false;
+        radioTicks += now - radioStart;
+    }
+
+    RadioSession_radioEvent(events);
+}
+
+bool EnergyMeter_init(void)
+{
+    return Power_registerNotify(&standbyNotifyObj,
+                                PowerCC26XX_ENTERING_STANDBY | PowerCC26XX_AWAKE_STANDBY,
+                                standbyNotify, 0) == Power_SOK;
+}
+
+void EnergyMeter_start(void)
+{
+    startTime = RF_getCurrentTime();
+    startStandbyTicks = standbyTicks;
+    startNumWakeUps = numWakeUps;
+    startRadioTicks = radioTicks + (radioOn ? startTime - radioStart : 0);
+    startNumPowerUps = numPowerUps;
+    numFrames = 0;
+    airTicks = 0;
+    txChargeExtra = 0;
+}
+
+uint32_t EnergyMeter_txCurrent(int8_t txPower)
+{
+    const uint32_t numPoints = sizeof(txCurrents) / sizeof(txCurrents[0]);
+    uint32_t i;
+
+    if (txPower <= txCurrents[0].txPower)
+    {
+        return txCurrents[0].current;
+    }
+    for (i = 1; i < numPoints; i++)
+    {
+        if (txPower <= txCurrents[i].txPower)
+        {
+            const TxCurrentPoint *lo = &txCurrents[i - 1];
+            const TxCurrentPoint *hi = &txCurrents[i];
+            return lo->current + (hi->current - lo->current) * (uint32_t)(txPower - lo->txPower) /
+                                 (uint32_t)(hi->txPower - lo->txPower);
+        }
+    }
+    return txCurrents[numPoints - 1].current;
+}
+
+void EnergyMeter_addFrame(uint8_t length, int8_t txPower)
+{
+    uint32_t ticks = RF_convertUsToRatTicks(MAC_FRAME_AIR_US(length));
+    uint32_t current = EnergyMeter_txCurrent(txPower);
+
+    numFrames++;
+    airTicks += ticks;
+    if (current > ENERGY_RADIO_NA)
+    {
+        txChargeExtra += (uint64_t)(current - ENERGY_RADIO_NA) * ticks;
+    }
+}
+
+void EnergyMeter_stop(EnergyMeter_Report *report)
+{
+    uint32_t now = RF_getCurrentTime();
+
+    memset(report, 0, sizeof(*report));
+    report->numFrames = numFrames;
+    report->numWakeUps = numWakeUps - startNumWakeUps;
+    report->numPowerUps = numPowerUps - startNumPowerUps;
+    report->elapsedTicks = now - startTime;
+    report->standbyTicks = standbyTicks - startStandbyTicks;
+    report->radioTicks = radioTicks + (radioOn ? now - radioStart : 0) - startRadioTicks;
+    report->airTicks = airTicks;
+
+    /* nA x RAT ticks: the MCU and, with xoscHfAlwaysNeeded, the crystal
+     * run whenever the device is not in standby; the radio adds its own */
+    uint32_t activeTicks = report->elapsedTicks - report->standbyTicks;
+    uint32_t activeCurrent = ENERGY_ACTIVE_NA;
+    if (RFCC26XX_hwAttrs.xoscHfAlwaysNeeded)
+    {
+        activeCurrent += ENERGY_XOSC_NA;
+    }
+    uint64_t charge = (uint64_t)ENERGY_STANDBY_NA * report->standbyTicks +
+                      (uint64_t)activeCurrent * activeTicks +
+                      (uint64_t)ENERGY_RADIO_NA * report->radioTicks +
+                      txChargeExtra;
+
+    /* nA x us x mV is 1e-18 J */
+    uint64_t energy = charge / RF_RAT_TICKS_PER_US * ENERGY_SUPPLY_MV / 1000000000u;
+    report->energyNj = (uint32_t)energy;
+    report->energyPerFrameNj = (numFrames > 0) ? (uint32_t)(energy / numFrames) : 0;
+}
+
+int EnergyMeter_formatReport(const EnergyMeter_Report *report, char *buf, size_t size)
+{
+    uint32_t elapsedUs = RF_convertRatTicksToUs(report->elapsedTicks);
+
+    return snprintf(buf, size, "# frames %lu, %lu us: standby %lu us, radio %lu us, air %lu us, "
+                    "%lu.%03lu uJ/frame\n",
+                    (unsigned long)report->numFrames, (unsigned long)elapsedUs,
+                    (unsigned long)RF_convertRatTicksToUs(report->standbyTicks),
+                    (unsigned long)RF_convertRatTicksToUs(report->radioTicks),
+                    (unsigned long)RF_convertRatTicksToUs(report->airTicks),
+                    (unsigned long)(report->energyPerFrameNj / 1000),
+                    (unsigned long)(report->energyPerFrameNj % 1000));
+}
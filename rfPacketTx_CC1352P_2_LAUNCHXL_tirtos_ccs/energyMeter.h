@@ -0,0 +1,99 @@
+/*
+ *  ======== energyMeter.h ========
+ *  Energy estimate from measured standby, radio and air time.
+ *
+ *  The meter times three states with the RAT clock (RF_getCurrentTime()
+ *  keeps counting while the radio is off):
+ *   - standby, from the PowerCC26XX_ENTERING_STANDBY and AWAKE_STANDBY
+ *     notifications of the Power driver,
+ *   - radio powered, from the RF_GlobalEventRadioSetup and
+ *     RF_GlobalEventRadioPowerDown events of the RF driver (rfDriverCallback),
+ *   - frames on air, from their length as reported with EnergyMeter_addFrame().
+ *  The rest of the window counts as MCU active. Each state is weighted
+ *  with the supply current below; TX takes the current of its level.
+ *
+ *  The currents are rough typical CC1352P figures and only make the
+ *  estimate comparable between settings; measure the board and override
+ *  them for absolute numbers. The MCU idling in WFI between standby
+ *  periods is counted as active, so the estimate errs high.
+ */
+#ifndef ENERGYMETER_H_
+#define ENERGYMETER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Supply voltage */
+#ifndef ENERGY_SUPPLY_MV
+#define ENERGY_SUPPLY_MV            3000
+#endif
+
+/* Supply currents in nA: standby with RTC and full RAM retention, MCU
+ * active at 48 MHz, radio powered but not transmitting (synthesizer,
+ * setup, RX) and the HF crystal */
+#ifndef ENERGY_STANDBY_NA
+#define ENERGY_STANDBY_NA           850
+#endif
+#ifndef ENERGY_ACTIVE_NA
+#define ENERGY_ACTIVE_NA            2900000
+#endif
+#ifndef ENERGY_RADIO_NA
+#define ENERGY_RADIO_NA             6900000
+#endif
+#ifndef ENERGY_XOSC_NA
+#define ENERGY_XOSC_NA              300000
+#endif
+
+typedef struct
+{
+    uint32_t numFrames;
+    uint32_t numWakeUps;        /* Standby exits */
+    uint32_t numPowerUps;       /* Radio power-ups */
+    uint32_t elapsedTicks;      /* RAT ticks, EnergyMeter_start() to EnergyMeter_stop() */
+    uint32_t standbyTicks;
+    uint32_t radioTicks;        /* Radio powered, air time included */
+    uint32_t airTicks;          /* Frames on air, SHR and FCS included */
+    uint32_t energyNj;          /* Estimate for the whole window */
+    uint32_t energyPerFrameNj;
+} EnergyMeter_Report;
+
+/*
+ *  ======== EnergyMeter_init ========
+ *  Registers for the standby notifications. Returns false if the Power
+ *  driver refuses.
+ */
+extern bool EnergyMeter_init(void);
+
+/*
+ *  ======== EnergyMeter_start ========
+ *  Starts a measurement window.
+ */
+extern void EnergyMeter_start(void);
+
+/*
+ *  ======== EnergyMeter_addFrame ========
+ *  Counts a frame of length bytes (without FCS) sent at txPower dBm.
+ */
+extern void EnergyMeter_addFrame(uint8_t length, int8_t txPower);
+
+/*
+ *  ======== EnergyMeter_stop ========
+ *  Ends the window and writes the times and the energy estimate.
+ */
+extern void EnergyMeter_stop(EnergyMeter_Report *report);
+
+/*
+ *  ======== EnergyMeter_txCurrent ========
+ *  Estimated supply current in nA while sending at txPower dBm.
+ */
+extern uint32_t EnergyMeter_txCurrent(int8_t txPower);
+
+/*
+ *  ======== EnergyMeter_formatReport ========
+ *  Writes one line: frames, the time shares and the energy per frame in
+ *  uJ. Returns the length like snprintf().
+ */
+extern int EnergyMeter_formatReport(const EnergyMeter_Report *report, char *buf, size_t size);
+
+#endif /* ENERGYMETER_H_ */
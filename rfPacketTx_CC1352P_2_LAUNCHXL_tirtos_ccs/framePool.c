@@ -0,0 +1,115 @@
+/*
+ *  ======== framePool.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+
+#include "framePool.h"
+
+/***** Defines *****/
+
+/* Free list terminator */
+#define NIL_INDEX           0xFFFF
+
+#define HEAD_INDEX(head)    ((uint16_t)((head) & 0xFFFF))
+#define HEAD_NEXT(head, idx) ((((head) + 0x10000) & 0xFFFF0000) | (idx))
+
+/***** Function definitions *****/
+
+FramePool_Handle FramePool_construct(FramePool_Object *pool, FramePool_Slot *slots,
+                                     uint16_t numSlots)
+{
+    uint16_t i;
+
+    if ((numSlots == 0) || (numSlots > FRAME_POOL_MAX_SLOTS))
+    {
+        return NULL;
+    }
+
+    pool->slots = slots;
+    pool->numSlots = numSlots;
+
+    for (i = 0; i < numSlots; i++)
+    {
+        slots[i].next = (i + 1 < numSlots) ? (uint16_t)(i + 1) : NIL_INDEX;
+        slots[i].length = 0;
+    }
+
+    atomic_init(&pool->freeHead, 0);
+    atomic_init(&pool->numUsed, 0);
+    atomic_init(&pool->maxUsed, 0);
+    atomic_init(&pool->numAllocs, 0);
+    atomic_init(&pool->numFailures, 0);
+
+    return pool;
+}
+
+FramePool_Slot *FramePool_alloc(FramePool_Handle pool)
+{
+    uint_least32_t head = atomic_load_explicit(&pool->freeHead, memory_order_acquire);
+    uint16_t idx;
+
+    do
+    {
+        idx = HEAD_INDEX(head);
+        if (idx == NIL_INDEX)
+        {
+            atomic_fetch_add_explicit(&pool->numFailures, 1, memory_order_relaxed);
+            return NULL;
+        }
+
+        /* If another context takes this slot first, the tag in head has
+         * changed and the exchange fails, so a stale next is never used */
+    } while (!atomic_compare_exchange_weak_explicit(&pool->freeHead, &head,
+                                                    HEAD_NEXT(head, pool->slots[idx].next),
+                                                    memory_order_acquire,
+                                                    memory_order_acquire));
+
+    uint_least16_t used = atomic_fetch_add_explicit(&pool->numUsed, 1, memory_order_relaxed) + 1;
+    uint_least16_t maxUsed = atomic_load_explicit(&pool->maxUsed, memory_order_relaxed);
+    while ((used > maxUsed) &&
+           !atomic_compare_exchange_weak_explicit(&pool->maxUsed, &maxUsed, used,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+    {
+    }
+    atomic_fetch_add_explicit(&pool->numAllocs, 1, memory_order_relaxed);
+
+    FramePool_Slot *slot = &pool->slots[idx];
+    slot->length = 0;
+
+    return slot;
+}
+
+void FramePool_free(FramePool_Handle pool, FramePool_Slot *slot)
+{
+    uint16_t idx = (uint16_t)(slot - pool->slots);
+    uint_least32_t head = atomic_load_explicit(&pool->freeHead, memory_order_relaxed);
+
+    do
+    {
+        slot->next = HEAD_INDEX(head);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->freeHead, &head,
+                                                    HEAD_NEXT(head, idx),
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+
+    atomic_fetch_sub_explicit(&pool->numUsed, 1, memory_order_relaxed);
+}
+
+void FramePool_getStats(FramePool_Handle pool, FramePool_Stats *stats)
+{
+    stats->numSlots = pool->numSlots;
+    stats->numUsed = (uint16_t)atomic_load_explicit(&pool->numUsed, memory_order_relaxed);
+    stats->maxUsed = (uint16_t)atomic_load_explicit(&pool->maxUsed, memory_order_relaxed);
+    stats->numAllocs = atomic_load_explicit(&pool->numAllocs, memory_order_relaxed);
+    stats->numFailures = atomic_load_explicit(&pool->numFailures, memory_order_relaxed);
+}
+
+void FramePool_resetWatermark(FramePool_Handle pool)
+{
+    atomic_store_explicit(&pool->maxUsed,
+                          atomic_load_explicit(&pool->numUsed, memory_order_relaxed),
+                          memory_order_relaxed);
+}
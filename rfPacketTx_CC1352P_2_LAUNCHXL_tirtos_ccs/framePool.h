@@ -0,0 +1,103 @@
+/*
+ *  ======== framePool.h ========
+ *  Fixed-capacity pool of IEEE 802.15.4 frame buffers.
+ *
+ *  Each slot holds one PSDU of up to aMaxPHYPacketSize (127) bytes. Free
+ *  slots are kept on a lock-free LIFO list whose head is updated with a
+ *  single compare-and-swap, so FramePool_alloc() and FramePool_free() are
+ *  O(1) and can be called from tasks, SWIs and HWIs alike. The pool uses no
+ *  heap: the caller provides the slot storage, which decides where the
+ *  slots are placed in memory (see FRAME_POOL_SECTION).
+ *
+ *  The module only depends on the C standard library and builds on the
+ *  host as well as on the target.
+ */
+#ifndef FRAMEPOOL_H_
+#define FRAMEPOOL_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/* aMaxPHYPacketSize */
+#define FRAME_POOL_PSDU_SIZE    127
+
+/* Maximum number of slots per pool, limited by the 16 bit slot index */
+#define FRAME_POOL_MAX_SLOTS    0xFFFE
+
+/*
+ * Places a slot array in a named linker section, e.g.
+ *   static FramePool_Slot slots[8] FRAME_POOL_SECTION(".frameBuffers");
+ * The linker command file decides which RAM bank the section goes to.
+ */
+#if defined(__TI_COMPILER_VERSION__) || defined(__GNUC__)
+#define FRAME_POOL_SECTION(name)    __attribute__((section(name)))
+#else
+#define FRAME_POOL_SECTION(name)
+#endif
+
+typedef struct
+{
+    uint16_t next;      /* Free list link, only valid while the slot is free */
+    uint8_t length;     /* Number of valid bytes in psdu, set by the user */
+    uint8_t psdu[FRAME_POOL_PSDU_SIZE];
+} FramePool_Slot;
+
+typedef struct
+{
+    FramePool_Slot *slots;
+    uint16_t numSlots;
+
+    /* Free list head: slot index in the low 16 bits and a tag in the high
+     * 16 bits that changes on every update, so a stale head can not be
+     * mistaken for the current one (ABA) */
+    atomic_uint_least32_t freeHead;
+
+    atomic_uint_least16_t numUsed;
+    atomic_uint_least16_t maxUsed;      /* High-watermark of numUsed */
+    atomic_uint_least32_t numAllocs;
+    atomic_uint_least32_t numFailures; /* FramePool_alloc() calls on an empty pool */
+} FramePool_Object;
+
+typedef FramePool_Object *FramePool_Handle;
+
+typedef struct
+{
+    uint16_t numSlots;
+    uint16_t numUsed;
+    uint16_t maxUsed;
+    uint32_t numAllocs;
+    uint32_t numFailures;
+} FramePool_Stats;
+
+/*
+ *  ======== FramePool_construct ========
+ *  Builds a pool on top of numSlots slots of caller-provided storage.
+ *  Returns NULL if numSlots is 0 or larger than FRAME_POOL_MAX_SLOTS.
+ */
+extern FramePool_Handle FramePool_construct(FramePool_Object *pool, FramePool_Slot *slots,
+                                            uint16_t numSlots);
+
+/*
+ *  ======== FramePool_alloc ========
+ *  Takes a slot from the pool, or returns NULL if the pool is empty.
+ */
+extern FramePool_Slot *FramePool_alloc(FramePool_Handle pool);
+
+/*
+ *  ======== FramePool_free ========
+ *  Returns a slot obtained from FramePool_alloc() to the pool.
+ */
+extern void FramePool_free(FramePool_Handle pool, FramePool_Slot *slot);
+
+/*
+ *  ======== FramePool_getStats ========
+ */
+extern void FramePool_getStats(FramePool_Handle pool, FramePool_Stats *stats);
+
+/*
+ *  ======== FramePool_resetWatermark ========
+ *  Restarts the high-watermark from the current number of used slots.
+ */
+extern void FramePool_resetWatermark(FramePool_Handle pool);
+
+#endif /* FRAMEPOOL_H_ */
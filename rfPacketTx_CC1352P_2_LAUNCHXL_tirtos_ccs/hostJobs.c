@@ -0,0 +1,481 @@
+/*
+ *  ======== hostJobs.c ========
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "hostJobs.h"
+#include "hostLink.h"
+#include "memWatch.h"
+#include "payloadGen.h"
+#include "pcapng.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+#include "txPipe.h"
+#include "txTimed.h"
+
+/* TI Drivers */
+#include <ti/drivers/dpl/HwiP.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/***** Defines *****/
+#define REPORT_QUEUE_MASK       (HOST_JOBS_REPORT_QUEUE - 1)
+
+/* Trace records per HOST_MSG_TRACE_DATA message */
+#define TRACE_BATCH             (HOST_PROTOCOL_MAX_PAYLOAD / RADIO_TRACE_RECORD_SIZE)
+
+/***** Type declarations *****/
+typedef struct
+{
+    uint8_t length;
+    uint8_t psdu[HOST_PROTOCOL_MAX_LENGTH];
+} HostJobs_Frame;
+
+/***** Prototypes *****/
+static bool receiveFrames(uint8_t numFrames);
+static uint8_t buildFrame(uint8_t **psdu, uint32_t index, void *arg);
+static void addOutcome(uint32_t index, uint8_t status, uint32_t timeStamp, uint8_t length);
+static bool captureFrame(bool wait);
+static void flushCapture(void);
+static bool sendReport(bool all);
+static void sendOutcomes(bool all);
+static void pipeDone(uint32_t index, uint16_t status, uint32_t timeStamp, void *arg);
+static void timedDone(const TxTimed_Completion *completion);
+static void runJob(RF_ScheduleCmdParams *scheduleParams);
+static void sendTrace(void);
+
+/***** Variable declarations *****/
+static const MacFrame_Template *frameTemplate;
+static HostJobs_Frame frames[HOST_PROTOCOL_MAX_FRAMES];
+static uint8_t seqNumber;
+static PayloadGen_Object payloadGen;
+
+/* The job being run */
+static HostProtocol_Job job;
+static HostProtocol_JobDone jobDone;
+static uint32_t firstStart;             /* RAT time the first frame went on air */
+static uint32_t lastEnd;                /* RAT time the last frame so far left the air */
+
+/* Frame outcomes by frame index; filled from the completions, emptied
+ * in index order by sendOutcomes() */
+static HostProtocol_ReportEntry reportQueue[HOST_JOBS_REPORT_QUEUE];
+static volatile bool reportFilled[HOST_JOBS_REPORT_QUEUE];
+static uint32_t reportNext;             /* Index of the next frame to report */
+static uint32_t captureNext;            /* Index of the next frame to capture */
+static uint32_t freeNext;               /* Index of the oldest entry in use */
+
+static uint8_t message[HOST_PROTOCOL_MAX_PAYLOAD];
+
+/* PCAPNG blocks of the frames captured so far, sent when the next would
+ * not fit. The frames are built again, in order, from their own copy of
+ * the generator state, rather than kept. */
+static uint8_t capture[HOST_PROTOCOL_MAX_PAYLOAD];
+static uint32_t captureLength;
+static Pcapng_Clock captureClock;
+static PayloadGen_Object captureGen;
+static uint8_t captureSeqNumber;
+
+static HostJobs_Stats stats;
+
+/***** Function definitions *****/
+
+/* Reads the frame list of a job straight into the frame buffers */
+static bool receiveFrames(uint8_t numFrames)
+{
+    uint8_t i;
+
+    for (i = 0; i < numFrames; i++)
+    {
+        uint8_t type;
+        uint16_t length;
+
+        HostLink_receiveHeader(&type, &length);
+        if ((type != HOST_MSG_FRAME) || (length == 0) || (length > HOST_PROTOCOL_MAX_LENGTH))
+        {
+            HostLink_receivePayload(NULL, length);
+            return false;
+        }
+        if (!HostLink_receivePayload(frames[i].psdu, length))
+        {
+            return false;
+        }
+        frames[i].length = (uint8_t)length;
+    }
+
+    return true;
+}
+
+static uint8_t buildFrame(uint8_t **psdu, uint32_t index, void *arg)
+{
+    /* Reports go out between frames; the UART DMA does the rest */
+    sendOutcomes(false);
+
+    /* List frames are sent from where the UART DMA wrote them; they do not
+     * change until the next job */
+    if (job.source == HOST_JOB_SOURCE_LIST)
+    {
+        HostJobs_Frame *frame = &frames[index % job.numFrames];
+        *psdu = frame->psdu;
+        return frame->length;
+    }
+
+    uint8_t *payload = MacFrame_writeHeader(frameTemplate, seqNumber++, *psdu);
+    PayloadGen_fill(&payloadGen, payload, job.length - frameTemplate->hdrLen);
+
+    return job.length;
+}
+
+/* Called from the TxPipe loop or the RF driver callback */
+static void addOutcome(uint32_t index, uint8_t status, uint32_t timeStamp, uint8_t length)
+{
+    uint32_t slot = index & REPORT_QUEUE_MASK;
+
+    if (status == HOST_FRAME_SENT)
+    {
+        if (jobDone.numSent == 0)
+        {
+            firstStart = timeStamp;
+        }
+        lastEnd = timeStamp + RF_convertUsToRatTicks(MAC_FRAME_AIR_US(length));
+        jobDone.numSent++;
+    }
+    else
+    {
+        jobDone.numErrors++;
+    }
+
+    /* Too far ahead of the reports: the host link is slower than the radio */
+    if (index - freeNext >= HOST_JOBS_REPORT_QUEUE)
+    {
+        jobDone.numReportsLost++;
+        return;
+    }
+
+    reportQueue[slot].status = status;
+    reportQueue[slot].timeStamp = timeStamp;
+    reportFilled[slot] = true;
+}
+
+/* Adds the frame captureNext to the capture and moves on; false if the
+ * capture is full and may not be sent yet */
+static bool captureFrame(bool wait)
+{
+    const HostProtocol_ReportEntry *entry = &reportQueue[captureNext & REPORT_QUEUE_MASK];
+    uint8_t psdu[HOST_PROTOCOL_MAX_LENGTH];
+    const uint8_t *frame = psdu;
+    uint8_t length = job.length;
+
+    if (job.source == HOST_JOB_SOURCE_LIST)
+    {
+        frame = frames[captureNext % job.numFrames].psdu;
+        length = frames[captureNext % job.numFrames].length;
+    }
+
+    if ((entry->status == HOST_FRAME_SENT) &&
+        (captureLength + PCAPNG_EPB_LENGTH(length) > sizeof(capture)))
+    {
+        if (!wait && !HostLink_canSend())
+        {
+            return false;
+        }
+        flushCapture();
+    }
+
+    if (job.source != HOST_JOB_SOURCE_LIST)
+    {
+        /* Keeps the generator in step also for frames that were not sent */
+        uint8_t *payload = MacFrame_writeHeader(frameTemplate, captureSeqNumber++, psdu);
+        PayloadGen_fill(&captureGen, payload, job.length - frameTemplate->hdrLen);
+    }
+    if (entry->status == HOST_FRAME_SENT)
+    {
+        captureLength += Pcapng_writeFrame(&capture[captureLength], 0,
+                                           Pcapng_toNs(&captureClock, entry->timeStamp), job.channel,
+                                           frame, length);
+        stats.numCaptured++;
+    }
+
+    captureNext++;
+    return true;
+}
+
+static void flushCapture(void)
+{
+    if (captureLength > 0)
+    {
+        HostLink_send(HOST_MSG_CAPTURE, capture, (uint16_t)captureLength);
+        captureLength = 0;
+    }
+}
+
+/* Sends a report of the outcomes from reportNext on; false if there is
+ * none to send yet */
+static bool sendReport(bool all)
+{
+    HostProtocol_ReportEntry entries[HOST_PROTOCOL_REPORT_BATCH];
+    uint8_t numEntries = 0;
+
+    /* Past the window a slot still holds an older frame the capture needs */
+    while ((numEntries < HOST_PROTOCOL_REPORT_BATCH) &&
+           (reportNext + numEntries - freeNext < HOST_JOBS_REPORT_QUEUE) &&
+           reportFilled[(reportNext + numEntries) & REPORT_QUEUE_MASK])
+    {
+        entries[numEntries] = reportQueue[(reportNext + numEntries) & REPORT_QUEUE_MASK];
+        numEntries++;
+    }
+    if ((numEntries == 0) || (!all && ((numEntries < HOST_PROTOCOL_REPORT_BATCH) || !HostLink_canSend())))
+    {
+        return false;
+    }
+
+    uint16_t length = HostProtocol_encodeReport(message, job.jobId, reportNext, entries, numEntries);
+    HostLink_send(HOST_MSG_REPORT, message, length);
+    stats.numReports++;
+    reportNext += numEntries;
+
+    return true;
+}
+
+/* Reports and captures the outcomes that are in, in order. Unless all is
+ * set, only full reports and capture batches are sent, and only while the
+ * host link has a buffer free: the rest waits for the next call rather
+ * than hold up the frame being built. */
+static void sendOutcomes(bool all)
+{
+    bool capturing = (job.flags & HOST_JOB_FLAG_CAPTURE) != 0;
+    bool progress = true;
+
+    while (progress)
+    {
+        progress = sendReport(all);
+        while (capturing && (captureNext - freeNext < HOST_JOBS_REPORT_QUEUE) &&
+               reportFilled[captureNext & REPORT_QUEUE_MASK] && captureFrame(all))
+        {
+            progress = true;
+        }
+
+        /* Free the entries both are done with, the completions may fill
+         * them again */
+        uint32_t done = (capturing && (captureNext - freeNext < reportNext - freeNext)) ? captureNext
+                                                                                        : reportNext;
+        while (freeNext != done)
+        {
+            reportFilled[freeNext & REPORT_QUEUE_MASK] = false;
+            freeNext++;
+        }
+    }
+}
+
+static void pipeDone(uint32_t index, uint16_t status, uint32_t timeStamp, void *arg)
+{
+    uint8_t length = (job.source == HOST_JOB_SOURCE_LIST) ? frames[index % job.numFrames].length
+                                                          : job.length;
+
+    addOutcome(index, (status == IEEE_DONE_OK) ? HOST_FRAME_SENT : HOST_FRAME_ERROR, timeStamp, length);
+}
+
+static void timedDone(const TxTimed_Completion *completion)
+{
+    uint32_t index = (uint32_t)(uintptr_t)completion->arg;
+    uint8_t length = (job.source == HOST_JOB_SOURCE_LIST) ? frames[index % job.numFrames].length
+                                                          : job.length;
+
+    addOutcome(index, (completion->status == IEEE_DONE_OK) ? HOST_FRAME_SENT : HOST_FRAME_ERROR,
+               completion->timeStamp, length);
+}
+
+static void runJob(RF_ScheduleCmdParams *scheduleParams)
+{
+    uint32_t i;
+
+    memset(&jobDone, 0, sizeof(jobDone));
+    memset((void *)reportFilled, 0, sizeof(reportFilled));
+    jobDone.jobId = job.jobId;
+    reportNext = 0;
+    captureNext = 0;
+    freeNext = 0;
+    if (job.source != HOST_JOB_SOURCE_LIST)
+    {
+        PayloadGen_init(&payloadGen, (PayloadGen_Pattern)job.source, job.jobId);
+    }
+
+    RadioSession_setChannel(job.channel);
+    RadioSession_setTxPower(job.txPower);
+
+    if (job.flags & HOST_JOB_FLAG_CAPTURE)
+    {
+        /* A section of its own, so the host can start a file at any job */
+        captureGen = payloadGen;
+        captureSeqNumber = seqNumber;
+        captureLength = Pcapng_writeSectionHeader(capture);
+        captureLength += Pcapng_writeInterface(&capture[captureLength], job.channel,
+                                               RadioSession_getTxPower());
+    }
+    RF_Handle rfHandle = RadioSession_beginTx(scheduleParams);
+
+    if (job.mode == HOST_JOB_MODE_BURST)
+    {
+        TxPipe_Params pipeParams;
+        TxPipe_Params_init(&pipeParams);
+        pipeParams.build = buildFrame;
+        pipeParams.done = pipeDone;
+        TxPipe_send(rfHandle, &pipeParams, job.count, NULL);
+    }
+    else
+    {
+        TxTimed_Params timedParams;
+        TxTimed_Params_init(&timedParams);
+        timedParams.period = RF_convertUsToRatTicks(job.interval);
+        TxTimed_open(rfHandle, &timedParams, timedDone);
+        for (i = 0; i < job.count; i++)
+        {
+            uint8_t buf[HOST_PROTOCOL_MAX_LENGTH];
+            uint8_t *psdu = buf;
+            uint8_t length = buildFrame(&psdu, i, NULL);
+
+            /* A frame that was not posted has no completion */
+            int_fast8_t submitStatus = TxTimed_submit(psdu, length, (void *)(uintptr_t)i);
+            if (submitStatus != TX_TIMED_STATUS_SUCCESS)
+            {
+                uintptr_t key = HwiP_disable();
+                addOutcome(i, (submitStatus == TX_TIMED_STATUS_MISSED) ? HOST_FRAME_MISSED : HOST_FRAME_ERROR,
+                           0, length);
+                HwiP_restore(key);
+            }
+        }
+        TxTimed_waitEmpty();
+    }
+
+    RadioSession_endTx();
+
+    sendOutcomes(true);
+    flushCapture();
+    jobDone.elapsed = (jobDone.numSent > 0) ? RF_convertRatTicksToUs(lastEnd - firstStart) : 0;
+    HostProtocol_encodeJobDone(message, &jobDone);
+    HostLink_send(HOST_MSG_JOB_DONE, message, HOST_PROTOCOL_JOB_DONE_LENGTH);
+
+    stats.numFrames += jobDone.numSent;
+    stats.numReportsLost += jobDone.numReportsLost;
+}
+
+/* Sends the unread trace records, then how many there were. The stacks
+ * and heap are sampled first, between jobs, so the memory records go
+ * along with the commands. */
+static void sendTrace(void)
+{
+    HostProtocol_TraceDone traceDone = { 0 };
+    RadioTrace_Stats traceStats;
+    uint32_t numRecords;
+
+    MemWatch_sample();
+    MemWatch_trace();
+
+    while ((numRecords = RadioTrace_read(message, TRACE_BATCH)) > 0)
+    {
+        HostLink_send(HOST_MSG_TRACE_DATA, message, (uint16_t)(numRecords * RADIO_TRACE_RECORD_SIZE));
+        traceDone.numSent += numRecords;
+    }
+
+    RadioTrace_getStats(&traceStats);
+    traceDone.numRecords = traceStats.numRecords;
+    traceDone.numLost = traceStats.numLost;
+    HostProtocol_encodeTraceDone(message, &traceDone);
+    HostLink_send(HOST_MSG_TRACE_DONE, message, HOST_PROTOCOL_TRACE_DONE_LENGTH);
+
+    stats.numTraceRecords += traceDone.numSent;
+}
+
+void HostJobs_serve(const MacFrame_Template *tmpl, RF_ScheduleCmdParams *scheduleParams)
+{
+    frameTemplate = tmpl;
+    Pcapng_Clock_init(&captureClock);
+
+    if (!HostLink_open())
+    {
+        while(1);
+    }
+
+    while (1)
+    {
+        uint8_t type;
+        uint16_t length;
+
+        HostLink_receiveHeader(&type, &length);
+
+        if ((type == HOST_MSG_PING) && (length == 0))
+        {
+            if (HostLink_receivePayload(NULL, 0))
+            {
+                uint8_t pong[3] = { HOST_PROTOCOL_VERSION, HOST_PROTOCOL_MAX_FRAMES, HOST_PROTOCOL_MAX_LENGTH };
+                HostLink_send(HOST_MSG_PONG, pong, sizeof(pong));
+            }
+        }
+        else if ((type == HOST_MSG_JOB) && (length == HOST_PROTOCOL_JOB_LENGTH))
+        {
+            if (!HostLink_receivePayload(message, length))
+            {
+                continue;
+            }
+            HostProtocol_decodeJob(message, &job);
+
+            uint8_t status = HOST_JOB_STATUS_ACCEPTED;
+            if ((job.mode > HOST_JOB_MODE_TIMED) || (job.count == 0) ||
+                (job.channel < RADIO_SESSION_CHANNEL_MIN) || (job.channel > RADIO_SESSION_CHANNEL_MAX) ||
+                ((job.mode == HOST_JOB_MODE_TIMED) && (job.interval == 0)))
+            {
+                status = HOST_JOB_STATUS_INVALID;
+            }
+            else if (job.source == HOST_JOB_SOURCE_LIST)
+            {
+                if ((job.numFrames == 0) || (job.numFrames > HOST_PROTOCOL_MAX_FRAMES))
+                {
+                    status = HOST_JOB_STATUS_INVALID;
+                }
+                else if (!receiveFrames(job.numFrames))
+                {
+                    status = HOST_JOB_STATUS_NO_FRAMES;
+                }
+            }
+            else if ((job.source >= PAYLOAD_GEN_COUNT) || (job.length < frameTemplate->hdrLen) ||
+                     (job.length > HOST_PROTOCOL_MAX_LENGTH))
+            {
+                status = HOST_JOB_STATUS_INVALID;
+            }
+
+            uint8_t ack[3] = { (uint8_t)job.jobId, (uint8_t)(job.jobId >> 8), status };
+            HostLink_send(HOST_MSG_JOB_ACK, ack, sizeof(ack));
+            if (status != HOST_JOB_STATUS_ACCEPTED)
+            {
+                stats.numRejected++;
+                continue;
+            }
+
+            stats.numJobs++;
+            runJob(scheduleParams);
+        }
+        else if ((type == HOST_MSG_TRACE) && (length == 0))
+        {
+            if (HostLink_receivePayload(NULL, 0))
+            {
+                sendTrace();
+            }
+        }
+        else
+        {
+            /* Unknown here, or a frame without its job */
+            HostLink_receivePayload(NULL, length);
+            uint8_t error[2] = { HOST_ERROR_TYPE, type };
+            HostLink_send(HOST_MSG_ERROR, error, sizeof(error));
+        }
+    }
+}
+
+void HostJobs_getStats(HostJobs_Stats *pStats)
+{
+    *pStats = stats;
+}
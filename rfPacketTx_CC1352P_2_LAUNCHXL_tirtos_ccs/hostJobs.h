@@ -0,0 +1,66 @@
+/*
+ *  ======== hostJobs.h ========
+ *  Runs TX jobs sent by a host over the host link (hostLink.h).
+ *
+ *  A job is checked, its frame list (if any) is received straight into
+ *  the job's frame buffers, and it is acknowledged before the radio
+ *  starts. Burst jobs are sent back to back through TxPipe, timed jobs on
+ *  a TxTimed grid. The outcome of every frame is collected from the
+ *  completions and streamed to the host in reports of up to
+ *  HOST_PROTOCOL_REPORT_BATCH frames while the job runs; the UART writes
+ *  them out with DMA, so reporting costs the radio no time.
+ *
+ *  A job may ask for the frames it sent as PCAPNG (pcapng.h). They are
+ *  batched into HOST_MSG_CAPTURE messages along with the reports, frames
+ *  in the order they were sent, so the capture costs the radio no more
+ *  time than the reports do as long as the UART keeps up.
+ *
+ *  Between jobs, HOST_MSG_TRACE drains the radio trace (radioTrace.h) to
+ *  the host, so it can be read out of the target, with a fresh memory
+ *  sample (memWatch.h) at its end.
+ *
+ *  Generated frames carry the MAC header of the given template with a
+ *  sequence number that counts on across jobs, then the job's pattern
+ *  (payloadGen.h), which starts from the job ID as seed.
+ */
+#ifndef HOSTJOBS_H_
+#define HOSTJOBS_H_
+
+#include <stdint.h>
+
+#include "hostProtocol.h"
+#include "macFrame.h"
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Frame outcomes waiting to be reported, a power of two; must cover the
+ * frames in flight plus a report */
+#ifndef HOST_JOBS_REPORT_QUEUE
+#define HOST_JOBS_REPORT_QUEUE      64
+#endif
+
+typedef struct
+{
+    uint32_t numJobs;           /* Jobs accepted */
+    uint32_t numRejected;       /* Jobs refused with HOST_JOB_STATUS_INVALID or _NO_FRAMES */
+    uint32_t numFrames;         /* Frames sent by all jobs */
+    uint32_t numReports;        /* HOST_MSG_REPORT messages */
+    uint32_t numReportsLost;
+    uint32_t numCaptured;       /* Frames sent back as PCAPNG */
+    uint32_t numTraceRecords;   /* Radio trace records sent on HOST_MSG_TRACE */
+} HostJobs_Stats;
+
+/*
+ *  ======== HostJobs_serve ========
+ *  Opens the host link and runs jobs as they come. Does not return. The
+ *  radio session must be open.
+ */
+extern void HostJobs_serve(const MacFrame_Template *frameTemplate, RF_ScheduleCmdParams *scheduleParams);
+
+/*
+ *  ======== HostJobs_getStats ========
+ */
+extern void HostJobs_getStats(HostJobs_Stats *stats);
+
+#endif /* HOSTJOBS_H_ */
@@ -0,0 +1,195 @@
+/*
+ *  ======== hostLink.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <string.h>
+
+#include "hostLink.h"
+
+/* TI Drivers */
+#include <ti/drivers/UART2.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+/* Board Header files */
+#include "ti_drivers_config.h"
+
+/***** Defines *****/
+#define NUM_TX_BUFFERS          2
+
+/***** Prototypes *****/
+static void writeCallback(UART2_Handle handle, void *buf, size_t count, void *userArg,
+                          int_fast16_t status);
+
+/***** Variable declarations *****/
+static UART2_Handle uart;
+
+/* CRC of the header received last, continued over its payload */
+static uint16_t rxCrc;
+
+static uint8_t txBuffers[NUM_TX_BUFFERS][HOST_PROTOCOL_MAX_MESSAGE];
+static uint32_t txLengths[NUM_TX_BUFFERS];
+static uint8_t txFill;                  /* Next buffer to fill, thread only */
+static volatile uint8_t txSending;      /* Buffer being written */
+static volatile uint8_t txQueued;       /* Buffers filled and not yet written out */
+
+static SemaphoreP_Struct txFreeSemStruct;
+static SemaphoreP_Handle txFreeSem;
+static SemaphoreP_Struct txIdleSemStruct;
+static SemaphoreP_Handle txIdleSem;
+
+static HostLink_Stats stats;
+
+/***** Function definitions *****/
+
+static void writeCallback(UART2_Handle handle, void *buf, size_t count, void *userArg,
+                          int_fast16_t status)
+{
+    /* Start the other buffer if it was queued meanwhile */
+    txQueued--;
+    txSending ^= 1;
+    if (txQueued > 0)
+    {
+        UART2_write(uart, txBuffers[txSending], txLengths[txSending], NULL);
+    }
+    else
+    {
+        SemaphoreP_post(txIdleSem);
+    }
+
+    SemaphoreP_post(txFreeSem);
+}
+
+bool HostLink_open(void)
+{
+    UART2_Params params;
+    SemaphoreP_Params semParams;
+
+    UART2_Params_init(&params);
+    params.baudRate = HOST_LINK_BAUD_RATE;
+    params.readMode = UART2_Mode_BLOCKING;
+    params.readReturnMode = UART2_ReadReturnMode_FULL;
+    params.writeMode = UART2_Mode_CALLBACK;
+    params.writeCallback = writeCallback;
+
+    uart = UART2_open(CONFIG_UART2_0, &params);
+    if (uart == NULL)
+    {
+        return false;
+    }
+
+    SemaphoreP_Params_init(&semParams);
+    semParams.mode = SemaphoreP_Mode_COUNTING;
+    txFreeSem = SemaphoreP_construct(&txFreeSemStruct, NUM_TX_BUFFERS, &semParams);
+    txIdleSem = SemaphoreP_constructBinary(&txIdleSemStruct, 0);
+
+    memset(&stats, 0, sizeof(stats));
+
+    return true;
+}
+
+void HostLink_receiveHeader(uint8_t *type, uint16_t *length)
+{
+    uint8_t hdr[HOST_PROTOCOL_HDR_LENGTH];
+    uint32_t numValid = 0;
+
+    while (1)
+    {
+        UART2_read(uart, &hdr[numValid], HOST_PROTOCOL_HDR_LENGTH - numValid, NULL);
+        if (HostProtocol_parseHeader(hdr, type, length))
+        {
+            break;
+        }
+
+        /* Keep what may be the start of the next header */
+        uint32_t i = 1;
+        while ((i < HOST_PROTOCOL_HDR_LENGTH) && (hdr[i] != HOST_PROTOCOL_SYNC))
+        {
+            i++;
+        }
+        numValid = HOST_PROTOCOL_HDR_LENGTH - i;
+        memmove(hdr, &hdr[i], numValid);
+        stats.numSkipped += i;
+    }
+
+    rxCrc = HostProtocol_crc16(0xFFFF, &hdr[1], HOST_PROTOCOL_HDR_LENGTH - 1);
+}
+
+bool HostLink_receivePayload(uint8_t *dest, uint16_t length)
+{
+    uint8_t crc[HOST_PROTOCOL_CRC_LENGTH];
+
+    if (dest != NULL)
+    {
+        UART2_read(uart, dest, length, NULL);
+        rxCrc = HostProtocol_crc16(rxCrc, dest, length);
+    }
+    else
+    {
+        /* Drop it in small pieces */
+        uint8_t scratch[16];
+        while (length > 0)
+        {
+            uint16_t chunk = (length > sizeof(scratch)) ? sizeof(scratch) : length;
+            UART2_read(uart, scratch, chunk, NULL);
+            rxCrc = HostProtocol_crc16(rxCrc, scratch, chunk);
+            length -= chunk;
+        }
+    }
+
+    UART2_read(uart, crc, sizeof(crc), NULL);
+    if (rxCrc != (uint16_t)(crc[0] | (crc[1] << 8)))
+    {
+        uint8_t error[2] = { HOST_ERROR_CRC, 0 };
+        stats.numCrcErrors++;
+        HostLink_send(HOST_MSG_ERROR, error, sizeof(error));
+        return false;
+    }
+
+    stats.numReceived++;
+    return true;
+}
+
+void HostLink_send(uint8_t type, const uint8_t *payload, uint16_t length)
+{
+    if (SemaphoreP_pend(txFreeSem, SemaphoreP_NO_WAIT) != SemaphoreP_OK)
+    {
+        stats.numSendWaits++;
+        SemaphoreP_pend(txFreeSem, SemaphoreP_WAIT_FOREVER);
+    }
+
+    uint8_t index = txFill;
+    txFill ^= 1;
+    txLengths[index] = HostProtocol_encode(txBuffers[index], type, payload, length);
+    stats.numSent++;
+
+    /* The callback starts it if the other buffer is still being written */
+    uintptr_t key = HwiP_disable();
+    txQueued++;
+    bool start = (txQueued == 1);
+    HwiP_restore(key);
+    if (start)
+    {
+        UART2_write(uart, txBuffers[index], txLengths[index], NULL);
+    }
+}
+
+bool HostLink_canSend(void)
+{
+    return txQueued < NUM_TX_BUFFERS;
+}
+
+void HostLink_flush(void)
+{
+    while (txQueued > 0)
+    {
+        SemaphoreP_pend(txIdleSem, SemaphoreP_WAIT_FOREVER);
+    }
+}
+
+void HostLink_getStats(HostLink_Stats *pStats)
+{
+    *pStats = stats;
+}
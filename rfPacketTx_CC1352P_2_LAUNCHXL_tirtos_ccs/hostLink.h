@@ -0,0 +1,82 @@
+/*
+ *  ======== hostLink.h ========
+ *  Framed host messages (hostProtocol.h) over UART2.
+ *
+ *  Receiving is split in two so payloads need no staging buffer: the
+ *  caller gets the header first and then hands HostLink_receivePayload()
+ *  the place the payload belongs, e.g. a TX buffer, which the UART DMA
+ *  writes directly. The CRC is checked over the payload in place.
+ *
+ *  Sending copies the message into one of two buffers and returns while
+ *  the UART DMA writes it out, so a thread can stream reports while it
+ *  keeps the radio busy; it only blocks while both buffers are in flight.
+ *
+ *  Receiving and sending must each be done from one thread.
+ */
+#ifndef HOSTLINK_H_
+#define HOSTLINK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hostProtocol.h"
+
+/* 8N1; the XDS110 debug probe UART takes up to 3 Mbaud */
+#ifndef HOST_LINK_BAUD_RATE
+#define HOST_LINK_BAUD_RATE         1000000
+#endif
+
+typedef struct
+{
+    uint32_t numReceived;       /* Messages with a good CRC */
+    uint32_t numCrcErrors;
+    uint32_t numSkipped;        /* Bytes dropped looking for a sync */
+    uint32_t numSent;
+    uint32_t numSendWaits;      /* HostLink_send() calls that found both buffers busy */
+} HostLink_Stats;
+
+/*
+ *  ======== HostLink_open ========
+ *  Opens CONFIG_UART2_0. Returns false if the UART can not be opened.
+ */
+extern bool HostLink_open(void);
+
+/*
+ *  ======== HostLink_receiveHeader ========
+ *  Blocks until the header of the next message and returns its type and
+ *  payload length. Bytes that do not form a header are skipped.
+ */
+extern void HostLink_receiveHeader(uint8_t *type, uint16_t *length);
+
+/*
+ *  ======== HostLink_receivePayload ========
+ *  Reads the payload and CRC of the message whose header came last. The
+ *  payload goes straight to dest, or is dropped if dest is NULL. Returns
+ *  false, after telling the host with HOST_MSG_ERROR, if the CRC is wrong.
+ */
+extern bool HostLink_receivePayload(uint8_t *dest, uint16_t length);
+
+/*
+ *  ======== HostLink_send ========
+ *  Queues a message, length up to HOST_PROTOCOL_MAX_PAYLOAD.
+ */
+extern void HostLink_send(uint8_t type, const uint8_t *payload, uint16_t length);
+
+/*
+ *  ======== HostLink_canSend ========
+ *  True if HostLink_send() would not block.
+ */
+extern bool HostLink_canSend(void);
+
+/*
+ *  ======== HostLink_flush ========
+ *  Blocks until every queued message is out.
+ */
+extern void HostLink_flush(void);
+
+/*
+ *  ======== HostLink_getStats ========
+ */
+extern void HostLink_getStats(HostLink_Stats *stats);
+
+#endif /* HOSTLINK_H_ */
@@ -0,0 +1,206 @@
+/*
+ *  ======== hostProtocol.c ========
+ */
+
+/***** Includes *****/
+#include <string.h>
+
+#include "hostProtocol.h"
+
+/***** Prototypes *****/
+static void put16(uint8_t *buf, uint16_t value);
+static void put32(uint8_t *buf, uint32_t value);
+static uint16_t get16(const uint8_t *buf);
+static uint32_t get32(const uint8_t *buf);
+
+/***** Variable declarations *****/
+
+/* CRC-16/CCITT of every nibble, polynomial 0x1021 */
+static const uint16_t crcTable[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/***** Function definitions *****/
+
+static void put16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t *buf, uint32_t value)
+{
+    put16(buf, (uint16_t)value);
+    put16(&buf[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *buf)
+{
+    return get16(buf) | ((uint32_t)get16(&buf[2]) << 16);
+}
+
+uint16_t HostProtocol_crc16(uint16_t crc, const uint8_t *buf, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ crcTable[(crc >> 12) ^ (buf[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crcTable[(crc >> 12) ^ (buf[i] & 0x0F)]);
+    }
+
+    return crc;
+}
+
+void HostProtocol_writeHeader(uint8_t *buf, uint8_t type, uint16_t length)
+{
+    buf[0] = HOST_PROTOCOL_SYNC;
+    buf[1] = type;
+    put16(&buf[2], length);
+}
+
+uint32_t HostProtocol_encode(uint8_t *buf, uint8_t type, const uint8_t *payload, uint16_t length)
+{
+    uint8_t *dest = &buf[HOST_PROTOCOL_HDR_LENGTH];
+
+    HostProtocol_writeHeader(buf, type, length);
+    if ((payload != NULL) && (payload != dest))
+    {
+        memmove(dest, payload, length);
+    }
+
+    /* The sync byte is not covered */
+    uint16_t crc = HostProtocol_crc16(0xFFFF, &buf[1], HOST_PROTOCOL_HDR_LENGTH - 1 + length);
+    put16(&dest[length], crc);
+
+    return HOST_PROTOCOL_HDR_LENGTH + length + HOST_PROTOCOL_CRC_LENGTH;
+}
+
+bool HostProtocol_parseHeader(const uint8_t *buf, uint8_t *type, uint16_t *length)
+{
+    if (buf[0] != HOST_PROTOCOL_SYNC)
+    {
+        return false;
+    }
+
+    *type = buf[1];
+    *length = get16(&buf[2]);
+
+    return *length <= HOST_PROTOCOL_MAX_PAYLOAD;
+}
+
+void HostProtocol_encodeJob(uint8_t *buf, const HostProtocol_Job *job)
+{
+    put16(&buf[0], job->jobId);
+    buf[2] = job->mode;
+    buf[3] = job->channel;
+    buf[4] = (uint8_t)job->txPower;
+    buf[5] = job->source;
+    buf[6] = job->length;
+    buf[7] = job->numFrames;
+    put32(&buf[8], job->count);
+    put32(&buf[12], job->interval);
+    buf[16] = job->flags;
+}
+
+void HostProtocol_decodeJob(const uint8_t *buf, HostProtocol_Job *job)
+{
+    job->jobId = get16(&buf[0]);
+    job->mode = buf[2];
+    job->channel = buf[3];
+    job->txPower = (int8_t)buf[4];
+    job->source = buf[5];
+    job->length = buf[6];
+    job->numFrames = buf[7];
+    job->count = get32(&buf[8]);
+    job->interval = get32(&buf[12]);
+    job->flags = buf[16];
+}
+
+void HostProtocol_encodeJobDone(uint8_t *buf, const HostProtocol_JobDone *done)
+{
+    put16(&buf[0], done->jobId);
+    put32(&buf[2], done->numSent);
+    put32(&buf[6], done->numErrors);
+    put32(&buf[10], done->elapsed);
+    put32(&buf[14], done->numReportsLost);
+}
+
+void HostProtocol_decodeJobDone(const uint8_t *buf, HostProtocol_JobDone *done)
+{
+    done->jobId = get16(&buf[0]);
+    done->numSent = get32(&buf[2]);
+    done->numErrors = get32(&buf[6]);
+    done->elapsed = get32(&buf[10]);
+    done->numReportsLost = get32(&buf[14]);
+}
+
+void HostProtocol_encodeTraceDone(uint8_t *buf, const HostProtocol_TraceDone *done)
+{
+    put32(&buf[0], done->numRecords);
+    put32(&buf[4], done->numSent);
+    put32(&buf[8], done->numLost);
+}
+
+void HostProtocol_decodeTraceDone(const uint8_t *buf, HostProtocol_TraceDone *done)
+{
+    done->numRecords = get32(&buf[0]);
+    done->numSent = get32(&buf[4]);
+    done->numLost = get32(&buf[8]);
+}
+
+uint16_t HostProtocol_encodeReport(uint8_t *buf, uint16_t jobId, uint32_t firstIndex,
+                                   const HostProtocol_ReportEntry *entries, uint8_t numEntries)
+{
+    uint8_t *entry = &buf[HOST_PROTOCOL_REPORT_HDR_LENGTH];
+    uint8_t i;
+
+    put16(&buf[0], jobId);
+    put32(&buf[2], firstIndex);
+    buf[6] = numEntries;
+    for (i = 0; i < numEntries; i++)
+    {
+        entry[0] = entries[i].status;
+        put32(&entry[1], entries[i].timeStamp);
+        entry += HOST_PROTOCOL_REPORT_ENTRY_LENGTH;
+    }
+
+    return (uint16_t)(entry - buf);
+}
+
+int HostProtocol_decodeReport(const uint8_t *buf, uint16_t length, uint16_t *jobId,
+                              uint32_t *firstIndex, HostProtocol_ReportEntry *entries)
+{
+    const uint8_t *entry = &buf[HOST_PROTOCOL_REPORT_HDR_LENGTH];
+    uint8_t numEntries;
+    uint8_t i;
+
+    if (length < HOST_PROTOCOL_REPORT_HDR_LENGTH)
+    {
+        return -1;
+    }
+    numEntries = buf[6];
+    if ((numEntries > HOST_PROTOCOL_REPORT_BATCH) ||
+        (length != HOST_PROTOCOL_REPORT_HDR_LENGTH + numEntries * HOST_PROTOCOL_REPORT_ENTRY_LENGTH))
+    {
+        return -1;
+    }
+
+    *jobId = get16(&buf[0]);
+    *firstIndex = get32(&buf[2]);
+    for (i = 0; i < numEntries; i++)
+    {
+        entries[i].status = entry[0];
+        entries[i].timeStamp = get32(&entry[1]);
+        entry += HOST_PROTOCOL_REPORT_ENTRY_LENGTH;
+    }
+
+    return numEntries;
+}
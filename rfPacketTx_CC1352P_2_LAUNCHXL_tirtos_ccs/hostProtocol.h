@@ -0,0 +1,198 @@
+/*
+ *  ======== hostProtocol.h ========
+ *  Binary protocol between a host and the firmware over UART.
+ *
+ *  Every message is framed as
+ *
+ *      sync | type | length (LE16) | payload (length bytes) | CRC (LE16)
+ *
+ *  with sync HOST_PROTOCOL_SYNC and a CRC-16/CCITT-FALSE over type, length
+ *  and payload. A receiver that loses track skips bytes until the next
+ *  sync whose header and CRC check out. Multi-byte fields are little
+ *  endian.
+ *
+ *  The host sends a job, a whole batch of frames with one setting: either
+ *  a generator spec (pattern, length and count) or a list of up to
+ *  HOST_PROTOCOL_MAX_FRAMES frames, each in a HOST_MSG_FRAME message right
+ *  behind the job, sent count times in turn. The firmware acknowledges the
+ *  job, streams the outcome of the frames in HOST_MSG_REPORT messages of
+ *  up to HOST_PROTOCOL_REPORT_BATCH frames and ends with HOST_MSG_JOB_DONE.
+ *  Nothing is sent per frame in either direction.
+ *
+ *  A job with HOST_JOB_FLAG_CAPTURE also gets every frame it sent back as
+ *  PCAPNG (pcapng.h): HOST_MSG_CAPTURE messages carry whole blocks, as
+ *  many as fit, starting with a section header and interface for the job,
+ *  so the host only appends their payloads to a file.
+ *
+ *  Between jobs the host can drain the radio trace ring (radioTrace.h)
+ *  with HOST_MSG_TRACE. The firmware answers with the unread records in
+ *  HOST_MSG_TRACE_DATA messages, in their wire format as many as fit, and
+ *  ends with HOST_MSG_TRACE_DONE, so the host appends the payloads to a
+ *  file for host/traceDecode.c. The firmware samples its stacks and heap
+ *  first, so the memory records come along.
+ *
+ *  Only depends on the C standard library, the host client builds it too.
+ */
+#ifndef HOSTPROTOCOL_H_
+#define HOSTPROTOCOL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HOST_PROTOCOL_VERSION       3
+#define HOST_PROTOCOL_SYNC          0xA5
+
+#define HOST_PROTOCOL_HDR_LENGTH    4
+#define HOST_PROTOCOL_CRC_LENGTH    2
+
+/* Largest payload: a batch of capture blocks; reports of
+ * HOST_PROTOCOL_REPORT_BATCH frames fit as well */
+#define HOST_PROTOCOL_MAX_PAYLOAD   512
+#define HOST_PROTOCOL_MAX_MESSAGE   (HOST_PROTOCOL_HDR_LENGTH + HOST_PROTOCOL_MAX_PAYLOAD + \
+                                     HOST_PROTOCOL_CRC_LENGTH)
+
+/* Frames in one job's list, and the longest frame (MAC header and
+ * payload, without FCS) */
+#define HOST_PROTOCOL_MAX_FRAMES    8
+#define HOST_PROTOCOL_MAX_LENGTH    125
+
+/* Message types, host to firmware */
+#define HOST_MSG_PING               0x01    /* Empty, answered with HOST_MSG_PONG */
+#define HOST_MSG_JOB                0x02    /* HostProtocol_Job */
+#define HOST_MSG_FRAME              0x03    /* One frame of the job's list */
+#define HOST_MSG_TRACE              0x04    /* Empty, drains the radio trace */
+
+/* Message types, firmware to host */
+#define HOST_MSG_PONG               0x81    /* version, max frames, max length */
+#define HOST_MSG_JOB_ACK            0x82    /* job ID, HOST_JOB_STATUS_* */
+#define HOST_MSG_REPORT             0x83    /* Outcome of consecutive frames of a job */
+#define HOST_MSG_JOB_DONE           0x84    /* HostProtocol_JobDone */
+#define HOST_MSG_ERROR              0x85    /* HOST_ERROR_*, type of the message */
+#define HOST_MSG_CAPTURE            0x86    /* PCAPNG blocks of sent frames */
+#define HOST_MSG_TRACE_DATA         0x87    /* Radio trace records */
+#define HOST_MSG_TRACE_DONE         0x88    /* HostProtocol_TraceDone */
+
+/* Job modes */
+#define HOST_JOB_MODE_BURST         0       /* Back to back, double buffered (txPipe.c) */
+#define HOST_JOB_MODE_TIMED         1       /* interval apart on the radio timer (txTimed.c) */
+
+/* Job flags */
+#define HOST_JOB_FLAG_CAPTURE       0x01    /* Send the frames back as PCAPNG */
+
+/* Job source: a PayloadGen_Pattern for generated frames, or the list */
+#define HOST_JOB_SOURCE_LIST        0xFF
+
+/* HOST_MSG_JOB_ACK status */
+#define HOST_JOB_STATUS_ACCEPTED    0
+#define HOST_JOB_STATUS_INVALID     1       /* Parameter out of range */
+#define HOST_JOB_STATUS_NO_FRAMES   2       /* Frame list incomplete or corrupted */
+
+/* HOST_MSG_REPORT frame status */
+#define HOST_FRAME_SENT             0
+#define HOST_FRAME_ERROR            1
+#define HOST_FRAME_MISSED           2       /* Timed job, slot missed */
+
+/* HOST_MSG_ERROR codes */
+#define HOST_ERROR_CRC              1
+#define HOST_ERROR_LENGTH           2
+#define HOST_ERROR_TYPE             3       /* Unknown or unexpected message */
+
+#define HOST_PROTOCOL_JOB_LENGTH            17
+#define HOST_PROTOCOL_JOB_DONE_LENGTH       18
+#define HOST_PROTOCOL_REPORT_HDR_LENGTH     7
+#define HOST_PROTOCOL_REPORT_ENTRY_LENGTH   5
+#define HOST_PROTOCOL_REPORT_BATCH          32
+#define HOST_PROTOCOL_TRACE_DONE_LENGTH     12
+
+typedef struct
+{
+    uint16_t jobId;
+    uint8_t  mode;              /* HOST_JOB_MODE_* */
+    uint8_t  channel;           /* 11-26 */
+    int8_t   txPower;           /* dBm */
+    uint8_t  source;            /* PayloadGen_Pattern or HOST_JOB_SOURCE_LIST */
+    uint8_t  length;            /* Generated frame length, MAC header included */
+    uint8_t  numFrames;         /* Frames in the list, 1-HOST_PROTOCOL_MAX_FRAMES */
+    uint8_t  flags;             /* HOST_JOB_FLAG_* */
+    uint32_t count;             /* Frames to send */
+    uint32_t interval;          /* us between frames of a timed job */
+} HostProtocol_Job;
+
+typedef struct
+{
+    uint16_t jobId;
+    uint32_t numSent;
+    uint32_t numErrors;         /* Frames that failed or missed their slot */
+    uint32_t elapsed;           /* us, first frame on air to the end of the last */
+    uint32_t numReportsLost;    /* Frame outcomes the firmware could not queue */
+} HostProtocol_JobDone;
+
+typedef struct
+{
+    uint32_t numRecords;        /* Records logged since start-up */
+    uint32_t numSent;           /* Records in the HOST_MSG_TRACE_DATA messages before */
+    uint32_t numLost;           /* Records overwritten before they were read, in total */
+} HostProtocol_TraceDone;
+
+typedef struct
+{
+    uint8_t  status;            /* HOST_FRAME_* */
+    uint32_t timeStamp;         /* RAT time the frame started on air */
+} HostProtocol_ReportEntry;
+
+/*
+ *  ======== HostProtocol_crc16 ========
+ *  Continues a CRC-16/CCITT-FALSE over length bytes; start with 0xFFFF.
+ */
+extern uint16_t HostProtocol_crc16(uint16_t crc, const uint8_t *buf, uint32_t length);
+
+/*
+ *  ======== HostProtocol_writeHeader ========
+ *  Writes the HOST_PROTOCOL_HDR_LENGTH byte header.
+ */
+extern void HostProtocol_writeHeader(uint8_t *buf, uint8_t type, uint16_t length);
+
+/*
+ *  ======== HostProtocol_encode ========
+ *  Frames a message: writes header, payload and CRC to buf, which must
+ *  hold length + HOST_PROTOCOL_HDR_LENGTH + HOST_PROTOCOL_CRC_LENGTH
+ *  bytes. payload may already be in place at buf + HOST_PROTOCOL_HDR_LENGTH.
+ *  Returns the message length.
+ */
+extern uint32_t HostProtocol_encode(uint8_t *buf, uint8_t type, const uint8_t *payload,
+                                    uint16_t length);
+
+/*
+ *  ======== HostProtocol_parseHeader ========
+ *  Checks sync and length of a header and returns the type and payload
+ *  length. Returns false if it is not a header.
+ */
+extern bool HostProtocol_parseHeader(const uint8_t *buf, uint8_t *type, uint16_t *length);
+
+/* Payload encoders and decoders; each buffer holds the fixed length above */
+extern void HostProtocol_encodeJob(uint8_t *buf, const HostProtocol_Job *job);
+extern void HostProtocol_decodeJob(const uint8_t *buf, HostProtocol_Job *job);
+extern void HostProtocol_encodeJobDone(uint8_t *buf, const HostProtocol_JobDone *done);
+extern void HostProtocol_decodeJobDone(const uint8_t *buf, HostProtocol_JobDone *done);
+extern void HostProtocol_encodeTraceDone(uint8_t *buf, const HostProtocol_TraceDone *done);
+extern void HostProtocol_decodeTraceDone(const uint8_t *buf, HostProtocol_TraceDone *done);
+
+/*
+ *  ======== HostProtocol_encodeReport ========
+ *  Writes a report of numEntries frames starting at frame firstIndex of
+ *  the job and returns the payload length.
+ */
+extern uint16_t HostProtocol_encodeReport(uint8_t *buf, uint16_t jobId, uint32_t firstIndex,
+                                          const HostProtocol_ReportEntry *entries,
+                                          uint8_t numEntries);
+
+/*
+ *  ======== HostProtocol_decodeReport ========
+ *  Reads a report payload of length bytes. entries holds
+ *  HOST_PROTOCOL_REPORT_BATCH entries. Returns the number of entries, or
+ *  -1 if the length does not match.
+ */
+extern int HostProtocol_decodeReport(const uint8_t *buf, uint16_t length, uint16_t *jobId,
+                                     uint32_t *firstIndex, HostProtocol_ReportEntry *entries);
+
+#endif /* HOSTPROTOCOL_H_ */
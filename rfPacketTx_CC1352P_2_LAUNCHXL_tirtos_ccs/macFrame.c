@@ -0,0 +1,97 @@
+/*
+ *  ======== macFrame.c ========
+ */
+
+/***** Includes *****/
+#include <string.h>
+
+#include "macFrame.h"
+
+/***** Prototypes *****/
+static uint8_t *putU16(uint8_t *p, uint16_t value);
+static uint8_t *putAddr(uint8_t *p, uint8_t mode, uint16_t shortAddr, uint64_t extAddr);
+
+/***** Function definitions *****/
+
+static uint8_t *putU16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t *putAddr(uint8_t *p, uint8_t mode, uint16_t shortAddr, uint64_t extAddr)
+{
+    if (mode == MAC_ADDR_MODE_SHORT)
+    {
+        return putU16(p, shortAddr);
+    }
+
+    uint8_t i;
+    for (i = 0; i < 8; i++)
+    {
+        *p++ = (uint8_t)(extAddr >> (8 * i));
+    }
+    return p;
+}
+
+bool MacFrame_initTemplate(MacFrame_Template *tmpl, const MacFrame_Params *params)
+{
+    uint8_t dstMode = params->dstAddrMode;
+    uint8_t srcMode = params->srcAddrMode;
+
+    if ((dstMode == 1) || (dstMode > MAC_ADDR_MODE_EXT) ||
+        (srcMode == 1) || (srcMode > MAC_ADDR_MODE_EXT))
+    {
+        return false;
+    }
+
+    /* PAN ID compression only applies if both addresses are present */
+    bool panIdComp = params->panIdCompression &&
+                     (dstMode != MAC_ADDR_MODE_NONE) && (srcMode != MAC_ADDR_MODE_NONE);
+
+    uint8_t *p = tmpl->hdr;
+    p = putU16(p, MAC_FCF(params->frameType & 0x7, params->ackRequest ? 1 : 0, panIdComp ? 1 : 0,
+                          dstMode, params->frameVersion & 0x3, srcMode));
+    *p++ = 0;   /* Sequence number, patched per frame */
+
+    if (dstMode != MAC_ADDR_MODE_NONE)
+    {
+        p = putU16(p, params->dstPanId);
+        p = putAddr(p, dstMode, params->dstShortAddr, params->dstExtAddr);
+    }
+    if (srcMode != MAC_ADDR_MODE_NONE)
+    {
+        if (!panIdComp)
+        {
+            p = putU16(p, params->srcPanId);
+        }
+        p = putAddr(p, srcMode, params->srcShortAddr, params->srcExtAddr);
+    }
+
+    tmpl->hdrLen = (uint8_t)(p - tmpl->hdr);
+
+    return true;
+}
+
+uint8_t *MacFrame_writeHeader(const MacFrame_Template *tmpl, uint8_t seq, uint8_t *buf)
+{
+    memcpy(buf, tmpl->hdr, tmpl->hdrLen);
+    buf[MAC_FRAME_SEQ_OFFSET] = seq;
+
+    return buf + tmpl->hdrLen;
+}
+
+uint8_t MacFrame_build(const MacFrame_Template *tmpl, uint8_t seq,
+                       const uint8_t *payload, uint8_t payloadLen, uint8_t *buf)
+{
+    uint16_t length = (uint16_t)tmpl->hdrLen + payloadLen;
+    if (length > MAC_FRAME_MAX_LENGTH)
+    {
+        return 0;
+    }
+
+    memcpy(MacFrame_writeHeader(tmpl, seq, buf), payload, payloadLen);
+
+    return (uint8_t)length;
+}
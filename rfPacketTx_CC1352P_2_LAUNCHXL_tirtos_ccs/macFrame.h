@@ -0,0 +1,182 @@
+/*
+ *  ======== macFrame.h ========
+ *  IEEE 802.15.4 MAC frame builder.
+ *
+ *  A MacFrame_Template holds a complete MAC header with the sequence number
+ *  left blank. Templates with a fixed layout can be written as constant
+ *  initializers with the MAC_FRAME_TEMPLATE_* macros, so the header bytes
+ *  are computed by the compiler; any other layout is built once at run time
+ *  with MacFrame_initTemplate(). Per frame, MacFrame_build() only copies
+ *  the header, patches the sequence number and appends the payload.
+ *
+ *  Frames are built without the FCS, which the radio appends
+ *  (CMD_IEEE_TX txOpt.bIncludeCrc = 0). Multi-byte fields are little
+ *  endian on air.
+ *
+ *  The module only depends on the C standard library and builds on the
+ *  host as well as on the target.
+ */
+#ifndef MACFRAME_H_
+#define MACFRAME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Frame types */
+#define MAC_FRAME_TYPE_BEACON       0
+#define MAC_FRAME_TYPE_DATA         1
+#define MAC_FRAME_TYPE_ACK          2
+#define MAC_FRAME_TYPE_COMMAND      3
+
+/* Addressing modes */
+#define MAC_ADDR_MODE_NONE          0
+#define MAC_ADDR_MODE_SHORT         2
+#define MAC_ADDR_MODE_EXT           3
+
+/* Frame versions */
+#define MAC_FRAME_VERSION_2003      0
+#define MAC_FRAME_VERSION_2006      1
+
+#define MAC_BROADCAST_ADDR          0xFFFF
+#define MAC_BROADCAST_PAN_ID        0xFFFF
+
+/* Frame control field */
+#define MAC_FCF(type, ackReq, panIdComp, dstMode, version, srcMode) \
+    ((uint16_t)((type) | ((ackReq) << 5) | ((panIdComp) << 6) | \
+                ((dstMode) << 10) | ((version) << 12) | ((srcMode) << 14)))
+
+/* Offset of the sequence number in every MAC header */
+#define MAC_FRAME_SEQ_OFFSET        2
+
+/* FCF, sequence number, both PAN IDs and two extended addresses */
+#define MAC_FRAME_MAX_HDR_LENGTH    23
+
+/* aMaxPHYPacketSize minus the 2 byte FCS */
+#define MAC_FRAME_MAX_LENGTH        125
+
+/* Time on air in microseconds at 250 kbps of a frame of len bytes without
+ * FCS: preamble, SFD and PHR, the frame and the FCS, 32 us per byte */
+#define MAC_FRAME_AIR_US(len)       (((uint32_t)(len) + 6 + 2) * 32)
+
+/* CMD_IEEE_TX start to the frame going on air, its timeStamp
+ * (aTurnaroundTime, 12 symbols) */
+#define MAC_FRAME_TX_START_TO_AIR_US    192
+
+typedef struct
+{
+    uint8_t hdrLen;
+    uint8_t hdr[MAC_FRAME_MAX_HDR_LENGTH];
+} MacFrame_Template;
+
+typedef struct
+{
+    uint8_t  frameType;         /* MAC_FRAME_TYPE_* */
+    uint8_t  frameVersion;      /* MAC_FRAME_VERSION_* */
+    bool     ackRequest;
+    bool     panIdCompression;  /* Only used when both addresses are present */
+    uint8_t  dstAddrMode;       /* MAC_ADDR_MODE_* */
+    uint16_t dstPanId;
+    uint16_t dstShortAddr;
+    uint64_t dstExtAddr;
+    uint8_t  srcAddrMode;       /* MAC_ADDR_MODE_* */
+    uint16_t srcPanId;
+    uint16_t srcShortAddr;
+    uint64_t srcExtAddr;
+} MacFrame_Params;
+
+/* Little endian byte lists for template initializers */
+#define MAC_U16_BYTES(x)    (uint8_t)((x) & 0xFF), (uint8_t)(((x) >> 8) & 0xFF)
+#define MAC_U64_BYTES(x)    MAC_U16_BYTES((uint64_t)(x)), MAC_U16_BYTES((uint64_t)(x) >> 16), \
+                            MAC_U16_BYTES((uint64_t)(x) >> 32), MAC_U16_BYTES((uint64_t)(x) >> 48)
+
+/*
+ * Data frame, short source and destination address, PAN ID compression.
+ * 9 byte header.
+ */
+#define MAC_FRAME_TEMPLATE_DATA_SHORT(panId, dstAddr, srcAddr, ackReq)                          \
+    { .hdrLen = 9,                                                                              \
+      .hdr = { MAC_U16_BYTES(MAC_FCF(MAC_FRAME_TYPE_DATA, ackReq, 1, MAC_ADDR_MODE_SHORT,       \
+                                     MAC_FRAME_VERSION_2003, MAC_ADDR_MODE_SHORT)),             \
+               0, MAC_U16_BYTES(panId), MAC_U16_BYTES(dstAddr), MAC_U16_BYTES(srcAddr) } }
+
+/*
+ * Data frame, extended source and destination address, PAN ID compression.
+ * 21 byte header.
+ */
+#define MAC_FRAME_TEMPLATE_DATA_EXT(panId, dstAddr, srcAddr, ackReq)                            \
+    { .hdrLen = 21,                                                                             \
+      .hdr = { MAC_U16_BYTES(MAC_FCF(MAC_FRAME_TYPE_DATA, ackReq, 1, MAC_ADDR_MODE_EXT,         \
+                                     MAC_FRAME_VERSION_2003, MAC_ADDR_MODE_EXT)),               \
+               0, MAC_U16_BYTES(panId), MAC_U64_BYTES(dstAddr), MAC_U64_BYTES(srcAddr) } }
+
+/*
+ * Beacon frame, short source address, no destination. 7 byte header; the
+ * superframe specification, GTS and pending address fields are payload.
+ */
+#define MAC_FRAME_TEMPLATE_BEACON_SHORT(panId, srcAddr)                                         \
+    { .hdrLen = 7,                                                                              \
+      .hdr = { MAC_U16_BYTES(MAC_FCF(MAC_FRAME_TYPE_BEACON, 0, 0, MAC_ADDR_MODE_NONE,           \
+                                     MAC_FRAME_VERSION_2003, MAC_ADDR_MODE_SHORT)),             \
+               0, MAC_U16_BYTES(panId), MAC_U16_BYTES(srcAddr) } }
+
+/*
+ * Beacon frame, extended source address, no destination. 13 byte header.
+ */
+#define MAC_FRAME_TEMPLATE_BEACON_EXT(panId, srcAddr)                                           \
+    { .hdrLen = 13,                                                                             \
+      .hdr = { MAC_U16_BYTES(MAC_FCF(MAC_FRAME_TYPE_BEACON, 0, 0, MAC_ADDR_MODE_NONE,           \
+                                     MAC_FRAME_VERSION_2003, MAC_ADDR_MODE_EXT)),               \
+               0, MAC_U16_BYTES(panId), MAC_U64_BYTES(srcAddr) } }
+
+/*
+ * MAC command frame, short source and destination address, PAN ID
+ * compression. 9 byte header; the command identifier is the first payload
+ * byte.
+ */
+#define MAC_FRAME_TEMPLATE_COMMAND_SHORT(panId, dstAddr, srcAddr, ackReq)                       \
+    { .hdrLen = 9,                                                                              \
+      .hdr = { MAC_U16_BYTES(MAC_FCF(MAC_FRAME_TYPE_COMMAND, ackReq, 1, MAC_ADDR_MODE_SHORT,    \
+                                     MAC_FRAME_VERSION_2003, MAC_ADDR_MODE_SHORT)),             \
+               0, MAC_U16_BYTES(panId), MAC_U16_BYTES(dstAddr), MAC_U16_BYTES(srcAddr) } }
+
+/*
+ *  ======== MacFrame_initTemplate ========
+ *  Builds a template for any frame type and addressing combination.
+ *  Returns false for invalid addressing modes.
+ */
+extern bool MacFrame_initTemplate(MacFrame_Template *tmpl, const MacFrame_Params *params);
+
+/*
+ *  ======== MacFrame_writeHeader ========
+ *  Copies the header with sequence number seq to buf and returns a pointer
+ *  to the first payload byte, so the payload can be written in place.
+ */
+extern uint8_t *MacFrame_writeHeader(const MacFrame_Template *tmpl, uint8_t seq, uint8_t *buf);
+
+/*
+ *  ======== MacFrame_build ========
+ *  Writes header and payload to buf and returns the frame length to put in
+ *  CMD_IEEE_TX payloadLen, or 0 if the frame would exceed
+ *  MAC_FRAME_MAX_LENGTH.
+ */
+extern uint8_t MacFrame_build(const MacFrame_Template *tmpl, uint8_t seq,
+                              const uint8_t *payload, uint8_t payloadLen, uint8_t *buf);
+
+/*
+ *  ======== MacFrame_getType ========
+ *  Returns the frame type, MAC_FRAME_TYPE_*, from the FCF.
+ */
+static inline uint8_t MacFrame_getType(const uint8_t *frame)
+{
+    return frame[0] & 0x07;
+}
+
+/*
+ *  ======== MacFrame_getSeq ========
+ */
+static inline uint8_t MacFrame_getSeq(const uint8_t *frame)
+{
+    return frame[MAC_FRAME_SEQ_OFFSET];
+}
+
+#endif /* MACFRAME_H_ */
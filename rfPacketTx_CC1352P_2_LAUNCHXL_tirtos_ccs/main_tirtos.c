@@ -35,35 +35,86 @@
  *  ======== main_tirtos.c ========
  */
 #include <stdint.h>
+#include <stdio.h>
 
 /* POSIX Header files */
 #include <pthread.h>
 
 /* RTOS header files */
 #include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+
+/* TI Drivers */
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26X2.h>
 
 /* Example/Board Header files */
 #include "ti_drivers_config.h"
+#include "bootTime.h"
 
 extern void *mainThread(void *arg0);
 
 /* Stack size in bytes */
 #define THREADSTACKSIZE    2096
 
+/* Build with STATIC_ALLOCATION defined, for the compiler and the linker,
+ * to take nothing from the heap: the thread is a task constructed on a
+ * static stack and stdout gets a static buffer, and the linker command
+ * file shrinks the heap to match. memWatch.h reports what is left. */
+#ifdef STATIC_ALLOCATION
+#define STDOUT_BUFFER_SIZE  256
+
+static Task_Struct mainTaskStruct;
+static uint8_t mainTaskStack[THREADSTACKSIZE] __attribute__((aligned(8)));
+static char stdoutBuffer[STDOUT_BUFFER_SIZE];
+
+/*
+ *  ======== mainTask ========
+ */
+static void mainTask(UArg arg0, UArg arg1)
+{
+    mainThread(NULL);
+}
+#endif
+
 /*
  *  ======== main ========
  */
 int main(void)
 {
+#ifndef STATIC_ALLOCATION
     pthread_t           thread;
     pthread_attr_t      attrs;
     struct sched_param  priParam;
     int                 retc;
     int                 detachState;
+#endif
+
+    BootTime_init();
 
     /* Call driver init functions */
     Board_initGeneral();
-
+    BootTime_mark(BOOT_TIME_BOARD);
+
+#ifdef FAST_BOOT
+    /* Start the HF crystal now rather than when the radio first powers up,
+     * so it settles while the kernel starts; mainThread() releases it
+     * after the first frame */
+    Power_setDependency(PowerCC26XX_XOSC_HF);
+    BootTime_mark(BOOT_TIME_XOSC);
+#endif
+
+#ifdef STATIC_ALLOCATION
+    /* Otherwise the first write to stdout allocates its buffer */
+    setvbuf(stdout, stdoutBuffer, _IOLBF, sizeof(stdoutBuffer));
+
+    Task_Params taskParams;
+    Task_Params_init(&taskParams);
+    taskParams.stack = mainTaskStack;
+    taskParams.stackSize = THREADSTACKSIZE;
+    taskParams.priority = 1;
+    Task_construct(&mainTaskStruct, mainTask, &taskParams, NULL);
+#else
     /* Set priority and stack size attributes */
     pthread_attr_init(&attrs);
     priParam.sched_priority = 1;
@@ -88,7 +139,9 @@ int main(void)
         /* pthread_create() failed */
         while (1);
     }
+#endif
 
+    BootTime_mark(BOOT_TIME_BIOS);
     BIOS_start();
 
     return (0);
@@ -0,0 +1,155 @@
+/*
+ *  ======== memWatch.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+
+#include "memWatch.h"
+#include "radioTrace.h"
+
+/* RTOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Memory.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Task.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/***** Prototypes *****/
+static void addRegion(uint16_t region, uint32_t size, uint32_t used);
+static void addTask(Task_Handle task, uint8_t index);
+
+/***** Variable declarations *****/
+static MemWatch_Stats stats;
+
+/***** Function definitions *****/
+
+/* Keeps the peak of the region from the samples before */
+static void addRegion(uint16_t region, uint32_t size, uint32_t used)
+{
+    MemWatch_Region *r = NULL;
+    uint8_t i;
+
+    for (i = 0; i < stats.numRegions; i++)
+    {
+        if (stats.regions[i].region == region)
+        {
+            r = &stats.regions[i];
+            break;
+        }
+    }
+    if (r == NULL)
+    {
+        if (stats.numRegions == MEM_WATCH_MAX_REGIONS)
+        {
+            return;
+        }
+        r = &stats.regions[stats.numRegions++];
+        r->region = region;
+        r->peak = 0;
+    }
+
+    r->size = size;
+    if (used > r->peak)
+    {
+        r->peak = used;
+    }
+}
+
+static void addTask(Task_Handle task, uint8_t index)
+{
+    Task_Stat taskStat;
+
+    Task_stat(task, &taskStat);
+    if (taskStat.used >= taskStat.stackSize)
+    {
+        stats.overflow = true;
+    }
+    addRegion(MEM_WATCH_REGION(MEM_WATCH_KIND_TASK, index), taskStat.stackSize, taskStat.used);
+}
+
+void MemWatch_sample(void)
+{
+    uint32_t start = RF_getCurrentTime();
+    uint8_t index = 0;
+    Int i;
+
+    /* Static tasks first, such as the idle task, then the list of those
+     * created or constructed at run time, in the order they were made */
+    for (i = 0; i < Task_Object_count(); i++)
+    {
+        addTask(Task_Object_get(NULL, i), index++);
+    }
+    Task_Handle task;
+    for (task = Task_Object_first(); task != NULL; task = Task_Object_next(task))
+    {
+        addTask(task, index++);
+    }
+
+    Hwi_StackInfo stackInfo;
+    if (Hwi_getStackInfo(&stackInfo, TRUE))
+    {
+        stats.overflow = true;
+    }
+    addRegion(MEM_WATCH_REGION(MEM_WATCH_KIND_ISR, 0), stackInfo.hwiStackSize, stackInfo.hwiStackPeak);
+
+    Memory_Stats heapStats;
+    Memory_getStats(NULL, &heapStats);
+    addRegion(MEM_WATCH_REGION(MEM_WATCH_KIND_HEAP, 0), heapStats.totalSize,
+              heapStats.totalSize - heapStats.totalFreeSize);
+
+    stats.numSamples++;
+    stats.sampleTicks = RF_getCurrentTime() - start;
+}
+
+void MemWatch_trace(void)
+{
+    uint32_t now = RF_getCurrentTime();
+    uint8_t i;
+
+    for (i = 0; i < stats.numRegions; i++)
+    {
+        const MemWatch_Region *r = &stats.regions[i];
+        RadioTrace_addMemory(r->region, r->size, r->peak, now);
+    }
+}
+
+void MemWatch_getStats(MemWatch_Stats *pStats)
+{
+    *pStats = stats;
+}
+
+int MemWatch_formatStats(const MemWatch_Stats *s, char *buf, size_t size)
+{
+    static const char *const kindNames[] = { "?", "task", "isr", "heap" };
+    int n = snprintf(buf, size, "# memory");
+    size_t used;
+    uint8_t i;
+
+    for (i = 0; i < s->numRegions; i++)
+    {
+        const MemWatch_Region *r = &s->regions[i];
+        uint8_t kind = r->region >> 8;
+        char name[8];
+
+        if (kind == MEM_WATCH_KIND_TASK)
+        {
+            snprintf(name, sizeof(name), "task%u", r->region & 0xFF);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "%s", (kind <= MEM_WATCH_KIND_HEAP) ? kindNames[kind] : kindNames[0]);
+        }
+        used = ((size_t)n < size) ? (size_t)n : size;
+        n += snprintf(buf + used, size - used, "%s%s %lu/%lu", (i == 0) ? " " : ", ", name,
+                      (unsigned long)r->peak, (unsigned long)r->size);
+    }
+    used = ((size_t)n < size) ? (size_t)n : size;
+    n += snprintf(buf + used, size - used, "%s, sampled in %lu us\n", s->overflow ? ", overflow" : "",
+                  (unsigned long)RF_convertRatTicksToUs(s->sampleTicks));
+
+    return n;
+}
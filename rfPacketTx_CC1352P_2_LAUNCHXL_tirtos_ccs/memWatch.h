@@ -0,0 +1,80 @@
+/*
+ *  ======== memWatch.h ========
+ *  Stack and heap high-water marks.
+ *
+ *  The kernel fills every task stack and the ISR stack with 0xBE before
+ *  they are used (Task.initStackFlag and Hwi.initStackFlag, both on by
+ *  default), and Task_stat() and Hwi_getStackInfo() scan for the deepest
+ *  byte that was ever overwritten. MemWatch_sample() takes that for every
+ *  task, created, constructed or static, and for the ISR stack (the C
+ *  stack of the linker command file), so their peaks are exact whenever
+ *  they are sampled. The heap keeps no such mark: its peak is the least
+ *  free space seen by any sample, so it is only as good as the sampling.
+ *
+ *  MemWatch_trace() logs every region as a memory record of the radio
+ *  trace (radioTrace.h), read out and decoded with the commands.
+ *
+ *  Sampling scans the stacks, roughly a microsecond per 100 bytes, so it
+ *  belongs between bursts, not next to the radio.
+ */
+#ifndef MEMWATCH_H_
+#define MEMWATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Tasks, the ISR stack and the heap */
+#ifndef MEM_WATCH_MAX_REGIONS
+#define MEM_WATCH_MAX_REGIONS       8
+#endif
+
+/* Region numbers: kind in the high byte, the task's number in the low */
+#define MEM_WATCH_KIND_TASK         1
+#define MEM_WATCH_KIND_ISR          2
+#define MEM_WATCH_KIND_HEAP         3
+#define MEM_WATCH_REGION(kind, index)   ((uint16_t)(((kind) << 8) | (index)))
+
+typedef struct
+{
+    uint16_t region;            /* MEM_WATCH_REGION() */
+    uint32_t size;              /* Bytes */
+    uint32_t peak;              /* Most bytes ever used */
+} MemWatch_Region;
+
+typedef struct
+{
+    uint32_t numSamples;
+    uint32_t sampleTicks;       /* RAT ticks the last sample took */
+    uint8_t numRegions;
+    bool overflow;              /* A stack was found used to its last byte */
+    MemWatch_Region regions[MEM_WATCH_MAX_REGIONS];
+} MemWatch_Stats;
+
+/*
+ *  ======== MemWatch_sample ========
+ *  Takes the high-water marks of every stack and the free space of the
+ *  default heap, from a task.
+ */
+extern void MemWatch_sample(void);
+
+/*
+ *  ======== MemWatch_trace ========
+ *  Logs the peaks of the last sample to the radio trace, one record per
+ *  region.
+ */
+extern void MemWatch_trace(void);
+
+/*
+ *  ======== MemWatch_getStats ========
+ */
+extern void MemWatch_getStats(MemWatch_Stats *stats);
+
+/*
+ *  ======== MemWatch_formatStats ========
+ *  Writes one line with the peak and size of every region in bytes.
+ *  Returns the length like snprintf().
+ */
+extern int MemWatch_formatStats(const MemWatch_Stats *stats, char *buf, size_t size);
+
+#endif /* MEMWATCH_H_ */
@@ -0,0 +1,178 @@
+/*
+ *  ======== payloadGen.c ========
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <string.h>
+
+#include "payloadGen.h"
+
+/***** Defines *****/
+#define PRBS9_MASK              0x1FF
+#define PRBS15_MASK             0x7FFF
+
+/* Bytes generated per PayloadGen_check() round */
+#define CHECK_CHUNK             16
+
+/***** Prototypes *****/
+static void buildPrbs9Table(void);
+static uint32_t countBits(uint32_t x);
+
+/***** Variable declarations *****/
+
+/* Next 8 output bits for each PRBS9 register; the register keeps the last
+ * 9 bits of the sequence, the oldest in bit 0 */
+static uint8_t prbs9Table[PRBS9_MASK + 1];
+static bool prbs9TableBuilt;
+
+/***** Function definitions *****/
+
+static void buildPrbs9Table(void)
+{
+    uint32_t reg;
+
+    for (reg = 0; reg <= PRBS9_MASK; reg++)
+    {
+        uint32_t r = reg;
+        uint8_t out = 0;
+        uint8_t k;
+
+        /* s[n] = s[n-9] ^ s[n-5] */
+        for (k = 0; k < 8; k++)
+        {
+            uint32_t bit = (r ^ (r >> 4)) & 1;
+            r = (r >> 1) | (bit << 8);
+            out |= (uint8_t)(bit << k);
+        }
+        prbs9Table[reg] = out;
+    }
+
+    prbs9TableBuilt = true;
+}
+
+static uint32_t countBits(uint32_t x)
+{
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F;
+    return (x * 0x01010101) >> 24;
+}
+
+void PayloadGen_init(PayloadGen_Object *gen, PayloadGen_Pattern pattern, uint32_t seed)
+{
+    gen->pattern = pattern;
+
+    switch (pattern)
+    {
+        case PAYLOAD_GEN_PRBS9:
+            if (!prbs9TableBuilt)
+            {
+                buildPrbs9Table();
+            }
+            seed &= PRBS9_MASK;
+            gen->state = (seed != 0) ? seed : PRBS9_MASK;
+            break;
+
+        case PAYLOAD_GEN_PRBS15:
+            seed &= PRBS15_MASK;
+            gen->state = (seed != 0) ? seed : PRBS15_MASK;
+            break;
+
+        default:
+            gen->state = seed & 0xFF;
+            break;
+    }
+}
+
+void PayloadGen_fill(PayloadGen_Object *gen, uint8_t *buf, uint32_t length)
+{
+    uint32_t state = gen->state;
+    uint32_t i = 0;
+
+    switch (gen->pattern)
+    {
+        case PAYLOAD_GEN_FIXED:
+            memset(buf, (int)state, length);
+            break;
+
+        case PAYLOAD_GEN_COUNTER:
+        {
+            /* Four counter bytes per word, each byte adding on its own
+             * without a carry into the next; little endian, so the first
+             * byte is the low one */
+            uint32_t word = state * 0x01010101;
+            word = ((word & 0x7F7F7F7F) + 0x03020100) ^ (word & 0x80808080);
+            for (i = 0; i + 4 <= length; i += 4)
+            {
+                memcpy(&buf[i], &word, 4);
+                word = ((word & 0x7F7F7F7F) + 0x04040404) ^ (word & 0x80808080);
+            }
+            for (; i < length; i++)
+            {
+                buf[i] = (uint8_t)(state + i);
+            }
+            state = (state + length) & 0xFF;
+            break;
+        }
+
+        case PAYLOAD_GEN_PRBS9:
+            for (i = 0; i < length; i++)
+            {
+                uint8_t out = prbs9Table[state];
+                buf[i] = out;
+                state = (state >> 8) | ((uint32_t)out << 1);
+            }
+            break;
+
+        case PAYLOAD_GEN_PRBS15:
+            for (i = 0; i < length; i++)
+            {
+                /* s[n] = s[n-15] ^ s[n-14], eight bits at once */
+                uint32_t out = (state ^ (state >> 1)) & 0xFF;
+                buf[i] = (uint8_t)out;
+                state = (state >> 8) | (out << 7);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    gen->state = state;
+}
+
+uint32_t PayloadGen_check(PayloadGen_Object *gen, const uint8_t *buf, uint32_t length)
+{
+    uint8_t expected[CHECK_CHUNK];
+    uint32_t numErrors = 0;
+
+    while (length > 0)
+    {
+        uint32_t chunk = (length > CHECK_CHUNK) ? CHECK_CHUNK : length;
+        uint32_t i;
+
+        PayloadGen_fill(gen, expected, chunk);
+        for (i = 0; i < chunk; i++)
+        {
+            numErrors += countBits(expected[i] ^ buf[i]);
+        }
+
+        buf += chunk;
+        length -= chunk;
+    }
+
+    return numErrors;
+}
+
+const char *PayloadGen_getName(PayloadGen_Pattern pattern)
+{
+    switch (pattern)
+    {
+        case PAYLOAD_GEN_FIXED:   return "fixed";
+        case PAYLOAD_GEN_COUNTER: return "counter";
+        case PAYLOAD_GEN_PRBS9:   return "prbs9";
+        case PAYLOAD_GEN_PRBS15:  return "prbs15";
+        default:                  return "?";
+    }
+}
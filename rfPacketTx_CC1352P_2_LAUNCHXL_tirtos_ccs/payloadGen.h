@@ -0,0 +1,67 @@
+/*
+ *  ======== payloadGen.h ========
+ *  Payload patterns for PER and bit error testing.
+ *
+ *  A generator writes one continuous sequence across any number of
+ *  buffers: every fill resumes where the last one stopped, so the payloads
+ *  of consecutive frames are consecutive pieces of the pattern. A receiver
+ *  holding a generator in the same state checks a payload against it with
+ *  PayloadGen_check(), which counts the bit errors and moves on by the
+ *  same length.
+ *
+ *  PRBS bits are packed least significant bit first, the order the radio
+ *  sends them, so the bit stream on air is the sequence itself:
+ *   - PRBS9, x^9 + x^5 + 1 (ITU-T O.153), period 511 bits, eight bits per
+ *     lookup in a 512 entry table,
+ *   - PRBS15, x^15 + x^14 + 1 (ITU-T O.150), period 32767 bits, eight
+ *     bits per step straight from the register: both taps of the next 8
+ *     bits are already in it.
+ *  The counter writes 0, 1, 2, ... 255, 0, ... and the fixed pattern one
+ *  byte value, both a 32 bit word at a time.
+ */
+#ifndef PAYLOADGEN_H_
+#define PAYLOADGEN_H_
+
+#include <stdint.h>
+
+typedef enum
+{
+    PAYLOAD_GEN_FIXED,          /* seed is the byte value */
+    PAYLOAD_GEN_COUNTER,        /* seed is the first byte */
+    PAYLOAD_GEN_PRBS9,          /* seed is the register, 0 for all ones */
+    PAYLOAD_GEN_PRBS15,
+    PAYLOAD_GEN_COUNT
+} PayloadGen_Pattern;
+
+typedef struct
+{
+    PayloadGen_Pattern pattern;
+    uint32_t state;             /* Byte value, next counter byte or LFSR register */
+} PayloadGen_Object;
+
+/*
+ *  ======== PayloadGen_init ========
+ *  Starts pattern from seed. The generator is a plain struct: copying it
+ *  saves the position in the sequence.
+ */
+extern void PayloadGen_init(PayloadGen_Object *gen, PayloadGen_Pattern pattern, uint32_t seed);
+
+/*
+ *  ======== PayloadGen_fill ========
+ *  Writes the next length bytes of the sequence to buf.
+ */
+extern void PayloadGen_fill(PayloadGen_Object *gen, uint8_t *buf, uint32_t length);
+
+/*
+ *  ======== PayloadGen_check ========
+ *  Compares buf with the next length bytes of the sequence and returns
+ *  the number of bits that differ.
+ */
+extern uint32_t PayloadGen_check(PayloadGen_Object *gen, const uint8_t *buf, uint32_t length);
+
+/*
+ *  ======== PayloadGen_getName ========
+ */
+extern const char *PayloadGen_getName(PayloadGen_Pattern pattern);
+
+#endif /* PAYLOADGEN_H_ */
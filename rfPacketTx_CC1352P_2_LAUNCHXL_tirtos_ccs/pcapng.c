@@ -0,0 +1,150 @@
+/*
+ *  ======== pcapng.c ========
+ */
+
+/***** Includes *****/
+#include <stdio.h>
+#include <string.h>
+
+#include "pcapng.h"
+
+/***** Defines *****/
+#define BLOCK_SHB               0x0A0D0D0A
+#define BLOCK_IDB               0x00000001
+#define BLOCK_EPB               0x00000006
+#define BYTE_ORDER_MAGIC        0x1A2B3C4D
+
+#define OPT_END                 0
+#define OPT_IF_NAME             2
+#define OPT_IF_DESCRIPTION      3
+#define OPT_IF_TSRESOL          9
+
+#define TS_RESOLUTION_NS        9       /* 10^-9 s */
+#define NS_PER_RAT_TICK         250
+
+#define TAP_FCS_TYPE            0
+#define TAP_CHANNEL             3
+#define TAP_FCS_NONE            0
+
+#define IF_NAME                 "cc1352p-tx"
+
+/***** Prototypes *****/
+static void put16(uint8_t *buf, uint16_t value);
+static void put32(uint8_t *buf, uint32_t value);
+static uint32_t putOption(uint8_t *buf, uint16_t code, const void *value, uint16_t length);
+
+/***** Function definitions *****/
+
+static void put16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t *buf, uint32_t value)
+{
+    put16(buf, (uint16_t)value);
+    put16(&buf[2], (uint16_t)(value >> 16));
+}
+
+/* Writes an option padded to 32 bits and returns its length */
+static uint32_t putOption(uint8_t *buf, uint16_t code, const void *value, uint16_t length)
+{
+    uint32_t padded = (length + 3u) & ~3u;
+
+    put16(&buf[0], code);
+    put16(&buf[2], length);
+    memset(&buf[4 + length], 0, padded - length);
+    memcpy(&buf[4], value, length);
+
+    return 4 + padded;
+}
+
+void Pcapng_Clock_init(Pcapng_Clock *clock)
+{
+    clock->lastTime = 0;
+    clock->numWraps = 0;
+}
+
+uint64_t Pcapng_toNs(Pcapng_Clock *clock, uint32_t ratTime)
+{
+    if (ratTime < clock->lastTime)
+    {
+        clock->numWraps++;
+    }
+    clock->lastTime = ratTime;
+
+    return ((((uint64_t)clock->numWraps) << 32) | ratTime) * NS_PER_RAT_TICK;
+}
+
+uint32_t Pcapng_writeSectionHeader(uint8_t *buf)
+{
+    put32(&buf[0], BLOCK_SHB);
+    put32(&buf[4], PCAPNG_SHB_LENGTH);
+    put32(&buf[8], BYTE_ORDER_MAGIC);
+    put16(&buf[12], 1);                 /* Version 1.0 */
+    put16(&buf[14], 0);
+    put32(&buf[16], 0xFFFFFFFF);        /* Section length not given */
+    put32(&buf[20], 0xFFFFFFFF);
+    put32(&buf[24], PCAPNG_SHB_LENGTH);
+
+    return PCAPNG_SHB_LENGTH;
+}
+
+uint32_t Pcapng_writeInterface(uint8_t *buf, uint8_t channel, int8_t txPower)
+{
+    static const uint8_t tsResolution = TS_RESOLUTION_NS;
+    char description[24];
+    uint32_t length = 16;
+
+    put32(&buf[0], BLOCK_IDB);
+    put16(&buf[8], PCAPNG_LINKTYPE_IEEE802_15_4_TAP);
+    put16(&buf[10], 0);
+    put32(&buf[12], 0);                 /* No snap length */
+
+    int n = snprintf(description, sizeof(description), "ch %u, %d dBm", channel, txPower);
+    length += putOption(&buf[length], OPT_IF_NAME, IF_NAME, sizeof(IF_NAME) - 1);
+    length += putOption(&buf[length], OPT_IF_DESCRIPTION, description, (uint16_t)n);
+    length += putOption(&buf[length], OPT_IF_TSRESOL, &tsResolution, 1);
+    length += putOption(&buf[length], OPT_END, NULL, 0);
+    length += 4;
+
+    put32(&buf[4], length);
+    put32(&buf[length - 4], length);
+
+    return length;
+}
+
+uint32_t Pcapng_writeFrame(uint8_t *buf, uint32_t interfaceId, uint64_t timeNs,
+                           uint8_t channel, const uint8_t *psdu, uint8_t length)
+{
+    uint32_t blockLength = PCAPNG_EPB_LENGTH(length);
+    uint32_t dataLength = PCAPNG_TAP_LENGTH + length;
+    uint8_t *tap = &buf[PCAPNG_EPB_HDR_LENGTH];
+
+    put32(&buf[0], BLOCK_EPB);
+    put32(&buf[4], blockLength);
+    put32(&buf[8], interfaceId);
+    put32(&buf[12], (uint32_t)(timeNs >> 32));
+    put32(&buf[16], (uint32_t)timeNs);
+    put32(&buf[20], dataLength);
+    put32(&buf[24], dataLength);
+
+    /* TAP header: version, reserved, length, then the TLVs */
+    tap[0] = 0;
+    tap[1] = 0;
+    put16(&tap[2], PCAPNG_TAP_LENGTH);
+    put16(&tap[4], TAP_FCS_TYPE);
+    put16(&tap[6], 1);
+    put32(&tap[8], TAP_FCS_NONE);
+    put16(&tap[12], TAP_CHANNEL);
+    put16(&tap[14], 3);
+    put16(&tap[16], channel);
+    put16(&tap[18], 0);                 /* Page 0, padding */
+
+    memcpy(&tap[PCAPNG_TAP_LENGTH], psdu, length);
+    memset(&tap[dataLength], 0, blockLength - 4 - PCAPNG_EPB_HDR_LENGTH - dataLength);
+    put32(&buf[blockLength - 4], blockLength);
+
+    return blockLength;
+}
@@ -0,0 +1,76 @@
+/*
+ *  ======== pcapng.h ========
+ *  PCAPNG blocks for a capture of the frames this device sends.
+ *
+ *  Frames are stored with the IEEE 802.15.4 TAP link type, each with a
+ *  TAP header giving the channel and that the PSDU has no FCS (the radio
+ *  appends it). Time stamps are the radio timer times the frames started
+ *  on air, in nanoseconds. The TX power is not a TAP field: every change
+ *  of channel or TX power starts a new interface whose description holds
+ *  both, and the frames refer to it.
+ *
+ *  The caller decides where the blocks go and how many are batched into
+ *  one write. All blocks are little endian. Only depends on the C standard
+ *  library, the host tools build it too.
+ */
+#ifndef PCAPNG_H_
+#define PCAPNG_H_
+
+#include <stdint.h>
+
+#define PCAPNG_LINKTYPE_IEEE802_15_4_TAP    283
+
+#define PCAPNG_SHB_LENGTH           28
+#define PCAPNG_IDB_MAX_LENGTH       68
+#define PCAPNG_TAP_LENGTH           20
+#define PCAPNG_EPB_HDR_LENGTH       28
+
+/* Enhanced packet block of a PSDU of the given length */
+#define PCAPNG_EPB_LENGTH(psduLength)   (PCAPNG_EPB_HDR_LENGTH + \
+                                         ((PCAPNG_TAP_LENGTH + (psduLength) + 3) & ~3) + 4)
+#define PCAPNG_EPB_MAX_LENGTH       PCAPNG_EPB_LENGTH(127)
+
+/* Extends the 32 bit radio timer, which wraps every 17.9 minutes */
+typedef struct
+{
+    uint32_t lastTime;
+    uint32_t numWraps;
+} Pcapng_Clock;
+
+/*
+ *  ======== Pcapng_Clock_init ========
+ */
+extern void Pcapng_Clock_init(Pcapng_Clock *clock);
+
+/*
+ *  ======== Pcapng_toNs ========
+ *  Returns ratTime (RAT ticks, 4 per microsecond) in nanoseconds. Times
+ *  must come in order and less than a wrap apart.
+ */
+extern uint64_t Pcapng_toNs(Pcapng_Clock *clock, uint32_t ratTime);
+
+/*
+ *  ======== Pcapng_writeSectionHeader ========
+ *  Writes a section header block, which starts a file or a new section
+ *  with no interfaces. Returns PCAPNG_SHB_LENGTH.
+ */
+extern uint32_t Pcapng_writeSectionHeader(uint8_t *buf);
+
+/*
+ *  ======== Pcapng_writeInterface ========
+ *  Writes an interface description block for frames sent with the given
+ *  channel and TX power. Interfaces are numbered from 0 in the order
+ *  their blocks appear in the section. Returns the block length, up to
+ *  PCAPNG_IDB_MAX_LENGTH.
+ */
+extern uint32_t Pcapng_writeInterface(uint8_t *buf, uint8_t channel, int8_t txPower);
+
+/*
+ *  ======== Pcapng_writeFrame ========
+ *  Writes an enhanced packet block of a PSDU without FCS. Returns
+ *  PCAPNG_EPB_LENGTH(length).
+ */
+extern uint32_t Pcapng_writeFrame(uint8_t *buf, uint32_t interfaceId, uint64_t timeNs,
+                                  uint8_t channel, const uint8_t *psdu, uint8_t length);
+
+#endif /* PCAPNG_H_ */
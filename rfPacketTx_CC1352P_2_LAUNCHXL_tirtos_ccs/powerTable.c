@@ -0,0 +1,141 @@
+/*
+ *  ======== powerTable.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+
+#include "powerTable.h"
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Prototypes *****/
+static bool construct(PowerTable_Object *table, const RF_TxPowerTable_Entry *entries);
+static uint8_t entryIndex(const PowerTable_Object *table, int8_t txPower);
+
+/***** Variable declarations *****/
+static PowerTable_Object tables[POWER_TABLE_COUNT];
+
+/***** Function definitions *****/
+
+static bool construct(PowerTable_Object *table, const RF_TxPowerTable_Entry *entries)
+{
+    uint8_t n = 0;
+    while (entries[n].power != RF_TxPowerTable_INVALID_DBM)
+    {
+        n++;
+    }
+
+    table->entries = entries;
+    table->numEntries = 0;
+    if ((n == 0) || (entries[n - 1].power - entries[0].power + 1 > POWER_TABLE_MAX_SPAN))
+    {
+        return false;
+    }
+
+    /* SysConfig tables are sorted by power */
+    table->numEntries = n;
+    table->minDbm = entries[0].power;
+    table->maxDbm = entries[n - 1].power;
+
+    /* One pass: every dBm value takes the closer of the entries below and
+     * above it, the lower one on a tie */
+    uint8_t i = 0;
+    int16_t dbm;
+    for (dbm = table->minDbm; dbm <= table->maxDbm; dbm++)
+    {
+        if (entries[i + 1].power <= dbm)
+        {
+            i++;
+        }
+        if ((entries[i].power != dbm) && (entries[i + 1].power - dbm < dbm - entries[i].power))
+        {
+            table->index[dbm - table->minDbm] = i + 1;
+        }
+        else
+        {
+            table->index[dbm - table->minDbm] = i;
+        }
+    }
+
+    return true;
+}
+
+static uint8_t entryIndex(const PowerTable_Object *table, int8_t txPower)
+{
+    if (txPower <= table->minDbm)
+    {
+        return 0;
+    }
+    if (txPower >= table->maxDbm)
+    {
+        return table->numEntries - 1;
+    }
+    return table->index[txPower - table->minDbm];
+}
+
+bool PowerTable_init(void)
+{
+    bool ok = true;
+
+    ok &= construct(&tables[POWER_TABLE_2400_PA5], txPowerTable_2400_pa5);
+    ok &= construct(&tables[POWER_TABLE_2400_PA5_20], txPowerTable_2400_pa5_20);
+    ok &= construct(&tables[POWER_TABLE_868_PA13], txPowerTable_868_pa13);
+
+    return ok;
+}
+
+const PowerTable_Object *PowerTable_get(PowerTable_Id id)
+{
+    return (id < POWER_TABLE_COUNT) ? &tables[id] : NULL;
+}
+
+int8_t PowerTable_snap(const PowerTable_Object *table, int8_t txPower)
+{
+    return table->entries[entryIndex(table, txPower)].power;
+}
+
+const RF_TxPowerTable_Entry *PowerTable_lookup(const PowerTable_Object *table, int8_t txPower)
+{
+    return &table->entries[entryIndex(table, txPower)];
+}
+
+int8_t PowerTable_step(const PowerTable_Object *table, int8_t txPower, int8_t steps)
+{
+    int16_t i = entryIndex(table, txPower);
+
+    /* Moving from a level the table does not have to its nearest entry
+     * already counts as the first step if it goes the right way */
+    if ((steps > 0) && (table->entries[i].power > txPower))
+    {
+        steps--;
+    }
+    else if ((steps < 0) && (table->entries[i].power < txPower))
+    {
+        steps++;
+    }
+    i += steps;
+
+    if (i < 0)
+    {
+        i = 0;
+    }
+    else if (i >= table->numEntries)
+    {
+        i = table->numEntries - 1;
+    }
+
+    return table->entries[i].power;
+}
+
+void PowerTable_plan(const PowerTable_Object *table, int8_t fromPower, int8_t toPower,
+                     PowerTable_Change *change)
+{
+    const RF_TxPowerTable_Entry *to = PowerTable_lookup(table, toPower);
+
+    change->txPower = to->power;
+    change->value = to->value;
+    change->paSwitch = (fromPower != RF_TxPowerTable_INVALID_DBM) &&
+                       (PowerTable_lookup(table, fromPower)->value.paType != to->value.paType);
+}
@@ -0,0 +1,97 @@
+/*
+ *  ======== powerTable.h ========
+ *  Constant time TX power lookup.
+ *
+ *  RF_TxPowerTable_findValue() scans a power table linearly for an exact
+ *  dBm match. PowerTable_init() instead builds, once, a direct-indexed
+ *  dBm -> entry table for each of the SysConfig power tables, where every
+ *  dBm value in the table's range maps to the nearest level the table
+ *  actually has. Holes such as 11-13 dBm in txPowerTable_2400_pa5_20 snap
+ *  to a neighbour instead of failing, and stepping up or down moves to the
+ *  next available level.
+ *
+ *  PowerTable_plan() tells in advance whether a change moves between the
+ *  default and the high PA. That is the expensive kind of change: the RF
+ *  driver re-runs the radio setup with the other override set and the
+ *  synthesizer must be programmed again.
+ */
+#ifndef POWERTABLE_H_
+#define POWERTABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Largest dBm range (max - min + 1) of a supported table */
+#ifndef POWER_TABLE_MAX_SPAN
+#define POWER_TABLE_MAX_SPAN    64
+#endif
+
+typedef enum
+{
+    POWER_TABLE_2400_PA5,       /* txPowerTable_2400_pa5, -20 to 5 dBm */
+    POWER_TABLE_2400_PA5_20,    /* txPowerTable_2400_pa5_20, -20 to 20 dBm */
+    POWER_TABLE_868_PA13,       /* txPowerTable_868_pa13, -20 to 14 dBm */
+    POWER_TABLE_COUNT
+} PowerTable_Id;
+
+typedef struct
+{
+    const RF_TxPowerTable_Entry *entries;
+    uint8_t numEntries;
+    int8_t  minDbm;
+    int8_t  maxDbm;
+    uint8_t index[POWER_TABLE_MAX_SPAN];    /* dBm - minDbm -> nearest entry */
+} PowerTable_Object;
+
+typedef struct
+{
+    int8_t  txPower;                /* Level that will actually be set */
+    RF_TxPowerTable_Value value;    /* Value for RF_setTxPower() */
+    bool    paSwitch;               /* Moves between the default and the high PA */
+} PowerTable_Change;
+
+/*
+ *  ======== PowerTable_init ========
+ *  Builds the lookup tables. Returns false if a table does not fit
+ *  POWER_TABLE_MAX_SPAN.
+ */
+extern bool PowerTable_init(void);
+
+/*
+ *  ======== PowerTable_get ========
+ */
+extern const PowerTable_Object *PowerTable_get(PowerTable_Id id);
+
+/*
+ *  ======== PowerTable_snap ========
+ *  Returns the available level nearest to txPower, the lower one on a tie.
+ *  Levels outside the table are clamped to its range.
+ */
+extern int8_t PowerTable_snap(const PowerTable_Object *table, int8_t txPower);
+
+/*
+ *  ======== PowerTable_lookup ========
+ *  Returns the entry for PowerTable_snap(table, txPower).
+ */
+extern const RF_TxPowerTable_Entry *PowerTable_lookup(const PowerTable_Object *table, int8_t txPower);
+
+/*
+ *  ======== PowerTable_step ========
+ *  Returns the next available level above (steps > 0) or below
+ *  (steps < 0) txPower, stopping at the ends of the table.
+ */
+extern int8_t PowerTable_step(const PowerTable_Object *table, int8_t txPower, int8_t steps);
+
+/*
+ *  ======== PowerTable_plan ========
+ *  Describes the change from fromPower to toPower without making it.
+ *  fromPower may be RF_TxPowerTable_INVALID_DBM if no power is set yet,
+ *  which never counts as a PA switch.
+ */
+extern void PowerTable_plan(const PowerTable_Object *table, int8_t fromPower, int8_t toPower,
+                            PowerTable_Change *change);
+
+#endif /* POWERTABLE_H_ */
@@ -0,0 +1,401 @@
+/*
+ *  ======== radioSession.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+
+#include "radioSession.h"
+#include "macFrame.h"
+#include "radioTrace.h"
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+
+/* Channel 11 is at 2405 MHz, channels are 5 MHz apart */
+#define CHANNEL_TO_FREQUENCY(ch)    (2405 + 5 * ((ch) - RADIO_SESSION_CHANNEL_MIN))
+#define FREQUENCY_TO_CHANNEL(f)     (RADIO_SESSION_CHANNEL_MIN + ((f) - 2405) / 5)
+
+#define NUM_CHANNELS                (RADIO_SESSION_CHANNEL_MAX - RADIO_SESSION_CHANNEL_MIN + 1)
+
+/***** Variable declarations *****/
+static RF_Object rfObject;
+static RF_Handle rfHandle;
+
+/* CMD_FS for every channel, built once from the exported settings */
+static rfc_CMD_FS_t fsTable[NUM_CHANNELS];
+
+static uint8_t currentChannel;
+static uint8_t tunedChannel;        /* Channel the synthesizer is on, 0 if not programmed */
+static const PowerTable_Object *powerTable;
+static int8_t currentTxPower = RF_TxPowerTable_INVALID_DBM;
+static uint32_t sessionStartTime;
+
+/* CMD_FS posted by RadioSession_postTune() and not yet waited for */
+static RF_CmdHandle pendingFs = RF_ALLOC_ERROR;
+static uint32_t pendingFsStart;
+static uint8_t pendingFsChannel;
+
+/* Between RadioSession_beginTx() and endTx(), with the parameters to post
+ * the CMD_FS of a PA switch with */
+static bool inTx;
+static RF_ScheduleCmdParams txScheduleParams;
+
+/* RF_setTxPower() of a PA switch in a TX session, until its CMD_FS is done */
+static bool paSwitchPending;
+static uint32_t paSwitchStart;
+
+static RadioSession_Stats stats;
+
+/* Power-up seen through the RF driver's global callback and not yet
+ * accounted; the CMD_FS or the first frame it ran for ends it */
+static volatile bool radioOn;
+static volatile bool powerUpPending;
+static volatile uint32_t powerUpStart;
+
+/* Updated by the TX paths and the global callback, also from RF callbacks;
+ * RadioSession_getStats() adds them to stats */
+static volatile uint32_t airTicks;
+static volatile uint32_t powerUpTicks;
+static volatile uint16_t numPowerUps;
+
+/***** Prototypes *****/
+static void finishTune(void);
+static void endPaSwitch(void);
+
+/***** Function definitions *****/
+
+/* Waits for a posted CMD_FS and accounts it like RadioSession_tune() */
+static void finishTune(void)
+{
+    if (pendingFs < 0)
+    {
+        return;
+    }
+
+    rfc_CMD_FS_t *fsCmd = &fsTable[pendingFsChannel - RADIO_SESSION_CHANNEL_MIN];
+    RF_EventMask result = RF_pendCmd(rfHandle, pendingFs, RF_EventLastCmdDone);
+    pendingFs = RF_ALLOC_ERROR;
+
+    uint32_t end = RF_getCurrentTime();
+    RadioTrace_add((RF_Op*)fsCmd, pendingFsStart, RADIO_TRACE_NO_TIME, end);
+    stats.setupTicks += end - pendingFsStart;
+    stats.numFsRuns++;
+
+    /* Any power-up is already in the time of the CMD_FS */
+    powerUpPending = false;
+
+    tunedChannel = ((result & RF_EventLastCmdDone) && (fsCmd->status == DONE_OK)) ? pendingFsChannel : 0;
+    endPaSwitch();
+}
+
+static void endPaSwitch(void)
+{
+    if (!paSwitchPending)
+    {
+        return;
+    }
+
+    uint32_t ticks = RF_getCurrentTime() - paSwitchStart;
+    paSwitchPending = false;
+
+    stats.numPaSwitchesTimed++;
+    stats.paSwitchTicks += ticks;
+    if ((stats.numPaSwitchesTimed == 1) || (ticks < stats.minPaSwitchTicks))
+    {
+        stats.minPaSwitchTicks = ticks;
+    }
+    if (ticks > stats.maxPaSwitchTicks)
+    {
+        stats.maxPaSwitchTicks = ticks;
+    }
+}
+
+RF_Handle RadioSession_open(void)
+{
+    if (powerTable == NULL)
+    {
+        if (!PowerTable_init())
+        {
+            return NULL;
+        }
+        powerTable = PowerTable_get(RADIO_SESSION_POWER_TABLE);
+
+        uint8_t i;
+        for (i = 0; i < NUM_CHANNELS; i++)
+        {
+            fsTable[i] = RF_cmdFs_ieee154;
+            fsTable[i].frequency = CHANNEL_TO_FREQUENCY(RADIO_SESSION_CHANNEL_MIN + i);
+            fsTable[i].fractFreq = 0;
+            fsTable[i].pNextOp = NULL;
+            fsTable[i].condition.rule = COND_NEVER;
+        }
+        currentChannel = FREQUENCY_TO_CHANNEL(RF_cmdFs_ieee154.frequency);
+    }
+
+    if (rfHandle == NULL)
+    {
+        RF_Params rfParams;
+        RF_Params_init(&rfParams);
+
+        uint32_t start = RF_getCurrentTime();
+
+        /* Request access to the radio */
+        rfHandle = RF_open(&rfObject, &RF_prop_ieee154, (RF_RadioSetup*)&RF_cmdRadioSetup_ieee154, &rfParams);
+
+        stats.setupTicks += RF_getCurrentTime() - start;
+        stats.numOpens++;
+
+        tunedChannel = 0;
+        currentTxPower = RF_TxPowerTable_INVALID_DBM;
+    }
+
+    return rfHandle;
+}
+
+void RadioSession_close(void)
+{
+    finishTune();
+    if (rfHandle != NULL)
+    {
+        RF_close(rfHandle);
+        rfHandle = NULL;
+    }
+}
+
+RF_Stat RadioSession_setChannel(uint8_t channel)
+{
+    if ((channel < RADIO_SESSION_CHANNEL_MIN) || (channel > RADIO_SESSION_CHANNEL_MAX))
+    {
+        return RF_StatInvalidParamsError;
+    }
+
+    currentChannel = channel;
+
+    return RF_StatSuccess;
+}
+
+uint8_t RadioSession_getChannel(void)
+{
+    return currentChannel;
+}
+
+const rfc_CMD_FS_t *RadioSession_getFsCmd(uint8_t channel)
+{
+    if ((channel < RADIO_SESSION_CHANNEL_MIN) || (channel > RADIO_SESSION_CHANNEL_MAX))
+    {
+        return NULL;
+    }
+
+    return &fsTable[channel - RADIO_SESSION_CHANNEL_MIN];
+}
+
+void RadioSession_setTunedChannel(uint8_t channel)
+{
+    finishTune();
+    tunedChannel = channel;
+    if (channel != 0)
+    {
+        currentChannel = channel;
+    }
+}
+
+void RadioSession_planTxPower(int8_t txPower, PowerTable_Change *change)
+{
+    PowerTable_plan(powerTable, currentTxPower, txPower, change);
+}
+
+RF_Stat RadioSession_setTxPower(int8_t txPower)
+{
+    PowerTable_Change change;
+    PowerTable_plan(powerTable, currentTxPower, txPower, &change);
+
+    if (change.txPower == currentTxPower)
+    {
+        return RF_StatSuccess;
+    }
+
+    finishTune();
+    uint32_t start = RF_getCurrentTime();
+
+    RF_Stat status = RF_setTxPower(rfHandle, change.value);
+
+    uint32_t ticks = RF_getCurrentTime() - start;
+    stats.setupTicks += ticks;
+
+    if (status == RF_StatSuccess)
+    {
+        bool firstLevel = (currentTxPower == RF_TxPowerTable_INVALID_DBM);
+
+        currentTxPower = change.txPower;
+        if (change.paSwitch)
+        {
+            /* The RF driver re-runs the radio setup with the other override
+             * set, so program the synthesizer again before the next TX */
+            stats.numPaSwitches++;
+            tunedChannel = 0;
+            if (inTx)
+            {
+                /* The setup runs ahead of the CMD_FS, both while the caller
+                 * goes on */
+                paSwitchStart = start;
+                paSwitchPending = true;
+                RadioSession_postTune(&txScheduleParams);
+            }
+        }
+        else if (!firstLevel)
+        {
+            stats.numPowerChanges++;
+            stats.powerChangeTicks += ticks;
+            if (ticks > stats.maxPowerChangeTicks)
+            {
+                stats.maxPowerChangeTicks = ticks;
+            }
+        }
+    }
+
+    return status;
+}
+
+int8_t RadioSession_getTxPower(void)
+{
+    return currentTxPower;
+}
+
+RF_Handle RadioSession_beginTx(RF_ScheduleCmdParams *scheduleParams)
+{
+    if (RadioSession_open() == NULL)
+    {
+        return NULL;
+    }
+
+    /* A power-up before the session was for someone else, e.g. a receiver */
+    powerUpPending = false;
+    RadioSession_tune(scheduleParams);
+
+    txScheduleParams = *scheduleParams;
+    inTx = true;
+    sessionStartTime = RF_getCurrentTime();
+
+    return rfHandle;
+}
+
+void RadioSession_postTune(RF_ScheduleCmdParams *scheduleParams)
+{
+    RadioTrace_setRadio(currentChannel, currentTxPower);
+
+    if ((pendingFs >= 0) || (tunedChannel == currentChannel))
+    {
+        return;
+    }
+
+    /* The first command also powers the radio up and runs its setup */
+    pendingFsChannel = currentChannel;
+    pendingFsStart = RF_getCurrentTime();
+    pendingFs = RF_scheduleCmd(rfHandle, (RF_Op*)&fsTable[currentChannel - RADIO_SESSION_CHANNEL_MIN],
+                               scheduleParams, NULL, 0);
+}
+
+void RadioSession_tune(RF_ScheduleCmdParams *scheduleParams)
+{
+    finishTune();
+    RadioTrace_setRadio(currentChannel, currentTxPower);
+
+    if (tunedChannel == currentChannel)
+    {
+        stats.numFsSkipped++;
+    }
+    else
+    {
+        rfc_CMD_FS_t *fsCmd = &fsTable[currentChannel - RADIO_SESSION_CHANNEL_MIN];
+        uint32_t start = RF_getCurrentTime();
+
+        /* Set the frequency */
+        RF_EventMask result = RF_runScheduleCmd(rfHandle, (RF_Op*)fsCmd, scheduleParams, NULL, 0);
+
+        uint32_t end = RF_getCurrentTime();
+        RadioTrace_add((RF_Op*)fsCmd, start, RADIO_TRACE_NO_TIME, end);
+        stats.setupTicks += end - start;
+        stats.numFsRuns++;
+        powerUpPending = false;
+
+        tunedChannel = ((result & RF_EventLastCmdDone) && (fsCmd->status == DONE_OK)) ? currentChannel : 0;
+    }
+    endPaSwitch();
+}
+
+void RadioSession_endTx(void)
+{
+    finishTune();
+    inTx = false;
+    stats.sessionTicks += RF_getCurrentTime() - sessionStartTime;
+
+    /* Power down the radio */
+    RF_yield(rfHandle);
+}
+
+void RadioSession_addAirTime(const rfc_CMD_IEEE_TX_t *txCmd)
+{
+    if (((volatile const RF_Op*)txCmd)->status != IEEE_DONE_OK)
+    {
+        return;
+    }
+
+    airTicks += RF_convertUsToRatTicks(MAC_FRAME_AIR_US(txCmd->payloadLen));
+
+    if (powerUpPending)
+    {
+        /* Power-up, setup and the CMD_FS the RF driver repeats, until the
+         * frame started */
+        int32_t ticks = (int32_t)(txCmd->timeStamp - RF_convertUsToRatTicks(MAC_FRAME_TX_START_TO_AIR_US) -
+                                  powerUpStart);
+        if (ticks > 0)
+        {
+            powerUpTicks += (uint32_t)ticks;
+        }
+        powerUpPending = false;
+    }
+}
+
+void RadioSession_radioEvent(RF_GlobalEvent events)
+{
+    /* RF_GlobalEventRadioSetup also comes for the setup of a PA switch,
+     * with the radio already on; that one is timed with the switch */
+    if ((events & RF_GlobalEventRadioSetup) && !radioOn)
+    {
+        radioOn = true;
+        powerUpStart = RF_getCurrentTime();
+        powerUpPending = true;
+        numPowerUps++;
+    }
+    else if (events & RF_GlobalEventRadioPowerDown)
+    {
+        radioOn = false;
+        powerUpPending = false;
+    }
+}
+
+void RadioSession_getStats(RadioSession_Stats *pStats)
+{
+    *pStats = stats;
+    pStats->setupTicks += powerUpTicks;
+    pStats->airTicks = airTicks;
+    pStats->numPowerUps = numPowerUps;
+}
+
+int RadioSession_formatPowerStats(const RadioSession_Stats *s, char *buf, size_t size)
+{
+    uint32_t avgChange = (s->numPowerChanges == 0) ? 0 : s->powerChangeTicks / s->numPowerChanges;
+    uint32_t avgSwitch = (s->numPaSwitchesTimed == 0) ? 0 : s->paSwitchTicks / s->numPaSwitchesTimed;
+
+    return snprintf(buf, size, "# power changes %u in %lu/%lu us, PA switches %u, %u timed in %lu/%lu/%lu us\n",
+                    s->numPowerChanges, (unsigned long)RF_convertRatTicksToUs(avgChange),
+                    (unsigned long)RF_convertRatTicksToUs(s->maxPowerChangeTicks),
+                    s->numPaSwitches, s->numPaSwitchesTimed,
+                    (unsigned long)RF_convertRatTicksToUs(s->minPaSwitchTicks),
+                    (unsigned long)RF_convertRatTicksToUs(avgSwitch),
+                    (unsigned long)RF_convertRatTicksToUs(s->maxPaSwitchTicks));
+}
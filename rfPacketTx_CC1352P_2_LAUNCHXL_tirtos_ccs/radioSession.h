@@ -0,0 +1,204 @@
+/*
+ *  ======== radioSession.h ========
+ *  Persistent radio session.
+ *
+ *  The radio is opened once with RF_cmdRadioSetup_ieee154 and kept open.
+ *  The session remembers the programmed channel and PA domain and only
+ *  re-runs CMD_FS when one of them actually changed, instead of repeating
+ *  RF_open, CMD_FS and RF_close for every burst. Between bursts the radio
+ *  is released with RF_yield() so the RF driver can still power it down.
+ *
+ *  The CMD_FS of every channel is built once when the session is first
+ *  opened, from RF_cmdFs_ieee154, whose frequency also sets the channel the
+ *  session starts on. Changing channel only selects another entry.
+ *
+ *  Both PA domains are configured in RF_cmdRadioSetup_ieee154, which
+ *  points at the TxStd and the Tx20 override set, so a switch needs no
+ *  new setup command, only for the RF driver to run the setup again with
+ *  the other set and a CMD_FS after it. Between RadioSession_beginTx()
+ *  and RadioSession_endTx() a switch posts that CMD_FS right away, so
+ *  setup and CMD_FS run while the caller builds the next frames, and the
+ *  time from RF_setTxPower() until both are done is measured. Outside,
+ *  the setup of the next power-up takes the new set anyway; the switch
+ *  only costs the CMD_FS and is counted, not timed. Level changes within
+ *  one PA are timed on their own.
+ *
+ *  Power-ups are seen through the RF driver's global callback, which
+ *  passes its events to RadioSession_radioEvent(). Power-up and setup are
+ *  timed from RF_GlobalEventRadioSetup until the CMD_FS or the first
+ *  frame they ran for starts; a power-up for anything else, like a
+ *  receiver started outside a TX session, is not counted. The TX paths
+ *  report every finished frame with RadioSession_addAirTime().
+ */
+#ifndef RADIOSESSION_H_
+#define RADIOSESSION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+#include "powerTable.h"
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_common_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Power table of the LaunchPad's 2.4 GHz path with the 20 dBm PA */
+#ifndef RADIO_SESSION_POWER_TABLE
+#define RADIO_SESSION_POWER_TABLE   POWER_TABLE_2400_PA5_20
+#endif
+
+/* IEEE 802.15.4 2.4 GHz channel range */
+#define RADIO_SESSION_CHANNEL_MIN   11
+#define RADIO_SESSION_CHANNEL_MAX   26
+
+typedef struct
+{
+    uint32_t setupTicks;        /* RAT ticks spent in RF_open, RF_setTxPower, CMD_FS and in power-up
+                                 * and setup until the first frame after it */
+    uint32_t sessionTicks;      /* RAT ticks from RadioSession_beginTx to endTx: CMD_FS, power-up,
+                                 * frames and whatever the caller does in between, not air time */
+    uint32_t airTicks;          /* RAT ticks on air of the frames sent with IEEE_DONE_OK */
+    uint16_t numOpens;          /* RF_open calls */
+    uint16_t numPowerUps;       /* Radio power-ups */
+    uint16_t numFsRuns;         /* CMD_FS actually sent to the radio */
+    uint16_t numFsSkipped;      /* CMD_FS avoided because the synthesizer was still valid */
+    uint16_t numPaSwitches;     /* Changes between the default and the high PA */
+    uint16_t numPaSwitchesTimed;    /* Of those, made during a TX session */
+    uint16_t numPowerChanges;   /* Level changes within one PA */
+    uint32_t paSwitchTicks;     /* RAT ticks from RF_setTxPower to setup and CMD_FS done, timed switches */
+    uint32_t minPaSwitchTicks;
+    uint32_t maxPaSwitchTicks;
+    uint32_t powerChangeTicks;  /* RAT ticks in RF_setTxPower, level changes */
+    uint32_t maxPowerChangeTicks;
+} RadioSession_Stats;
+
+/*
+ *  ======== RadioSession_open ========
+ *  Opens the radio if it is not open yet and returns the RF handle, NULL
+ *  if the power tables could not be built or the radio not be opened.
+ */
+extern RF_Handle RadioSession_open(void);
+
+/*
+ *  ======== RadioSession_close ========
+ *  Closes the radio. The next RadioSession_open() does a full setup again.
+ */
+extern void RadioSession_close(void);
+
+/*
+ *  ======== RadioSession_setChannel ========
+ *  Selects an IEEE 802.15.4 channel (11-26). The synthesizer is only
+ *  reprogrammed by the next RadioSession_beginTx() if the channel changed.
+ *  Returns RF_StatInvalidParamsError for channels outside the band.
+ */
+extern RF_Stat RadioSession_setChannel(uint8_t channel);
+
+/*
+ *  ======== RadioSession_getChannel ========
+ *  Returns the selected channel.
+ */
+extern uint8_t RadioSession_getChannel(void);
+
+/*
+ *  ======== RadioSession_getFsCmd ========
+ *  Returns the precomputed CMD_FS of a channel, NULL for channels outside
+ *  the band. Meant to be copied into command chains that change channel
+ *  on their own; the session runs its own copy.
+ */
+extern const rfc_CMD_FS_t *RadioSession_getFsCmd(uint8_t channel);
+
+/*
+ *  ======== RadioSession_setTunedChannel ========
+ *  Tells the session that a command chain left the synthesizer on channel,
+ *  which also becomes the selected channel, or 0 if it is not programmed.
+ */
+extern void RadioSession_setTunedChannel(uint8_t channel);
+
+/*
+ *  ======== RadioSession_planTxPower ========
+ *  Tells what RadioSession_setTxPower(txPower) would do: the level that
+ *  would be set and whether it switches PA, which costs a radio setup and
+ *  a CMD_FS.
+ */
+extern void RadioSession_planTxPower(int8_t txPower, PowerTable_Change *change);
+
+/*
+ *  ======== RadioSession_setTxPower ========
+ *  Sets the TX power in dBm, snapped to the nearest level of
+ *  RADIO_SESSION_POWER_TABLE. Does nothing if that level is already set.
+ *  A PA switch during a TX session posts the setup and CMD_FS it needs
+ *  before returning; the next call that needs the radio waits for them.
+ */
+extern RF_Stat RadioSession_setTxPower(int8_t txPower);
+
+/*
+ *  ======== RadioSession_getTxPower ========
+ *  Returns the TX power in dBm, RF_TxPowerTable_INVALID_DBM if none is set.
+ */
+extern int8_t RadioSession_getTxPower(void);
+
+/*
+ *  ======== RadioSession_beginTx ========
+ *  Programs the synthesizer if needed and returns the RF handle to send
+ *  with, NULL if the radio cannot be opened. Must be paired with
+ *  RadioSession_endTx(). A PA switch until then
+ *  is scheduled with a copy of scheduleParams.
+ */
+extern RF_Handle RadioSession_beginTx(RF_ScheduleCmdParams *scheduleParams);
+
+/*
+ *  ======== RadioSession_tune ========
+ *  Programs the synthesizer if the channel or the PA changed since it was
+ *  last programmed. RadioSession_beginTx() does this itself; calling it in
+ *  between lets a long TX session change channel and power without
+ *  yielding the radio.
+ */
+extern void RadioSession_tune(RF_ScheduleCmdParams *scheduleParams);
+
+/*
+ *  ======== RadioSession_postTune ========
+ *  Posts the CMD_FS RadioSession_tune() would run and returns at once, so
+ *  the radio powers up, runs its setup and programs the synthesizer while
+ *  the caller does something else. The next call that needs the radio,
+ *  RadioSession_tune() or RadioSession_beginTx() among them, waits for it.
+ */
+extern void RadioSession_postTune(RF_ScheduleCmdParams *scheduleParams);
+
+/*
+ *  ======== RadioSession_endTx ========
+ *  Accounts the time since RadioSession_beginTx() and yields the radio.
+ */
+extern void RadioSession_endTx(void);
+
+/*
+ *  ======== RadioSession_addAirTime ========
+ *  Accounts a finished CMD_IEEE_TX: its time on air if it was sent, and
+ *  for the first frame after a power-up the time until it started. Called
+ *  by the TX paths, from tasks and RF callbacks alike.
+ */
+extern void RadioSession_addAirTime(const rfc_CMD_IEEE_TX_t *txCmd);
+
+/*
+ *  ======== RadioSession_radioEvent ========
+ *  Follows the power-ups and power-downs of the radio. Called from the RF
+ *  driver's global callback (rfDriverCallback() in energyMeter.c).
+ */
+extern void RadioSession_radioEvent(RF_GlobalEvent events);
+
+/*
+ *  ======== RadioSession_getStats ========
+ */
+extern void RadioSession_getStats(RadioSession_Stats *stats);
+
+/*
+ *  ======== RadioSession_formatPowerStats ========
+ *  Writes one line: level changes with their avg/max time and PA
+ *  switches, with the min/avg/max time of the timed ones, in us. Returns
+ *  the length like snprintf().
+ */
+extern int RadioSession_formatPowerStats(const RadioSession_Stats *stats, char *buf, size_t size);
+
+#endif /* RADIOSESSION_H_ */
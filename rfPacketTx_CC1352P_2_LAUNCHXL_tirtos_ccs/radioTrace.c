@@ -0,0 +1,148 @@
+/*
+ *  ======== radioTrace.c ========
+ */
+
+/***** Includes *****/
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "radioTrace.h"
+
+/***** Defines *****/
+#define DEPTH_MASK              (RADIO_TRACE_DEPTH - 1)
+
+/* The 8 bit stamp tells a record from the one a lap earlier only if the
+ * ring is not a multiple of 256 records */
+#if (RADIO_TRACE_DEPTH < 2) || (RADIO_TRACE_DEPTH > 128) || (RADIO_TRACE_DEPTH & DEPTH_MASK)
+#error "RADIO_TRACE_DEPTH must be a power of two from 2 to 128"
+#endif
+
+_Static_assert(sizeof(RadioTrace_Record) == RADIO_TRACE_RECORD_SIZE, "RadioTrace_Record is padded");
+
+/***** Prototypes *****/
+static void writeRecord(uint16_t commandNo, uint16_t status, uint32_t postTime, uint32_t startTime,
+                        uint32_t endTime, uint8_t flags);
+
+/***** Variable declarations *****/
+static RadioTrace_Record ring[RADIO_TRACE_DEPTH];
+
+/* Number of the next record to write, claimed by writers with one atomic
+ * increment. readIndex is only used by the one reader. */
+static atomic_uint_least32_t writeIndex;
+static uint32_t readIndex;
+
+static uint8_t channel;
+static int8_t txPower;
+
+static RadioTrace_Stats stats;
+
+/***** Function definitions *****/
+
+void RadioTrace_reset(void)
+{
+    uint32_t i;
+
+    /* Stamp every slot as written a lap before record 0 */
+    memset(ring, 0, sizeof(ring));
+    for (i = 0; i < RADIO_TRACE_DEPTH; i++)
+    {
+        ring[i].seq = (uint8_t)(i - RADIO_TRACE_DEPTH);
+    }
+
+    atomic_store_explicit(&writeIndex, 0, memory_order_release);
+    readIndex = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void RadioTrace_setRadio(uint8_t newChannel, int8_t newTxPower)
+{
+    channel = newChannel;
+    txPower = newTxPower;
+}
+
+void RadioTrace_setChannel(uint8_t newChannel)
+{
+    channel = newChannel;
+}
+
+static void writeRecord(uint16_t commandNo, uint16_t status, uint32_t postTime, uint32_t startTime,
+                        uint32_t endTime, uint8_t flags)
+{
+    uint32_t index = atomic_fetch_add_explicit(&writeIndex, 1, memory_order_relaxed);
+    volatile RadioTrace_Record *record = &ring[index & DEPTH_MASK];
+
+    record->commandNo = commandNo;
+    record->status = status;
+    record->postTime = postTime;
+    record->startTime = startTime;
+    record->endTime = endTime;
+    record->txPower = txPower;
+    record->channel = channel;
+    record->flags = flags;
+
+    /* The stamp marks the record complete */
+    atomic_thread_fence(memory_order_release);
+    record->seq = (uint8_t)index;
+}
+
+void RadioTrace_add(const RF_Op *op, uint32_t postTime, uint32_t startTime, uint32_t endTime)
+{
+    writeRecord(op->commandNo, ((volatile const RF_Op *)op)->status, postTime, startTime, endTime,
+                (startTime != RADIO_TRACE_NO_TIME) ? RADIO_TRACE_FLAG_START : 0);
+}
+
+void RadioTrace_addMemory(uint16_t region, uint32_t size, uint32_t peak, uint32_t time)
+{
+    writeRecord(RADIO_TRACE_CMD_MEMORY, region, size, peak, time, RADIO_TRACE_FLAG_MEMORY);
+}
+
+uint32_t RadioTrace_read(void *buf, uint32_t maxRecords)
+{
+    uint8_t *out = buf;
+    uint32_t numCopied = 0;
+
+    while (numCopied < maxRecords)
+    {
+        uint32_t head = atomic_load_explicit(&writeIndex, memory_order_acquire);
+        if (head == readIndex)
+        {
+            break;
+        }
+        if (head - readIndex > RADIO_TRACE_DEPTH)
+        {
+            stats.numLost += head - readIndex - RADIO_TRACE_DEPTH;
+            readIndex = head - RADIO_TRACE_DEPTH;
+        }
+
+        const volatile RadioTrace_Record *record = &ring[readIndex & DEPTH_MASK];
+        if (record->seq != (uint8_t)readIndex)
+        {
+            /* Claimed but not written yet */
+            break;
+        }
+        atomic_thread_fence(memory_order_acquire);
+        memcpy(out, (const void *)record, RADIO_TRACE_RECORD_SIZE);
+        atomic_thread_fence(memory_order_acquire);
+
+        /* A writer a lap ahead may have overwritten it during the copy */
+        head = atomic_load_explicit(&writeIndex, memory_order_relaxed);
+        if (head - readIndex > RADIO_TRACE_DEPTH)
+        {
+            continue;
+        }
+
+        readIndex++;
+        out += RADIO_TRACE_RECORD_SIZE;
+        numCopied++;
+    }
+
+    stats.numRead += numCopied;
+    return numCopied;
+}
+
+void RadioTrace_getStats(RadioTrace_Stats *pStats)
+{
+    *pStats = stats;
+    pStats->numRecords = atomic_load_explicit(&writeIndex, memory_order_relaxed);
+}
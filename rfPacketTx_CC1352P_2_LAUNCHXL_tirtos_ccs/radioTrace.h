@@ -0,0 +1,115 @@
+/*
+ *  ======== radioTrace.h ========
+ *  Radio command trace ring.
+ *
+ *  Every radio operation the application runs is logged as one fixed-size
+ *  binary record: command number, status, RAT times of posting, start on
+ *  air and completion, TX power and channel. The ring is a power of two
+ *  and overwrites the oldest records. A writer claims its slot with one
+ *  atomic increment and stamps the record with its sequence number last,
+ *  so RadioTrace_add() takes no lock and can be called from tasks and RF
+ *  callbacks (SWI) alike; the reader recognizes records that were being
+ *  written or have been overwritten by the stamp.
+ *
+ *  Memory samples (memWatch.h) go into the same ring, as records with
+ *  RADIO_TRACE_FLAG_MEMORY set, so they are read out along with the
+ *  commands.
+ *
+ *  Records are copied out in bulk by RadioTrace_read() in their wire
+ *  format (little endian, RADIO_TRACE_RECORD_SIZE bytes each), ready to be
+ *  sent over UART or written to a file. host/traceDecode.c decodes them.
+ */
+#ifndef RADIOTRACE_H_
+#define RADIOTRACE_H_
+
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Number of records kept, must be a power of two */
+#ifndef RADIO_TRACE_DEPTH
+#define RADIO_TRACE_DEPTH       64
+#endif
+
+#define RADIO_TRACE_RECORD_SIZE 20
+
+/* startTime of commands the radio does not timestamp */
+#define RADIO_TRACE_NO_TIME     0xFFFFFFFF
+
+/* Record flags */
+#define RADIO_TRACE_FLAG_START  0x01    /* startTime is valid */
+#define RADIO_TRACE_FLAG_MEMORY 0x02    /* A memory sample, not a command */
+
+/* commandNo of memory samples. status holds the region, postTime its size
+ * in bytes, startTime the most it ever used and endTime the RAT time it
+ * was sampled. */
+#define RADIO_TRACE_CMD_MEMORY  0xFFFF
+
+typedef struct
+{
+    uint16_t commandNo;     /* CMD_* */
+    uint16_t status;        /* Status of the command when it was logged */
+    uint32_t postTime;      /* RAT time it was handed to the RF driver */
+    uint32_t startTime;     /* RAT time it started on air, if RADIO_TRACE_FLAG_START */
+    uint32_t endTime;       /* RAT time the RF driver reported it, or its chain, done */
+    int8_t   txPower;       /* dBm */
+    uint8_t  channel;       /* IEEE 802.15.4 channel, 0 if not known */
+    uint8_t  seq;           /* Low 8 bits of the record number, written last */
+    uint8_t  flags;         /* RADIO_TRACE_FLAG_* */
+} RadioTrace_Record;
+
+typedef struct
+{
+    uint32_t numRecords;    /* Records logged since RadioTrace_reset() */
+    uint32_t numRead;       /* Records RadioTrace_read() returned */
+    uint32_t numLost;       /* Records overwritten before they were read */
+} RadioTrace_Stats;
+
+/*
+ *  ======== RadioTrace_reset ========
+ *  Empties the ring. Must be called once before the first record and not
+ *  concurrently with RadioTrace_add().
+ */
+extern void RadioTrace_reset(void);
+
+/*
+ *  ======== RadioTrace_setRadio ========
+ *  Sets the channel and TX power stored with the following records.
+ */
+extern void RadioTrace_setRadio(uint8_t channel, int8_t txPower);
+
+/*
+ *  ======== RadioTrace_setChannel ========
+ *  Changes only the channel, for chains that hop.
+ */
+extern void RadioTrace_setChannel(uint8_t channel);
+
+/*
+ *  ======== RadioTrace_add ========
+ *  Logs one command. Command number and status are read from op, startTime
+ *  is RADIO_TRACE_NO_TIME if the command has no timestamp.
+ */
+extern void RadioTrace_add(const RF_Op *op, uint32_t postTime, uint32_t startTime,
+                           uint32_t endTime);
+
+/*
+ *  ======== RadioTrace_addMemory ========
+ *  Logs the high-water mark of one memory region.
+ */
+extern void RadioTrace_addMemory(uint16_t region, uint32_t size, uint32_t peak, uint32_t time);
+
+/*
+ *  ======== RadioTrace_read ========
+ *  Copies up to maxRecords of the oldest unread records to buf, which must
+ *  hold maxRecords * RADIO_TRACE_RECORD_SIZE bytes. Stops early at a record
+ *  that is still being written. Returns the number of records copied.
+ */
+extern uint32_t RadioTrace_read(void *buf, uint32_t maxRecords);
+
+/*
+ *  ======== RadioTrace_getStats ========
+ */
+extern void RadioTrace_getStats(RadioTrace_Stats *stats);
+
+#endif /* RADIOTRACE_H_ */
@@ -32,13 +32,40 @@
 
 /***** Includes *****/
 /* Standard C Libraries */
+#include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 
 /* TI Drivers */
 #include <ti/drivers/rf/RF.h>
 #include <ti/drivers/PIN.h>
+#include <ti/drivers/Power.h>
 #include <ti/drivers/pin/PINCC26XX.h>
+#include <ti/drivers/power/PowerCC26X2.h>
+
+/* Application Header files */
+#include "ackTx.h"
+#include "bootTime.h"
+#include "buttons.h"
+#include "channelHop.h"
+#include "energyMeter.h"
+#include "csmaTx.h"
+#include "framePool.h"
+#include "hostJobs.h"
+#include "macFrame.h"
+#include "memWatch.h"
+#include "payloadGen.h"
+#include "powerTable.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+#include "rxMonitor.h"
+#include "sharedRadio.h"
+#include "txBench.h"
+#include "txBurst.h"
+#include "txPipe.h"
+#include "txQueue.h"
+#include "txSweep.h"
+#include "txTimed.h"
 
 /* Driverlib Header files */
 #include DeviceFamily_constructPath(driverlib/rf_ieee_mailbox.h)
@@ -52,28 +79,221 @@
 /* Do power measurement */
 //#define POWER_MEASUREMENT
 
+/* Send mode for the packets of one button press */
+#define TX_MODE_BLOCKING    0   /* One blocking command per packet, PACKET_INTERVAL apart */
+#define TX_MODE_POSTED      1   /* Packets posted through the non-blocking TX queue */
+#define TX_MODE_CHAINED     2   /* All packets in one chained command */
+#define TX_MODE_CSMA        3   /* Each packet sent with CSMA-CA on the radio core */
+#define TX_MODE_ACK         4   /* Unicast packets, retransmitted by the radio core until acknowledged */
+#define TX_MODE_BENCH       5   /* Every press runs the TX benchmark (txBench.c) and prints CSV */
+#define TX_MODE_HOP         6   /* Like TX_MODE_CHAINED, hopping channel inside the chain (channelHop.c) */
+#define TX_MODE_SWEEP       7   /* Sweeps every level over SWEEP_CHANNELS at boot and on every press (txSweep.c) */
+#define TX_MODE_TIMED       8   /* Packets started by the radio timer, TIMED_PERIOD_US apart (txTimed.c) */
+#define TX_MODE_LOW_POWER   9   /* Like TX_MODE_TIMED, LOW_POWER_PERIOD_MS apart in standby, energy per packet */
+#define TX_MODE_PIPELINED   10  /* Next packet built while the last is on air, gaps printed (txPipe.c) */
+#define TX_MODE_HOST        11  /* Jobs from a host over UART2 instead of the buttons (hostJobs.c) */
+#define TX_MODE_RX          12  /* Receives only, every press prints PER and RSSI statistics (rxMonitor.c) */
+#define TX_MODE_SHARED      13  /* Keeps receiving while the packets preempt it, RX downtime printed (sharedRadio.c) */
+#ifndef TX_MODE
+#define TX_MODE             TX_MODE_CHAINED
+#endif
+
+/* Modes that send the packets of a press as one TxBurst */
+#define TX_MODE_IS_BURST    ((TX_MODE == TX_MODE_CHAINED) || (TX_MODE == TX_MODE_HOP))
+
+/* Modes that send the packets of a press on a TxTimed grid */
+#define TX_MODE_IS_TIMED    ((TX_MODE == TX_MODE_TIMED) || (TX_MODE == TX_MODE_LOW_POWER))
+
 /* Packet TX Configuration */
-#define PAYLOAD_LENGTH      30
+#define PAYLOAD_LENGTH      30      /* MAC header and payload, without FCS */
+#define MAC_PAN_ID          0x0000  /* Same PAN and address as RF_cmdIeeeRx_ieee154 */
+#define MAC_SHORT_ADDR      0xABBA
+#define MAC_PEER_ADDR       0x0001  /* Destination in TX_MODE_ACK */
+#define PACKETS_PER_BURST   10
+#define NUM_FRAME_SLOTS     2
+
+/* Payload after the sequence number: PAYLOAD_GEN_FIXED repeats the TX
+ * power, the others continue one sequence across all packets (payloadGen.h) */
+#ifndef PAYLOAD_PATTERN
+#define PAYLOAD_PATTERN     PAYLOAD_GEN_FIXED
+#endif
+
+/* TX_MODE_SWEEP: frames per level and channel, channels of the sweep,
+ * false to run the steps level by level as listed */
+#define SWEEP_FRAMES_PER_STEP   10
+#define SWEEP_CHANNELS          { 11, 18, 26 }
+#ifndef SWEEP_REORDER
+#define SWEEP_REORDER           true
+#endif
+
+/* TX_MODE_TIMED: spacing of the packets on air */
+#ifndef TIMED_PERIOD_US
+#define TIMED_PERIOD_US         5000
+#endif
+
+/* TX_MODE_LOW_POWER: spacing of the packets, the device sleeps in between */
+#ifndef LOW_POWER_PERIOD_MS
+#define LOW_POWER_PERIOD_MS     1000
+#endif
+/* TX_MODE_PIPELINED: false to build each packet only after the one
+ * before has been sent, to compare the gaps */
+#ifndef PIPE_OVERLAP
+#define PIPE_OVERLAP            true
+#endif
+
+/* TX_MODE_SHARED: spacing of the packets, the receiver listens in between */
+#ifndef SHARED_INTERVAL_US
+#define SHARED_INTERVAL_US      20000
+#endif
+
+/* Build with FAST_BOOT defined, for main_tirtos.c as well, to send one
+ * packet at FAST_BOOT_TX_POWER as soon as possible after reset: the radio
+ * is opened and tuned first and powers up while the rest is set up, and
+ * the HF crystal starts in main(). The boot report (bootTime.h) follows
+ * that packet, or the first press's first packet without FAST_BOOT. */
+#ifndef FAST_BOOT_TX_POWER
+#define FAST_BOOT_TX_POWER      0
+#endif
+
 #ifdef POWER_MEASUREMENT
 #define PACKET_INTERVAL     5  /* For power measurement set packet interval to 5s */
 #else
 #define PACKET_INTERVAL     200000  /* Set packet interval to 500000us or 500ms */
 #endif
 
+#ifdef POWER_MEASUREMENT
+/* Power measurement needs the packets spaced by PACKET_INTERVAL */
+#undef TX_MODE
+#define TX_MODE             TX_MODE_BLOCKING
+#endif
+
+/* Modes that act on button presses in the loop at the end of mainThread();
+ * the host and the receiver stay in loops of their own */
+#define TX_MODE_ON_PRESS    ((TX_MODE != TX_MODE_HOST) && (TX_MODE != TX_MODE_RX))
+
+/* Modes whose presses tell when their first packet went on air */
+#define TX_MODE_HAS_ON_AIR  (TX_MODE_ON_PRESS && (TX_MODE != TX_MODE_BENCH) && (TX_MODE != TX_MODE_SWEEP))
+
+/* Modes that fill and send the packets of a press here; the benchmark
+ * and the sweep build their own frames */
+#define TX_MODE_SENDS_PACKETS   (TX_MODE_ON_PRESS && (TX_MODE != TX_MODE_BENCH) && (TX_MODE != TX_MODE_SWEEP))
+
+/* Modes that wait for their commands and check the RF driver's termination
+ * reason; the queue and the timed grid only report the status of each
+ * packet */
+#define TX_MODE_CHECKS_TERMINATION  (TX_MODE_SENDS_PACKETS && (TX_MODE != TX_MODE_POSTED) && \
+                                     !TX_MODE_IS_TIMED)
+
+/* Modes that go through the packets of a press one by one and check the
+ * status of each; the pipeline counts its errors itself */
+#define TX_MODE_CHECKS_STATUS   (TX_MODE_SENDS_PACKETS && (TX_MODE != TX_MODE_PIPELINED))
+
 /***** Prototypes *****/
+#if TX_MODE_SENDS_PACKETS || defined(FAST_BOOT)
+static void fillPacket(uint8_t *buf, int8_t txPower);
+#endif
+#if TX_MODE_CHECKS_TERMINATION || defined(FAST_BOOT)
+static void checkTerminationReason(RF_EventMask terminationReason);
+#endif
+#if TX_MODE_CHECKS_STATUS || defined(FAST_BOOT)
+static void checkTxStatus(uint32_t cmdStatus);
+#endif
+#if TX_MODE_HAS_ON_AIR || defined(FAST_BOOT)
+static void printBootReport(void);
+#endif
+#ifdef FAST_BOOT
+static void sendBootFrame(RF_ScheduleCmdParams *scheduleParams);
+#endif
+#if TX_MODE == TX_MODE_POSTED
+static void txDoneCallback(const TxQueue_Completion *completion);
+#elif TX_MODE == TX_MODE_BENCH
+static void printBenchResult(const TxBench_Result *result);
+#elif TX_MODE == TX_MODE_SWEEP
+static void printSweepStep(const TxSweep_StepResult *result);
+static void runSweep(void);
+#endif
+#if TX_MODE_IS_TIMED
+static void timedDoneCallback(const TxTimed_Completion *completion);
+#elif TX_MODE == TX_MODE_PIPELINED
+static uint8_t buildPacket(uint8_t **psdu, uint32_t index, void *arg);
+#endif
 
 /***** Variable declarations *****/
-static RF_Object rfObject;
 static RF_Handle rfHandle;
 
 /* Pin driver handle */
 static PIN_Handle ledPinHandle;
 static PIN_State ledPinState;
-static PIN_Handle buttonPinHandle;
-static PIN_State buttonPinState;
 
-static uint8_t packet[PAYLOAD_LENGTH];
+#if TX_MODE_IS_BURST
+static TxBurst_Object txBurst;
+#else
+/* Frame buffers, see .frameBuffers in the linker command file */
+static FramePool_Slot frameSlots[NUM_FRAME_SLOTS] FRAME_POOL_SECTION(".frameBuffers");
+static FramePool_Object framePool;
+#endif
+#if TX_MODE_SENDS_PACKETS || defined(FAST_BOOT)
 static uint16_t seqNumber;
+#endif
+static PayloadGen_Object payloadGen;
+
+/* Data frame header, built at compile time */
+#if TX_MODE == TX_MODE_ACK
+static const MacFrame_Template dataFrameTemplate =
+    MAC_FRAME_TEMPLATE_DATA_SHORT(MAC_PAN_ID, MAC_PEER_ADDR, MAC_SHORT_ADDR, 1);
+#elif (TX_MODE != TX_MODE_RX) || defined(FAST_BOOT)
+static const MacFrame_Template dataFrameTemplate =
+    MAC_FRAME_TEMPLATE_DATA_SHORT(MAC_PAN_ID, MAC_BROADCAST_ADDR, MAC_SHORT_ADDR, 0);
+#endif
+
+/* Statistics, updated after every burst for the debugger; the host jobs
+ * keep their own */
+#if TX_MODE != TX_MODE_HOST
+static RadioSession_Stats radioStats;
+static RadioTrace_Stats traceStats;
+static MemWatch_Stats memStats;
+static Buttons_Stats buttonStats;
+#endif
+#if !TX_MODE_IS_BURST && TX_MODE_ON_PRESS
+static FramePool_Stats framePoolStats;
+#endif
+#if TX_MODE == TX_MODE_POSTED
+static TxQueue_Stats txQueueStats;
+
+/* RAT timestamp of the first packet of the current burst */
+static volatile uint32_t firstPacketTime;
+#elif TX_MODE == TX_MODE_CSMA
+static CsmaTx_Stats csmaStats;
+#elif TX_MODE == TX_MODE_ACK
+static AckTx_Stats ackStats;
+#elif TX_MODE == TX_MODE_BENCH
+static TxBench_Result benchResult;
+static uint32_t numBenchPoints;
+#elif TX_MODE == TX_MODE_HOP
+static ChannelHop_Stats hopStats;
+#elif TX_MODE == TX_MODE_SWEEP
+static const uint8_t sweepChannels[] = SWEEP_CHANNELS;
+static int8_t sweepPowers[POWER_TABLE_MAX_SPAN];
+static TxSweep_Params sweepParams;
+static TxSweep_Result sweepResult;
+#endif
+#if TX_MODE_IS_TIMED
+static TxTimed_Stats timedStats;
+
+/* RAT ticks each packet of the last burst went on air after its slot */
+static int32_t timedOffsets[PACKETS_PER_BURST];
+static volatile uint32_t firstPacketTime;
+#endif
+#if TX_MODE == TX_MODE_LOW_POWER
+static EnergyMeter_Report energyReport;
+#elif TX_MODE == TX_MODE_PIPELINED
+static TxPipe_Result pipeResult;
+#elif TX_MODE == TX_MODE_RX
+static RxMonitor_Stats rxStats;
+#elif TX_MODE == TX_MODE_SHARED
+static RxMonitor_Stats rxStats;
+static SharedRadio_Stats sharedStats;
+#endif
 
 /*
  * Initial LED pin configuration table
@@ -86,37 +306,222 @@ PIN_Config ledPinTable[] = {
     PIN_TERMINATE
 };
 
-/*
- * Application button pin configuration table:
- */
-PIN_Config buttonPinTable[] = {
-    CONFIG_PIN_BUTTON_0  | PIN_INPUT_EN | PIN_PULLUP | PIN_IRQ_DIS,
-    CONFIG_PIN_BUTTON_1  | PIN_INPUT_EN | PIN_PULLUP | PIN_IRQ_DIS,
-    PIN_TERMINATE
-};
-
 /***** Function definitions *****/
 
-void *mainThread(void *arg0)
+#if TX_MODE_SENDS_PACKETS || defined(FAST_BOOT)
+static void fillPacket(uint8_t *buf, int8_t txPower)
 {
-    RF_Params rfParams;
-    RF_Params_init(&rfParams);
+    /* Create a data frame with incrementing sequence number. The payload
+     * repeats the 16 bit sequence number, followed by PAYLOAD_PATTERN. */
+    uint8_t *payload = MacFrame_writeHeader(&dataFrameTemplate, (uint8_t)seqNumber, buf);
+    payload[0] = (uint8_t)(seqNumber >> 8);
+    payload[1] = (uint8_t)(seqNumber++);
+    if (PAYLOAD_PATTERN == PAYLOAD_GEN_FIXED)
+    {
+        PayloadGen_init(&payloadGen, PAYLOAD_GEN_FIXED, (uint8_t)txPower);
+    }
+    PayloadGen_fill(&payloadGen, &payload[2], PAYLOAD_LENGTH - dataFrameTemplate.hdrLen - 2);
+}
+#endif
 
-    RF_ScheduleCmdParams scheduleParams;
-    RF_ScheduleCmdParams_init(&scheduleParams);
+#if TX_MODE_CHECKS_TERMINATION || defined(FAST_BOOT)
+static void checkTerminationReason(RF_EventMask terminationReason)
+{
+    switch(terminationReason)
+    {
+        case RF_EventLastCmdDone:
+            // A stand-alone radio operation command or the last radio
+            // operation command in a chain finished.
+            break;
+        case RF_EventCmdCancelled:
+            // Command cancelled before it was started; it can be caused
+            // by RF_cancelCmd() or RF_flushCmd().
+            break;
+        case RF_EventCmdAborted:
+            // Abrupt command termination caused by RF_cancelCmd() or
+            // RF_flushCmd().
+            break;
+        case RF_EventCmdStopped:
+            // Graceful command termination caused by RF_cancelCmd() or
+            // RF_flushCmd().
+            break;
+        case RF_EventLastFGCmdDone:
+            // Graceful command termination caused by RF_cancelCmd() or
+            // RF_flushCmd().
+            break;
+        default:
+            // Uncaught error event
+            while(1);
+    }
+}
+#endif
 
-    /* Open LED pins */
-    ledPinHandle = PIN_open(&ledPinState, ledPinTable);
-    if (ledPinHandle == NULL)
+#if TX_MODE_CHECKS_STATUS || defined(FAST_BOOT)
+static void checkTxStatus(uint32_t cmdStatus)
+{
+    switch(cmdStatus)
     {
-        while(1);
+        case IEEE_DONE_OK:
+            // Packet transmitted successfully
+            break;
+        case IEEE_DONE_STOPPED:
+            // received CMD_STOP while transmitting packet and finished
+            // transmitting packet
+            break;
+        case IEEE_DONE_ABORT:
+            // Received CMD_ABORT while transmitting packet
+            break;
+        case IEEE_ERROR_PAR:
+            // Observed illegal parameter
+            break;
+        case IEEE_ERROR_NO_SETUP:
+            // Command sent without setting up the radio in a supported
+            // mode using CMD_PROP_RADIO_SETUP or CMD_RADIO_SETUP
+            break;
+        case IEEE_ERROR_NO_FS:
+            // Command sent without the synthesizer being programmed
+            break;
+        case IEEE_ERROR_TXUNF:
+            // TX underflow observed during operation
+            break;
+        default:
+            // Uncaught error event - these could come from the
+            // pool of states defined in rf_mailbox.h
+            while(1);
     }
+}
+#endif
 
-    buttonPinHandle = PIN_open(&buttonPinState, buttonPinTable);
-    if(!buttonPinHandle) {
-        /* Error initializing button pins */
+#if TX_MODE_HAS_ON_AIR || defined(FAST_BOOT)
+static void printBootReport(void)
+{
+    BootTime_Report report;
+    char line[192];
+
+    BootTime_getReport(&report);
+    BootTime_formatReport(&report, line, sizeof(line));
+    fputs(line, stdout);
+    fflush(stdout);
+}
+#endif
+
+#ifdef FAST_BOOT
+static void sendBootFrame(RF_ScheduleCmdParams *scheduleParams)
+{
+    uint8_t psdu[PAYLOAD_LENGTH];
+    rfc_CMD_IEEE_TX_t txCmd = RF_cmdIeeeTx_ieee154;
+
+    fillPacket(psdu, FAST_BOOT_TX_POWER);
+    txCmd.payloadLen = PAYLOAD_LENGTH;
+    txCmd.pPayload = psdu;
+    txCmd.startTrigger.triggerType = TRIG_NOW;
+    txCmd.condition.rule = COND_NEVER;
+    txCmd.pNextOp = NULL;
+
+    /* Waits for the CMD_FS posted at the start of mainThread() */
+    rfHandle = RadioSession_beginTx(scheduleParams);
+    BootTime_mark(BOOT_TIME_READY);
+
+    uint32_t postTime = RF_getCurrentTime();
+    RF_EventMask terminationReason = RF_runScheduleCmd(rfHandle, (RF_Op*)&txCmd, scheduleParams, NULL, 0);
+    uint16_t txStatus = ((volatile RF_Op*)&txCmd)->status;
+    RadioTrace_add((RF_Op*)&txCmd, postTime, (txStatus == IEEE_DONE_OK) ? txCmd.timeStamp : RADIO_TRACE_NO_TIME,
+                   RF_getCurrentTime());
+    RadioSession_addAirTime(&txCmd);
+    checkTerminationReason(terminationReason);
+    checkTxStatus(txStatus);
+    BootTime_markOnAir(txCmd.timeStamp);
+    RadioSession_endTx();
+
+    /* The radio starts the crystal itself from here on and it may stop
+     * in standby again */
+    Power_releaseDependency(PowerCC26XX_XOSC_HF);
+
+    printBootReport();
+}
+#endif
+
+#if TX_MODE == TX_MODE_POSTED
+static void txDoneCallback(const TxQueue_Completion *completion)
+{
+    checkTxStatus(completion->status);
+
+    if((uintptr_t)completion->arg == 0)  // First packet of the burst
+    {
+        firstPacketTime = completion->timeStamp;
+    }
+}
+#elif TX_MODE == TX_MODE_BENCH
+static void printBenchResult(const TxBench_Result *result)
+{
+    char line[96];
+
+    /* Keep the last point for the debugger */
+    benchResult = *result;
+    numBenchPoints++;
+
+    /* CIO console on the target, stdout in the host simulation */
+    TxBench_formatResult(result, line, sizeof(line));
+    fputs(line, stdout);
+}
+#elif TX_MODE == TX_MODE_SWEEP
+static void printSweepStep(const TxSweep_StepResult *result)
+{
+    char line[64];
+
+    TxSweep_formatStep(result, line, sizeof(line));
+    fputs(line, stdout);
+}
+
+static void runSweep(void)
+{
+    char line[128];
+
+    TxSweep_formatHeader(line, sizeof(line));
+    fputs(line, stdout);
+    if(!TxSweep_run(&sweepParams, printSweepStep, &sweepResult))
+    {
+        /* Too many steps, an invalid channel in SWEEP_CHANNELS or no radio */
         while(1);
     }
+    TxSweep_formatResult(&sweepResult, line, sizeof(line));
+    fputs(line, stdout);
+
+    /* PA switches inside the sweep apart from the level changes */
+    RadioSession_getStats(&radioStats);
+    RadioSession_formatPowerStats(&radioStats, line, sizeof(line));
+    fputs(line, stdout);
+    fflush(stdout);
+}
+#endif
+
+#if TX_MODE_IS_TIMED
+static void timedDoneCallback(const TxTimed_Completion *completion)
+{
+    uintptr_t packetIdx = (uintptr_t)completion->arg;
+
+    checkTxStatus(completion->status);
+
+    timedOffsets[packetIdx] = completion->offset;
+    if(packetIdx == 0)
+    {
+        firstPacketTime = completion->timeStamp;
+    }
+}
+#elif TX_MODE == TX_MODE_PIPELINED
+static uint8_t buildPacket(uint8_t **psdu, uint32_t index, void *arg)
+{
+    fillPacket(*psdu, *(const int8_t *)arg);
+    return PAYLOAD_LENGTH;
+}
+#endif
+
+void *mainThread(void *arg0)
+{
+    BootTime_mark(BOOT_TIME_THREAD);
+
+    RF_ScheduleCmdParams scheduleParams;
+    RF_ScheduleCmdParams_init(&scheduleParams);
 
     /* =========== Populated parameters =========== */
     scheduleParams.startTime    = 0;
@@ -127,158 +532,468 @@ void *mainThread(void *arg0)
     scheduleParams.endType      = RF_EndNotSpecified;
     /* ============================================= */
 
+    /* Open the radio once, it stays open across bursts */
+    RadioTrace_reset();
+    rfHandle = RadioSession_open();
+    if (rfHandle == NULL)
+    {
+        /* Power tables could not be built or the radio not opened */
+        while(1);
+    }
+#ifdef FAST_BOOT
+    /* The radio powers up, is set up and tuned while the pins, buttons
+     * and frames are set up below */
+    RadioSession_setTxPower(FAST_BOOT_TX_POWER);
+    RadioSession_postTune(&scheduleParams);
+#endif
+    BootTime_mark(BOOT_TIME_RADIO);
+
+    /* Open LED pins */
+    ledPinHandle = PIN_open(&ledPinState, ledPinTable);
+    if (ledPinHandle == NULL)
+    {
+        while(1);
+    }
+
+    if(!Buttons_open()) {
+        /* Error initializing button pins */
+        while(1);
+    }
+
+#if !TX_MODE_IS_BURST
+    FramePool_construct(&framePool, frameSlots, NUM_FRAME_SLOTS);
+#endif
+    PayloadGen_init(&payloadGen, PAYLOAD_PATTERN, 0);
+    BootTime_mark(BOOT_TIME_INIT);
+
+#ifdef FAST_BOOT
+    sendBootFrame(&scheduleParams);
+#endif
+
+#if TX_MODE == TX_MODE_POSTED
+    TxQueue_init(rfHandle, txDoneCallback);
+#elif TX_MODE == TX_MODE_CSMA
+    CsmaTx_Params csmaParams;
+    CsmaTx_Params_init(&csmaParams);
+#elif TX_MODE == TX_MODE_ACK
+    AckTx_Params ackParams;
+    AckTx_Params_init(&ackParams);
+#elif TX_MODE == TX_MODE_BENCH
+    TxBench_Params benchParams;
+    TxBench_Params_init(&benchParams);
+    benchParams.frameTemplate = &dataFrameTemplate;
+#elif TX_MODE == TX_MODE_SWEEP
+    /* Every level of the power table */
+    const PowerTable_Object *sweepTable = PowerTable_get(RADIO_SESSION_POWER_TABLE);
+    int8_t level = sweepTable->minDbm;
+    TxSweep_Params_init(&sweepParams);
+    while(1)
+    {
+        sweepPowers[sweepParams.numTxPowers++] = level;
+        if(level >= sweepTable->maxDbm)
+        {
+            break;
+        }
+        level = PowerTable_step(sweepTable, level, 1);
+    }
+    sweepParams.txPowers = sweepPowers;
+    sweepParams.channels = sweepChannels;
+    sweepParams.numChannels = sizeof(sweepChannels);
+    sweepParams.framesPerStep = SWEEP_FRAMES_PER_STEP;
+    sweepParams.frameLength = PAYLOAD_LENGTH;
+    sweepParams.frameTemplate = &dataFrameTemplate;
+    sweepParams.reorder = SWEEP_REORDER;
+
+    /* Production test: no button press needed for the first sweep */
+    runSweep();
+#elif TX_MODE == TX_MODE_TIMED
+    TxTimed_Params timedParams;
+    TxTimed_Params_init(&timedParams);
+    timedParams.period = RF_convertUsToRatTicks(TIMED_PERIOD_US);
+#elif TX_MODE == TX_MODE_LOW_POWER
+    /* The RF driver wakes the radio just in time for each slot */
+    TxTimed_Params timedParams;
+    TxTimed_Params_init(&timedParams);
+    timedParams.period = RF_convertMsToRatTicks(LOW_POWER_PERIOD_MS);
+    timedParams.leadTime = timedParams.period;
+    if(!EnergyMeter_init())
+    {
+        while(1);
+    }
+#elif TX_MODE == TX_MODE_PIPELINED
+    TxPipe_Params pipeParams;
+    TxPipe_Params_init(&pipeParams);
+    pipeParams.build = buildPacket;
+    pipeParams.overlap = PIPE_OVERLAP;
+#elif TX_MODE == TX_MODE_HOST
+    /* The host drives the radio from here on, the buttons are not used */
+    HostJobs_serve(&dataFrameTemplate, &scheduleParams);
+    return NULL;
+#elif TX_MODE == TX_MODE_RX
+    /* Measurement end of a link test: the radio stays in RX from here on,
+     * every press prints the statistics since the press before */
+    RadioSession_tune(&scheduleParams);
+    if(RxMonitor_start(rfHandle, NULL) != RF_StatSuccess)
+    {
+        while(1);
+    }
+    while(1)
+    {
+        Buttons_Event buttonEvent;
+        Buttons_waitEvent(&buttonEvent);
+        RxMonitor_getStats(&rxStats, true);
+
+        char line[256];
+        RxMonitor_formatStats(&rxStats, line, sizeof(line));
+        fputs(line, stdout);
+        RxMonitor_formatHistogram(&rxStats, line, sizeof(line));
+        fputs(line, stdout);
+        fflush(stdout);
+
+        Buttons_getStats(&buttonStats);
+        RadioSession_getStats(&radioStats);
+        MemWatch_sample();
+        MemWatch_trace();
+        MemWatch_getStats(&memStats);
+        RadioTrace_getStats(&traceStats);
+
+        /* Only a radio error ends the command; listen again */
+        if(!RxMonitor_isRunning())
+        {
+            RxMonitor_stop();
+            RxMonitor_start(rfHandle, NULL);
+        }
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+    }
+#elif TX_MODE == TX_MODE_SHARED
+    /* The session's frames preempt the receiver, so the CMD_FS must as well
+     * or it would wait behind the receiver for good */
+    scheduleParams.activityInfo = SHARED_RADIO_ACTIVITY_TX;
+    RadioSession_tune(&scheduleParams);
+    if(SharedRadio_open() != RF_StatSuccess)
+    {
+        while(1);
+    }
+#elif TX_MODE == TX_MODE_HOP
+    ChannelHop_Params hopParams;
+    ChannelHop_Params_init(&hopParams);
+    ChannelHop_init(&hopParams);
+#elif TX_MODE == TX_MODE_BLOCKING
     RF_cmdIeeeTx_ieee154.payloadLen = PAYLOAD_LENGTH;
-    RF_cmdIeeeTx_ieee154.pPayload = packet;
     RF_cmdIeeeTx_ieee154.startTrigger.triggerType = TRIG_NOW;
+#endif
 
-    /* Set Tx Power: 0dBm - 20dBm */
+#if TX_MODE_ON_PRESS
+    /* Set Tx Power: every level of the power table, -20dBm - 20dBm */
+    const PowerTable_Object *powerTable = PowerTable_get(RADIO_SESSION_POWER_TABLE);
     int8_t txPower = 0;
-    uint8_t leftButtonPressed = 0;
-    uint8_t rightButtonPressed = 0;
+#if TX_MODE_HAS_ON_AIR
+    uint32_t firstPacketTimeStamp = 0;
+#endif
+#if TX_MODE == TX_MODE_PIPELINED
+    pipeParams.arg = &txPower;
+#endif
 
     while(1)
     {
-        /* Detect button state */
-        while(PIN_getInputValue(CONFIG_PIN_BUTTON_0) && PIN_getInputValue(CONFIG_PIN_BUTTON_1)) ;  // Wait for press button
-        usleep(10000);  // Debounce
+        /* Sleep until a button is pressed */
+        Buttons_Event buttonEvent;
+        Buttons_waitEvent(&buttonEvent);
+
+        /* Step to the next level the table has, e.g. 10dBm <-> 14dBm */
+        if(buttonEvent.button == BUTTONS_LEFT)
+        {
+            PIN_setOutputValue(ledPinHandle, CONFIG_PIN_RLED, 1);
+            txPower = PowerTable_step(powerTable, txPower, -1);
+        }
+        else
+        {
+            PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED, 1);
+            txPower = PowerTable_step(powerTable, txPower, 1);
+        }
+
+        /* Only reconfigures the radio if the power level changed */
+        RadioSession_setTxPower(txPower);
+
+#if TX_MODE_CHECKS_STATUS
+        uint8_t packetIdx;
+#endif
+#if TX_MODE_IS_BURST
+        TxBurst_init(&txBurst);
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
+        {
+            fillPacket(TxBurst_addFrame(&txBurst, PAYLOAD_LENGTH), txPower);
+        }
+    #if TX_MODE == TX_MODE_HOP
+        /* Next channels of the hop sequence, a CMD_FS in front of each hop */
+        ChannelHop_assign(&txBurst);
+    #endif
+
+        /* Send all packets back-to-back in one command chain */
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        checkTerminationReason(TxBurst_send(&txBurst, rfHandle, &scheduleParams));
+        RadioSession_endTx();
+    #if TX_MODE == TX_MODE_HOP
+        ChannelHop_update(&txBurst);
+        ChannelHop_getStats(&hopStats);
+    #endif
+        firstPacketTimeStamp = TxBurst_getFrameTimeStamp(&txBurst, 0);
+
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
+        {
+            uint16_t frameStatus = TxBurst_getFrameStatus(&txBurst, packetIdx);
+            if(frameStatus != IDLE)  // Packets after a failed one are never started
+            {
+                checkTxStatus(frameStatus);
+            }
+        }
 
-        while((PIN_getInputValue(CONFIG_PIN_BUTTON_0) == 0) || (PIN_getInputValue(CONFIG_PIN_BUTTON_1) == 0))  // Wait for release
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#elif TX_MODE == TX_MODE_POSTED
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
         {
-            if(PIN_getInputValue(CONFIG_PIN_BUTTON_0) == 0)  // Left button pressed
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
+            void *arg = (void *)(uintptr_t)packetIdx;
+            int_fast8_t submitStatus = TxQueue_submit(frame->psdu, PAYLOAD_LENGTH, arg);
+            if(submitStatus == TX_QUEUE_STATUS_FULL)
             {
-                leftButtonPressed = 1;
-                PIN_setOutputValue(ledPinHandle, CONFIG_PIN_RLED, 1);
+                /* Let the radio catch up and try again */
+                TxQueue_waitEmpty();
+                submitStatus = TxQueue_submit(frame->psdu, PAYLOAD_LENGTH, arg);
             }
-            if(PIN_getInputValue(CONFIG_PIN_BUTTON_1) == 0)  // Right button pressed
+            if(submitStatus != TX_QUEUE_STATUS_SUCCESS)
             {
-                rightButtonPressed = 1;
-                PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED, 1);
+                /* RF_postCmd() failed, or the queue is full with the radio idle */
+                while(1);
             }
+
+            /* The queue keeps its own copy, so the frame can go back at once */
+            FramePool_free(&framePool, frame);
         }
+        TxQueue_waitEmpty();
+        RadioSession_endTx();
+        firstPacketTimeStamp = firstPacketTime;
 
-        if(leftButtonPressed)
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+        TxQueue_getStats(&txQueueStats);
+#elif TX_MODE == TX_MODE_TIMED
+        /* The grid starts a lead time after the radio is set up */
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        TxTimed_open(rfHandle, &timedParams, timedDoneCallback);
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
         {
-            if(txPower > 0)
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
+            if(TxTimed_submit(frame->psdu, PAYLOAD_LENGTH, (void *)(uintptr_t)packetIdx) != TX_TIMED_STATUS_SUCCESS)
             {
-                if(txPower == 14)
-                {
-                    txPower = 10;
-                }
-                else
-                {
-                    txPower = txPower - 1;
-                }
+                /* Missed its slot, the next packet keeps its own */
+                timedOffsets[packetIdx] = INT32_MAX;
             }
+
+            /* The command keeps its own copy, so the frame can go back at once */
+            FramePool_free(&framePool, frame);
         }
-        else if(rightButtonPressed)
+        TxTimed_waitEmpty();
+        RadioSession_endTx();
+        firstPacketTimeStamp = firstPacketTime;
+
+        TxTimed_getStats(&timedStats);
+        char line[112];
+        TxTimed_formatStats(&timedStats, line, sizeof(line));
+        fputs(line, stdout);
+        fflush(stdout);
+
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#elif TX_MODE == TX_MODE_LOW_POWER
+        /* Tune now, the RF driver replays the CMD_FS on every power-up */
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        RadioSession_endTx();
+        TxTimed_open(rfHandle, &timedParams, timedDoneCallback);
+        EnergyMeter_start();
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
         {
-            if(txPower < 20)
+            rfHandle = RadioSession_beginTx(&scheduleParams);
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
+            if(TxTimed_submit(frame->psdu, PAYLOAD_LENGTH, (void *)(uintptr_t)packetIdx) != TX_TIMED_STATUS_SUCCESS)
             {
-                if(txPower == 10)
-                {
-                    txPower = 14;
-                }
-                else
-                {
-                    txPower = txPower + 1;
-                }
+                timedOffsets[packetIdx] = INT32_MAX;
+            }
+            FramePool_free(&framePool, frame);
+
+            /* One packet at a time, so the radio is off and the device in
+             * standby until the driver wakes the radio for the next slot */
+            TxTimed_waitEmpty();
+            RadioSession_endTx();
+            if(timedOffsets[packetIdx] != INT32_MAX)
+            {
+                EnergyMeter_addFrame(PAYLOAD_LENGTH, txPower);
             }
         }
+        EnergyMeter_stop(&energyReport);
+        firstPacketTimeStamp = firstPacketTime;
 
-        leftButtonPressed = 0;
-        rightButtonPressed = 0;
-        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_RLED, 0);
-        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED, 0);
+        /* Printed after the window, so it does not count */
+        char line[112];
+        EnergyMeter_formatReport(&energyReport, line, sizeof(line));
+        fputs(line, stdout);
+        fflush(stdout);
 
-        /* Request access to the radio */
-        rfHandle = RF_open(&rfObject, &RF_prop_ieee154, (RF_RadioSetup*)&RF_cmdRadioSetup_ieee154, &rfParams);
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+        TxTimed_getStats(&timedStats);
+#elif TX_MODE == TX_MODE_PIPELINED
+        /* Each packet is built while the one before is on air */
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        checkTerminationReason(TxPipe_send(rfHandle, &pipeParams, PACKETS_PER_BURST, &pipeResult));
+        RadioSession_endTx();
+        firstPacketTimeStamp = pipeResult.firstTimeStamp;
 
-        RF_setTxPower(rfHandle, RF_TxPowerTable_findValue(txPowerTable_2400_pa5_20, txPower));
+        char line[96];
+        TxPipe_formatResult(&pipeResult, line, sizeof(line));
+        fputs(line, stdout);
+        fflush(stdout);
 
-        /* Set the frequency */
-        RF_runScheduleCmd(rfHandle, (RF_Op*)&RF_cmdFs_ieee154, &scheduleParams, NULL, 0);
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#elif TX_MODE == TX_MODE_SHARED
+        /* The receiver keeps running; every packet takes the radio from it */
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
+        {
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
 
-        uint8_t packetIdx;
-        for(packetIdx = 0; packetIdx < 10; packetIdx++)
+            SharedRadio_Result result;
+            checkTerminationReason(SharedRadio_send(rfHandle, frame->psdu, PAYLOAD_LENGTH, &result));
+            if(result.txStatus != IDLE)  // Otherwise refused, it could not end in time
+            {
+                checkTxStatus(result.txStatus);
+            }
+            if(packetIdx == 0)
+            {
+                firstPacketTimeStamp = result.timeStamp;
+            }
+
+            FramePool_free(&framePool, frame);
+            usleep(SHARED_INTERVAL_US);
+        }
+        RadioSession_endTx();
+
+        SharedRadio_getStats(&sharedStats, true);
+        RxMonitor_getStats(&rxStats, true);
+        char line[256];
+        SharedRadio_formatStats(&sharedStats, line, sizeof(line));
+        fputs(line, stdout);
+        RxMonitor_formatStats(&rxStats, line, sizeof(line));
+        fputs(line, stdout);
+        fflush(stdout);
+
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#elif TX_MODE == TX_MODE_CSMA
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        if(CsmaTx_open(rfHandle, &csmaParams) != RF_StatSuccess)
+        {
+            /* Background receiver not started */
+            while(1);
+        }
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
         {
-            /* Create packet with incrementing sequence number and random payload */
-            packet[0] = (uint8_t)(seqNumber >> 8);
-            packet[1] = (uint8_t)(seqNumber++);
-            uint8_t i;
-            for (i = 2; i < PAYLOAD_LENGTH; i++)
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
+
+            /* Send packet once the channel is clear */
+            CsmaTx_Result result;
+            checkTerminationReason(CsmaTx_send(frame->psdu, PAYLOAD_LENGTH, &result));
+            if(result.csmaStatus == IEEE_DONE_OK)  // Otherwise channel access failed and nothing was sent
+            {
+                checkTxStatus(result.txStatus);
+            }
+            if(packetIdx == 0)
             {
-                packet[i] = (uint8_t)txPower;
+                firstPacketTimeStamp = result.timeStamp;
             }
 
-            /* Send packet */
-            RF_EventMask terminationReason = RF_runScheduleCmd(rfHandle, (RF_Op*)&RF_cmdIeeeTx_ieee154,
-                                                               &scheduleParams, NULL, 0);
+            FramePool_free(&framePool, frame);
+        }
+        CsmaTx_close();
+        RadioSession_endTx();
 
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+        CsmaTx_getStats(&csmaStats);
+#elif TX_MODE == TX_MODE_ACK
+        rfHandle = RadioSession_beginTx(&scheduleParams);
+        if(AckTx_open(rfHandle, &ackParams) != RF_StatSuccess)
+        {
+            /* Background receiver not started or too many retries */
+            while(1);
+        }
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
+        {
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
 
-            switch(terminationReason)
+            /* Send packet, retried by the radio core until it is acknowledged */
+            AckTx_Result result;
+            checkTerminationReason(AckTx_send(frame->psdu, PAYLOAD_LENGTH, &result));
+            checkTxStatus(result.txStatus);
+            if(packetIdx == 0)
             {
-                case RF_EventLastCmdDone:
-                    // A stand-alone radio operation command or the last radio
-                    // operation command in a chain finished.
-                    break;
-                case RF_EventCmdCancelled:
-                    // Command cancelled before it was started; it can be caused
-                // by RF_cancelCmd() or RF_flushCmd().
-                    break;
-                case RF_EventCmdAborted:
-                    // Abrupt command termination caused by RF_cancelCmd() or
-                    // RF_flushCmd().
-                    break;
-                case RF_EventCmdStopped:
-                    // Graceful command termination caused by RF_cancelCmd() or
-                    // RF_flushCmd().
-                    break;
-                case RF_EventLastFGCmdDone:
-                    // Graceful command termination caused by RF_cancelCmd() or
-                    // RF_flushCmd().
-                    break;
-                default:
-                    // Uncaught error event
-                    while(1);
+                firstPacketTimeStamp = result.timeStamp;
             }
 
-            uint32_t cmdStatus = ((volatile RF_Op*)&RF_cmdIeeeTx_ieee154)->status;
-            switch(cmdStatus)
+            FramePool_free(&framePool, frame);
+        }
+        AckTx_close();
+        RadioSession_endTx();
+
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+        AckTx_getStats(&ackStats);
+#elif TX_MODE == TX_MODE_BENCH
+        /* The sweep sets its own TX power levels */
+        char header[160];
+        TxBench_formatHeader(header, sizeof(header));
+        fputs(header, stdout);
+        TxBench_run(&benchParams, printBenchResult);
+        fflush(stdout);
+
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#elif TX_MODE == TX_MODE_SWEEP
+        /* The sweep sets its own TX power levels and channels */
+        runSweep();
+
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
+#else
+        for(packetIdx = 0; packetIdx < PACKETS_PER_BURST; packetIdx++)
+        {
+            FramePool_Slot *frame = FramePool_alloc(&framePool);
+            fillPacket(frame->psdu, txPower);
+            RF_cmdIeeeTx_ieee154.pPayload = frame->psdu;
+
+            /* Send packet */
+            rfHandle = RadioSession_beginTx(&scheduleParams);
+            uint32_t postTime = RF_getCurrentTime();
+            RF_EventMask terminationReason = RF_runScheduleCmd(rfHandle, (RF_Op*)&RF_cmdIeeeTx_ieee154,
+                                                               &scheduleParams, NULL, 0);
+            uint16_t txStatus = ((volatile RF_Op*)&RF_cmdIeeeTx_ieee154)->status;
+            RadioTrace_add((RF_Op*)&RF_cmdIeeeTx_ieee154, postTime,
+                           (txStatus == IEEE_DONE_OK) ? RF_cmdIeeeTx_ieee154.timeStamp : RADIO_TRACE_NO_TIME,
+                           RF_getCurrentTime());
+            RadioSession_addAirTime(&RF_cmdIeeeTx_ieee154);
+            checkTerminationReason(terminationReason);
+            checkTxStatus(txStatus);
+            if(packetIdx == 0)
             {
-                case IEEE_DONE_OK:
-                    // Packet transmitted successfully
-                    break;
-                case IEEE_DONE_STOPPED:
-                    // received CMD_STOP while transmitting packet and finished
-                    // transmitting packet
-                    break;
-                case IEEE_DONE_ABORT:
-                    // Received CMD_ABORT while transmitting packet
-                    break;
-                case IEEE_ERROR_PAR:
-                    // Observed illegal parameter
-                    break;
-                case IEEE_ERROR_NO_SETUP:
-                    // Command sent without setting up the radio in a supported
-                    // mode using CMD_PROP_RADIO_SETUP or CMD_RADIO_SETUP
-                    break;
-                case IEEE_ERROR_NO_FS:
-                    // Command sent without the synthesizer being programmed
-                    break;
-                case IEEE_ERROR_TXUNF:
-                    // TX underflow observed during operation
-                    break;
-                default:
-                    // Uncaught error event - these could come from the
-                    // pool of states defined in rf_mailbox.h
-                    while(1);
+                firstPacketTimeStamp = RF_cmdIeeeTx_ieee154.timeStamp;
             }
 
+            /* Power down the radio */
+            RadioSession_endTx();
+            FramePool_free(&framePool, frame);
+
     #ifndef POWER_MEASUREMENT
             PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED,!PIN_getOutputValue(CONFIG_PIN_GLED));
     #endif
-            /* Power down the radio */
-            RF_yield(rfHandle);
 
     #ifdef POWER_MEASUREMENT
             /* Sleep for PACKET_INTERVAL s */
@@ -288,6 +1003,28 @@ void *mainThread(void *arg0)
             usleep(PACKET_INTERVAL);
     #endif
         }
-        RF_close(rfHandle);
+#endif
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_RLED, 0);
+        PIN_setOutputValue(ledPinHandle, CONFIG_PIN_GLED, 0);
+
+#if TX_MODE_HAS_ON_AIR
+        Buttons_recordOnAir(&buttonEvent, firstPacketTimeStamp);
+        if(BootTime_markOnAir(firstPacketTimeStamp))
+        {
+            printBootReport();
+        }
+#endif
+        Buttons_getStats(&buttonStats);
+#if !TX_MODE_IS_BURST
+        FramePool_getStats(&framePool, &framePoolStats);
+#endif
+        RadioSession_getStats(&radioStats);
+
+        /* High-water marks, in the trace after the commands of the burst */
+        MemWatch_sample();
+        MemWatch_trace();
+        MemWatch_getStats(&memStats);
+        RadioTrace_getStats(&traceStats);
     }
+#endif
 }
@@ -0,0 +1,366 @@
+/*
+ *  ======== rxMonitor.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rxMonitor.h"
+#include "macFrame.h"
+#include "radioTrace.h"
+
+/* TI Drivers */
+#include <ti/drivers/dpl/HwiP.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+
+/* Appended to every frame: RSSI, correlation and CRC status, timestamp */
+#define APPENDED_LENGTH         (1 + 1 + 4)
+
+/* Length byte (lenSz = 1), the frame without FCS and what is appended */
+#define ENTRY_DATA_LENGTH       (1 + MAC_FRAME_MAX_LENGTH + APPENDED_LENGTH)
+#define ENTRY_LENGTH            ((offsetof(rfc_dataEntryGeneral_t, data) + ENTRY_DATA_LENGTH + 3) & ~3u)
+
+/***** Type declarations *****/
+
+/* The radio needs the entries word aligned */
+typedef union
+{
+    uint32_t align;
+    uint8_t bytes[ENTRY_LENGTH];
+} RxMonitor_Entry;
+
+/***** Prototypes *****/
+static void rxCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+static void takeEntries(void);
+static void countFrame(const uint8_t *data);
+static void clearStats(void);
+static RF_CmdHandle postRx(void);
+
+/***** Variable declarations *****/
+static RF_Handle rfHandle;
+static RF_CmdHandle rxCmdHandle = RF_ALLOC_ERROR;
+static uint32_t rxPostTime;
+static volatile bool running;
+static RxMonitor_Params rxParams;
+
+static rfc_CMD_IEEE_RX_t rxCmd;
+static rfc_ieeeRxOutput_t rxOutput;
+static dataQueue_t rxQueue;
+static RxMonitor_Entry entries[RX_MONITOR_NUM_ENTRIES];
+static uint8_t nextEntry;               /* Next entry the radio finishes */
+static uint8_t lastBufFull;             /* rxOutput.nRxBufFull counted so far */
+
+/* Sequence number of the last data frame, once there is one */
+static bool seqValid;
+static uint8_t lastSeq;
+
+static RxMonitor_Stats stats;
+
+/***** Function definitions *****/
+
+static void rxCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    takeEntries();
+
+    if (e & RF_EventCmdPreempted)
+    {
+        /* Queue it again behind the command that took the radio */
+        uint32_t now = RF_getCurrentTime();
+        RadioTrace_add((RF_Op*)&rxCmd, rxPostTime, RADIO_TRACE_NO_TIME, now);
+        stats.numPreempted++;
+        if (rxParams.preemptFxn != NULL)
+        {
+            rxParams.preemptFxn(now);
+        }
+        rxCmdHandle = postRx();
+        running = (rxCmdHandle >= 0);
+    }
+    else if (e & (RF_EventLastCmdDone | RF_EventCmdCancelled | RF_EventCmdAborted | RF_EventCmdStopped))
+    {
+        running = false;
+    }
+}
+
+/* Parses every entry the radio has finished, in order, and hands it back */
+static void takeEntries(void)
+{
+    uint8_t backlog = 0;
+
+    while (1)
+    {
+        rfc_dataEntryGeneral_t *entry = (rfc_dataEntryGeneral_t *)entries[nextEntry].bytes;
+        if (((volatile rfc_dataEntryGeneral_t *)entry)->status != DATA_ENTRY_FINISHED)
+        {
+            break;
+        }
+
+        countFrame(&entry->data);
+        entry->status = DATA_ENTRY_PENDING;
+        nextEntry = (nextEntry + 1) % RX_MONITOR_NUM_ENTRIES;
+        backlog++;
+    }
+
+    if (backlog > stats.maxBacklog)
+    {
+        stats.maxBacklog = backlog;
+    }
+
+    /* The radio's counter is 8 bit; it can not wrap between two callbacks */
+    uint8_t bufFull = ((volatile rfc_ieeeRxOutput_t *)&rxOutput)->nRxBufFull;
+    stats.numBufFull += (uint8_t)(bufFull - lastBufFull);
+    lastBufFull = bufFull;
+}
+
+static void countFrame(const uint8_t *data)
+{
+    stats.numFrames++;
+    if (data[0] < APPENDED_LENGTH)
+    {
+        /* Nothing a frame could be in */
+        stats.numCrcErrors++;
+        return;
+    }
+
+    /* Length byte, frame, then the appended fields in place */
+    uint8_t length = data[0] - APPENDED_LENGTH;
+    const uint8_t *psdu = &data[1];
+    int8_t rssi = (int8_t)psdu[length];
+    const rfc_ieeeRxCorrCrc_t *corrCrc = (const rfc_ieeeRxCorrCrc_t *)&psdu[length + 1];
+    const uint8_t *ts = &psdu[length + 2];
+    uint32_t timeStamp = ts[0] | ((uint32_t)ts[1] << 8) | ((uint32_t)ts[2] << 16) | ((uint32_t)ts[3] << 24);
+
+    int32_t bin = (rssi - RX_MONITOR_RSSI_MIN) / RX_MONITOR_RSSI_STEP;
+    if (rssi < RX_MONITOR_RSSI_MIN)
+    {
+        bin = 0;
+    }
+    else if (bin >= RX_MONITOR_RSSI_BINS)
+    {
+        bin = RX_MONITOR_RSSI_BINS - 1;
+    }
+    stats.rssiBins[bin]++;
+    stats.totalRssi += rssi;
+    if (rssi < stats.minRssi)
+    {
+        stats.minRssi = rssi;
+    }
+    if (rssi > stats.maxRssi)
+    {
+        stats.maxRssi = rssi;
+    }
+
+    if (corrCrc->status.bCrcErr)
+    {
+        /* The sequence number may be wrong as well */
+        stats.numCrcErrors++;
+        return;
+    }
+
+    if (stats.numFrames - stats.numCrcErrors == 1)
+    {
+        stats.firstTimeStamp = timeStamp;
+    }
+    stats.lastTimeStamp = timeStamp;
+    stats.lastLength = length;
+    stats.numBytes += length;
+
+    if ((length <= MAC_FRAME_SEQ_OFFSET) || (MacFrame_getType(psdu) != MAC_FRAME_TYPE_DATA))
+    {
+        stats.numOther++;
+        return;
+    }
+
+    uint8_t seq = MacFrame_getSeq(psdu);
+    uint8_t delta = seq - lastSeq;
+    if (!seqValid)
+    {
+        seqValid = true;
+        stats.numData++;
+    }
+    else if (delta == 0)
+    {
+        stats.numDuplicates++;
+    }
+    else
+    {
+        stats.numData++;
+        stats.numMissed += delta - 1;
+    }
+    lastSeq = seq;
+}
+
+static void clearStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    stats.minRssi = INT8_MAX;
+    stats.maxRssi = INT8_MIN;
+    seqValid = false;
+}
+
+static RF_CmdHandle postRx(void)
+{
+    RF_ScheduleCmdParams scheduleParams;
+
+    RF_ScheduleCmdParams_init(&scheduleParams);
+    scheduleParams.endType = RF_EndInfinit;
+    scheduleParams.activityInfo = rxParams.activityInfo;
+
+    rxPostTime = RF_getCurrentTime();
+    return RF_scheduleCmd(rfHandle, (RF_Op*)&rxCmd, &scheduleParams, rxCallback,
+                          RF_EventRxEntryDone | RF_EventRxBufFull);
+}
+
+void RxMonitor_Params_init(RxMonitor_Params *params)
+{
+    params->activityInfo = RF_PriorityNormal;
+    params->preemptFxn = NULL;
+}
+
+RF_Stat RxMonitor_start(RF_Handle handle, const RxMonitor_Params *params)
+{
+    uint8_t i;
+
+    rfHandle = handle;
+    if (params != NULL)
+    {
+        rxParams = *params;
+    }
+    else
+    {
+        RxMonitor_Params_init(&rxParams);
+    }
+    clearStats();
+
+    /* Circular queue: the last entry points back to the first */
+    for (i = 0; i < RX_MONITOR_NUM_ENTRIES; i++)
+    {
+        rfc_dataEntryGeneral_t *entry = (rfc_dataEntryGeneral_t *)entries[i].bytes;
+        entry->pNextEntry = entries[(i + 1) % RX_MONITOR_NUM_ENTRIES].bytes;
+        entry->status = DATA_ENTRY_PENDING;
+        entry->config.type = DATA_ENTRY_TYPE_GEN;
+        entry->config.lenSz = 1;
+        entry->config.irqIntv = 0;
+        entry->length = ENTRY_DATA_LENGTH;
+    }
+    rxQueue.pCurrEntry = entries[0].bytes;
+    rxQueue.pLastEntry = NULL;
+    nextEntry = 0;
+
+    memset(&rxOutput, 0, sizeof(rxOutput));
+    lastBufFull = 0;
+
+    /* Everything on the channel, frames with CRC errors included */
+    rxCmd = RF_cmdIeeeRx_ieee154;
+    rxCmd.pRxQ = &rxQueue;
+    rxCmd.pOutput = &rxOutput;
+    rxCmd.rxConfig.bAutoFlushCrc = 0;
+    rxCmd.rxConfig.bAutoFlushIgn = 1;
+    rxCmd.rxConfig.bIncludePhyHdr = 0;
+    rxCmd.rxConfig.bIncludeCrc = 0;
+    rxCmd.rxConfig.bAppendRssi = 1;
+    rxCmd.rxConfig.bAppendCorrCrc = 1;
+    rxCmd.rxConfig.bAppendSrcInd = 0;
+    rxCmd.rxConfig.bAppendTimestamp = 1;
+    rxCmd.frameFiltOpt.frameFiltEn = 0;
+    rxCmd.frameFiltOpt.autoAckEn = 0;
+    rxCmd.startTrigger.triggerType = TRIG_NOW;
+    rxCmd.endTrigger.triggerType = TRIG_NEVER;
+
+    running = true;
+    rxCmdHandle = postRx();
+    if (rxCmdHandle < 0)
+    {
+        running = false;
+        return RF_StatError;
+    }
+
+    return RF_StatSuccess;
+}
+
+void RxMonitor_stop(void)
+{
+    if (rxCmdHandle >= 0)
+    {
+        RF_cancelCmd(rfHandle, rxCmdHandle, RF_ABORT_GRACEFULLY);
+        RF_pendCmd(rfHandle, rxCmdHandle, RF_EventLastCmdDone);
+        RadioTrace_add((RF_Op*)&rxCmd, rxPostTime, RADIO_TRACE_NO_TIME, RF_getCurrentTime());
+        rxCmdHandle = RF_ALLOC_ERROR;
+    }
+}
+
+bool RxMonitor_isRunning(void)
+{
+    return running;
+}
+
+void RxMonitor_getStats(RxMonitor_Stats *pStats, bool reset)
+{
+    /* The RF callback updates them */
+    uintptr_t key = HwiP_disable();
+    *pStats = stats;
+    if (reset)
+    {
+        clearStats();
+    }
+    HwiP_restore(key);
+}
+
+int RxMonitor_formatStats(const RxMonitor_Stats *s, char *buf, size_t size)
+{
+    uint32_t numGood = s->numFrames - s->numCrcErrors;
+    uint32_t numExpected = s->numData + s->numMissed;
+    uint32_t perPpm = (numExpected == 0) ? 0 :
+        (uint32_t)(((uint64_t)s->numMissed * 1000000) / numExpected);
+    int32_t avgRssi = (s->numFrames == 0) ? 0 : s->totalRssi / (int32_t)s->numFrames;
+    uint32_t bitRate = 0;
+    uint32_t frameRate = 0;
+
+    /* From the start of the first good frame to the end of the last */
+    if (numGood > 0)
+    {
+        uint32_t us = RF_convertRatTicksToUs(s->lastTimeStamp - s->firstTimeStamp) +
+                      MAC_FRAME_AIR_US(s->lastLength);
+        bitRate = (uint32_t)(((uint64_t)s->numBytes * 8 * 1000000) / us);
+        frameRate = (uint32_t)(((uint64_t)numGood * 1000000) / us);
+    }
+
+    return snprintf(buf, size, "# rx %lu, crc %lu, missed %lu, per %lu ppm, buffer full %lu, "
+                               "backlog %u, rssi %d/%ld/%d dBm, %lu bit/s, %lu frames/s\n",
+                    (unsigned long)s->numFrames, (unsigned long)s->numCrcErrors,
+                    (unsigned long)s->numMissed, (unsigned long)perPpm,
+                    (unsigned long)s->numBufFull, s->maxBacklog,
+                    (s->numFrames == 0) ? 0 : s->minRssi, (long)avgRssi,
+                    (s->numFrames == 0) ? 0 : s->maxRssi,
+                    (unsigned long)bitRate, (unsigned long)frameRate);
+}
+
+int RxMonitor_formatHistogram(const RxMonitor_Stats *s, char *buf, size_t size)
+{
+    int n = snprintf(buf, size, "# rssi");
+    size_t used;
+    int i;
+
+    for (i = 0; i < RX_MONITOR_RSSI_BINS; i++)
+    {
+        if (s->rssiBins[i] > 0)
+        {
+            used = ((size_t)n < size) ? (size_t)n : size;
+            n += snprintf(buf + used, size - used, " %d:%lu",
+                          RX_MONITOR_RSSI_MIN + i * RX_MONITOR_RSSI_STEP, (unsigned long)s->rssiBins[i]);
+        }
+    }
+    used = ((size_t)n < size) ? (size_t)n : size;
+    n += snprintf(buf + used, size - used, "\n");
+
+    return n;
+}
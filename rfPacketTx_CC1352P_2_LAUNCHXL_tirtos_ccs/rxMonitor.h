@@ -0,0 +1,138 @@
+/*
+ *  ======== rxMonitor.h ========
+ *  Continuous IEEE 802.15.4 receiver for link measurements.
+ *
+ *  A copy of RF_cmdIeeeRx_ieee154 runs as a background command until it
+ *  is stopped, receiving into a circular queue of RX_MONITOR_NUM_ENTRIES
+ *  general data entries, each large enough for a 127 byte frame. Frames
+ *  are parsed in place from the RX entry done callback, length, RSSI, CRC
+ *  status and timestamp straight from the entry, and every entry is handed
+ *  back to the radio as soon as it has been looked at; nothing is copied.
+ *  CRC errors are kept (bAutoFlushCrc = 0), so they can be counted.
+ *
+ *  Data frames are followed by their sequence number: a jump of more than
+ *  one counts the frames in between as missed, which gives the packet
+ *  error rate as 1 - ok / expected over the frames of the peer. Runs of
+ *  256 or more lost frames can not be told from a wrap. Every frame also
+ *  goes into a histogram of its RSSI, and the timestamps of the first and
+ *  the last good frame give the throughput.
+ *
+ *  Frames lost because no entry was free show up as numBufFull; the
+ *  deepest backlog of entries found in one callback tells how close the
+ *  queue came to that.
+ *
+ *  The receiver can share the radio with another RF client. It is
+ *  scheduled at the priority in its parameters; when a client with a
+ *  higher priority preempts it, it is posted again from the callback
+ *  right away, so the RF driver resumes it as soon as the other client's
+ *  command is done. The queue and the statistics carry on.
+ */
+#ifndef RXMONITOR_H_
+#define RXMONITOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Entries of the receive queue. At line rate a 127 byte frame takes
+ * 4.4 ms on air, so each entry adds that much time to hand it back. */
+#ifndef RX_MONITOR_NUM_ENTRIES
+#define RX_MONITOR_NUM_ENTRIES      8
+#endif
+
+/* RSSI histogram: RX_MONITOR_RSSI_BINS bins of RX_MONITOR_RSSI_STEP dB
+ * from RX_MONITOR_RSSI_MIN; the outer bins also take what is beyond */
+#ifndef RX_MONITOR_RSSI_MIN
+#define RX_MONITOR_RSSI_MIN         (-100)
+#endif
+#ifndef RX_MONITOR_RSSI_STEP
+#define RX_MONITOR_RSSI_STEP        5
+#endif
+#ifndef RX_MONITOR_RSSI_BINS
+#define RX_MONITOR_RSSI_BINS        16
+#endif
+
+/* Called from the RF callback when the receiver was preempted, with the
+ * RAT time it learned of it */
+typedef void (*RxMonitor_PreemptFxn)(uint32_t time);
+
+typedef struct
+{
+    uint32_t activityInfo;      /* Of the RX command, priority in the low 16 bits (sharedRadio.h) */
+    RxMonitor_PreemptFxn preemptFxn;    /* May be NULL */
+} RxMonitor_Params;
+
+typedef struct
+{
+    uint32_t numFrames;         /* Frames received, CRC errors included */
+    uint32_t numCrcErrors;
+    uint32_t numOther;          /* Good frames that are not data frames */
+    uint32_t numData;           /* Good data frames */
+    uint32_t numDuplicates;     /* Data frames with the sequence number of the one before */
+    uint32_t numMissed;         /* Data frames the sequence numbers say never arrived */
+    uint32_t numBufFull;        /* Frames dropped by the radio, no entry free */
+    uint32_t numPreempted;      /* Times another client took the radio */
+    uint32_t numBytes;          /* PSDU bytes of good frames, FCS excluded */
+    uint32_t firstTimeStamp;    /* RAT time the first good frame started */
+    uint32_t lastTimeStamp;     /* RAT time the last good frame started */
+    uint8_t lastLength;         /* PSDU length of that frame, FCS excluded */
+    uint8_t maxBacklog;         /* Most entries found finished by one callback */
+    int8_t minRssi;
+    int8_t maxRssi;
+    int32_t totalRssi;          /* Over numFrames */
+    uint32_t rssiBins[RX_MONITOR_RSSI_BINS];
+} RxMonitor_Stats;
+
+/*
+ *  ======== RxMonitor_Params_init ========
+ *  RF_PriorityNormal, no preempt function.
+ */
+extern void RxMonitor_Params_init(RxMonitor_Params *params);
+
+/*
+ *  ======== RxMonitor_start ========
+ *  Starts receiving on the channel the radio is tuned to and clears the
+ *  statistics. params may be NULL for the defaults. Returns RF_StatError
+ *  if the RF driver did not take the command.
+ */
+extern RF_Stat RxMonitor_start(RF_Handle rfHandle, const RxMonitor_Params *params);
+
+/*
+ *  ======== RxMonitor_stop ========
+ *  Stops receiving; the frames received so far stay in the statistics.
+ */
+extern void RxMonitor_stop(void);
+
+/*
+ *  ======== RxMonitor_isRunning ========
+ *  False once the receive command has ended for another reason than
+ *  preemption, or could not be posted again after it.
+ */
+extern bool RxMonitor_isRunning(void);
+
+/*
+ *  ======== RxMonitor_getStats ========
+ *  Takes a consistent copy of the statistics. With reset set they start
+ *  over, and the next frame is the first of a new measurement.
+ */
+extern void RxMonitor_getStats(RxMonitor_Stats *stats, bool reset);
+
+/*
+ *  ======== RxMonitor_formatStats ========
+ *  Writes one line: frames, CRC errors, missed, PER in parts per million,
+ *  buffer full drops, backlog, RSSI min/avg/max and the throughput in
+ *  bit/s and frames/s. Returns the length like snprintf().
+ */
+extern int RxMonitor_formatStats(const RxMonitor_Stats *stats, char *buf, size_t size);
+
+/*
+ *  ======== RxMonitor_formatHistogram ========
+ *  Writes one line with the lower edge and count of every RSSI bin that is
+ *  not empty. Returns the length like snprintf().
+ */
+extern int RxMonitor_formatHistogram(const RxMonitor_Stats *stats, char *buf, size_t size);
+
+#endif /* RXMONITOR_H_ */
@@ -0,0 +1,192 @@
+/*
+ *  ======== sharedRadio.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sharedRadio.h"
+#include "macFrame.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+#include "rxMonitor.h"
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Prototypes *****/
+static void rxPreempted(uint32_t time);
+static void txCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+/***** Variable declarations *****/
+static RF_Object rxObject;
+static RF_Handle rxHandle;
+
+/* The receiver's own copy; the RF driver replays it when it switches to
+ * the receiver's client */
+static rfc_CMD_FS_t rxFsCmd;
+
+static rfc_CMD_IEEE_TX_t txCmd;
+static volatile uint32_t txDoneTime;
+
+/* Set by the receiver's callback when the frame took the radio from it */
+static volatile bool preempted;
+static volatile uint32_t preemptTime;
+
+static SharedRadio_Stats stats;
+
+/***** Function definitions *****/
+
+static void rxPreempted(uint32_t time)
+{
+    preemptTime = time;
+    preempted = true;
+}
+
+static void txCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    if (e & (RF_EventLastCmdDone | RF_EventCmdCancelled | RF_EventCmdAborted | RF_EventCmdStopped))
+    {
+        txDoneTime = RF_getCurrentTime();
+    }
+}
+
+RF_Stat SharedRadio_open(void)
+{
+    RF_Params rfParams;
+    RxMonitor_Params rxParams;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.minDowntime = UINT32_MAX;
+
+    txCmd = RF_cmdIeeeTx_ieee154;
+    txCmd.startTrigger.triggerType = TRIG_NOW;
+    txCmd.condition.rule = COND_NEVER;
+    txCmd.pNextOp = NULL;
+
+    if (rxHandle == NULL)
+    {
+        RF_Params_init(&rfParams);
+        rxHandle = RF_open(&rxObject, &RF_prop_ieee154, (RF_RadioSetup*)&RF_cmdRadioSetup_ieee154, &rfParams);
+        if (rxHandle == NULL)
+        {
+            return RF_StatError;
+        }
+    }
+
+    /* Same channel as the session */
+    const rfc_CMD_FS_t *fsCmd = RadioSession_getFsCmd(RadioSession_getChannel());
+    if (fsCmd == NULL)
+    {
+        return RF_StatInvalidParamsError;
+    }
+    rxFsCmd = *fsCmd;
+    RF_EventMask result = RF_runCmd(rxHandle, (RF_Op*)&rxFsCmd, RF_PriorityNormal, NULL, 0);
+    if (!(result & RF_EventLastCmdDone) || (rxFsCmd.status != DONE_OK))
+    {
+        return RF_StatError;
+    }
+
+    RxMonitor_Params_init(&rxParams);
+    rxParams.activityInfo = SHARED_RADIO_ACTIVITY_RX;
+    rxParams.preemptFxn = rxPreempted;
+
+    return RxMonitor_start(rxHandle, &rxParams);
+}
+
+RF_EventMask SharedRadio_send(RF_Handle txHandle, uint8_t *psdu, uint8_t length,
+                              SharedRadio_Result *result)
+{
+    RF_ScheduleCmdParams scheduleParams;
+
+    txCmd.status = IDLE;
+    txCmd.pPayload = psdu;
+    txCmd.payloadLen = length;
+    preempted = false;
+    stats.numTx++;
+    memset(result, 0, sizeof(*result));
+    result->txStatus = IDLE;
+
+    /* Either on air by endTime or not at all */
+    uint32_t postTime = RF_getCurrentTime();
+    RF_ScheduleCmdParams_init(&scheduleParams);
+    scheduleParams.endType = RF_EndAbs;
+    scheduleParams.endTime = postTime + RF_convertUsToRatTicks(MAC_FRAME_TX_START_TO_AIR_US + MAC_FRAME_AIR_US(length) +
+                                                               SHARED_RADIO_TX_MARGIN_US);
+    scheduleParams.activityInfo = SHARED_RADIO_ACTIVITY_TX;
+
+    RF_CmdHandle ch = RF_scheduleCmd(txHandle, (RF_Op*)&txCmd, &scheduleParams, txCallback, 0);
+    if (ch < 0)
+    {
+        stats.numRefused++;
+        return RF_EventCmdCancelled;
+    }
+
+    RF_EventMask terminationReason = RF_pendCmd(txHandle, ch, RF_EventLastCmdDone);
+    uint16_t status = ((volatile RF_Op*)&txCmd)->status;
+    result->txStatus = status;
+    result->timeStamp = txCmd.timeStamp;
+    uint32_t doneTime = txDoneTime;
+
+    RadioTrace_add((RF_Op*)&txCmd, postTime, (status == IEEE_DONE_OK) ? txCmd.timeStamp : RADIO_TRACE_NO_TIME,
+                   doneTime);
+    RadioSession_addAirTime(&txCmd);
+
+    if (status != IEEE_DONE_OK)
+    {
+        stats.numTxErrors++;
+    }
+    if ((int32_t)(doneTime - scheduleParams.endTime) > 0)
+    {
+        stats.numLate++;
+    }
+
+    /* The receiver was posted again when it was preempted and is back now */
+    if (preempted)
+    {
+        uint32_t downtime = doneTime - preemptTime;
+        result->rxPreempted = true;
+        result->rxDowntime = downtime;
+        stats.numDowntimes++;
+        stats.totalDowntime += downtime;
+        if (downtime < stats.minDowntime)
+        {
+            stats.minDowntime = downtime;
+        }
+        if (downtime > stats.maxDowntime)
+        {
+            stats.maxDowntime = downtime;
+        }
+    }
+
+    return terminationReason;
+}
+
+void SharedRadio_getStats(SharedRadio_Stats *pStats, bool reset)
+{
+    *pStats = stats;
+    if (reset)
+    {
+        memset(&stats, 0, sizeof(stats));
+        stats.minDowntime = UINT32_MAX;
+    }
+}
+
+int SharedRadio_formatStats(const SharedRadio_Stats *s, char *buf, size_t size)
+{
+    uint32_t avgDowntime = (s->numDowntimes == 0) ? 0 : s->totalDowntime / s->numDowntimes;
+
+    return snprintf(buf, size, "# shared tx %lu, errors %lu, refused %lu, late %lu, "
+                               "rx downtime %lu/%lu/%lu us over %lu\n",
+                    (unsigned long)s->numTx, (unsigned long)s->numTxErrors,
+                    (unsigned long)s->numRefused, (unsigned long)s->numLate,
+                    (unsigned long)((s->numDowntimes == 0) ? 0 : RF_convertRatTicksToUs(s->minDowntime)),
+                    (unsigned long)RF_convertRatTicksToUs(avgDowntime),
+                    (unsigned long)RF_convertRatTicksToUs(s->maxDowntime),
+                    (unsigned long)s->numDowntimes);
+}
@@ -0,0 +1,93 @@
+/*
+ *  ======== sharedRadio.h ========
+ *  Background receiver and foreground sender on one radio.
+ *
+ *  The receiver (rxMonitor.h) runs on an RF client of its own, opened
+ *  with the same setup as the radio session, so the RF driver switches
+ *  between the two clients without a new radio setup. It is scheduled at
+ *  RF_PriorityNormal and never ends. Every frame of the session's client
+ *  is scheduled at RF_PriorityHigh with an absolute end time, the time
+ *  the frame needs plus SHARED_RADIO_TX_MARGIN_US; the RF driver preempts
+ *  the receiver for it and refuses it if it can no longer end in time.
+ *  The receiver posts itself again when it is preempted, so it resumes
+ *  right after the frame.
+ *
+ *  The receiver is deaf from the moment it is preempted until the frame
+ *  is reported done, by which time the RF driver has it running again.
+ *  That downtime is measured for every frame, from the RF callbacks of
+ *  the two clients.
+ *
+ *  Priorities go in the low 16 bits of activityInfo and an activity ID in
+ *  the high 16, the way the DMM policy manager lays them out.
+ */
+#ifndef SHAREDRADIO_H_
+#define SHAREDRADIO_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+#define SHARED_RADIO_ACTIVITY(id, priority) (((uint32_t)(id) << 16) | (uint16_t)(priority))
+#define SHARED_RADIO_ACTIVITY_RX    SHARED_RADIO_ACTIVITY(1, RF_PriorityNormal)
+#define SHARED_RADIO_ACTIVITY_TX    SHARED_RADIO_ACTIVITY(2, RF_PriorityHigh)
+
+/* Time a frame may take beyond its own (TX startup and air time) before
+ * its end time: RF driver dispatch and the receiver being aborted */
+#ifndef SHARED_RADIO_TX_MARGIN_US
+#define SHARED_RADIO_TX_MARGIN_US   1000
+#endif
+
+typedef struct
+{
+    uint16_t txStatus;          /* CMD_IEEE_TX status, IDLE if the frame was refused */
+    bool rxPreempted;           /* The frame took the radio from the receiver */
+    uint32_t timeStamp;         /* RAT time the frame started on air */
+    uint32_t rxDowntime;        /* RAT ticks the receiver was deaf for it */
+} SharedRadio_Result;
+
+typedef struct
+{
+    uint32_t numTx;             /* Frames scheduled */
+    uint32_t numTxErrors;       /* Frames that did not end with IEEE_DONE_OK */
+    uint32_t numRefused;        /* Frames the RF driver refused, end time out of reach */
+    uint32_t numLate;           /* Frames reported done after their end time */
+    uint32_t numDowntimes;      /* Frames that preempted the receiver */
+    uint32_t minDowntime;       /* RAT ticks the receiver was deaf per frame */
+    uint32_t maxDowntime;
+    uint32_t totalDowntime;
+} SharedRadio_Stats;
+
+/*
+ *  ======== SharedRadio_open ========
+ *  Opens the receiver's RF client and starts receiving on the channel the
+ *  session is tuned to. The radio session must be open.
+ */
+extern RF_Stat SharedRadio_open(void);
+
+/*
+ *  ======== SharedRadio_send ========
+ *  Sends one frame (MAC header and payload, no FCS) on the session's
+ *  client, the handle RadioSession_beginTx() returned, preempting the
+ *  receiver, and blocks until it is done. Returns the RF driver
+ *  termination reason, RF_EventCmdCancelled if the frame was refused.
+ */
+extern RF_EventMask SharedRadio_send(RF_Handle txHandle, uint8_t *psdu, uint8_t length,
+                                     SharedRadio_Result *result);
+
+/*
+ *  ======== SharedRadio_getStats ========
+ *  With reset set the statistics start over.
+ */
+extern void SharedRadio_getStats(SharedRadio_Stats *stats, bool reset);
+
+/*
+ *  ======== SharedRadio_formatStats ========
+ *  Writes one line: frames, errors, refused, late and the min/avg/max RX
+ *  downtime per frame in us. Returns the length like snprintf().
+ */
+extern int SharedRadio_formatStats(const SharedRadio_Stats *stats, char *buf, size_t size);
+
+#endif /* SHAREDRADIO_H_ */
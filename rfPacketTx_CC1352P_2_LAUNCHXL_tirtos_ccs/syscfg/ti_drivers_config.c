@@ -17,6 +17,30 @@
 
 #include "ti_drivers_config.h"
 
+/*
+ *  =============================== DMA ===============================
+ */
+
+#include <ti/drivers/dma/UDMACC26XX.h>
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(inc/hw_memmap.h)
+
+UDMACC26XX_Object udmaCC26XXObject;
+
+const UDMACC26XX_HWAttrs udmaCC26XXHWAttrs = {
+    .baseAddr        = UDMA0_BASE,
+    .powerMngrId     = PowerCC26XX_PERIPH_UDMA,
+    .intNum          = INT_DMA_ERR,
+    .intPriority     = (~0)
+};
+
+const UDMACC26XX_Config UDMACC26XX_config[1] = {
+    {
+        .object         = &udmaCC26XXObject,
+        .hwAttrs        = &udmaCC26XXHWAttrs,
+    },
+};
+
 /*
  *  =============================== GPIO ===============================
  */
@@ -67,7 +91,7 @@ const GPIOCC26XX_Config GPIOCC26XX_config = {
 #include <ti/drivers/PIN.h>
 #include <ti/drivers/pin/PINCC26XX.h>
 
-#define CONFIG_PIN_COUNT 4
+#define CONFIG_PIN_COUNT 6
 
 const PIN_Config BoardGpioInitTable[CONFIG_PIN_COUNT + 1] = {
     /* SKY13317-373LF RF Antenna Switch, Parent Signal: /ti/drivers/RF RF Antenna Pin 0, (DIO28) */
@@ -78,6 +102,10 @@ const PIN_Config BoardGpioInitTable[CONFIG_PIN_COUNT + 1] = {
     CONFIG_RF_SUB1GHZ | PIN_INPUT_EN | PIN_NOPULL | PIN_IRQ_DIS,
     /* LaunchPad LED Green, Parent Signal: CONFIG_GPIO_GLED GPIO Pin, (DIO7) */
     CONFIG_PIN_GLED | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MED,
+    /* XDS110 UART, Parent Signal: CONFIG_UART2_0 TX, (DIO13) */
+    CONFIG_PIN_UART_TX | PIN_INPUT_EN | PIN_PULLDOWN | PIN_IRQ_DIS,
+    /* XDS110 UART, Parent Signal: CONFIG_UART2_0 RX, (DIO12) */
+    CONFIG_PIN_UART_RX | PIN_INPUT_EN | PIN_PULLDOWN | PIN_IRQ_DIS,
 
     PIN_TERMINATE
 };
@@ -108,6 +136,67 @@ const PowerCC26X2_Config PowerCC26X2_config = {
 };
 
 
+/*
+ *  =============================== UART2 ===============================
+ */
+
+#include <ti/drivers/UART2.h>
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(driverlib/udma.h)
+#include DeviceFamily_constructPath(inc/hw_memmap.h)
+#include DeviceFamily_constructPath(inc/hw_ints.h)
+#include <ti/drivers/uart2/UART2CC26X2.h>
+
+#define CONFIG_UART2_COUNT 1
+
+UART2CC26X2_Object uart2CC26X2Objects[CONFIG_UART2_COUNT];
+
+static unsigned char uart2RxRingBuffer0[32];
+/* TX ring buffer allocated to be used for nonblocking mode */
+static unsigned char uart2TxRingBuffer0[32];
+
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaUart0RxControlTableEntry, UDMA_CHAN_UART0_RX);
+ALLOCATE_CONTROL_TABLE_ENTRY(dmaUart0TxControlTableEntry, UDMA_CHAN_UART0_TX);
+
+static const UART2CC26X2_HWAttrs uart2CC26X2HWAttrs[CONFIG_UART2_COUNT] = {
+  {
+    .baseAddr           = UART0_BASE,
+    .intNum             = INT_UART0_COMB,
+    .intPriority        = (~0),
+    .rxPin              = IOID_12,
+    .txPin              = IOID_13,
+    .ctsPin             = PIN_UNASSIGNED,
+    .rtsPin             = PIN_UNASSIGNED,
+    .flowControl        = UART2_FLOWCTRL_NONE,
+    .powerId            = PowerCC26XX_PERIPH_UART0,
+    .rxBufPtr           = uart2RxRingBuffer0,
+    .rxBufSize          = sizeof(uart2RxRingBuffer0),
+    .txBufPtr           = uart2TxRingBuffer0,
+    .txBufSize          = sizeof(uart2TxRingBuffer0),
+    .txPinMux           = IOC_PORT_MCU_UART0_TX,
+    .rxPinMux           = IOC_PORT_MCU_UART0_RX,
+    .ctsPinMux          = IOC_PORT_MCU_UART0_CTS,
+    .rtsPinMux          = IOC_PORT_MCU_UART0_RTS,
+    .dmaTxTableEntryPri = &dmaUart0TxControlTableEntry,
+    .dmaRxTableEntryPri = &dmaUart0RxControlTableEntry,
+    .rxChannelMask      = 1 << UDMA_CHAN_UART0_RX,
+    .txChannelMask      = 1 << UDMA_CHAN_UART0_TX,
+    .txIntFifoThr       = UART2CC26X2_FIFO_THRESHOLD_1_8,
+    .rxIntFifoThr       = UART2CC26X2_FIFO_THRESHOLD_4_8
+  },
+};
+
+const UART2_Config UART2_config[CONFIG_UART2_COUNT] = {
+    {   /* CONFIG_UART2_0 */
+        .object      = &uart2CC26X2Objects[CONFIG_UART2_0],
+        .hwAttrs     = &uart2CC26X2HWAttrs[CONFIG_UART2_0]
+    },
+};
+
+const uint_least8_t CONFIG_UART2_0_CONST = CONFIG_UART2_0;
+const uint_least8_t UART2_count = CONFIG_UART2_COUNT;
+
+
 /*
  *  =============================== RF Driver ===============================
  */
@@ -134,7 +223,7 @@ extern void __attribute__((weak)) rfDriverCallbackAntennaSwitching (RF_Handle cl
 const RFCC26XX_HWAttrsV2 RFCC26XX_hwAttrs = {
     .hwiPriority        = (~0),
     .swiPriority        = (uint8_t)0,
-    .xoscHfAlwaysNeeded = true,
+    .xoscHfAlwaysNeeded = false,
     .globalCallback     = &RF_globalCallbackFunction,
     .globalEventMask    = RF_GlobalEventInit | RF_GlobalEventRadioPowerDown | RF_GlobalEventRadioSetup
 };
@@ -70,13 +70,31 @@ extern const PIN_Config BoardGpioInitTable[];
 #define CONFIG_PIN_BUTTON_0               0x0000000F
 /* LaunchPad Left Button, (DIO14) */
 #define CONFIG_PIN_BUTTON_1               0x0000000E
+/* XDS110 UART, Parent Signal: CONFIG_UART2_0 TX, (DIO13) */
+#define CONFIG_PIN_UART_TX                   0x0000000d
+/* XDS110 UART, Parent Signal: CONFIG_UART2_0 RX, (DIO12) */
+#define CONFIG_PIN_UART_RX                   0x0000000c
 /* SKY13317-373LF RF Antenna Switch, Parent Signal: /ti/drivers/RF RF Antenna Pin 0, (DIO28) */
 #define CONFIG_RF_24GHZ                   0x0000001c
 /* SKY13317-373LF RF Antenna Switch, Parent Signal: /ti/drivers/RF RF Antenna Pin 1, (DIO29) */
 #define CONFIG_RF_HIGH_PA                   0x0000001d
 /* SKY13317-373LF RF Antenna Switch, Parent Signal: /ti/drivers/RF RF Antenna Pin 2, (DIO30) */
 #define CONFIG_RF_SUB1GHZ                   0x0000001e
-#define CONFIG_TI_DRIVERS_PIN_COUNT    4
+#define CONFIG_TI_DRIVERS_PIN_COUNT    6
+
+
+/*
+ *  ======== UART2 ========
+ */
+
+/*
+ *  TX: DIO13
+ *  RX: DIO12
+ *  XDS110 UART
+ */
+extern const uint_least8_t              CONFIG_UART2_0_CONST;
+#define CONFIG_UART2_0                  0
+#define CONFIG_TI_DRIVERS_UART2_COUNT   1
 
 
 /*
@@ -0,0 +1,350 @@
+/*
+ *  ======== txBench.c ========
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "txBench.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+#include "txBurst.h"
+#include "txQueue.h"
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+#define FRAME_AIR_TICKS(len)    RF_convertUsToRatTicks(MAC_FRAME_AIR_US(len))
+
+/***** Prototypes *****/
+static void fillFrame(const TxBench_Params *params, uint8_t *buf, uint8_t length);
+static void initTxCmd(uint8_t length);
+static void addSample(TxBench_Result *result, uint16_t status, uint32_t latency);
+static void runBlocking(const TxBench_Params *params, RF_Handle rfHandle, uint8_t length,
+                        TxBench_Result *result);
+static void runPosted(const TxBench_Params *params, uint8_t length, TxBench_Result *result);
+static void runChained(const TxBench_Params *params, RF_Handle rfHandle, uint8_t length,
+                       TxBench_Result *result);
+static void postedCallback(const TxQueue_Completion *completion);
+static uint32_t percentile(uint32_t *sorted, uint16_t numSamples, uint8_t percent);
+
+/***** Variable declarations *****/
+static const char *const modeNames[TX_BENCH_MODE_COUNT] = { "blocking", "posted", "chained" };
+
+static RF_ScheduleCmdParams scheduleParams;
+static rfc_CMD_IEEE_TX_t txCmd;
+static TxBurst_Object txBurst;
+static uint8_t frameBuf[MAC_FRAME_MAX_LENGTH];
+static uint8_t seqNumber;
+
+/* Latency of every frame of the current point */
+static uint32_t samples[TX_BENCH_MAX_FRAMES];
+static TxBench_Result *currentResult;
+
+/***** Function definitions *****/
+
+static void fillFrame(const TxBench_Params *params, uint8_t *buf, uint8_t length)
+{
+    uint8_t full[MAC_FRAME_MAX_LENGTH];
+    uint8_t i = 0;
+
+    /* The first length bytes of a data frame, the header cut short if
+     * the frame is shorter than it */
+    if (params->frameTemplate != NULL)
+    {
+        MacFrame_writeHeader(params->frameTemplate, seqNumber, full);
+        i = params->frameTemplate->hdrLen;
+    }
+    for (; i < length; i++)
+    {
+        full[i] = seqNumber;
+    }
+    memcpy(buf, full, length);
+
+    seqNumber++;
+}
+
+static void addSample(TxBench_Result *result, uint16_t status, uint32_t latency)
+{
+    /* A failed frame has no time on air, its latency is not a sample */
+    if (status != IEEE_DONE_OK)
+    {
+        result->numErrors++;
+    }
+    else
+    {
+        uint16_t numSamples = result->numFrames - result->numErrors;
+        if (numSamples < TX_BENCH_MAX_FRAMES)
+        {
+            samples[numSamples] = latency;
+        }
+        result->airTicks += FRAME_AIR_TICKS(result->length);
+    }
+    result->numFrames++;
+}
+
+static void initTxCmd(uint8_t length)
+{
+    txCmd = RF_cmdIeeeTx_ieee154;
+    txCmd.payloadLen = length;
+    txCmd.pPayload = frameBuf;
+    txCmd.startTrigger.triggerType = TRIG_NOW;
+    txCmd.condition.rule = COND_NEVER;
+    txCmd.pNextOp = NULL;
+}
+
+static void runBlocking(const TxBench_Params *params, RF_Handle rfHandle, uint8_t length,
+                        TxBench_Result *result)
+{
+    uint16_t i;
+    for (i = 0; i < params->framesPerPoint; i++)
+    {
+        fillFrame(params, frameBuf, length);
+        txCmd.status = IDLE;
+
+        uint32_t submitTime = RF_getCurrentTime();
+        RF_runScheduleCmd(rfHandle, (RF_Op*)&txCmd, &scheduleParams, NULL, 0);
+
+        uint16_t status = ((volatile RF_Op*)&txCmd)->status;
+        RadioTrace_add((RF_Op*)&txCmd, submitTime,
+                       (status == IEEE_DONE_OK) ? txCmd.timeStamp : RADIO_TRACE_NO_TIME,
+                       RF_getCurrentTime());
+        RadioSession_addAirTime(&txCmd);
+        addSample(result, status, txCmd.timeStamp - submitTime);
+    }
+}
+
+static void postedCallback(const TxQueue_Completion *completion)
+{
+    addSample(currentResult, completion->status, completion->timeStamp - completion->submitTime);
+}
+
+static void runPosted(const TxBench_Params *params, uint8_t length, TxBench_Result *result)
+{
+    currentResult = result;
+
+    uint16_t i;
+    for (i = 0; i < params->framesPerPoint; i++)
+    {
+        /* The queue copies the frame, so one buffer is enough */
+        fillFrame(params, frameBuf, length);
+        while (TxQueue_submit(frameBuf, length, NULL) == TX_QUEUE_STATUS_FULL)
+        {
+            TxQueue_waitEmpty();
+        }
+    }
+    TxQueue_waitEmpty();
+}
+
+static void runChained(const TxBench_Params *params, RF_Handle rfHandle, uint8_t length,
+                       TxBench_Result *result)
+{
+    uint16_t remaining = params->framesPerPoint;
+
+    while (remaining > 0)
+    {
+        uint8_t numFrames = (remaining > TX_BURST_MAX_FRAMES) ? TX_BURST_MAX_FRAMES : (uint8_t)remaining;
+        uint8_t i;
+
+        TxBurst_init(&txBurst);
+        for (i = 0; i < numFrames; i++)
+        {
+            fillFrame(params, TxBurst_addFrame(&txBurst, length), length);
+        }
+
+        uint32_t submitTime = RF_getCurrentTime();
+        TxBurst_send(&txBurst, rfHandle, &scheduleParams);
+
+        for (i = 0; i < numFrames; i++)
+        {
+            addSample(result, TxBurst_getFrameStatus(&txBurst, i),
+                      TxBurst_getFrameTimeStamp(&txBurst, i) - submitTime);
+        }
+        remaining -= numFrames;
+    }
+}
+
+static uint32_t percentile(uint32_t *sorted, uint16_t numSamples, uint8_t percent)
+{
+    /* Nearest rank */
+    uint32_t rank = ((uint32_t)numSamples * percent + 99) / 100;
+    return sorted[(rank > 0) ? (rank - 1) : 0];
+}
+
+void TxBench_Params_init(TxBench_Params *params)
+{
+    const PowerTable_Object *table = PowerTable_get(RADIO_SESSION_POWER_TABLE);
+
+    params->modeMask = TX_BENCH_MODE_MASK_ALL;
+    params->minLength = 1;
+    params->maxLength = MAC_FRAME_MAX_LENGTH;
+    params->lengthStep = 31;
+    params->minTxPower = table->minDbm;
+    params->maxTxPower = table->maxDbm;
+    params->framesPerPoint = 50;
+    params->frameTemplate = NULL;
+}
+
+void TxBench_runPoint(const TxBench_Params *params, uint8_t mode, uint8_t length,
+                      TxBench_Result *result)
+{
+    memset(result, 0, sizeof(*result));
+    result->mode = mode;
+    result->length = length;
+    result->txPower = RadioSession_getTxPower();
+
+    if ((length == 0) || (length > MAC_FRAME_MAX_LENGTH) || (mode >= TX_BENCH_MODE_COUNT) ||
+        (params->framesPerPoint == 0) || (params->framesPerPoint > TX_BENCH_MAX_FRAMES))
+    {
+        return;
+    }
+
+    RF_ScheduleCmdParams_init(&scheduleParams);
+
+    /* CMD_FS, if needed, and one frame that is not counted, so radio
+     * power-up is not part of the measurement */
+    RF_Handle rfHandle = RadioSession_beginTx(&scheduleParams);
+    fillFrame(params, frameBuf, length);
+    initTxCmd(length);
+    RF_runScheduleCmd(rfHandle, (RF_Op*)&txCmd, &scheduleParams, NULL, 0);
+
+    if (mode == TX_BENCH_MODE_POSTED)
+    {
+        TxQueue_init(rfHandle, postedCallback);
+    }
+
+    uint32_t start = RF_getCurrentTime();
+    switch (mode)
+    {
+        case TX_BENCH_MODE_BLOCKING:
+            runBlocking(params, rfHandle, length, result);
+            break;
+        case TX_BENCH_MODE_POSTED:
+            runPosted(params, length, result);
+            break;
+        default:
+            runChained(params, rfHandle, length, result);
+            break;
+    }
+    result->elapsedTicks = RF_getCurrentTime() - start;
+
+    RadioSession_endTx();
+
+    /* Insertion sort: a few dozen samples, once per point */
+    uint16_t numSamples = result->numFrames - result->numErrors;
+    uint16_t i;
+    if (numSamples > TX_BENCH_MAX_FRAMES)
+    {
+        numSamples = TX_BENCH_MAX_FRAMES;
+    }
+    if (numSamples == 0)
+    {
+        return;
+    }
+    for (i = 1; i < numSamples; i++)
+    {
+        uint32_t sample = samples[i];
+        uint16_t j = i;
+        while ((j > 0) && (samples[j - 1] > sample))
+        {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = sample;
+    }
+    result->latencyP50 = percentile(samples, numSamples, 50);
+    result->latencyP99 = percentile(samples, numSamples, 99);
+    result->latencyMax = samples[numSamples - 1];
+}
+
+uint32_t TxBench_run(const TxBench_Params *params, TxBench_ResultFxn resultFxn)
+{
+    const PowerTable_Object *table = PowerTable_get(RADIO_SESSION_POWER_TABLE);
+    uint32_t numPoints = 0;
+    int8_t txPower = PowerTable_snap(table, params->minTxPower);
+    int8_t maxTxPower = PowerTable_snap(table, params->maxTxPower);
+
+    if ((params->minLength == 0) || (params->minLength > params->maxLength) ||
+        (params->maxLength > MAC_FRAME_MAX_LENGTH) || (params->lengthStep == 0))
+    {
+        return 0;
+    }
+
+    while (1)
+    {
+        RadioSession_setTxPower(txPower);
+
+        uint8_t mode;
+        for (mode = 0; mode < TX_BENCH_MODE_COUNT; mode++)
+        {
+            if (!(params->modeMask & (1 << mode)))
+            {
+                continue;
+            }
+
+            uint16_t length = params->minLength;
+            while (1)
+            {
+                TxBench_Result result;
+                TxBench_runPoint(params, mode, (uint8_t)length, &result);
+                numPoints++;
+                if (resultFxn != NULL)
+                {
+                    resultFxn(&result);
+                }
+
+                if (length == params->maxLength)
+                {
+                    break;
+                }
+                length += params->lengthStep;
+                if (length > params->maxLength)
+                {
+                    length = params->maxLength;
+                }
+            }
+        }
+
+        if (txPower >= maxTxPower)
+        {
+            break;
+        }
+        txPower = PowerTable_step(table, txPower, 1);
+    }
+
+    return numPoints;
+}
+
+int TxBench_formatHeader(char *buf, size_t size)
+{
+    return snprintf(buf, size, "mode,length,tx_dbm,frames,errors,elapsed_us,frames_per_s,"
+                               "airtime_permille,latency_p50_us,latency_p99_us,latency_max_us\n");
+}
+
+int TxBench_formatResult(const TxBench_Result *result, char *buf, size_t size)
+{
+    uint32_t elapsedUs = RF_convertRatTicksToUs(result->elapsedTicks);
+    uint32_t sent = result->numFrames - result->numErrors;
+
+    /* Tenths of frames per second, rounded */
+    uint32_t fps10 = (elapsedUs == 0) ? 0 :
+        (uint32_t)(((uint64_t)sent * 10000000 + elapsedUs / 2) / elapsedUs);
+    uint32_t permille = (result->elapsedTicks == 0) ? 0 :
+        (uint32_t)(((uint64_t)result->airTicks * 1000 + result->elapsedTicks / 2) / result->elapsedTicks);
+
+    return snprintf(buf, size, "%s,%u,%d,%u,%u,%lu,%lu.%lu,%lu,%lu,%lu,%lu\n",
+                    (result->mode < TX_BENCH_MODE_COUNT) ? modeNames[result->mode] : "?",
+                    result->length, result->txPower, result->numFrames, result->numErrors,
+                    (unsigned long)elapsedUs,
+                    (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10),
+                    (unsigned long)permille,
+                    (unsigned long)RF_convertRatTicksToUs(result->latencyP50),
+                    (unsigned long)RF_convertRatTicksToUs(result->latencyP99),
+                    (unsigned long)RF_convertRatTicksToUs(result->latencyMax));
+}
@@ -0,0 +1,105 @@
+/*
+ *  ======== txBench.h ========
+ *  TX throughput and latency benchmark.
+ *
+ *  Sends a fixed number of frames per point and sweeps frame length, TX
+ *  power and send mode: one blocking RF_runScheduleCmd() per frame, frames
+ *  posted through the TX queue, or chained bursts. Everything is measured
+ *  with the radio timer, so the same code gives comparable numbers on the
+ *  target and in the host simulation.
+ *
+ *  Per point it reports frames per second, the share of the elapsed time
+ *  the radio was actually sending, and the command latency, from handing a
+ *  frame to the RF driver to the frame starting on air. Elapsed time runs
+ *  from the first submission to the last completion. CMD_FS and radio
+ *  power-up are done before it starts, with one frame that is not counted.
+ */
+#ifndef TXBENCH_H_
+#define TXBENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "macFrame.h"
+#include "powerTable.h"
+
+/* Most frames measured per point, bounds the latency sample buffer */
+#ifndef TX_BENCH_MAX_FRAMES
+#define TX_BENCH_MAX_FRAMES     100
+#endif
+
+/* Send modes */
+#define TX_BENCH_MODE_BLOCKING  0
+#define TX_BENCH_MODE_POSTED    1
+#define TX_BENCH_MODE_CHAINED   2
+#define TX_BENCH_MODE_COUNT     3
+
+#define TX_BENCH_MODE_MASK_ALL  ((1 << TX_BENCH_MODE_COUNT) - 1)
+
+typedef struct
+{
+    uint8_t  modeMask;          /* 1 << TX_BENCH_MODE_* for every mode to run */
+    uint8_t  minLength;         /* Frame length without FCS, 1-125 */
+    uint8_t  maxLength;
+    uint8_t  lengthStep;        /* maxLength is always included */
+    int8_t   minTxPower;        /* dBm, every level of the table in between is run */
+    int8_t   maxTxPower;
+    uint16_t framesPerPoint;    /* Up to TX_BENCH_MAX_FRAMES */
+    const MacFrame_Template *frameTemplate;  /* Header for the frames, NULL for raw bytes */
+} TxBench_Params;
+
+typedef struct
+{
+    uint8_t  mode;              /* TX_BENCH_MODE_* */
+    uint8_t  length;            /* Frame length without FCS */
+    int8_t   txPower;           /* dBm actually set */
+    uint16_t numFrames;
+    uint16_t numErrors;         /* Frames that did not end with IEEE_DONE_OK */
+    uint32_t elapsedTicks;      /* RAT ticks, first submission to last completion */
+    uint32_t airTicks;          /* RAT ticks the frames were on air */
+    uint32_t latencyP50;        /* RAT ticks, submission to frame on air, frames without errors only, 0 if none */
+    uint32_t latencyP99;
+    uint32_t latencyMax;
+} TxBench_Result;
+
+/* Called after every point, e.g. to print it */
+typedef void (*TxBench_ResultFxn)(const TxBench_Result *result);
+
+/*
+ *  ======== TxBench_Params_init ========
+ *  All modes, frame lengths 1, 32, 63, 94 and 125, every level of
+ *  RADIO_SESSION_POWER_TABLE and 50 frames per point. The radio session
+ *  must be open.
+ */
+extern void TxBench_Params_init(TxBench_Params *params);
+
+/*
+ *  ======== TxBench_run ========
+ *  Runs the sweep on the radio session, TX power outermost so the PA is
+ *  switched as rarely as possible. Returns the number of points.
+ */
+extern uint32_t TxBench_run(const TxBench_Params *params, TxBench_ResultFxn resultFxn);
+
+/*
+ *  ======== TxBench_runPoint ========
+ *  Measures one point at the TX power currently set.
+ */
+extern void TxBench_runPoint(const TxBench_Params *params, uint8_t mode, uint8_t length,
+                             TxBench_Result *result);
+
+/*
+ *  ======== TxBench_formatHeader ========
+ *  Writes the CSV header line, including the newline. Returns the length
+ *  like snprintf().
+ */
+extern int TxBench_formatHeader(char *buf, size_t size);
+
+/*
+ *  ======== TxBench_formatResult ========
+ *  Writes one CSV line: mode, length, tx_dbm, frames, errors, elapsed_us,
+ *  frames_per_s, airtime_permille, latency_p50_us, latency_p99_us,
+ *  latency_max_us. Integer arithmetic only.
+ */
+extern int TxBench_formatResult(const TxBench_Result *result, char *buf, size_t size);
+
+#endif /* TXBENCH_H_ */
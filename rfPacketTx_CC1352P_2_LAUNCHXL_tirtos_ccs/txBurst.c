@@ -0,0 +1,210 @@
+/*
+ *  ======== txBurst.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+
+#include "txBurst.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Function definitions *****/
+
+void TxBurst_init(TxBurst_Object *burst)
+{
+    burst->numFrames = 0;
+}
+
+uint8_t *TxBurst_addFrame(TxBurst_Object *burst, uint8_t payloadLen)
+{
+    if ((burst->numFrames >= TX_BURST_MAX_FRAMES) ||
+        (payloadLen == 0) || (payloadLen > TX_BURST_MAX_PAYLOAD_LENGTH))
+    {
+        return NULL;
+    }
+
+    uint8_t idx = burst->numFrames++;
+    rfc_CMD_IEEE_TX_t *cmd = &burst->cmd[idx];
+
+    burst->channel[idx] = 0;
+    burst->hop[idx] = false;
+
+    /* Start from the exported SmartRF Studio settings */
+    *cmd = RF_cmdIeeeTx_ieee154;
+    cmd->payloadLen = payloadLen;
+    cmd->pPayload = burst->payload[idx];
+    cmd->startTrigger.triggerType = TRIG_NOW;
+
+    return burst->payload[idx];
+}
+
+void TxBurst_setFrameChannel(TxBurst_Object *burst, uint8_t frameIdx, uint8_t channel)
+{
+    if ((frameIdx < burst->numFrames) && (RadioSession_getFsCmd(channel) != NULL))
+    {
+        burst->channel[frameIdx] = channel;
+    }
+}
+
+RF_EventMask TxBurst_send(TxBurst_Object *burst, RF_Handle rfHandle,
+                          RF_ScheduleCmdParams *scheduleParams)
+{
+    uint8_t i;
+    uint8_t channel = burst->channel[0];
+    rfc_CMD_IEEE_TX_t *prev = NULL;
+
+    if (burst->numFrames == 0)
+    {
+        return RF_EventLastCmdDone;
+    }
+
+    for (i = 0; i < burst->numFrames; i++)
+    {
+        rfc_CMD_IEEE_TX_t *cmd = &burst->cmd[i];
+        RF_Op *first = (RF_Op*)cmd;
+
+        cmd->status = IDLE;
+        cmd->pNextOp = NULL;
+        cmd->condition.rule = COND_NEVER;
+
+        burst->hop[i] = (i > 0) && (burst->channel[i] != 0) && (burst->channel[i] != channel);
+        if (burst->hop[i])
+        {
+            /* Retune right after the frame before, from the precomputed entry */
+            rfc_CMD_FS_t *fs = &burst->fs[i];
+            *fs = *RadioSession_getFsCmd(burst->channel[i]);
+            fs->status = IDLE;
+            fs->startTrigger.triggerType = TRIG_NOW;
+            fs->condition.rule = COND_STOP_ON_FALSE;
+            fs->pNextOp = (uint8_t *)cmd;
+            first = (RF_Op*)fs;
+            channel = burst->channel[i];
+        }
+
+        if (prev != NULL)
+        {
+            /* Only continue with the next frame if this one went out */
+            prev->pNextOp = (uint8_t *)first;
+            prev->condition.rule = COND_STOP_ON_FALSE;
+        }
+        prev = cmd;
+    }
+
+    uint32_t postTime = RF_getCurrentTime();
+    RF_EventMask terminationReason = RF_runScheduleCmd(rfHandle, (RF_Op*)&burst->cmd[0],
+                                                       scheduleParams, NULL, 0);
+    uint32_t endTime = RF_getCurrentTime();
+
+    /* The driver only reports the end of the whole chain */
+    for (i = 0; i < burst->numFrames; i++)
+    {
+        if (burst->hop[i])
+        {
+            if (((volatile RF_Op*)&burst->fs[i])->status == IDLE)
+            {
+                break;
+            }
+            RadioTrace_setChannel(burst->channel[i]);
+            RadioTrace_add((RF_Op*)&burst->fs[i], postTime, RADIO_TRACE_NO_TIME, endTime);
+        }
+
+        uint16_t status = TxBurst_getFrameStatus(burst, i);
+        if (status == IDLE)
+        {
+            break;
+        }
+        RadioTrace_add((RF_Op*)&burst->cmd[i], postTime,
+                       (status == IEEE_DONE_OK) ? burst->cmd[i].timeStamp : RADIO_TRACE_NO_TIME,
+                       endTime);
+        RadioSession_addAirTime(&burst->cmd[i]);
+    }
+
+    return terminationReason;
+}
+
+uint16_t TxBurst_getFrameStatus(TxBurst_Object *burst, uint8_t frameIdx)
+{
+    if (frameIdx >= burst->numFrames)
+    {
+        return IDLE;
+    }
+
+    return ((volatile RF_Op*)&burst->cmd[frameIdx])->status;
+}
+
+uint32_t TxBurst_getFrameTimeStamp(TxBurst_Object *burst, uint8_t frameIdx)
+{
+    if (frameIdx >= burst->numFrames)
+    {
+        return 0;
+    }
+
+    return burst->cmd[frameIdx].timeStamp;
+}
+
+uint8_t TxBurst_getFrameChannel(TxBurst_Object *burst, uint8_t frameIdx)
+{
+    uint8_t i;
+    uint8_t channel = 0;
+
+    for (i = 0; (i <= frameIdx) && (i < burst->numFrames); i++)
+    {
+        if ((i == 0) || burst->hop[i])
+        {
+            channel = burst->channel[i];
+        }
+    }
+
+    return channel;
+}
+
+bool TxBurst_isHop(TxBurst_Object *burst, uint8_t frameIdx)
+{
+    if ((frameIdx >= burst->numFrames) || !burst->hop[frameIdx])
+    {
+        return false;
+    }
+
+    return ((volatile RF_Op*)&burst->fs[frameIdx])->status == DONE_OK;
+}
+
+uint8_t TxBurst_getTunedChannel(TxBurst_Object *burst)
+{
+    uint8_t i;
+    uint8_t channel = (burst->numFrames > 0) ? burst->channel[0] : 0;
+
+    for (i = 1; i < burst->numFrames; i++)
+    {
+        if (burst->hop[i])
+        {
+            uint16_t status = ((volatile RF_Op*)&burst->fs[i])->status;
+            if (status == IDLE)
+            {
+                break;
+            }
+            channel = (status == DONE_OK) ? burst->channel[i] : 0;
+        }
+    }
+
+    return channel;
+}
+
+uint8_t TxBurst_getNumSent(TxBurst_Object *burst)
+{
+    uint8_t i;
+    uint8_t numSent = 0;
+
+    for (i = 0; i < burst->numFrames; i++)
+    {
+        if (TxBurst_getFrameStatus(burst, i) == IEEE_DONE_OK)
+        {
+            numSent++;
+        }
+    }
+
+    return numSent;
+}
@@ -0,0 +1,119 @@
+/*
+ *  ======== txBurst.h ========
+ *  Chained multi-frame IEEE 802.15.4 transmission.
+ *
+ *  A burst is a linked list of CMD_IEEE_TX commands, each with its own
+ *  payload buffer, that is handed to the RF driver in a single call. The
+ *  radio core walks the chain through pNextOp without returning to the
+ *  MCU between frames, so frames go out back-to-back instead of paying the
+ *  command scheduling and radio power-up cost once per frame.
+ *
+ *  Frames can be given their own channel. A copy of the session's
+ *  precomputed CMD_FS is then chained in front of every frame whose channel
+ *  differs from the one before it, so the burst hops without returning to
+ *  the MCU either.
+ */
+#ifndef TXBURST_H_
+#define TXBURST_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_common_cmd.h)
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Maximum number of frames in one burst */
+#ifndef TX_BURST_MAX_FRAMES
+#define TX_BURST_MAX_FRAMES         10
+#endif
+
+/* Maximum MAC payload per frame: aMaxPHYPacketSize (127) minus the 2 byte FCS */
+#ifndef TX_BURST_MAX_PAYLOAD_LENGTH
+#define TX_BURST_MAX_PAYLOAD_LENGTH 125
+#endif
+
+typedef struct
+{
+    rfc_CMD_IEEE_TX_t cmd[TX_BURST_MAX_FRAMES];
+    rfc_CMD_FS_t fs[TX_BURST_MAX_FRAMES];       /* Retune in front of frame i, if hop[i] */
+    uint8_t payload[TX_BURST_MAX_FRAMES][TX_BURST_MAX_PAYLOAD_LENGTH];
+    uint8_t channel[TX_BURST_MAX_FRAMES];       /* 0: channel of the frame before */
+    bool hop[TX_BURST_MAX_FRAMES];
+    uint8_t numFrames;
+} TxBurst_Object;
+
+/*
+ *  ======== TxBurst_init ========
+ *  Empties the burst. Must be called before the first TxBurst_addFrame().
+ */
+extern void TxBurst_init(TxBurst_Object *burst);
+
+/*
+ *  ======== TxBurst_addFrame ========
+ *  Appends a frame of payloadLen bytes to the burst and returns its payload
+ *  buffer for the caller to fill. Returns NULL if the burst is full or
+ *  payloadLen is out of range.
+ */
+extern uint8_t *TxBurst_addFrame(TxBurst_Object *burst, uint8_t payloadLen);
+
+/*
+ *  ======== TxBurst_setFrameChannel ========
+ *  Sends frame frameIdx on an IEEE 802.15.4 channel (11-26). The first
+ *  frame goes out on the channel the synthesizer is on, its channel only
+ *  tells TxBurst_send() whether the second frame needs a CMD_FS.
+ */
+extern void TxBurst_setFrameChannel(TxBurst_Object *burst, uint8_t frameIdx, uint8_t channel);
+
+/*
+ *  ======== TxBurst_send ========
+ *  Links the queued frames into one command chain and runs it. Each frame
+ *  only starts if the previous one ended with IEEE_DONE_OK, so a failure
+ *  stops the rest of the burst. Returns the RF driver termination reason.
+ */
+extern RF_EventMask TxBurst_send(TxBurst_Object *burst, RF_Handle rfHandle,
+                                 RF_ScheduleCmdParams *scheduleParams);
+
+/*
+ *  ======== TxBurst_getFrameStatus ========
+ *  Returns the radio command status of frame frameIdx after TxBurst_send().
+ *  Frames that were never started report IDLE.
+ */
+extern uint16_t TxBurst_getFrameStatus(TxBurst_Object *burst, uint8_t frameIdx);
+
+/*
+ *  ======== TxBurst_getFrameTimeStamp ========
+ *  Returns the RAT time at which frame frameIdx started on air.
+ */
+extern uint32_t TxBurst_getFrameTimeStamp(TxBurst_Object *burst, uint8_t frameIdx);
+
+/*
+ *  ======== TxBurst_getFrameChannel ========
+ *  Returns the channel frame frameIdx was sent on, 0 if no frame up to it
+ *  had a channel set.
+ */
+extern uint8_t TxBurst_getFrameChannel(TxBurst_Object *burst, uint8_t frameIdx);
+
+/*
+ *  ======== TxBurst_isHop ========
+ *  Tells whether a CMD_FS ran in front of frame frameIdx and succeeded.
+ */
+extern bool TxBurst_isHop(TxBurst_Object *burst, uint8_t frameIdx);
+
+/*
+ *  ======== TxBurst_getTunedChannel ========
+ *  Returns the channel the burst left the synthesizer on after
+ *  TxBurst_send(), 0 if a CMD_FS of the burst failed.
+ */
+extern uint8_t TxBurst_getTunedChannel(TxBurst_Object *burst);
+
+/*
+ *  ======== TxBurst_getNumSent ========
+ *  Returns the number of frames that completed with IEEE_DONE_OK.
+ */
+extern uint8_t TxBurst_getNumSent(TxBurst_Object *burst);
+
+#endif /* TXBURST_H_ */
@@ -0,0 +1,236 @@
+/*
+ *  ======== txPipe.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "txPipe.h"
+#include "macFrame.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* TI Drivers */
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+#define NUM_BUFFERS             2
+
+/***** Type declarations *****/
+typedef struct
+{
+    rfc_CMD_IEEE_TX_t cmd;
+    uint32_t postTime;
+    uint32_t doneTime;
+    RF_EventMask events;
+    uint8_t psdu[MAC_FRAME_MAX_LENGTH];
+} TxPipe_Buffer;
+
+/***** Prototypes *****/
+static void pipeCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+static void waitDone(uint32_t count);
+static void finishFrame(const TxPipe_Params *params, uint32_t index);
+
+/***** Variable declarations *****/
+static TxPipe_Buffer buffers[NUM_BUFFERS];
+
+/* Frames of the current run whose command has ended, only written by the
+ * RF callback */
+static volatile uint32_t numDone;
+
+static SemaphoreP_Struct doneSemStruct;
+static SemaphoreP_Handle doneSem;
+
+/* State of the current run */
+static TxPipe_Result runResult;
+static RF_EventMask runEvents;
+static bool prevSent;
+static uint32_t prevEnd;
+
+/***** Function definitions *****/
+
+static void pipeCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    /* The RF driver runs the commands of one client in order, so this is
+     * always the older of the two buffers */
+    TxPipe_Buffer *buf = &buffers[numDone % NUM_BUFFERS];
+
+    buf->doneTime = RF_getCurrentTime();
+    buf->events = e;
+
+    /* Hand the buffer back to the builder */
+    numDone++;
+    SemaphoreP_post(doneSem);
+}
+
+static void waitDone(uint32_t count)
+{
+    while ((int32_t)(numDone - count) < 0)
+    {
+        SemaphoreP_pend(doneSem, SemaphoreP_WAIT_FOREVER);
+    }
+}
+
+/* Collects the outcome of an ended frame before its buffer is reused */
+static void finishFrame(const TxPipe_Params *params, uint32_t index)
+{
+    TxPipe_Buffer *buf = &buffers[index % NUM_BUFFERS];
+    uint16_t status = ((volatile RF_Op*)&buf->cmd)->status;
+    bool sent = (status == IEEE_DONE_OK);
+
+    RadioTrace_add((RF_Op*)&buf->cmd, buf->postTime,
+                   sent ? buf->cmd.timeStamp : RADIO_TRACE_NO_TIME, buf->doneTime);
+    RadioSession_addAirTime(&buf->cmd);
+
+    /* The last frame, or the first that failed */
+    if (runResult.numErrors == 0)
+    {
+        runEvents = buf->events;
+    }
+
+    if (!sent)
+    {
+        runResult.numErrors++;
+    }
+    else
+    {
+        if (index == 0)
+        {
+            runResult.firstTimeStamp = buf->cmd.timeStamp;
+        }
+        if (prevSent)
+        {
+            uint32_t gap = buf->cmd.timeStamp - prevEnd;
+            if (gap < runResult.minGap)
+            {
+                runResult.minGap = gap;
+            }
+            if (gap > runResult.maxGap)
+            {
+                runResult.maxGap = gap;
+            }
+            runResult.totalGap += gap;
+            runResult.numGaps++;
+        }
+        prevEnd = buf->cmd.timeStamp + RF_convertUsToRatTicks(MAC_FRAME_AIR_US(buf->cmd.payloadLen));
+    }
+    prevSent = sent;
+
+    if (params->done != NULL)
+    {
+        params->done(index, status, buf->cmd.timeStamp, params->arg);
+    }
+}
+
+void TxPipe_Params_init(TxPipe_Params *params)
+{
+    params->build = NULL;
+    params->done = NULL;
+    params->arg = NULL;
+    params->overlap = true;
+}
+
+RF_EventMask TxPipe_send(RF_Handle rfHandle, const TxPipe_Params *params,
+                         uint32_t numFrames, TxPipe_Result *result)
+{
+    /* Frames that may be posted but not yet ended while the next is built */
+    const uint32_t ahead = params->overlap ? NUM_BUFFERS - 1 : 0;
+    uint32_t numPosted = 0;
+    uint32_t numFinished = 0;
+
+    if (doneSem == NULL)
+    {
+        doneSem = SemaphoreP_constructBinary(&doneSemStruct, 0);
+    }
+
+    memset(&runResult, 0, sizeof(runResult));
+    runResult.minGap = UINT32_MAX;
+    runEvents = RF_EventLastCmdDone;
+    prevSent = false;
+    numDone = 0;
+
+    while (numPosted < numFrames)
+    {
+        /* Wait for a free buffer and collect the frame it held */
+        waitDone(numPosted - ahead);
+        while (numFinished + ahead < numPosted)
+        {
+            finishFrame(params, numFinished++);
+        }
+
+        TxPipe_Buffer *buf = &buffers[numPosted % NUM_BUFFERS];
+
+        uint8_t *psdu = buf->psdu;
+        uint32_t buildStart = RF_getCurrentTime();
+        uint8_t length = params->build(&psdu, numPosted, params->arg);
+        uint32_t buildTicks = RF_getCurrentTime() - buildStart;
+        if (buildTicks > runResult.maxBuildTicks)
+        {
+            runResult.maxBuildTicks = buildTicks;
+        }
+        runResult.totalBuildTicks += buildTicks;
+
+        /* Start from the exported SmartRF Studio settings */
+        buf->cmd = RF_cmdIeeeTx_ieee154;
+        buf->cmd.payloadLen = length;
+        buf->cmd.pPayload = psdu;
+        buf->cmd.startTrigger.triggerType = TRIG_NOW;
+        buf->cmd.pNextOp = NULL;
+        buf->cmd.condition.rule = COND_NEVER;
+
+        /* Nothing in flight: the radio has been waiting for this frame */
+        if ((numPosted > 0) && (numDone == numPosted))
+        {
+            runResult.numStalls++;
+        }
+
+        buf->postTime = RF_getCurrentTime();
+        if (RF_postCmd(rfHandle, (RF_Op*)&buf->cmd, RF_PriorityNormal, pipeCallback, 0) < 0)
+        {
+            if (runResult.numErrors == 0)
+            {
+                runEvents = RF_EventError;
+            }
+            runResult.numErrors++;
+            break;
+        }
+        numPosted++;
+        runResult.numFrames++;
+    }
+
+    waitDone(numPosted);
+    while (numFinished < numPosted)
+    {
+        finishFrame(params, numFinished++);
+    }
+
+    if (result != NULL)
+    {
+        *result = runResult;
+    }
+
+    return runEvents;
+}
+
+int TxPipe_formatResult(const TxPipe_Result *result, char *buf, size_t size)
+{
+    uint32_t avgGap = (result->numGaps > 0) ? result->totalGap / result->numGaps : 0;
+    uint32_t avgBuild = (result->numFrames > 0) ? result->totalBuildTicks / result->numFrames : 0;
+
+    return snprintf(buf, size, "# frames %lu, errors %lu, stalls %lu, gap %lu/%lu/%lu us, build %lu/%lu us\n",
+                    (unsigned long)result->numFrames, (unsigned long)result->numErrors,
+                    (unsigned long)result->numStalls,
+                    (unsigned long)RF_convertRatTicksToUs((result->numGaps > 0) ? result->minGap : 0),
+                    (unsigned long)RF_convertRatTicksToUs(avgGap),
+                    (unsigned long)RF_convertRatTicksToUs(result->maxGap),
+                    (unsigned long)RF_convertRatTicksToUs(avgBuild),
+                    (unsigned long)RF_convertRatTicksToUs(result->maxBuildTicks));
+}
@@ -0,0 +1,81 @@
+/*
+ *  ======== txPipe.h ========
+ *  Double buffered IEEE 802.15.4 sender.
+ *
+ *  Two buffers, each with its own CMD_IEEE_TX, take turns: while the
+ *  frame in one is on air, the build function writes the next frame into
+ *  the other and it is posted right away, so the RF driver starts it as
+ *  soon as the radio is free. The command done callback hands the sent
+ *  buffer back for the frame after that. Building a frame is off the path
+ *  between frames as long as it takes less than a frame on air.
+ *
+ *  The gap between frames is measured from the frame timestamps, end of
+ *  one frame on air to the start of the next, together with the time each
+ *  build took and the number of stalls: frames posted only after the one
+ *  before had ended, which leaves the radio idle while the MCU catches up.
+ */
+#ifndef TXPIPE_H_
+#define TXPIPE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Builds frame index of the run into *psdu (MAC header and payload, no FCS)
+ * and returns its length, 1-125. A frame that is already built can be sent
+ * from where it is by pointing *psdu to it instead; it must stay unchanged
+ * until the frame has ended. */
+typedef uint8_t (*TxPipe_BuildFxn)(uint8_t **psdu, uint32_t index, void *arg);
+
+/* Called in order for every frame that has ended, from TxPipe_send(),
+ * with the CMD_IEEE_TX status and the RAT time it started on air */
+typedef void (*TxPipe_DoneFxn)(uint32_t index, uint16_t status, uint32_t timeStamp, void *arg);
+
+typedef struct
+{
+    TxPipe_BuildFxn build;
+    TxPipe_DoneFxn done;        /* May be NULL */
+    void *arg;                  /* Passed to build and done */
+    bool overlap;               /* false to build each frame after the one before has ended */
+} TxPipe_Params;
+
+typedef struct
+{
+    uint32_t numFrames;         /* Frames posted */
+    uint32_t numErrors;         /* Frames that did not end with IEEE_DONE_OK */
+    uint32_t numStalls;         /* Frames posted after the frame before had ended */
+    uint32_t numGaps;           /* Gaps between two frames sent without error */
+    uint32_t firstTimeStamp;    /* RAT time the first frame started on air */
+    uint32_t minGap;            /* RAT ticks, end of a frame on air to the start of the next */
+    uint32_t maxGap;
+    uint32_t totalGap;
+    uint32_t maxBuildTicks;     /* RAT ticks in the build function per frame */
+    uint32_t totalBuildTicks;
+} TxPipe_Result;
+
+/*
+ *  ======== TxPipe_Params_init ========
+ *  No build or done function, overlapping.
+ */
+extern void TxPipe_Params_init(TxPipe_Params *params);
+
+/*
+ *  ======== TxPipe_send ========
+ *  Builds and sends numFrames frames on the tuned radio and blocks until
+ *  the last has ended. result may be NULL. Returns the RF driver
+ *  termination reason of the first frame that failed, or of the last.
+ */
+extern RF_EventMask TxPipe_send(RF_Handle rfHandle, const TxPipe_Params *params,
+                                uint32_t numFrames, TxPipe_Result *result);
+
+/*
+ *  ======== TxPipe_formatResult ========
+ *  Writes one line: frames, errors, stalls, the min/avg/max gap and the
+ *  avg/max build time in us. Returns the length like snprintf().
+ */
+extern int TxPipe_formatResult(const TxPipe_Result *result, char *buf, size_t size);
+
+#endif /* TXPIPE_H_ */
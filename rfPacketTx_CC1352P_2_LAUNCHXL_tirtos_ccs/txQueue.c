@@ -0,0 +1,177 @@
+/*
+ *  ======== txQueue.c ========
+ */
+
+/***** Includes *****/
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "txQueue.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* TI Drivers */
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Type declarations *****/
+typedef struct
+{
+    rfc_CMD_IEEE_TX_t cmd;
+    RF_CmdHandle cmdHandle;
+    uint32_t submitTime;
+    void *arg;
+    uint8_t payload[TX_QUEUE_MAX_PAYLOAD_LENGTH];
+} TxQueue_Slot;
+
+/***** Prototypes *****/
+static void txQueueCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+/***** Variable declarations *****/
+static TxQueue_Slot slots[TX_QUEUE_DEPTH];
+
+/* Free running counters: head is only written by TxQueue_submit(), tail
+ * only by the RF callback, so the ring needs no lock */
+static volatile uint32_t head;
+static volatile uint32_t tail;
+
+static RF_Handle rfHandle;
+static TxQueue_Callback userCallback;
+static TxQueue_Stats stats;
+
+static SemaphoreP_Struct emptySemStruct;
+static SemaphoreP_Handle emptySem;
+
+/***** Function definitions *****/
+
+static void txQueueCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    /* The RF driver runs the commands of one client in order, so the
+     * completed command is always the oldest one in flight */
+    TxQueue_Slot *slot = &slots[tail % TX_QUEUE_DEPTH];
+    TxQueue_Completion completion;
+
+    completion.status = ((volatile RF_Op*)&slot->cmd)->status;
+    completion.events = e;
+    completion.submitTime = slot->submitTime;
+    completion.timeStamp = slot->cmd.timeStamp;
+    completion.doneTime = RF_getCurrentTime();
+    completion.arg = slot->arg;
+
+    RadioTrace_add((RF_Op*)&slot->cmd, completion.submitTime,
+                   (completion.status == IEEE_DONE_OK) ? completion.timeStamp : RADIO_TRACE_NO_TIME,
+                   completion.doneTime);
+    RadioSession_addAirTime(&slot->cmd);
+
+    uint32_t latency = completion.doneTime - completion.submitTime;
+    if (latency < stats.minLatency)
+    {
+        stats.minLatency = latency;
+    }
+    if (latency > stats.maxLatency)
+    {
+        stats.maxLatency = latency;
+    }
+    stats.totalLatency += latency;
+    stats.numCompleted++;
+
+    /* Release the slot before the user callback so it can submit again */
+    tail++;
+
+    if (userCallback != NULL)
+    {
+        userCallback(&completion);
+    }
+
+    if (tail == head)
+    {
+        SemaphoreP_post(emptySem);
+    }
+}
+
+void TxQueue_init(RF_Handle handle, TxQueue_Callback callback)
+{
+    if (emptySem == NULL)
+    {
+        emptySem = SemaphoreP_constructBinary(&emptySemStruct, 0);
+    }
+
+    rfHandle = handle;
+    userCallback = callback;
+    head = 0;
+    tail = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.minLatency = UINT32_MAX;
+}
+
+int_fast8_t TxQueue_submit(const uint8_t *payload, uint8_t payloadLen, void *arg)
+{
+    if ((payloadLen == 0) || (payloadLen > TX_QUEUE_MAX_PAYLOAD_LENGTH))
+    {
+        stats.numErrors++;
+        return TX_QUEUE_STATUS_ERROR;
+    }
+
+    uint32_t occupancy = head - tail;
+    if (occupancy >= TX_QUEUE_DEPTH)
+    {
+        stats.numDropped++;
+        return TX_QUEUE_STATUS_FULL;
+    }
+
+    TxQueue_Slot *slot = &slots[head % TX_QUEUE_DEPTH];
+
+    /* Start from the exported SmartRF Studio settings */
+    slot->cmd = RF_cmdIeeeTx_ieee154;
+    slot->cmd.payloadLen = payloadLen;
+    slot->cmd.pPayload = slot->payload;
+    slot->cmd.startTrigger.triggerType = TRIG_NOW;
+    slot->cmd.pNextOp = NULL;
+    slot->cmd.condition.rule = COND_NEVER;
+    memcpy(slot->payload, payload, payloadLen);
+
+    slot->arg = arg;
+    slot->submitTime = RF_getCurrentTime();
+
+    /* The slot must be visible to the callback before the command runs */
+    head++;
+    occupancy++;
+
+    slot->cmdHandle = RF_postCmd(rfHandle, (RF_Op*)&slot->cmd, RF_PriorityNormal, txQueueCallback, 0);
+    if (slot->cmdHandle < 0)
+    {
+        /* Nothing was queued behind this slot, so it can be taken back */
+        head--;
+        stats.numErrors++;
+        return TX_QUEUE_STATUS_ERROR;
+    }
+
+    stats.numSubmitted++;
+    if (occupancy > stats.maxOccupancy)
+    {
+        stats.maxOccupancy = (uint8_t)occupancy;
+    }
+
+    return TX_QUEUE_STATUS_SUCCESS;
+}
+
+void TxQueue_waitEmpty(void)
+{
+    while (tail != head)
+    {
+        SemaphoreP_pend(emptySem, SemaphoreP_WAIT_FOREVER);
+    }
+}
+
+void TxQueue_getStats(TxQueue_Stats *pStats)
+{
+    *pStats = stats;
+    pStats->occupancy = (uint8_t)(head - tail);
+}
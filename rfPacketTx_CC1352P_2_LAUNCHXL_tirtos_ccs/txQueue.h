@@ -0,0 +1,86 @@
+/*
+ *  ======== txQueue.h ========
+ *  Non-blocking IEEE 802.15.4 transmit queue.
+ *
+ *  Frames are copied into a bounded ring of slots, each with its own
+ *  CMD_IEEE_TX command and payload buffer, and posted to the RF driver
+ *  with RF_postCmd(). TxQueue_submit() never waits for the radio; the
+ *  completion of every frame is reported through a callback that runs in
+ *  the RF driver callback (SWI) context.
+ *
+ *  TxQueue_submit() must only be called from one thread at a time.
+ */
+#ifndef TXQUEUE_H_
+#define TXQUEUE_H_
+
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Number of frames that can be in flight. The RF driver queues at most 8
+ * commands per client, so this must not be larger than that. */
+#ifndef TX_QUEUE_DEPTH
+#define TX_QUEUE_DEPTH              4
+#endif
+
+/* Maximum MAC payload per frame: aMaxPHYPacketSize (127) minus the 2 byte FCS */
+#ifndef TX_QUEUE_MAX_PAYLOAD_LENGTH
+#define TX_QUEUE_MAX_PAYLOAD_LENGTH 125
+#endif
+
+/* TxQueue_submit() return values */
+#define TX_QUEUE_STATUS_SUCCESS     (0)
+#define TX_QUEUE_STATUS_FULL        (-1)  /* All slots in flight, frame dropped */
+#define TX_QUEUE_STATUS_ERROR       (-2)  /* Invalid length or RF_postCmd() failed */
+
+typedef struct
+{
+    uint16_t status;        /* CMD_IEEE_TX status, IEEE_DONE_OK on success */
+    RF_EventMask events;    /* Events the RF driver reported for the command */
+    uint32_t submitTime;    /* RAT time when the frame was submitted */
+    uint32_t timeStamp;     /* RAT time when the frame started on air */
+    uint32_t doneTime;      /* RAT time when the completion was handled */
+    void *arg;              /* Argument given to TxQueue_submit() */
+} TxQueue_Completion;
+
+typedef void (*TxQueue_Callback)(const TxQueue_Completion *completion);
+
+typedef struct
+{
+    uint8_t  occupancy;         /* Frames currently in flight */
+    uint8_t  maxOccupancy;      /* High-watermark of occupancy */
+    uint32_t numSubmitted;
+    uint32_t numCompleted;
+    uint32_t numDropped;        /* Submits rejected because the queue was full */
+    uint32_t numErrors;         /* Submits rejected by RF_postCmd() */
+    uint32_t minLatency;        /* Submit to completion, in RAT ticks */
+    uint32_t maxLatency;
+    uint32_t totalLatency;      /* Sum over numCompleted frames */
+} TxQueue_Stats;
+
+/*
+ *  ======== TxQueue_init ========
+ *  Resets the queue and its statistics. callback may be NULL.
+ */
+extern void TxQueue_init(RF_Handle rfHandle, TxQueue_Callback callback);
+
+/*
+ *  ======== TxQueue_submit ========
+ *  Copies payloadLen bytes into a free slot and posts it. Returns
+ *  TX_QUEUE_STATUS_FULL without waiting if no slot is free.
+ */
+extern int_fast8_t TxQueue_submit(const uint8_t *payload, uint8_t payloadLen, void *arg);
+
+/*
+ *  ======== TxQueue_waitEmpty ========
+ *  Blocks until all submitted frames have completed.
+ */
+extern void TxQueue_waitEmpty(void);
+
+/*
+ *  ======== TxQueue_getStats ========
+ */
+extern void TxQueue_getStats(TxQueue_Stats *stats);
+
+#endif /* TXQUEUE_H_ */
@@ -0,0 +1,282 @@
+/*
+ *  ======== txSweep.c ========
+ */
+
+/***** Includes *****/
+#include <stdio.h>
+#include <string.h>
+
+#include "txSweep.h"
+#include "powerTable.h"
+#include "radioSession.h"
+#include "txBurst.h"
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+
+/* Sequence number, level and channel at the start of every payload */
+#define STAMP_LENGTH            4
+
+/***** Prototypes *****/
+static bool addStep(TxSweep_Step *steps, uint16_t *numSteps, uint16_t maxSteps,
+                    int8_t txPower, uint8_t channel);
+static void fillFrame(const TxSweep_Params *params, const TxSweep_Step *step, uint8_t *buf);
+
+/***** Variable declarations *****/
+static TxSweep_Step plan[TX_SWEEP_MAX_STEPS];
+static TxBurst_Object txBurst;
+static uint16_t seqNumber;
+
+/***** Function definitions *****/
+
+static bool addStep(TxSweep_Step *steps, uint16_t *numSteps, uint16_t maxSteps,
+                    int8_t txPower, uint8_t channel)
+{
+    uint16_t i;
+
+    /* Levels the table lacks snap to a neighbour that may be listed too */
+    for (i = 0; i < *numSteps; i++)
+    {
+        if ((steps[i].txPower == txPower) && (steps[i].channel == channel))
+        {
+            return true;
+        }
+    }
+    if (*numSteps >= maxSteps)
+    {
+        return false;
+    }
+
+    steps[*numSteps].txPower = txPower;
+    steps[*numSteps].channel = channel;
+    (*numSteps)++;
+    return true;
+}
+
+static void fillFrame(const TxSweep_Params *params, const TxSweep_Step *step, uint8_t *buf)
+{
+    uint8_t *payload = MacFrame_writeHeader(params->frameTemplate, (uint8_t)seqNumber, buf);
+    uint8_t payloadLen = params->frameLength - params->frameTemplate->hdrLen;
+    uint8_t i;
+
+    payload[0] = (uint8_t)(seqNumber >> 8);
+    payload[1] = (uint8_t)seqNumber;
+    payload[2] = (uint8_t)step->txPower;
+    payload[3] = step->channel;
+    for (i = STAMP_LENGTH; i < payloadLen; i++)
+    {
+        payload[i] = (uint8_t)step->txPower;
+    }
+
+    seqNumber++;
+}
+
+void TxSweep_Params_init(TxSweep_Params *params)
+{
+    params->txPowers = NULL;
+    params->numTxPowers = 0;
+    params->channels = NULL;
+    params->numChannels = 0;
+    params->framesPerStep = 10;
+    params->frameLength = 30;
+    params->frameTemplate = NULL;
+    params->reorder = true;
+}
+
+uint16_t TxSweep_plan(const TxSweep_Params *params, TxSweep_Step *steps, uint16_t maxSteps)
+{
+    const PowerTable_Object *table = PowerTable_get(RADIO_SESSION_POWER_TABLE);
+    uint16_t numSteps = 0;
+    uint8_t p;
+    uint8_t c;
+
+    if ((params->numTxPowers == 0) || (params->numChannels == 0) || (params->framesPerStep == 0) ||
+        (params->frameTemplate == NULL) || (params->frameLength > MAC_FRAME_MAX_LENGTH) ||
+        (params->frameLength < params->frameTemplate->hdrLen + STAMP_LENGTH))
+    {
+        return 0;
+    }
+    for (c = 0; c < params->numChannels; c++)
+    {
+        if (RadioSession_getFsCmd(params->channels[c]) == NULL)
+        {
+            return 0;
+        }
+    }
+
+    if (!params->reorder)
+    {
+        /* As listed: every channel at a level, level by level */
+        for (p = 0; p < params->numTxPowers; p++)
+        {
+            for (c = 0; c < params->numChannels; c++)
+            {
+                if (!addStep(steps, &numSteps, maxSteps,
+                             PowerTable_snap(table, params->txPowers[p]), params->channels[c]))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Start with the PA that is in use, so the first step does not switch */
+        int8_t current = RadioSession_getTxPower();
+        uint8_t firstPa = PowerTable_lookup(table, (current != RF_TxPowerTable_INVALID_DBM) ?
+                                                   current : params->txPowers[0])->value.paType;
+        uint8_t pass;
+
+        for (pass = 0; pass < 2; pass++)
+        {
+            for (c = 0; c < params->numChannels; c++)
+            {
+                /* The second PA walks the channels backwards: it starts on
+                 * the channel the first one ended on */
+                uint8_t channel = params->channels[(pass == 0) ? c : (params->numChannels - 1 - c)];
+
+                for (p = 0; p < params->numTxPowers; p++)
+                {
+                    const RF_TxPowerTable_Entry *entry = PowerTable_lookup(table, params->txPowers[p]);
+                    if (((entry->value.paType == firstPa) == (pass == 0)) &&
+                        !addStep(steps, &numSteps, maxSteps, entry->power, channel))
+                    {
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Mark the PA switches, relative to the level set now */
+    int8_t prevPower = RadioSession_getTxPower();
+    uint16_t i;
+    for (i = 0; i < numSteps; i++)
+    {
+        PowerTable_Change change;
+        PowerTable_plan(table, prevPower, steps[i].txPower, &change);
+        steps[i].paSwitch = change.paSwitch;
+        prevPower = steps[i].txPower;
+    }
+
+    return numSteps;
+}
+
+bool TxSweep_run(const TxSweep_Params *params, TxSweep_StepFxn stepFxn, TxSweep_Result *result)
+{
+    RF_ScheduleCmdParams scheduleParams;
+    RadioSession_Stats before;
+    RadioSession_Stats after;
+    uint32_t callbackTicks = 0;
+    uint16_t i;
+
+    memset(result, 0, sizeof(*result));
+
+    uint16_t numSteps = TxSweep_plan(params, plan, TX_SWEEP_MAX_STEPS);
+    if (numSteps == 0)
+    {
+        return false;
+    }
+
+    RF_ScheduleCmdParams_init(&scheduleParams);
+    RadioSession_getStats(&before);
+
+    /* Levels can only be set with the radio open */
+    if (RadioSession_open() == NULL)
+    {
+        return false;
+    }
+
+    uint32_t start = RF_getCurrentTime();
+    RF_Handle rfHandle = NULL;
+
+    for (i = 0; i < numSteps; i++)
+    {
+        const TxSweep_Step *step = &plan[i];
+        TxSweep_StepResult stepResult;
+
+        memset(&stepResult, 0, sizeof(stepResult));
+        stepResult.step = *step;
+
+        uint32_t stepStart = RF_getCurrentTime();
+
+        /* The radio stays with the session for the whole sweep. Channel
+         * first, so the CMD_FS a PA switch posts is already the right one */
+        RadioSession_setChannel(step->channel);
+        RadioSession_setTxPower(step->txPower);
+        if (rfHandle == NULL)
+        {
+            rfHandle = RadioSession_beginTx(&scheduleParams);
+        }
+        else
+        {
+            RadioSession_tune(&scheduleParams);
+        }
+        stepResult.setupTicks = RF_getCurrentTime() - stepStart;
+
+        /* framesPerStep frames, chained TX_BURST_MAX_FRAMES at a time */
+        uint16_t remaining = params->framesPerStep;
+        while (remaining > 0)
+        {
+            uint8_t numFrames = (remaining > TX_BURST_MAX_FRAMES) ? TX_BURST_MAX_FRAMES : (uint8_t)remaining;
+            uint8_t f;
+
+            TxBurst_init(&txBurst);
+            for (f = 0; f < numFrames; f++)
+            {
+                fillFrame(params, step, TxBurst_addFrame(&txBurst, params->frameLength));
+            }
+            TxBurst_send(&txBurst, rfHandle, &scheduleParams);
+
+            uint8_t numSent = TxBurst_getNumSent(&txBurst);
+            stepResult.numSent += numSent;
+            stepResult.numErrors += numFrames - numSent;
+            remaining -= numFrames;
+        }
+        stepResult.elapsedTicks = RF_getCurrentTime() - stepStart;
+
+        result->numSteps++;
+        result->numSent += stepResult.numSent;
+        result->numErrors += stepResult.numErrors;
+
+        if (stepFxn != NULL)
+        {
+            uint32_t callbackStart = RF_getCurrentTime();
+            stepFxn(&stepResult);
+            callbackTicks += RF_getCurrentTime() - callbackStart;
+        }
+    }
+
+    RadioSession_endTx();
+
+    result->elapsedTicks = RF_getCurrentTime() - start - callbackTicks;
+    RadioSession_getStats(&after);
+    result->numPaSwitches = after.numPaSwitches - before.numPaSwitches;
+    result->numFsRuns = after.numFsRuns - before.numFsRuns;
+
+    return true;
+}
+
+int TxSweep_formatHeader(char *buf, size_t size)
+{
+    return snprintf(buf, size, "tx_dbm,channel,pa_switch,sent,errors,setup_us,elapsed_us\n");
+}
+
+int TxSweep_formatStep(const TxSweep_StepResult *result, char *buf, size_t size)
+{
+    return snprintf(buf, size, "%d,%u,%u,%u,%u,%lu,%lu\n",
+                    result->step.txPower, result->step.channel, result->step.paSwitch ? 1 : 0,
+                    result->numSent, result->numErrors,
+                    (unsigned long)RF_convertRatTicksToUs(result->setupTicks),
+                    (unsigned long)RF_convertRatTicksToUs(result->elapsedTicks));
+}
+
+int TxSweep_formatResult(const TxSweep_Result *result, char *buf, size_t size)
+{
+    return snprintf(buf, size, "# steps %u, PA switches %u, CMD_FS %u, sent %lu, errors %lu, %lu us\n",
+                    result->numSteps, result->numPaSwitches, result->numFsRuns,
+                    (unsigned long)result->numSent, (unsigned long)result->numErrors,
+                    (unsigned long)RF_convertRatTicksToUs(result->elapsedTicks));
+}
@@ -0,0 +1,116 @@
+/*
+ *  ======== txSweep.h ========
+ *  TX power and channel sweep for RF characterization.
+ *
+ *  Sends framesPerStep frames at every combination of a list of TX power
+ *  levels and channels, without user input and without yielding the radio
+ *  in between. Each frame carries the level and channel it was sent with.
+ *
+ *  Moving between the default and the high PA is by far the most expensive
+ *  step: the RF driver re-runs the radio setup with the other override set
+ *  (pOverrides_ieee154TxStd / pOverrides_ieee154Tx20) and the synthesizer
+ *  must be programmed again. Changing channel costs a CMD_FS, changing the
+ *  level within a PA only an RF_setTxPower(). With reorder set, the steps
+ *  are therefore run one PA at a time, starting with the PA currently in
+ *  use, then channel by channel, with every level of that PA on a channel
+ *  before moving on: one PA switch and one CMD_FS per channel and PA for
+ *  the whole sweep.
+ */
+#ifndef TXSWEEP_H_
+#define TXSWEEP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "macFrame.h"
+
+/* Most steps (levels times channels) of a sweep */
+#ifndef TX_SWEEP_MAX_STEPS
+#define TX_SWEEP_MAX_STEPS      128
+#endif
+
+typedef struct
+{
+    const int8_t *txPowers;     /* dBm, snapped to RADIO_SESSION_POWER_TABLE */
+    uint8_t numTxPowers;
+    const uint8_t *channels;    /* 11-26 */
+    uint8_t numChannels;
+    uint16_t framesPerStep;
+    uint8_t frameLength;        /* Without FCS, header plus at least 4 payload bytes */
+    const MacFrame_Template *frameTemplate;
+    bool reorder;               /* Order the steps for the fewest PA switches and CMD_FS */
+} TxSweep_Params;
+
+typedef struct
+{
+    int8_t  txPower;
+    uint8_t channel;
+    bool    paSwitch;           /* The step changes PA */
+} TxSweep_Step;
+
+typedef struct
+{
+    TxSweep_Step step;
+    uint16_t numSent;
+    uint16_t numErrors;         /* Frames that did not end with IEEE_DONE_OK */
+    uint32_t setupTicks;        /* RAT ticks to set level and channel */
+    uint32_t elapsedTicks;      /* RAT ticks for the whole step */
+} TxSweep_StepResult;
+
+typedef struct
+{
+    uint16_t numSteps;
+    uint16_t numPaSwitches;
+    uint16_t numFsRuns;
+    uint32_t numSent;
+    uint32_t numErrors;
+    uint32_t elapsedTicks;      /* RAT ticks for the sweep, without the step callbacks */
+} TxSweep_Result;
+
+/* Called after every step, e.g. to print it. Its time is not counted. */
+typedef void (*TxSweep_StepFxn)(const TxSweep_StepResult *result);
+
+/*
+ *  ======== TxSweep_Params_init ========
+ *  No levels or channels, 10 frames of 30 bytes per step, reordered.
+ */
+extern void TxSweep_Params_init(TxSweep_Params *params);
+
+/*
+ *  ======== TxSweep_plan ========
+ *  Writes the steps in the order they would run to steps. Returns their
+ *  number, 0 if a parameter is out of range or there are more than
+ *  maxSteps.
+ */
+extern uint16_t TxSweep_plan(const TxSweep_Params *params, TxSweep_Step *steps, uint16_t maxSteps);
+
+/*
+ *  ======== TxSweep_run ========
+ *  Runs the sweep on the radio session. Returns false, without sending
+ *  anything, if the plan is empty or the radio cannot be opened.
+ */
+extern bool TxSweep_run(const TxSweep_Params *params, TxSweep_StepFxn stepFxn, TxSweep_Result *result);
+
+/*
+ *  ======== TxSweep_formatHeader ========
+ *  Writes the CSV header line of TxSweep_formatStep(). Returns the length
+ *  like snprintf().
+ */
+extern int TxSweep_formatHeader(char *buf, size_t size);
+
+/*
+ *  ======== TxSweep_formatStep ========
+ *  Writes one CSV line: tx_dbm, channel, pa_switch, sent, errors,
+ *  setup_us, elapsed_us.
+ */
+extern int TxSweep_formatStep(const TxSweep_StepResult *result, char *buf, size_t size);
+
+/*
+ *  ======== TxSweep_formatResult ========
+ *  Writes the summary line: steps, PA switches, CMD_FS, frames sent and
+ *  failed, and the sweep time.
+ */
+extern int TxSweep_formatResult(const TxSweep_Result *result, char *buf, size_t size);
+
+#endif /* TXSWEEP_H_ */
@@ -0,0 +1,282 @@
+/*
+ *  ======== txTimed.c ========
+ */
+
+/***** Includes *****/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "txTimed.h"
+#include "macFrame.h"
+#include "radioSession.h"
+#include "radioTrace.h"
+
+/* TI Drivers */
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+/* Driverlib Header files */
+#include DeviceFamily_constructPath(driverlib/rf_ieee_cmd.h)
+
+/* Board Header files */
+#include <ti_radio_config.h>
+
+/***** Defines *****/
+#define START_TO_AIR            RF_convertUsToRatTicks(MAC_FRAME_TX_START_TO_AIR_US)
+
+/***** Type declarations *****/
+typedef struct
+{
+    rfc_CMD_IEEE_TX_t cmd;
+    RF_CmdHandle cmdHandle;
+    uint32_t slot;
+    uint32_t submitTime;
+    void *arg;
+    uint8_t payload[TX_TIMED_MAX_PAYLOAD_LENGTH];
+} TxTimed_Slot;
+
+/***** Prototypes *****/
+static void txTimedCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+static long offsetToUs(int32_t offset);
+
+/***** Variable declarations *****/
+static TxTimed_Slot slots[TX_TIMED_DEPTH];
+
+/* Free running counters: head is only written by TxTimed_submit(), tail
+ * only by the RF callback, so the ring needs no lock */
+static volatile uint32_t head;
+static volatile uint32_t tail;
+
+static RF_Handle rfHandle;
+static TxTimed_Callback userCallback;
+static TxTimed_Params timedParams;
+static uint32_t anchor;
+static uint32_t nextSlot;
+static TxTimed_Stats stats;
+
+/* Posted on every completion, for both a free command and an empty ring */
+static SemaphoreP_Struct doneSemStruct;
+static SemaphoreP_Handle doneSem;
+
+/***** Function definitions *****/
+
+static void txTimedCallback(RF_Handle h, RF_CmdHandle ch, RF_EventMask e)
+{
+    /* The RF driver runs the commands of one client in order, so the
+     * completed command is always the oldest one posted */
+    TxTimed_Slot *slot = &slots[tail % TX_TIMED_DEPTH];
+    TxTimed_Completion completion;
+
+    completion.status = ((volatile RF_Op*)&slot->cmd)->status;
+    completion.events = e;
+    completion.slot = slot->slot;
+    completion.slotTime = TxTimed_getSlotTime(slot->slot);
+    completion.timeStamp = slot->cmd.timeStamp;
+    completion.offset = 0;
+    completion.arg = slot->arg;
+
+    RadioTrace_add((RF_Op*)&slot->cmd, slot->submitTime,
+                   (completion.status == IEEE_DONE_OK) ? completion.timeStamp : RADIO_TRACE_NO_TIME,
+                   RF_getCurrentTime());
+    RadioSession_addAirTime(&slot->cmd);
+
+    if (completion.status == IEEE_DONE_OK)
+    {
+        /* RAT times wrap, the difference does not */
+        completion.offset = (int32_t)(completion.timeStamp - completion.slotTime);
+
+        if ((stats.numSent == 0) || (completion.offset < stats.minOffset))
+        {
+            stats.minOffset = completion.offset;
+        }
+        if ((stats.numSent == 0) || (completion.offset > stats.maxOffset))
+        {
+            stats.maxOffset = completion.offset;
+        }
+        stats.totalAbsOffset += (completion.offset < 0) ? -completion.offset : completion.offset;
+        stats.lastOffset = completion.offset;
+        stats.numSent++;
+
+        if ((timedParams.allowDelay != RF_AllowDelayAny) &&
+            (completion.offset > (int32_t)timedParams.allowDelay))
+        {
+            stats.numLate++;
+        }
+    }
+    else
+    {
+        stats.numErrors++;
+    }
+
+    /* Release the command before the user callback so it can submit again */
+    tail++;
+
+    if (userCallback != NULL)
+    {
+        userCallback(&completion);
+    }
+
+    SemaphoreP_post(doneSem);
+}
+
+/* RAT ticks to us, keeping the sign of an offset */
+static long offsetToUs(int32_t offset)
+{
+    return (offset < 0) ? -(long)RF_convertRatTicksToUs((uint32_t)-offset)
+                        : (long)RF_convertRatTicksToUs((uint32_t)offset);
+}
+
+void TxTimed_Params_init(TxTimed_Params *params)
+{
+    params->period = RF_convertUsToRatTicks(5000);
+    params->schedule = NULL;
+    params->scheduleLength = 0;
+    params->leadTime = RF_convertUsToRatTicks(2000);
+    params->allowDelay = RF_convertUsToRatTicks(10);
+}
+
+bool TxTimed_open(RF_Handle handle, const TxTimed_Params *params, TxTimed_Callback callback)
+{
+    uint8_t i;
+
+    if ((params->period == 0) || (params->scheduleLength > TX_TIMED_MAX_SCHEDULE) ||
+        ((params->schedule != NULL) && (params->scheduleLength == 0)) ||
+        (params->leadTime < START_TO_AIR))
+    {
+        return false;
+    }
+    for (i = 0; i < params->scheduleLength; i++)
+    {
+        if ((params->schedule[i] >= params->period) ||
+            ((i > 0) && (params->schedule[i] <= params->schedule[i - 1])))
+        {
+            return false;
+        }
+    }
+
+    if (doneSem == NULL)
+    {
+        doneSem = SemaphoreP_constructBinary(&doneSemStruct, 0);
+    }
+
+    rfHandle = handle;
+    userCallback = callback;
+    timedParams = *params;
+    if (timedParams.schedule == NULL)
+    {
+        timedParams.scheduleLength = 1;
+    }
+    head = 0;
+    tail = 0;
+    nextSlot = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    anchor = RF_getCurrentTime() + params->leadTime;
+
+    return true;
+}
+
+uint32_t TxTimed_getSlotTime(uint32_t slot)
+{
+    uint32_t time = anchor + (slot / timedParams.scheduleLength) * timedParams.period;
+
+    if (timedParams.schedule != NULL)
+    {
+        time += timedParams.schedule[slot % timedParams.scheduleLength];
+    }
+
+    return time;
+}
+
+int_fast8_t TxTimed_submit(const uint8_t *payload, uint8_t payloadLen, void *arg)
+{
+    if ((payloadLen == 0) || (payloadLen > TX_TIMED_MAX_PAYLOAD_LENGTH))
+    {
+        stats.numErrors++;
+        return TX_TIMED_STATUS_ERROR;
+    }
+
+    while (head - tail >= TX_TIMED_DEPTH)
+    {
+        SemaphoreP_pend(doneSem, SemaphoreP_WAIT_FOREVER);
+    }
+
+    /* The slot is used up whether the frame makes it or not */
+    uint32_t slotNumber = nextSlot++;
+    uint32_t startTime = TxTimed_getSlotTime(slotNumber) - START_TO_AIR;
+    uint32_t now = RF_getCurrentTime();
+
+    stats.numSubmitted++;
+
+    if ((timedParams.allowDelay != RF_AllowDelayAny) &&
+        ((int32_t)(now - startTime) > (int32_t)timedParams.allowDelay))
+    {
+        stats.numMissed++;
+        return TX_TIMED_STATUS_MISSED;
+    }
+
+    TxTimed_Slot *slot = &slots[head % TX_TIMED_DEPTH];
+
+    /* Start from the exported SmartRF Studio settings. pastTrig lets a
+     * command the radio core gets late still go out, to be measured. */
+    slot->cmd = RF_cmdIeeeTx_ieee154;
+    slot->cmd.payloadLen = payloadLen;
+    slot->cmd.pPayload = slot->payload;
+    slot->cmd.startTrigger.triggerType = TRIG_ABSTIME;
+    slot->cmd.startTrigger.pastTrig = 1;
+    slot->cmd.startTime = startTime;
+    slot->cmd.pNextOp = NULL;
+    slot->cmd.condition.rule = COND_NEVER;
+    memcpy(slot->payload, payload, payloadLen);
+
+    slot->slot = slotNumber;
+    slot->arg = arg;
+    slot->submitTime = now;
+
+    /* The driver powers the radio up in time for startTime and refuses the
+     * command if it cannot start it within allowDelay */
+    RF_ScheduleCmdParams scheduleParams;
+    RF_ScheduleCmdParams_init(&scheduleParams);
+    scheduleParams.startTime = startTime;
+    scheduleParams.startType = RF_StartAbs;
+    scheduleParams.allowDelay = timedParams.allowDelay;
+
+    /* The slot must be visible to the callback before the command runs */
+    head++;
+
+    slot->cmdHandle = RF_scheduleCmd(rfHandle, (RF_Op*)&slot->cmd, &scheduleParams, txTimedCallback, 0);
+    if (slot->cmdHandle < 0)
+    {
+        /* Nothing was queued behind this slot, so it can be taken back */
+        head--;
+        stats.numErrors++;
+        return TX_TIMED_STATUS_ERROR;
+    }
+
+    return TX_TIMED_STATUS_SUCCESS;
+}
+
+void TxTimed_waitEmpty(void)
+{
+    while (tail != head)
+    {
+        SemaphoreP_pend(doneSem, SemaphoreP_WAIT_FOREVER);
+    }
+}
+
+void TxTimed_getStats(TxTimed_Stats *pStats)
+{
+    *pStats = stats;
+}
+
+int TxTimed_formatStats(const TxTimed_Stats *s, char *buf, size_t size)
+{
+    uint32_t avgAbsOffset = (s->numSent == 0) ? 0 : s->totalAbsOffset / s->numSent;
+
+    return snprintf(buf, size, "# timed tx %lu of %lu, late %lu, missed %lu, errors %lu, "
+                               "offset %ld/%lu/%ld us\n",
+                    (unsigned long)s->numSent, (unsigned long)s->numSubmitted,
+                    (unsigned long)s->numLate, (unsigned long)s->numMissed,
+                    (unsigned long)s->numErrors, offsetToUs(s->minOffset),
+                    (unsigned long)RF_convertRatTicksToUs(avgAbsOffset), offsetToUs(s->maxOffset));
+}
@@ -0,0 +1,136 @@
+/*
+ *  ======== txTimed.h ========
+ *  IEEE 802.15.4 transmit at absolute radio timer times.
+ *
+ *  Every frame gets a slot on a fixed grid: slot k goes on air at
+ *
+ *      anchor + (k / scheduleLength) * period + schedule[k % scheduleLength]
+ *
+ *  where the anchor is leadTime after TxTimed_open() and schedule lists the
+ *  offsets of the frames inside one period (no schedule: one frame at the
+ *  start of each period). The CMD_IEEE_TX of a slot is posted ahead with
+ *  startTrigger TRIG_ABSTIME, so the radio core starts it from the RAT
+ *  compare and the spacing does not depend on thread scheduling, radio
+ *  power-up or processing time. Slots are fixed: a frame that misses its
+ *  slot does not move the ones after it.
+ *
+ *  Lateness is checked twice. Before posting, a slot whose start is more
+ *  than allowDelay in the past is given up (TX_TIMED_STATUS_MISSED); the
+ *  RF driver does the same from the allowDelay of the schedule parameters.
+ *  After the frame, its offset from the slot, timeStamp minus slot time, is
+ *  reported; frames that started more than allowDelay late are counted.
+ *
+ *  TxTimed_submit() must only be called from one thread at a time.
+ */
+#ifndef TXTIMED_H_
+#define TXTIMED_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* TI Drivers */
+#include <ti/drivers/rf/RF.h>
+
+/* Number of frames that can be posted ahead, at most the 8 commands per
+ * client the RF driver queues */
+#ifndef TX_TIMED_DEPTH
+#define TX_TIMED_DEPTH              4
+#endif
+
+/* Maximum MAC payload per frame: aMaxPHYPacketSize (127) minus the 2 byte FCS */
+#ifndef TX_TIMED_MAX_PAYLOAD_LENGTH
+#define TX_TIMED_MAX_PAYLOAD_LENGTH 125
+#endif
+
+/* Longest schedule inside one period */
+#define TX_TIMED_MAX_SCHEDULE       16
+
+/* TxTimed_submit() return values */
+#define TX_TIMED_STATUS_SUCCESS     (0)
+#define TX_TIMED_STATUS_MISSED      (-1)  /* Too late for the slot, frame dropped */
+#define TX_TIMED_STATUS_ERROR       (-2)  /* Invalid length or RF_scheduleCmd() failed */
+
+typedef struct
+{
+    uint32_t period;            /* RAT ticks, the grid repeats every period */
+    const uint32_t *schedule;   /* RAT ticks from the start of a period, ascending, or NULL */
+    uint8_t scheduleLength;
+    uint32_t leadTime;          /* RAT ticks from TxTimed_open() to the first slot */
+    uint32_t allowDelay;        /* RAT ticks a frame may start late, or RF_AllowDelayAny */
+} TxTimed_Params;
+
+typedef struct
+{
+    uint16_t status;            /* CMD_IEEE_TX status, IEEE_DONE_OK on success */
+    RF_EventMask events;        /* Events the RF driver reported for the command */
+    uint32_t slot;              /* Number of the slot since TxTimed_open() */
+    uint32_t slotTime;          /* RAT time the frame was due on air */
+    uint32_t timeStamp;         /* RAT time the frame started on air */
+    int32_t offset;             /* RAT ticks timeStamp - slotTime, 0 if not sent */
+    void *arg;                  /* Argument given to TxTimed_submit() */
+} TxTimed_Completion;
+
+typedef void (*TxTimed_Callback)(const TxTimed_Completion *completion);
+
+typedef struct
+{
+    uint32_t numSubmitted;
+    uint32_t numSent;
+    uint32_t numMissed;         /* Slots given up before posting */
+    uint32_t numLate;           /* Frames sent more than allowDelay after their slot */
+    uint32_t numErrors;         /* Frames that did not end with IEEE_DONE_OK, or could not be posted */
+    int32_t  lastOffset;        /* RAT ticks, as in TxTimed_Completion */
+    int32_t  minOffset;
+    int32_t  maxOffset;
+    uint32_t totalAbsOffset;    /* Sum of |offset| over numSent frames */
+} TxTimed_Stats;
+
+/*
+ *  ======== TxTimed_Params_init ========
+ *  One frame every 5 ms, the first 2 ms after TxTimed_open(), up to
+ *  10 us late.
+ */
+extern void TxTimed_Params_init(TxTimed_Params *params);
+
+/*
+ *  ======== TxTimed_open ========
+ *  Anchors the grid leadTime from now and clears the statistics. The
+ *  schedule is not copied. callback, called in the RF driver callback
+ *  context, may be NULL. Returns false if a parameter is out of range.
+ */
+extern bool TxTimed_open(RF_Handle rfHandle, const TxTimed_Params *params, TxTimed_Callback callback);
+
+/*
+ *  ======== TxTimed_submit ========
+ *  Copies payloadLen bytes and posts them for the next slot, waiting for
+ *  a free command if TX_TIMED_DEPTH are posted.
+ */
+extern int_fast8_t TxTimed_submit(const uint8_t *payload, uint8_t payloadLen, void *arg);
+
+/*
+ *  ======== TxTimed_getSlotTime ========
+ *  RAT time slot is due on air.
+ */
+extern uint32_t TxTimed_getSlotTime(uint32_t slot);
+
+/*
+ *  ======== TxTimed_waitEmpty ========
+ *  Blocks until all posted frames have completed.
+ */
+extern void TxTimed_waitEmpty(void);
+
+/*
+ *  ======== TxTimed_getStats ========
+ */
+extern void TxTimed_getStats(TxTimed_Stats *stats);
+
+/*
+ *  ======== TxTimed_formatStats ========
+ *  Writes one line: frames sent and submitted, late, missed, errors and
+ *  the min/avg/max offset from the slot in us, the average over |offset|.
+ *  Returns the length like snprintf().
+ */
+extern int TxTimed_formatStats(const TxTimed_Stats *stats, char *buf, size_t size);
+
+#endif /* TXTIMED_H_ */